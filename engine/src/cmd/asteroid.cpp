@@ -27,12 +27,21 @@
 
 #include "cmd/asteroid.h"
 
+#include <algorithm>
+
 #include "root_generic/vega_random.h"
 #include "cmd/script/flightgroup.h"
 #include "cmd/collection.h"
 #include "gfx_generic/vec.h"
 #include "gfx_generic/quaternion.h"
 #include "gfx_generic/matrix.h"
+#include "src/gfxlib.h"
+#include "src/star_system.h"
+#include "src/vegastrike.h"
+#include "configuration/configuration.h"
+
+extern double interpolation_blend_factor;
+extern float globQuerySphere(QVector start, QVector end, QVector pos, float radius);
 
 static void RecursiveSetSchedule(Unit *un) {
     if (un) {
@@ -48,8 +57,104 @@ static void RecursiveSetSchedule(Unit *un) {
     }
 }
 
-Asteroid::Asteroid(const char *filename, int faction, Flightgroup *fg, int fg_snumber,
-        float difficulty) : Unit(filename, false, faction, string(""), fg, fg_snumber) {
+AsteroidRocks *AsteroidRocks::loading = nullptr;
+
+AsteroidRocks::~AsteroidRocks() {
+    for (Unit *prototype : prototypes) {
+        prototype->Kill();
+        prototype->UnRef();
+    }
+}
+
+AsteroidRocks *AsteroidRocks::TakeLoading() {
+    AsteroidRocks *rocks = loading;
+    loading = nullptr;
+    return rocks;
+}
+
+bool AsteroidRocks::Add(const std::string &file, const QVector &position, QVector q, QVector r) {
+    const size_t kind = std::find(files.begin(), files.end(), file) - files.begin();
+    if (kind == files.size()) {
+        return false;
+    }
+    //same orientation Movable::SetOrientation builds for a subunit
+    q.Normalize();
+    r.Normalize();
+    QVector p;
+    CrossProduct(q, r, p);
+    CrossProduct(r, p, q);
+    field.Add(static_cast<uint16_t>(kind), position, Quaternion::from_vectors(p.Cast(), q.Cast(), r.Cast()),
+            prototypes[kind]->rSize());
+    return true;
+}
+
+bool AsteroidRocks::Adopt(Unit *rock) {
+    const std::string file = rock->name.get();
+    //only plain rocks; anything with subunits of its own, or spawned by chance, stays a unit
+    if (!rock->SubUnits.empty() || file.find("randomspawn") != std::string::npos || files.size() > UINT16_MAX) {
+        return false;
+    }
+    const uint16_t kind = static_cast<uint16_t>(files.size());
+    files.push_back(file);
+    rock->Ref();
+    prototypes.push_back(rock);
+    field.Add(kind, rock->curr_physical_state.position, rock->curr_physical_state.orientation, rock->rSize());
+    return true;
+}
+
+Unit *AsteroidRocks::Promote(size_t i, Unit *field_unit) {
+    const std::string &file = files[field.Kind(i)];
+    Unit *rock = new Unit(file.c_str(), true, field_unit->faction, std::string(), nullptr);
+    if (!field_unit->isSubUnit()) {
+        rock->SetRecursiveOwner(field_unit);
+    }
+    rock->curr_physical_state = field.RockTransformation(i);
+    rock->prev_physical_state = rock->curr_physical_state;
+    //placed right away, as a bolt may be about to hit it
+    rock->cumulative_transformation = rock->curr_physical_state;
+    rock->cumulative_transformation.Compose(field_unit->cumulative_transformation,
+            field_unit->cumulative_transformation_matrix);
+    rock->cumulative_transformation.to_matrix(rock->cumulative_transformation_matrix);
+    rock->name = file;
+    rock->SetAngularVelocity(field.Spin(i));
+    rock->schedule_priority = Unit::scheduleRoid;
+    field_unit->SubUnits.prepend(rock);
+    field.MarkPromoted(i);
+    return rock;
+}
+
+void AsteroidRocks::Draw(const Matrix &field_matrix, double offset) const {
+    Matrix local;
+    Matrix world;
+    for (size_t i = 0; i < field.size(); ++i) {
+        if (field.Promoted(i)) {
+            continue;
+        }
+        if (!GFXSphereInFrustum(Transform(field_matrix, field.Position(i)), field.Radius(i))) {
+            continue;
+        }
+        field.RockTransformation(i, offset).to_matrix(local);
+        MultMatrix(world, field_matrix, local);
+        prototypes[field.Kind(i)]->DrawInstance(world);
+    }
+}
+
+Asteroid::Asteroid(const char *filename, int faction, Flightgroup *fg, int fg_snumber, float difficulty)
+        : Asteroid(BeginLoad(), filename, faction, fg, fg_snumber, difficulty) {
+}
+
+AsteroidRocks *Asteroid::BeginLoad() {
+    if (!configuration().physics.lightweight_asteroid_fields) {
+        return nullptr;
+    }
+    AsteroidRocks::loading = new AsteroidRocks();
+    return AsteroidRocks::loading;
+}
+
+Asteroid::Asteroid(AsteroidRocks *loading, const char *filename, int faction, Flightgroup *fg, int fg_snumber,
+        float difficulty) : Unit(filename, false, faction, string(""), fg, fg_snumber), rocks(loading) {
+    //nobody asked for it if the field has no subunits at all
+    AsteroidRocks::loading = nullptr;
     asteroid_physics_offset = 0;
     un_iter iter = getSubUnits();
     while (*iter) {
@@ -59,7 +164,104 @@ Asteroid::Asteroid(const char *filename, int faction, Flightgroup *fg, int fg_sn
         (*iter)->SetAngularVelocity(Vector(x, y, z));
         ++iter;
     }
+    if (rocks && rocks->field.size() == 0) {
+        rocks.reset();
+    }
+    if (rocks) {
+        for (size_t i = 0; i < rocks->field.size(); ++i) {
+            float x = VegaRandom::Instance().RandomFloatInRange(-difficulty, difficulty);
+            float y = VegaRandom::Instance().RandomFloatInRange(-difficulty, difficulty);
+            float z = VegaRandom::Instance().RandomFloatInRange(-difficulty, difficulty);
+            rocks->field.SetSpin(i, Vector(x, y, z));
+        }
+        rocks->field.Build();
+        //the rocks kept as data still count toward the field's size, for the collide map and the scans
+        Vector rocks_min, rocks_max;
+        rocks->field.Extent(rocks_min, rocks_max);
+        if (radial_size > 0) {
+            rocks_min = rocks_min.Min(corner_min);
+            rocks_max = rocks_max.Max(corner_max);
+        }
+        corner_min = rocks_min;
+        corner_max = rocks_max;
+        radial_size = std::max(corner_min.Magnitude(), corner_max.Magnitude());
+    }
     RecursiveSetSchedule(this);
 }
 
 Asteroid::~Asteroid() = default;
+
+void Asteroid::PromoteNearbyRocks() {
+    AsteroidField &field = rocks->field;
+    field.Advance(simulation_atom_var);
+    promotion_countdown -= simulation_atom_var;
+    if (promotion_countdown > 0 || field.promoted_count() == field.size() || activeStarSystem == nullptr) {
+        return;
+    }
+    const float interval = configuration().physics.asteroid_promotion_scan_interval_flt;
+    const float reach = configuration().physics.asteroid_promotion_distance_flt;
+    promotion_countdown = interval;
+    std::vector<uint32_t> hits;
+    for (un_iter iter = activeStarSystem->getUnitList().createIterator(); *iter; ++iter) {
+        Unit *un = *iter;
+        const Vega_UnitType type = un->getUnitType();
+        if (un == this || type == Vega_UnitType::asteroid || type == Vega_UnitType::planet
+                || type == Vega_UnitType::nebula) {
+            continue;
+        }
+        //anything that can get within reach of a rock before the next scan
+        const float range = un->rSize() + reach + un->GetVelocity().Magnitude() * interval;
+        if ((un->Position() - Position()).Magnitude() > rSize() + range) {
+            continue;
+        }
+        hits.clear();
+        field.QuerySphere(InvTransform(cumulative_transformation_matrix, un->Position()), range, hits);
+        for (uint32_t rock : hits) {
+            rocks->Promote(rock, this);
+        }
+    }
+}
+
+void Asteroid::PromoteRockOnRay(const QVector &start, const QVector &end) {
+    const int64_t rock = rocks->field.QuerySegment(InvTransform(cumulative_transformation_matrix, start),
+            InvTransform(cumulative_transformation_matrix, end));
+    if (rock >= 0) {
+        rocks->Promote(static_cast<size_t>(rock), this);
+    }
+}
+
+Unit *Asteroid::rayCollide(csCollisionContext &context,
+        const QVector &start,
+        const QVector &end,
+        Vector &normal,
+        float &distance) {
+    //rocks nobody came close to are only data, so whatever is fired at them from afar has to bring them in
+    if (rocks && rocks->field.promoted_count() < rocks->field.size()
+            && configuration().physics.asteroid_weapon_collision
+            && globQuerySphere(start, end, cumulative_transformation_matrix.p, rSize())) {
+        PromoteRockOnRay(start, end);
+    }
+    return Unit::rayCollide(context, start, end, normal, distance);
+}
+
+void Asteroid::UpdatePhysics2(const Transformation &trans,
+        const Transformation &old_physical_state,
+        const Vector &accel,
+        float difficulty,
+        const Matrix &transmat,
+        const Vector &cum_vel,
+        bool lastframe,
+        UnitCollection *uc) {
+    Unit::UpdatePhysics2(trans, old_physical_state, accel, difficulty, transmat, cum_vel, lastframe, uc);
+    if (rocks) {
+        PromoteNearbyRocks();
+    }
+}
+
+void Asteroid::Draw(const Transformation &parent, const Matrix &parentMatrix) {
+    Unit::Draw(parent, parentMatrix);
+    if (rocks && !Killed()) {
+        //the rocks' time only advances once per atom; draw them between the last two, as subunits are
+        rocks->Draw(cumulative_transformation_matrix, (interpolation_blend_factor - 1.0) * simulation_atom_var);
+    }
+}
@@ -33,10 +33,64 @@
 #include "cmd/script/flightgroup.h"
 #include "cmd/collection.h"
 #include "cmd/unit_generic.h"
+#include "cmd/asteroid_field.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The rocks of an asteroid field that were never built as units, with one
+ * loaded unit per rock file to draw them and to copy when one is promoted.
+ *
+ * It is set up before the field's Unit loads, so the loader can hand plain
+ * rocks over instead of building a unit for each of them.
+ */
+class AsteroidRocks {
+public:
+    AsteroidRocks() = default;
+    ~AsteroidRocks();
+
+    AsteroidRocks(const AsteroidRocks &) = delete;
+    AsteroidRocks &operator=(const AsteroidRocks &) = delete;
+
+    /// the rocks being loaded right now, if any; only the first top level unit to ask gets them
+    static AsteroidRocks *TakeLoading();
+
+    /// records a rock of a file already seen; false if the file still needs a unit built
+    bool Add(const std::string &file, const QVector &position, QVector q, QVector r);
+    /// keeps a freshly built rock unit to draw the rocks of its file; false if it is not a plain rock
+    bool Adopt(Unit *rock);
+
+    /// turns rock i into a subunit of field_unit and returns it
+    Unit *Promote(size_t i, Unit *field_unit);
+
+    /// queues every unpromoted rock in view; field_matrix is the field's cumulative transformation,
+    /// offset how many seconds before the field's current time the frame is drawn at
+    void Draw(const Matrix &field_matrix, double offset) const;
+
+    AsteroidField field;
+
+private:
+    friend class Asteroid;
+    static AsteroidRocks *loading;
+
+    std::vector<std::string> files;
+    std::vector<Unit *> prototypes;
+};
 
 class Asteroid : public Unit {
 private:
     unsigned int asteroid_physics_offset{};
+    //the rocks nobody came close to yet, if physics.lightweight_asteroid_fields is on
+    std::unique_ptr<AsteroidRocks> rocks;
+    float promotion_countdown{};
+
+    Asteroid(AsteroidRocks *loading, const char *filename, int faction, Flightgroup *fg, int fg_snumber,
+            float difficulty);
+    static AsteroidRocks *BeginLoad();
+    void PromoteNearbyRocks();
+    void PromoteRockOnRay(const QVector &start, const QVector &end);
 
 public:
     Asteroid(const char *filename, int faction, Flightgroup *fg = nullptr, int fg_snumber = 0, float difficulty = .01);
@@ -49,6 +103,23 @@ public:
         return Vega_UnitType::asteroid;
     }
 
+    void UpdatePhysics2(const Transformation &trans,
+            const Transformation &old_physical_state,
+            const Vector &accel,
+            float difficulty,
+            const Matrix &transmat,
+            const Vector &CumulativeVelocity,
+            bool ResolveLast,
+            UnitCollection *uc = NULL) override;
+
+    void Draw(const Transformation &quat = identity_transformation,
+            const Matrix &m = identity_matrix) override;
+
+    using Unit::rayCollide;
+    /// promotes the first rock the bolt or beam runs into, so it is hit like any subunit
+    Unit *rayCollide(csCollisionContext &context, const QVector &start, const QVector &end, Vector &normal,
+            float &distance) override;
+
 private:
 
     Asteroid(std::vector<Mesh *> m, bool b, int i) : Unit(m, b, i) {
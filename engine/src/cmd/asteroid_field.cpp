@@ -0,0 +1,162 @@
+/*
+ * asteroid_field.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "cmd/asteroid_field.h"
+
+size_t AsteroidField::Add(uint16_t rock_kind, const QVector &position, const Quaternion &rock_orientation,
+        float rock_radius) {
+    pos_x.push_back(position.i);
+    pos_y.push_back(position.j);
+    pos_z.push_back(position.k);
+    radius.push_back(rock_radius);
+    orientation.push_back(rock_orientation);
+    spin.push_back(Vector(0, 0, 0));
+    kind.push_back(rock_kind);
+    promoted.push_back(0);
+    max_radius = std::max(max_radius, rock_radius);
+    return size() - 1;
+}
+
+void AsteroidField::MarkPromoted(size_t i) {
+    if (!promoted[i]) {
+        promoted[i] = 1;
+        ++promoted_rocks;
+    }
+}
+
+uint64_t AsteroidField::CellKey(int x, int y, int z) const {
+    const uint64_t mask = (1U << 21) - 1;
+    return ((static_cast<uint64_t>(x) & mask) << 42) | ((static_cast<uint64_t>(y) & mask) << 21)
+            | (static_cast<uint64_t>(z) & mask);
+}
+
+void AsteroidField::Build() {
+    //cells about the size of the biggest rock keep each query to a few cells
+    cell_size = std::max(2.0 * max_radius, 1.0);
+    cells.clear();
+    for (size_t i = 0; i < size(); ++i) {
+        cells[CellKey(static_cast<int>(floor(pos_x[i] / cell_size)),
+                static_cast<int>(floor(pos_y[i] / cell_size)),
+                static_cast<int>(floor(pos_z[i] / cell_size)))].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+Transformation AsteroidField::RockTransformation(size_t i, double offset) const {
+    //same rotation Movable::Rotate applies each atom, taken in one step
+    const Vector axis = spin[i] * static_cast<float>(time + offset);
+    const double theta = axis.Magnitude();
+    Quaternion rot = identity_quaternion;
+    if (theta >= 0.0001) {
+        rot = Quaternion(cos(theta * .5), axis * static_cast<float>(sin(theta * .5) / theta));
+    }
+    return Transformation(orientation[i] * rot, QVector(pos_x[i], pos_y[i], pos_z[i]));
+}
+
+void AsteroidField::QuerySphere(const QVector &center, float query_radius, std::vector<uint32_t> &hits) const {
+    const double reach = query_radius + max_radius;
+    const int x0 = static_cast<int>(floor((center.i - reach) / cell_size));
+    const int x1 = static_cast<int>(floor((center.i + reach) / cell_size));
+    const int y0 = static_cast<int>(floor((center.j - reach) / cell_size));
+    const int y1 = static_cast<int>(floor((center.j + reach) / cell_size));
+    const int z0 = static_cast<int>(floor((center.k - reach) / cell_size));
+    const int z1 = static_cast<int>(floor((center.k + reach) / cell_size));
+    auto test = [&](uint32_t i) {
+        if (promoted[i]) {
+            return;
+        }
+        const double dx = pos_x[i] - center.i, dy = pos_y[i] - center.j, dz = pos_z[i] - center.k;
+        const double r = query_radius + radius[i];
+        if (dx * dx + dy * dy + dz * dz <= r * r) {
+            hits.push_back(i);
+        }
+    };
+    const double span = static_cast<double>(x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1);
+    if (span > static_cast<double>(cells.size())) {
+        //the query covers more cells than are occupied; walk the occupied ones instead
+        for (const auto &cell : cells) {
+            for (uint32_t i : cell.second) {
+                test(i);
+            }
+        }
+        return;
+    }
+    for (int x = x0; x <= x1; ++x) {
+        for (int y = y0; y <= y1; ++y) {
+            for (int z = z0; z <= z1; ++z) {
+                auto cell = cells.find(CellKey(x, y, z));
+                if (cell != cells.end()) {
+                    for (uint32_t i : cell->second) {
+                        test(i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int64_t AsteroidField::QuerySegment(const QVector &start, const QVector &end) const {
+    const QVector dir = end - start;
+    const double length2 = dir.Dot(dir);
+    std::vector<uint32_t> hits;
+    QuerySphere((start + end) * 0.5, static_cast<float>(0.5 * sqrt(length2)), hits);
+    int64_t first = -1;
+    double first_entry = 0.0;
+    for (uint32_t i : hits) {
+        const QVector to_rock = Position(i) - start;
+        const double along = length2 > 0.0 ? std::min(std::max(to_rock.Dot(dir) / length2, 0.0), 1.0) : 0.0;
+        const QVector miss = to_rock - dir * along;
+        const double r2 = static_cast<double>(radius[i]) * radius[i];
+        const double gap2 = miss.Dot(miss);
+        if (gap2 > r2) {
+            continue;
+        }
+        //where the segment enters the sphere, as a fraction of its length
+        const double entry = length2 > 0.0 ? std::max(along - sqrt((r2 - gap2) / length2), 0.0) : 0.0;
+        if (first < 0 || entry < first_entry) {
+            first = i;
+            first_entry = entry;
+        }
+    }
+    return first;
+}
+
+void AsteroidField::Extent(Vector &corner_min, Vector &corner_max) const {
+    if (size() == 0) {
+        corner_min = corner_max = Vector(0, 0, 0);
+        return;
+    }
+    corner_min = Vector(FLT_MAX, FLT_MAX, FLT_MAX);
+    corner_max = Vector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (size_t i = 0; i < size(); ++i) {
+        const Vector r(radius[i], radius[i], radius[i]);
+        corner_min = corner_min.Min(Position(i).Cast() - r);
+        corner_max = corner_max.Max(Position(i).Cast() + r);
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * asteroid_field.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_ASTEROID_FIELD_H
+#define VEGA_STRIKE_ENGINE_CMD_ASTEROID_FIELD_H
+
+#include <cstdint>
+#include <vector>
+
+#include "gfx_generic/quaternion.h"
+#include "gfx_generic/vec.h"
+#include "src/gnuhash.h"
+
+/**
+ * The rocks of an asteroid field, kept as plain data instead of subunits.
+ *
+ * Positions, radii, orientations and spin are stored as parallel arrays in
+ * the frame of the field. Rocks only spin, so their orientation at any time
+ * is computed directly from the spin instead of being integrated, and their
+ * positions never change, which lets the field keep a static grid for
+ * proximity queries. A rock is turned back into a real subunit (promoted)
+ * once something comes close enough to interact with it; the units
+ * themselves are handled by Asteroid, this class knows nothing about them.
+ */
+class AsteroidField {
+public:
+    /// records a rock of the given kind (one kind per rock file) and returns its index
+    size_t Add(uint16_t kind, const QVector &position, const Quaternion &orientation, float radius);
+    /// builds the proximity grid; call once all rocks are added
+    void Build();
+
+    size_t size() const {
+        return radius.size();
+    }
+
+    size_t promoted_count() const {
+        return promoted_rocks;
+    }
+
+    void Advance(double seconds) {
+        time += seconds;
+    }
+
+    void SetSpin(size_t i, const Vector &angular_velocity) {
+        spin[i] = angular_velocity;
+    }
+
+    const Vector &Spin(size_t i) const {
+        return spin[i];
+    }
+
+    uint16_t Kind(size_t i) const {
+        return kind[i];
+    }
+
+    QVector Position(size_t i) const {
+        return QVector(pos_x[i], pos_y[i], pos_z[i]);
+    }
+
+    float Radius(size_t i) const {
+        return radius[i];
+    }
+
+    bool Promoted(size_t i) const {
+        return promoted[i] != 0;
+    }
+
+    /// takes rock i out of queries and drawing, once it became a subunit
+    void MarkPromoted(size_t i);
+
+    /// the transformation of rock i relative to the field, offset seconds from the current time
+    Transformation RockTransformation(size_t i, double offset = 0.0) const;
+
+    /// indices of the unpromoted rocks whose sphere comes within radius of center (field space)
+    void QuerySphere(const QVector &center, float radius, std::vector<uint32_t> &hits) const;
+    /// the unpromoted rock whose sphere the segment enters first (field space), or -1 if none
+    int64_t QuerySegment(const QVector &start, const QVector &end) const;
+
+    /// the box bounding every rock's sphere, in field space; empty if there are no rocks
+    void Extent(Vector &corner_min, Vector &corner_max) const;
+
+private:
+    uint64_t CellKey(int x, int y, int z) const;
+
+    //per rock, in field space
+    std::vector<double> pos_x, pos_y, pos_z;
+    std::vector<float> radius;
+    std::vector<Quaternion> orientation;
+    std::vector<Vector> spin;
+    std::vector<uint16_t> kind;
+    std::vector<uint8_t> promoted;
+
+    double cell_size = 1.0;
+    vsUMap<uint64_t, std::vector<uint32_t>> cells;
+    float max_radius = 0.0F;
+    double time = 0.0;
+    size_t promoted_rocks = 0;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_ASTEROID_FIELD_H
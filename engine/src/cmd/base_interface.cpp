@@ -727,6 +727,7 @@ void base_main_loop() {
     UpdateTime();
     Music::MuzakCycle();
 
+    Texture::UpdateResidency();
     GFXBeginScene();
     if (createdbase) {
         createdbase = false;
@@ -38,7 +38,11 @@ using std::vector;
 #include "cmd/mount_size.h"
 #include "cmd/weapon_info.h"
 #include "cmd/damageable.h"
+#include "collide2/CSopcodecollider.h"
 #include "src/universe.h"
+#include "src/star_system.h"
+#include "cmd/collide_map.h"
+#include "gfx_generic/weapon_instances.h"
 
 #include <algorithm>
 #include <cmath>
@@ -55,26 +59,42 @@ extern bool AdjustMatrix(Matrix &mat, const Vector &velocity, Unit *target, floa
  */
 struct BeamDrawContext {
     Matrix m;
-    class GFXVertexList *vlist;
     Beam *beam;
 
     BeamDrawContext() {
     }
 
-    BeamDrawContext(const Matrix &a, GFXVertexList *vl, Beam *b) : m(a), vlist(vl), beam(b) {
+    BeamDrawContext(const Matrix &a, Beam *b) : m(a), beam(b) {
     }
 };
 
 static DecalQueue beamdecals;
 static vector<vector<BeamDrawContext> > beamdrawqueue;
+///this frame's beams of one decal, next to the camera
+static WeaponInstances beaminstances;
 
-/*
- * Internal functions
- */
-static bool beamCheckCollision(QVector pos, float len, const Collidable &un) {
-    return (un.GetPosition() - pos).MagnitudeSquared() <= len * len + 2 * len * un.radius + un.radius * un.radius;
+///the most vertices RecalculateVertices writes for a beam
+static int beamVertexCount() {
+    const int radslices = configuration().physics.tractor.scoop_rad_slices | 1;    //Must be odd
+    const int longslices = configuration().physics.tractor.scoop_long_slices;
+    return std::max(48, ((4 * radslices) + 1) * longslices * 4);
 }
 
+///a beam waiting for the batched collision pass that follows unit physics
+struct BeamCollision {
+    Beam *beam;
+    Unit *target;
+    Unit *firer;
+    Unit *superunit;
+    ///the firing unit's simulation_atom_var, which scales the damage
+    float atom;
+    ///a scooping tractor or repulsor, which bends toward targets off its axis
+    bool scooping;
+};
+
+static vector<BeamCollision> beamcollidequeue;
+static bool beamcollideflushing = false;
+
 
 
 /*
@@ -96,8 +116,7 @@ static bool beamCheckCollision(QVector pos, float len, const Collidable &un) {
     }                               \
     while (0)
 
-void Beam::RecalculateVertices(const Matrix &trans) {
-    GFXColorVertex *beam = (vlist->BeginMutate(0))->colors;
+int Beam::RecalculateVertices(const Matrix &trans, GFXColorVertex *beam, float &length, float &scroll) {
     const float fadelocation = configuration().graphics.beam_fadeout_length_flt;
     const float hitfadelocation = configuration().graphics.beam_fadeout_hit_length_flt;
     //In radians - the /2 is because of the way in which we check against the cone.
@@ -236,92 +255,95 @@ void Beam::RecalculateVertices(const Matrix &trans) {
             beam[a].y = aux;
         }
     }
-    vlist->EndMutate(a);
+    length = len;
+    scroll = leftex;
+    return a;
 }
 
 #undef V
 
-void Beam::CollideHuge(const LineCollide &lc, Unit *targetToCollideWith, Unit *firer, Unit *superunit) {
-    QVector x0 = center;
-    QVector v = direction * curlength;
-    if (is_null(superunit->location[Unit::UNIT_ONLY]) && curlength) {
-        if (targetToCollideWith) {
-            this->Collide(targetToCollideWith, firer, superunit);
+void Beam::QueueCollision(Unit *targetToCollideWith, Unit *firer, Unit *superunit) {
+    if (curlength) {
+        beamcollidequeue.push_back(BeamCollision{this, targetToCollideWith, firer, superunit, simulation_atom_var, false});
+    }
+}
+
+void Beam::ProcessCollideQueue(StarSystem *ss) {
+    if (beamcollidequeue.empty() || beamcollideflushing) {
+        return;
+    }
+    static vector<CollideCapsule> capsules;
+    static vector<size_t> capsule_of;
+    static vector<std::pair<size_t, Unit *> > hits;
+    static vector<std::pair<double, Unit *> > candidates;
+    const bool scoop = configuration().physics.tractor.scoop;
+    csCollisionContext &context = csCollisionContext::ForThisThread();
+    beamcollideflushing = true;
+    capsules.clear();
+    capsule_of.assign(beamcollidequeue.size(), static_cast<size_t>(-1));
+    for (size_t i = 0; i < beamcollidequeue.size(); ++i) {
+        BeamCollision &q = beamcollidequeue[i];
+        if (is_null(q.superunit->location[Unit::UNIT_ONLY])) {
+            continue;   //not in the collide map: only its target is checked
         }
-    } else if (curlength) {
-        CollideMap *cm = _Universe->activeStarSystem()->collide_map[Unit::UNIT_ONLY];
-
-        CollideMap::iterator superloc = superunit->location[Unit::UNIT_ONLY];
-        CollideMap::iterator tmore = superloc;
-        if (!cm->Iterable(superloc)) {
-            CollideArray::CollidableBackref *br = static_cast< CollideArray::CollidableBackref * > (superloc);
-            CollideMap::iterator tmploc = cm->begin() + br->toflattenhints_offset;
-            if (tmploc == cm->end()) {
-                tmploc--;
-            }
-            tmore = superloc = tmploc;             //don't decrease tless
+        const Beam *b = q.beam;
+        const bool tractor = (b->damagerate < 0 && b->phasedamage > 0) || (b->damagerate > 0 && b->phasedamage < 0);
+        q.scooping = scoop && tractor;
+        capsule_of[i] = capsules.size();
+        if (q.scooping) {
+            //a scooping beam bends toward anything in its cone, so look all around its origin
+            capsules.push_back(CollideCapsule{b->center, b->center, b->curlength + b->curthick});
         } else {
-            ++tmore;
+            capsules.push_back(CollideCapsule{b->center, b->center + b->direction.Cast() * b->curlength, b->curthick});
         }
-        double r0 = x0.i;
-        double r1 = x0.i + v.i;
-        double minlook = r0 < r1 ? r0 : r1;
-        double maxlook = r0 < r1 ? r1 : r0;
-        bool targcheck = false;
-        maxlook += (maxlook - (*superunit->location[Unit::UNIT_ONLY])->getKey())
-                + 2 * curlength;           //double damage, yo
-        minlook += (minlook - (*superunit->location[Unit::UNIT_ONLY])->getKey()) - 2 * curlength * curlength;
-        //(a+2*b)^2-(a+b)^2 = 3b^2+2ab = 2b^2+(a+b)^2-a^2
-        if (superloc != cm->begin()
-                && minlook < (*superunit->location[Unit::UNIT_ONLY])->getKey()) {
-            //less traversal
-            CollideMap::iterator tless = superloc;
-            --tless;
-            while ((*tless)->getKey() >= minlook) {
-                CollideMap::iterator curcheck = tless;
-                bool breakit = false;
-                if (tless != cm->begin()) {
-                    --tless;
-                } else {
-                    breakit = true;
-                }
-                if ((*curcheck)->radius > 0) {
-                    if (beamCheckCollision(center, curlength, (**curcheck))) {
-                        Unit *tmp = (**curcheck).ref.unit;
-                        this->Collide(tmp, firer, superunit);
-                        targcheck = (targcheck || tmp == targetToCollideWith);
-                    }
-                }
-                if (breakit) {
-                    break;
-                }
+    }
+    ss->collide_map[Unit::UNIT_ONLY]->QueryCapsules(capsules, hits);
+    size_t next_hit = 0;
+    for (size_t i = 0; i < beamcollidequeue.size(); ++i) {
+        const BeamCollision q = beamcollidequeue[i];
+        candidates.clear();
+        if (capsule_of[i] != static_cast<size_t>(-1)) {
+            while (next_hit < hits.size() && hits[next_hit].first < capsule_of[i]) {
+                ++next_hit;
+            }
+            const CollideCapsule &capsule = capsules[capsule_of[i]];
+            for (; next_hit < hits.size() && hits[next_hit].first == capsule_of[i]; ++next_hit) {
+                Unit *un = hits[next_hit].second;
+                QVector offset(un->Position() - capsule.start);
+                candidates.push_back(std::make_pair(
+                        q.scooping ? offset.MagnitudeSquared() : offset.Dot(capsule.end - capsule.start), un));
             }
+            //nearest first: a hit shortens the beam, so the ones behind are cheaply rejected
+            std::sort(candidates.begin(), candidates.end());
         }
-        if (maxlook > (*superunit->location[Unit::UNIT_ONLY])->getKey()) {
-            //greater traversal
-            while (tmore != cm->end() && (*tmore)->getKey() <= maxlook) {
-                if ((*tmore)->radius > 0) {
-                    Unit *un = (*tmore)->ref.unit;
-                    if (beamCheckCollision(center, curlength, **tmore++)) {
-                        this->Collide(un, firer, superunit);
-                        targcheck = (targcheck || un == targetToCollideWith);
-                    }
-                } else {
-                    ++tmore;
-                }
+        const float backup = simulation_atom_var;
+        simulation_atom_var = q.atom;
+        bool targcheck = false;
+        for (size_t j = 0; j < candidates.size() && beamcollidequeue[i].beam; ++j) {
+            Beam *b = q.beam;
+            Unit *un = candidates[j].second;
+            QVector end(b->center + b->direction.Cast() * b->curlength);
+            if (!q.scooping && !un->capsuleMayCollide(context, b->center, end, b->curthick)) {
+                continue;
             }
+            b->Collide(context, un, q.firer, q.superunit);
+            targcheck = (targcheck || un == q.target);
         }
-        if (targetToCollideWith && !targcheck) {
-            this->Collide(targetToCollideWith, firer, superunit);
+        //the beam may have been destroyed along with a unit it killed
+        if (q.target && !targcheck && beamcollidequeue[i].beam) {
+            q.beam->Collide(context, q.target, q.firer, q.superunit);
         }
+        simulation_atom_var = backup;
     }
+    beamcollidequeue.clear();
+    beamcollideflushing = false;
 }
 
 /*
  * Constructors
  */
 Beam::Beam(const Transformation &trans, const WeaponInfo &clne, void *own, Unit *firer, int sound)
-        : vlist(NULL), Col(clne.r, clne.g, clne.b, clne.a) {
+        : Col(clne.r, clne.g, clne.b, clne.a) {
     listen_to_owner = false;
 #ifdef PERBOLTSOUND
     sound = AUDCreateSound( clne.sound, true );
@@ -356,8 +378,6 @@ Beam::Beam(const Transformation &trans, const WeaponInfo &clne, void *own, Unit
     impact = ALIVE;
     owner = own;
     numframes = 0;
-    const int radslices = configuration().physics.tractor.scoop_rad_slices | 1;    //Must be odd
-    const int longslices = configuration().physics.tractor.scoop_long_slices;
     lastlength = 0;
     curlength = simulation_atom_var * speed;
     lastthick = 0;
@@ -365,17 +385,6 @@ Beam::Beam(const Transformation &trans, const WeaponInfo &clne, void *own, Unit
     if (curthick > thickness) {      //clamp to max thickness - needed for large simulation atoms
         curthick = thickness;
     }
-    static GFXVertexList *_vlist = 0;
-    if (!_vlist) {
-        int numvertex = float_to_int(std::max(48, ((4 * radslices) + 1) * longslices * 4));
-        GFXColorVertex *beam =
-                new GFXColorVertex[numvertex];         //regretably necessary: radslices and longslices come from the config file... so it's at runtime.
-//        memset( beam, 0, sizeof (*beam)*numvertex );
-        _vlist = new GFXVertexList(GFXQUAD, numvertex, beam, numvertex, true);         //mutable color contained list
-        delete[] beam;
-    }
-    //Shared vlist - we recalculate it every time, so no loss
-    vlist = _vlist;
 #ifdef PERBOLTSOUND
     AUDStartPlaying( sound );
 #endif
@@ -385,14 +394,23 @@ Beam::Beam(const Transformation &trans, const WeaponInfo &clne, void *own, Unit
 
 Beam::~Beam() {
     VSDESTRUCT2
+    for (size_t i = 0; i < beamcollidequeue.size(); ++i) {
+        if (beamcollidequeue[i].beam == this) {
+            beamcollidequeue[i].beam = nullptr;
+        }
+    }
+    if (!beamcollideflushing) {
+        beamcollidequeue.erase(std::remove_if(beamcollidequeue.begin(), beamcollidequeue.end(),
+                [](const BeamCollision &q) {
+                    return q.beam == nullptr;
+                }), beamcollidequeue.end());
+    }
 #ifdef PERBOLTSOUND
     AUDDeleteSound( sound );
 #endif
 #ifdef BEAMCOLQ
     RemoveFromSystem( true );
 #endif
-    //DO NOT DELETE - shared vlist
-    //delete vlist;
 }
 
 // Called everytime the beam is fired
@@ -403,8 +421,6 @@ void Beam::Reinitialize() {
 
     impact = ALIVE;
     numframes = 0;
-    const int radslices = configuration().physics.tractor.scoop_rad_slices | 1;    //Must be odd
-    const int longslices = configuration().physics.tractor.scoop_long_slices;
     lastlength = 0;
     curlength = simulation_atom_var * speed;
     lastthick = 0;
@@ -412,17 +428,6 @@ void Beam::Reinitialize() {
     if (curthick > thickness) {      //clamp to max thickness - needed for large simulation atoms
         curthick = thickness;
     }
-    static GFXVertexList *_vlist = 0;
-    if (!_vlist) {
-        int numvertex = float_to_int(std::max(48, ((4 * radslices) + 1) * longslices * 4));
-        GFXColorVertex *beam =
-                new GFXColorVertex[numvertex];         //regretably necessary: radslices and longslices come from the config file... so it's at runtime.
-//        memset( beam, 0, sizeof (*beam)*numvertex );
-        _vlist = new GFXVertexList(GFXQUAD, numvertex, beam, numvertex, true);         //mutable color contained list
-        delete[] beam;
-    }
-    //Shared vlist - we recalculate it every time, so no loss
-    vlist = _vlist;
 #ifdef PERBOLTSOUND
     AUDStartPlaying( sound );
 #endif
@@ -433,6 +438,10 @@ void Beam::Reinitialize() {
  */
 
 bool Beam::Collide(Unit *target, Unit *firer, Unit *superunit) {
+    return Collide(csCollisionContext::ForThisThread(), target, firer, superunit);
+}
+
+bool Beam::Collide(csCollisionContext &context, Unit *target, Unit *firer, Unit *superunit) {
     if (target == NULL) {
         VS_LOG(error, "Recovering from nonfatal beam error when beam inactive\n");
         return false;
@@ -497,7 +506,7 @@ bool Beam::Collide(Unit *target, Unit *firer, Unit *superunit) {
         }
     }
     Unit *colidee;
-    if ((colidee = target->rayCollide(center, end, normal, distance))) {
+    if ((colidee = target->rayCollide(context, center, end, normal, distance))) {
         if (!(scoop && (tractor || repulsor))) {
             this->curlength = distance;
         }
@@ -654,7 +663,7 @@ void Beam::Draw(const Transformation &trans, const Matrix &m, Unit *targ, float
 #endif
     AUDSoundGain(sound, curthick * curthick / (thickness * thickness));
 
-    beamdrawqueue[decal].push_back(BeamDrawContext(cumulative_transformation_matrix, vlist, this));
+    beamdrawqueue[decal].push_back(BeamDrawContext(cumulative_transformation_matrix, this));
 }
 
 QVector Beam::GetPosition() const {
@@ -675,24 +684,32 @@ void Beam::ProcessDrawQueue() {
 
     GFXEnable(TEXTURE0);
     GFXDisable(TEXTURE1);
-    BeamDrawContext c;
+
+    //all beams of a decal go out in one draw, written relative to the camera
+    const QVector camera = _Universe->AccessCamera()->GetPosition();
+    beaminstances.Begin(camera, 0, 1);
+    Matrix at_camera;
+    Identity(at_camera);
+    at_camera.p = camera;
+    GFXLoadMatrixModel(at_camera);
+    static vector<GFXColorVertex> vertices;
+    vertices.resize(beamVertexCount());
     for (unsigned int decal = 0; decal < beamdrawqueue.size(); decal++) {
         Texture *tex = beamdecals.GetTexture(decal);
-        if (tex) {
+        if (tex && !beamdrawqueue[decal].empty()) {
+            beaminstances.BeginBeams();
+            for (const BeamDrawContext &c : beamdrawqueue[decal]) {
+                float length, scroll;
+                const int count = c.beam->RecalculateVertices(c.m, vertices.data(), length, scroll);
+                beaminstances.AddBeam(c.m, length, c.beam->curthick, scroll, c.beam->Col, vertices.data(), count);
+            }
+            const WeaponInstances::Batch batch = beaminstances.EndBeams();
             tex->MakeActive(0);
             GFXTextureEnv(0, GFXMODULATETEXTURE);
             GFXToggleTexture(true, 0);
-            if (beamdrawqueue[decal].size()) {
-                while (beamdrawqueue[decal].size()) {
-                    c = beamdrawqueue[decal].back();
-                    beamdrawqueue[decal].pop_back();
-
-                    c.beam->RecalculateVertices(c.m);
-                    GFXLoadMatrixModel(c.m);
-                    c.vlist->DrawOnce();
-                }
-            }
+            GFXDraw(GFXQUAD, beaminstances.Vertices(batch), static_cast<int>(batch.vertices), 3, 4, 2);
         }
+        beamdrawqueue[decal].clear();
     }
     GFXEnable(DEPTHWRITE);
     GFXEnable(CULLFACE);
@@ -770,7 +787,7 @@ void Beam::UpdatePhysics(const Transformation &trans,
         RemoveFromSystem( false );
 #endif
     } else {
-        CollideHuge(CollideInfo, listen_to_owner ? targetToCollideWith : NULL, firer, superunit);
+        QueueCollision(listen_to_owner ? targetToCollideWith : NULL, firer, superunit);
         if (!(curlength <= range && curlength > 0)) {
             //if curlength just happens to be nan --FIXME THIS MAKES NO SENSE AT ALL --chuck_starchaser
             if (curlength > range) {
@@ -34,6 +34,7 @@
 #include <vector>
 class GFXVertexList;
 class Texture;
+class csCollisionContext;
 struct GFXColor;
 using std::vector;
 
@@ -44,7 +45,6 @@ private:
     int sound;
     Transformation local_transformation;
     unsigned int decal;
-    GFXVertexList *vlist;
     LineCollide CollideInfo;
 
     unsigned int numframes;
@@ -77,8 +77,10 @@ private:
     QVector center; //in world coordinates as of last physics frame...
     Vector direction;
 
-    void RecalculateVertices(const Matrix &trans);
-    void CollideHuge(const LineCollide &, Unit *targetToCollideWith, Unit *firer, Unit *superunit);
+    ///Writes the beam's quads in the space of trans; returns the vertex count, the drawn length and texture scroll
+    int RecalculateVertices(const Matrix &trans, GFXColorVertex *beam, float &length, float &scroll);
+    ///defers this atom's collision checks to ProcessCollideQueue
+    void QueueCollision(Unit *targetToCollideWith, Unit *firer, Unit *superunit);
 public:
     Beam(const Transformation &trans, const WeaponInfo &clne, void *own, Unit *firer, int sound);
     void Init(const Transformation &trans, const WeaponInfo &clne, void *own, Unit *firer);
@@ -87,6 +89,7 @@ public:
     void Reinitialize();
 
     bool Collide(class Unit *target, Unit *firer, Unit *superunit /*for cargo*/ );
+    bool Collide(csCollisionContext &context, class Unit *target, Unit *firer, Unit *superunit /*for cargo*/ );
 
     void Destabilize();
     bool Dissolved();
@@ -97,6 +100,8 @@ public:
     void ListenToOwner(bool listen);
 
     static void ProcessDrawQueue();
+    ///collides every beam queued this atom, with one capsule sweep of the system's collide map
+    static void ProcessCollideQueue(class StarSystem *ss);
 
     bool Ready();
     float refireTime();
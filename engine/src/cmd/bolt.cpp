@@ -45,16 +45,11 @@
 #include "cmd/damageable.h"
 #include "src/vs_logging.h"
 #include "gfx_generic/texture_manager.h"
+#include "gfx_generic/weapon_instances.h"
 
 using std::vector;
 using std::string;
 
-extern double interpolation_blend_factor;
-
-inline void BlendTrans(Matrix &drawmat, const QVector &cur_position, const QVector &prev_position) {
-    drawmat.p = prev_position.Scale(1 - interpolation_blend_factor) + cur_position.Scale(interpolation_blend_factor);
-}
-
 // Bolts have texture
 int Bolt::AddTexture(BoltDrawManager *q, std::string file) {
     size_t decal = q->boltdecals.AddTexture(file.c_str(), MIPMAP);
@@ -94,9 +89,9 @@ int Bolt::AddAnimation(BoltDrawManager *q, std::string file, QVector cur_positio
 
 void Bolt::DrawAllBolts() {
     BoltDrawManager &bolt_draw_manager = BoltDrawManager::GetInstance();
-    GFXVertexList *qmesh = BoltDrawManager::boltmesh;
+    WeaponInstances &instances = BoltDrawManager::instances;
 
-    if (!qmesh || bolt_draw_manager.bolts.empty()) {
+    if (bolt_draw_manager.bolts.empty()) {
         return;
     }
 
@@ -113,17 +108,15 @@ void Bolt::DrawAllBolts() {
         GFXBlendMode(bsrc = ONE, bdst = ZERO);
     }
 
-    qmesh->LoadDrawState();
-    qmesh->BeginDrawState();
-    int decal = 0;
+    const double stretch = configuration().graphics.stretch_bolts_dbl;
 
-    // Iterate over specific types of bolts (with same texture)
+    // Iterate over specific types of bolts (with same texture), one draw each
     for (auto &&bolt_types : bolt_draw_manager.bolts) {
         if (bolt_types.empty()) {
             continue;
         }
 
-        Bolt bolt = bolt_types[0];
+        const Bolt &bolt = bolt_types[0];
 
         Texture *texture = TextureManager::GetInstance().GetTexture(bolt.bolt_name, MIPMAP);
         if (!texture) {
@@ -131,83 +124,76 @@ void Bolt::DrawAllBolts() {
             continue;
         }
 
+        instances.BeginBatch();
+        const WeaponInfo *style = nullptr;
+        for (auto &&each_bolt : bolt_types) {
+            if (each_bolt.type != style) {
+                style = each_bolt.type;
+                const float length = (stretch > 0)
+                        ? static_cast<float>(static_cast<double>(style->speed) * BoltDrawManager::elapsed_time * stretch)
+                        : style->length;
+                instances.SetStyle(style->radius, length, GFXColor(style->r, style->g, style->b, style->a), 0,
+                        each_bolt.bolt_size);
+            }
+            instances.AddBolt(each_bolt.prev_position, each_bolt.cur_position,
+                    each_bolt.drawmat.getR(), each_bolt.drawmat.getQ());
+        }
+        WeaponInstances::Batch batch = instances.EndBatch();
+        if (batch.instances == 0) {
+            continue;
+        }
+        instances.Expand(batch, BoltDrawManager::boltvertices, 12);
+
         for (size_t pass = 0, npasses = texture->numPasses(); pass < npasses; ++pass) {
             GFXTextureEnv(0, GFXMODULATETEXTURE);
             if (texture->SetupPass(0, bsrc, bdst)) {
                 texture->MakeActive();
                 GFXToggleTexture(true, 0);
-                for (auto &&each_bolt : bolt_types) {
-                    each_bolt.DrawBolt(qmesh);
-                }
+                GFXDraw(GFXQUAD, instances.Vertices(batch), static_cast<int>(batch.vertices), 3, 4, 2);
             }
         }
-        decal++;
     }
-
-    qmesh->EndDrawState();
 }
 
 void Bolt::DrawAllBalls() {
     BoltDrawManager &bolt_draw_manager = BoltDrawManager::GetInstance();
-    vector<Animation *>::iterator k = bolt_draw_manager.animations.begin();
+    WeaponInstances &instances = BoltDrawManager::instances;
+
+    //balls face the camera
+    Vector p, q, r;
+    _Universe->AccessCamera()->GetOrientation(p, q, r);
 
-    for (auto &&ball_types : bolt_draw_manager.balls) {
-        if (ball_types.size() == 0) {
+    for (size_t decal = 0; decal < bolt_draw_manager.balls.size(); ++decal) {
+        const vector<Bolt> &ball_types = bolt_draw_manager.balls[decal];
+        if (ball_types.empty()) {
             continue;
         }
 
-        Animation *cur = *k;
-
-        float bolt_size = 2 * ball_types[0].type->radius * 2;
-        bolt_size *= bolt_size;
-        //Matrix result;
-        //FIXME::MuST USE DRAWNO	TRANSFORMNOW cur->CalculateOrientation (result);
-
-        // Iterate over specific balls
-        for (auto &&bolt : ball_types) { // really ball
-            bolt.DrawBall(bolt_size, cur);
+        instances.BeginBatch();
+        const WeaponInfo *style = nullptr;
+        for (auto &&ball : ball_types) {
+            if (ball.type != style) {
+                style = ball.type;
+                instances.SetStyle(style->radius, style->radius, GFXColor(style->r, style->g, style->b, style->a), 0,
+                        ball.ball_size);
+            }
+            instances.AddBolt(ball.prev_position, ball.cur_position, r, q);
+        }
+        WeaponInstances::Batch batch = instances.EndBatch();
+        if (batch.instances == 0) {
+            continue;
         }
-    }
-}
-
-void Bolt::DrawBolt(GFXVertexList *qmesh) {
-    float distance = (cur_position - BoltDrawManager::camera_position).MagnitudeSquared();
-
-    if (distance * BoltDrawManager::pixel_angle >= bolt_size) {
-        return;
-    }
-
-    const WeaponInfo *wt = type;
-
-    BlendTrans(drawmat, cur_position, prev_position);
-    Matrix drawmat(this->drawmat);
-    if (configuration().graphics.stretch_bolts_flt > 0) {
-        ScaleMatrix(drawmat,
-                    Vector(1,
-                           1,
-                           static_cast<double>(type->speed) * BoltDrawManager::elapsed_time * configuration().graphics.
-                           stretch_bolts_dbl / type->length));
-    }
-    GFXLoadMatrixModel(drawmat);
-    GFXColor4f(wt->r, wt->g, wt->b, wt->a);
-    qmesh->Draw();
-}
-
-void Bolt::DrawBall(float &bolt_size, Animation *cur) {
-    // TODO: move up to DrawBalls
-    Vector p, q, r;
-    _Universe->AccessCamera()->GetOrientation(p, q, r);
 
-    //don't update time more than once
-    float distance = (cur_position - BoltDrawManager::camera_position).MagnitudeSquared();
-    if (distance * BoltDrawManager::pixel_angle < bolt_size) {
-        BlendTrans(drawmat, cur_position, prev_position);
-        Matrix tmp;
-        VectorAndPositionToMatrix(tmp, p, q, r, drawmat.p);
-        cur->SetDimensions(type->radius, type->radius);
-        GFXLoadMatrixModel(tmp);
-        GFXColor4f(type->r, type->g, type->b, type->a);
-        cur->DrawNoTransform(false, true);
+        Animation *cur = bolt_draw_manager.animations[decal];
+        const float ms = cur->mintcoord.i, Ms = cur->maxtcoord.i;
+        const float mt = cur->mintcoord.j, Mt = cur->maxtcoord.j;
+        GFXVertex quad[4];
+        quad[0].SetVertex(Vector(-1, -1, 0)).SetTexCoord(ms, Mt);
+        quad[1].SetVertex(Vector(1, -1, 0)).SetTexCoord(Ms, Mt);
+        quad[2].SetVertex(Vector(1, 1, 0)).SetTexCoord(Ms, mt);
+        quad[3].SetVertex(Vector(-1, 1, 0)).SetTexCoord(ms, mt);
+        instances.Expand(batch, quad, 4, cur->TextureSets());
+        cur->DrawVertices(instances.Vertices(batch), static_cast<int>(batch.vertices), true);
     }
 }
 
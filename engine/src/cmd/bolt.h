@@ -84,10 +84,9 @@ public:
             CollideMap::iterator hint);//makes a bolt
     void Destroy(unsigned int index);
     //static void Draw();
+    ///Draws each type of bolt, and each type of ball, in one go
     static void DrawAllBolts();
     static void DrawAllBalls();
-    void DrawBolt(GFXVertexList *qmesh);
-    void DrawBall(float &bolt_size, Animation *cur);
     bool Update(Collidable::CollideRef index);
     bool Collide(Collidable::CollideRef index);
     static void UpdatePhysics(StarSystem *ss);//updates all physics in the starsystem
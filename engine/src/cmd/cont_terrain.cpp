@@ -381,11 +381,14 @@ void ContinuousTerrain::Collide(Unit *un, Matrix t) {
             if (md[i].collider) {
                 if (un->colTrees) {
                     if (un->colTrees->colTree(un, Vector(0, 0, 0))) {
-                        if (un->colTrees->colTree(un, Vector(0, 0, 0))->Collide(*md[i].collider,
+                        csCollisionContext &context = csCollisionContext::ForThisThread();
+                        context.ResetCollisionPairs();
+                        if (un->colTrees->colTree(un, Vector(0, 0, 0))->Collide(context,
+                                *md[i].collider,
                                 &smalltransform,
                                 &bigtransform)) {
-                            csCollisionPair *mycollide = csOPCODECollider::GetCollisions();
-                            unsigned int numHits = csOPCODECollider::GetCollisionPairCount();
+                            csCollisionPair *mycollide = context.GetCollisions();
+                            unsigned int numHits = context.GetCollisionPairCount();
                             if (numHits) {
                                 smallpos.Set((mycollide[0].a1.x + mycollide[0].b1.x + mycollide[0].c1.x) / 3,
                                         (mycollide[0].a1.y + mycollide[0].b1.y + mycollide[0].c1.y) / 3,
@@ -62,22 +62,27 @@
 #include "msgcenter.h"
 #include "cmd/briefing.h"
 #include "pythonmission.h"
+#include "mission_scheduler.h"
 #include "flightgroup.h"
 #include "gldrv/winsys.h"
 #include "src/vs_logging.h"
 
 /* *********************************************************** */
 //ADD_FROM_PYTHON_FUNCTION(pythonMission)
-void Mission::DirectorLoop() {
+void Mission::DirectorSkip() {
     double oldgametime = gametime;
     gametime += SIMULATION_ATOM;     //elapsed;
-    //VS_LOG(trace, (boost::format("void Mission::DirectorLoop(): oldgametime = %1$.6f; SIMULATION_ATOM = %2$.6f; gametime = %3$.6f") % oldgametime % SIMULATION_ATOM % gametime));
+    //VS_LOG(trace, (boost::format("void Mission::DirectorSkip(): oldgametime = %1$.6f; SIMULATION_ATOM = %2$.6f; gametime = %3$.6f") % oldgametime % SIMULATION_ATOM % gametime));
     if (getTimeCompression() >= .1) {
         if (gametime <= oldgametime) {
-            VS_LOG(warning, "void Mission::DirectorLoop(): gametime is before oldgametime!");
+            VS_LOG(warning, "void Mission::DirectorSkip(): gametime is before oldgametime!");
             gametime = SIMULATION_ATOM;
         }
     }
+}
+
+void Mission::DirectorLoop() {
+    DirectorSkip();
     try {
         BriefingLoop();
         if (runtime.pymissions) {
@@ -173,6 +178,7 @@ void Mission::BriefingStart() {
         BriefingEnd();
     }
     briefing = new Briefing();
+    MissionScheduler::getSingleton()->briefingStarted(this);
     if (runtime.pymissions) {
         runtime.pymissions->callFunction("initbriefing");
     }
@@ -218,6 +224,7 @@ void Mission::BriefingEnd() {
         }
         delete briefing;
         briefing = NULL;
+        MissionScheduler::getSingleton()->briefingEnded(this);
     }
 }
 
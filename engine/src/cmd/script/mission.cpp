@@ -48,6 +48,7 @@
 #include "cmd/unit_generic.h"
 #include "mission.h"
 #include "flightgroup.h"
+#include "mission_scheduler.h"
 
 #include "src/python/python_class.h"
 #include "vegadisk/savegame.h"
@@ -253,6 +254,8 @@ void Mission::terminateMission() {
         VS_LOG(info, (boost::format("Not deleting mission twice: %1%") % this->mission_name));
     }
 
+    MissionScheduler::getSingleton()->forget(this);
+
     f = std::find(active_missions->begin(), active_missions->end(), this);
 
     // Debugging aid for persistent missions bug
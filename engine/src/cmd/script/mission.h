@@ -482,6 +482,8 @@ public:
     void GetOrigin(QVector &pos, string &planetname);
 
     void DirectorLoop();
+///advances mission time for an atom in which the scheduler did not run the director
+    void DirectorSkip();
     void DirectorStart(missionNode *node);
     void DirectorStartStarSystem(StarSystem *ss);
     void DirectorInitgame();
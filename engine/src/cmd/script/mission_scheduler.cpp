@@ -0,0 +1,162 @@
+/*
+ * mission_scheduler.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+
+#include "mission_scheduler.h"
+#include "src/vs_logging.h"
+
+template<> MissionScheduler *Singleton<MissionScheduler>::_singletonInstance = 0;
+
+const double MissionScheduler::EVERY_ATOM = 0.0;
+const double MissionScheduler::EVENTS_ONLY = -1.0;
+
+MissionScheduler::Entry &MissionScheduler::entry(const Mission *mis) {
+    return entries[mis];
+}
+
+void MissionScheduler::setTickInterval(const Mission *mis, double seconds) {
+    Entry &e = entry(mis);
+    e.tick_interval = seconds < 0.0 ? EVENTS_ONLY : seconds;
+    //let the new interval take effect from the next atom
+    e.next_tick = 0.0;
+}
+
+double MissionScheduler::getTickInterval(const Mission *mis) const {
+    vsUMap<const Mission *, Entry>::const_iterator i = entries.find(mis);
+    return i == entries.end() ? EVERY_ATOM : i->second.tick_interval;
+}
+
+void MissionScheduler::wakeAt(const Mission *mis, double game_time) {
+    Entry &e = entry(mis);
+    if (e.wake_time < 0.0 || game_time < e.wake_time) {
+        e.wake_time = game_time;
+    }
+}
+
+void MissionScheduler::wakeOn(const Mission *mis, unsigned int conditions) {
+    entry(mis).conditions |= conditions;
+}
+
+void MissionScheduler::clearWakeConditions(const Mission *mis) {
+    Entry &e = entry(mis);
+    e.conditions = 0;
+    e.wake_time = -1.0;
+}
+
+void MissionScheduler::notify(WakeCondition condition) {
+    for (auto &i : entries) {
+        if (i.second.conditions & condition) {
+            i.second.pending = true;
+        }
+    }
+}
+
+bool MissionScheduler::shouldRun(const Mission *mis, double game_time) {
+    vsUMap<const Mission *, Entry>::iterator i = entries.find(mis);
+    if (i == entries.end()) {
+        return true;
+    }
+    Entry &e = i->second;
+    bool due = false;
+    if (e.pending) {
+        e.pending = false;
+        due = true;
+    }
+    if (e.wake_time >= 0.0 && game_time >= e.wake_time) {
+        e.wake_time = -1.0;
+        due = true;
+    }
+    if (e.tick_interval == EVERY_ATOM) {
+        due = true;
+    } else if (e.tick_interval > 0.0 && game_time >= e.next_tick) {
+        e.next_tick = game_time + e.tick_interval;
+        due = true;
+    }
+    return due;
+}
+
+void MissionScheduler::recordRun(const Mission *mis, const std::string &name, double seconds) {
+    Entry &e = entry(mis);
+    if (e.name != name) {
+        e.name = name;
+    }
+    Accounting &acct = e.accounting;
+    ++acct.runs;
+    acct.total_seconds += seconds;
+    acct.last_seconds = seconds;
+    acct.peak_seconds = std::max(acct.peak_seconds, seconds);
+}
+
+void MissionScheduler::recordSkip(const Mission *mis) {
+    ++entry(mis).accounting.skips;
+}
+
+MissionScheduler::Accounting MissionScheduler::getAccounting(const Mission *mis) const {
+    vsUMap<const Mission *, Entry>::const_iterator i = entries.find(mis);
+    return i == entries.end() ? Accounting() : i->second.accounting;
+}
+
+void MissionScheduler::logAccounting() const {
+    for (const auto &i : entries) {
+        const Accounting &acct = i.second.accounting;
+        VS_LOG(info, (boost::format("Mission %1%: %2% runs, %3% skipped, %4$.6f s total, %5$.6f s peak")
+                % i.second.name % acct.runs % acct.skips % acct.total_seconds % acct.peak_seconds));
+    }
+}
+
+void MissionScheduler::forget(const Mission *mis) {
+    vsUMap<const Mission *, Entry>::iterator i = entries.find(mis);
+    if (i != entries.end()) {
+        const Accounting &acct = i->second.accounting;
+        VS_LOG(debug, (boost::format("Mission %1% done: %2% runs, %3% skipped, %4$.6f s total")
+                % i->second.name % acct.runs % acct.skips % acct.total_seconds));
+        entries.erase(i);
+    }
+    briefings.erase(std::remove(briefings.begin(), briefings.end(), mis), briefings.end());
+}
+
+void MissionScheduler::briefingStarted(Mission *mis) {
+    if (std::find(briefings.begin(), briefings.end(), mis) == briefings.end()) {
+        briefings.push_back(mis);
+    }
+}
+
+void MissionScheduler::briefingEnded(Mission *mis) {
+    briefings.erase(std::remove(briefings.begin(), briefings.end(), mis), briefings.end());
+}
+
+unsigned int MissionScheduler::parseWakeCondition(const std::string &name) {
+    if (name == "death" || name == "unit_death") {
+        return WAKE_ON_UNIT_DEATH;
+    } else if (name == "system" || name == "system_entry") {
+        return WAKE_ON_SYSTEM_ENTRY;
+    } else if (name == "dock" || name == "docking") {
+        return WAKE_ON_DOCKING;
+    }
+    VS_LOG(warning, (boost::format("Unknown mission wake condition '%1%'") % name));
+    return 0;
+}
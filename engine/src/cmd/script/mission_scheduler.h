@@ -0,0 +1,121 @@
+/*
+ * mission_scheduler.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_SCRIPT_MISSION_SCHEDULER_H
+#define VEGA_STRIKE_ENGINE_CMD_SCRIPT_MISSION_SCHEDULER_H
+
+#include <string>
+#include <vector>
+
+#include "src/gnuhash.h"
+#include "src/Singleton.h"
+
+class Mission;
+
+/**
+ * Decides which missions get their director script run on a given sim atom.
+ *
+ * By default every mission runs every atom, exactly as before. A mission may
+ * instead declare a tick interval (in game seconds), or go fully event driven
+ * and only be woken by a timer or by one of the wake conditions below.
+ * Missions that are skipped still have their game time advanced.
+ *
+ * The scheduler also keeps the list of missions with a briefing in progress,
+ * so the per-atom briefing update no longer has to visit every mission, and
+ * it accounts the real time spent in each mission's director script. It
+ * never looks inside a Mission, only keys on its address.
+ */
+class MissionScheduler : public Singleton<MissionScheduler> {
+public:
+    enum WakeCondition {
+        WAKE_ON_UNIT_DEATH = 1,
+        WAKE_ON_SYSTEM_ENTRY = 2,
+        WAKE_ON_DOCKING = 4,
+    };
+
+    /// tick interval meaning "run on every sim atom" (the default)
+    static const double EVERY_ATOM;
+    /// tick interval meaning "only run when a timer or wake condition fires"
+    static const double EVENTS_ONLY;
+
+    struct Accounting {
+        unsigned long runs = 0;
+        unsigned long skips = 0;
+        double total_seconds = 0.0;
+        double last_seconds = 0.0;
+        double peak_seconds = 0.0;
+    };
+
+    void setTickInterval(const Mission *mis, double seconds);
+    double getTickInterval(const Mission *mis) const;
+    /// run the mission once when game time reaches game_time
+    void wakeAt(const Mission *mis, double game_time);
+    /// adds to the set of WakeCondition bits the mission listens to
+    void wakeOn(const Mission *mis, unsigned int conditions);
+    void clearWakeConditions(const Mission *mis);
+
+    /// flags every mission listening to this condition to run next atom
+    void notify(WakeCondition condition);
+
+    /// consumes any pending wake up; true if the director should run now
+    bool shouldRun(const Mission *mis, double game_time);
+    /// name is the mission's, for the accounting log
+    void recordRun(const Mission *mis, const std::string &name, double seconds);
+    void recordSkip(const Mission *mis);
+
+    Accounting getAccounting(const Mission *mis) const;
+    void logAccounting() const;
+    /// drops all scheduling state for a mission being terminated
+    void forget(const Mission *mis);
+
+    void briefingStarted(Mission *mis);
+    void briefingEnded(Mission *mis);
+
+    /// the missions with a briefing in progress, the only ones BriefingUpdate has to run on
+    const std::vector<Mission *> &briefingsInProgress() const {
+        return briefings;
+    }
+
+    static unsigned int parseWakeCondition(const std::string &name);
+
+private:
+    struct Entry {
+        std::string name;
+        double tick_interval = EVERY_ATOM;
+        double next_tick = 0.0;
+        double wake_time = -1.0;
+        unsigned int conditions = 0;
+        bool pending = false;
+        Accounting accounting;
+    };
+
+    Entry &entry(const Mission *mis);
+
+    vsUMap<const Mission *, Entry> entries;
+    std::vector<Mission *> briefings;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_SCRIPT_MISSION_SCHEDULER_H
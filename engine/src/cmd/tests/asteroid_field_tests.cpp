@@ -0,0 +1,176 @@
+/*
+ * asteroid_field_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "cmd/asteroid_field.h"
+#include "gfx_generic/matrix.h"
+
+static std::vector<uint32_t> BruteForce(const AsteroidField &field, const QVector &center, float radius) {
+    std::vector<uint32_t> hits;
+    for (size_t i = 0; i < field.size(); ++i) {
+        const double reach = radius + field.Radius(i);
+        if (!field.Promoted(i) && (field.Position(i) - center).MagnitudeSquared() <= reach * reach) {
+            hits.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return hits;
+}
+
+static std::vector<uint32_t> Query(const AsteroidField &field, const QVector &center, float radius) {
+    std::vector<uint32_t> hits;
+    field.QuerySphere(center, radius, hits);
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+TEST(AsteroidField, QuerySphereFindsTouchingRocks) {
+    AsteroidField field;
+    field.Add(0, QVector(0, 0, 0), identity_quaternion, 10.0F);
+    field.Add(0, QVector(100, 0, 0), identity_quaternion, 10.0F);
+    field.Add(1, QVector(-250, 40, 0), identity_quaternion, 50.0F);
+    field.Build();
+
+    //reaches the first rock's surface, not the second's
+    EXPECT_EQ(Query(field, QVector(30, 0, 0), 20.0F), std::vector<uint32_t>({0}));
+    EXPECT_EQ(Query(field, QVector(50, 0, 0), 40.0F), std::vector<uint32_t>({0, 1}));
+    //the big rock is found from a neighbouring cell
+    EXPECT_EQ(Query(field, QVector(-190, 40, 0), 15.0F), std::vector<uint32_t>({2}));
+    EXPECT_TRUE(Query(field, QVector(0, 500, 0), 100.0F).empty());
+}
+
+TEST(AsteroidField, QuerySphereSkipsPromotedRocks) {
+    AsteroidField field;
+    field.Add(0, QVector(0, 0, 0), identity_quaternion, 5.0F);
+    field.Add(0, QVector(8, 0, 0), identity_quaternion, 5.0F);
+    field.Build();
+    field.MarkPromoted(0);
+    field.MarkPromoted(0);
+    EXPECT_EQ(field.promoted_count(), 1U);
+    EXPECT_EQ(Query(field, QVector(0, 0, 0), 4.0F), std::vector<uint32_t>({1}));
+}
+
+TEST(AsteroidField, QuerySphereMatchesBruteForce) {
+    std::mt19937 random(30);
+    std::uniform_real_distribution<double> coordinate(-5000.0, 5000.0);
+    std::uniform_real_distribution<float> size(1.0F, 120.0F);
+    AsteroidField field;
+    for (int i = 0; i < 2000; ++i) {
+        field.Add(static_cast<uint16_t>(i % 3), QVector(coordinate(random), coordinate(random), coordinate(random)),
+                identity_quaternion, size(random));
+    }
+    field.Build();
+    for (size_t i = 0; i < field.size(); i += 7) {
+        field.MarkPromoted(i);
+    }
+    //small queries walk the grid, huge ones every occupied cell
+    for (float radius : {10.0F, 300.0F, 20000.0F}) {
+        for (int q = 0; q < 50; ++q) {
+            const QVector center(coordinate(random), coordinate(random), coordinate(random));
+            EXPECT_EQ(Query(field, center, radius), BruteForce(field, center, radius));
+        }
+    }
+}
+
+TEST(AsteroidField, RocksSpinAroundTheirOwnCenter) {
+    AsteroidField field;
+    field.Add(0, QVector(10, 20, 30), identity_quaternion, 5.0F);
+    field.SetSpin(0, Vector(0, 0, 1));
+    field.Advance(M_PI / 2);
+    const Transformation t = field.RockTransformation(0);
+    EXPECT_DOUBLE_EQ(t.position.i, 10.0);
+    EXPECT_DOUBLE_EQ(t.position.j, 20.0);
+    EXPECT_DOUBLE_EQ(t.position.k, 30.0);
+    Matrix m;
+    t.to_matrix(m);
+    //a quarter turn about z takes the x axis onto the y axis
+    const Vector x = m.getP();
+    EXPECT_NEAR(x.i, 0.0, 1e-5);
+    EXPECT_NEAR(std::fabs(x.j), 1.0, 1e-5);
+    EXPECT_NEAR(x.k, 0.0, 1e-5);
+}
+
+TEST(AsteroidField, RockTransformationOffsetLooksBack) {
+    AsteroidField field;
+    field.Add(0, QVector(0, 0, 0), identity_quaternion, 5.0F);
+    field.SetSpin(0, Vector(0, 0, 1));
+    field.Advance(M_PI);
+    //half a turn back from a half turn is where the rock started
+    Matrix m;
+    field.RockTransformation(0, -M_PI).to_matrix(m);
+    const Vector x = m.getP();
+    EXPECT_NEAR(x.i, 1.0, 1e-5);
+    EXPECT_NEAR(x.j, 0.0, 1e-5);
+    EXPECT_NEAR(x.k, 0.0, 1e-5);
+}
+
+TEST(AsteroidField, QuerySegmentFindsFirstRockEntered) {
+    AsteroidField field;
+    field.Add(0, QVector(100, 0, 0), identity_quaternion, 10.0F);
+    field.Add(0, QVector(50, 3, 0), identity_quaternion, 10.0F);
+    field.Add(0, QVector(200, 0, 0), identity_quaternion, 10.0F);
+    field.Add(0, QVector(60, 40, 0), identity_quaternion, 10.0F);
+    field.Build();
+    EXPECT_EQ(field.QuerySegment(QVector(0, 0, 0), QVector(300, 0, 0)), 1);
+    //fired the other way the far rock comes first
+    EXPECT_EQ(field.QuerySegment(QVector(300, 0, 0), QVector(0, 0, 0)), 2);
+    //a bolt that stops short of every rock
+    EXPECT_EQ(field.QuerySegment(QVector(0, 0, 0), QVector(30, 0, 0)), -1);
+    EXPECT_EQ(field.QuerySegment(QVector(0, 20, 0), QVector(300, 20, 0)), -1);
+}
+
+TEST(AsteroidField, QuerySegmentSkipsPromotedRocks) {
+    AsteroidField field;
+    field.Add(0, QVector(50, 0, 0), identity_quaternion, 10.0F);
+    field.Add(0, QVector(100, 0, 0), identity_quaternion, 10.0F);
+    field.Build();
+    field.MarkPromoted(0);
+    EXPECT_EQ(field.QuerySegment(QVector(0, 0, 0), QVector(300, 0, 0)), 1);
+    field.MarkPromoted(1);
+    EXPECT_EQ(field.QuerySegment(QVector(0, 0, 0), QVector(300, 0, 0)), -1);
+}
+
+TEST(AsteroidField, ExtentCoversEveryRock) {
+    AsteroidField field;
+    Vector lo, hi;
+    field.Extent(lo, hi);
+    EXPECT_EQ(lo.i, 0.0F);
+    EXPECT_EQ(hi.i, 0.0F);
+    field.Add(0, QVector(-100, 5, 0), identity_quaternion, 10.0F);
+    field.Add(0, QVector(40, 60, -20), identity_quaternion, 30.0F);
+    field.Extent(lo, hi);
+    EXPECT_FLOAT_EQ(lo.i, -110.0F);
+    EXPECT_FLOAT_EQ(lo.j, -5.0F);
+    EXPECT_FLOAT_EQ(lo.k, -50.0F);
+    EXPECT_FLOAT_EQ(hi.i, 70.0F);
+    EXPECT_FLOAT_EQ(hi.j, 90.0F);
+    EXPECT_FLOAT_EQ(hi.k, 10.0F);
+}
@@ -0,0 +1,269 @@
+/*
+ * collide_map_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "cmd/collide_map.h"
+#include "cmd/unit_generic.h"
+
+namespace {
+
+Unit *Id(size_t i) {
+    return reinterpret_cast<Unit *>((i + 1) * 16);
+}
+
+//a map holding one unit sphere per entry, as a flatten would leave it
+void Fill(CollideMap &map, const std::vector<std::pair<QVector, float> > &spheres) {
+    map.sorted.clear();
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        Collidable c;
+        c.position = spheres[i].first;
+        c.radius = spheres[i].second;
+        c.ref.unit = Id(i);
+        map.sorted.push_back(c);
+    }
+    std::sort(map.sorted.begin(), map.sorted.end());
+}
+
+std::vector<Unit *> HitsOf(const std::vector<std::pair<size_t, Unit *> > &hits, size_t capsule) {
+    std::vector<Unit *> retval;
+    for (const auto &hit : hits) {
+        if (hit.first == capsule) {
+            retval.push_back(hit.second);
+        }
+    }
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+} // namespace
+
+TEST(CollideMap, CapsuleTouchesSphere) {
+    CollideCapsule beam{QVector(0, 0, 0), QVector(100, 0, 0), 1};
+    EXPECT_TRUE(CollideMap::CapsuleTouchesSphere(beam, QVector(50, 5, 0), 4.5f));
+    EXPECT_FALSE(CollideMap::CapsuleTouchesSphere(beam, QVector(50, 6, 0), 4.5f));
+    //past the end of the segment the capsule is round
+    EXPECT_TRUE(CollideMap::CapsuleTouchesSphere(beam, QVector(104, 0, 0), 3.5f));
+    EXPECT_FALSE(CollideMap::CapsuleTouchesSphere(beam, QVector(104, 3, 0), 3.5f));
+    CollideCapsule sphere{QVector(0, 0, 0), QVector(0, 0, 0), 10};
+    EXPECT_TRUE(CollideMap::CapsuleTouchesSphere(sphere, QVector(0, 12, 0), 2.5f));
+}
+
+TEST(CollideMap, QueryCapsulesFindsSpheresAlongTheBeam) {
+    CollideMap map(Unit::UNIT_ONLY);
+    Fill(map, {
+            {QVector(50, 3, 0), 5},         //0: on the beam
+            {QVector(50, 30, 0), 5},        //1: beside it
+            {QVector(-40, 0, 0), 5},        //2: behind the beam
+            {QVector(5000, 0, 0), 4990},    //3: a planet reaching back to the beam
+            {QVector(60, 0, 0), 0},         //4: a dead slot
+    });
+    std::vector<CollideCapsule> capsules = {
+            {QVector(0, 0, 0), QVector(100, 0, 0), 1},
+            {QVector(-40, 100, 0), QVector(-40, 5, 0), 1},
+    };
+    std::vector<std::pair<size_t, Unit *> > hits;
+    map.QueryCapsules(capsules, hits);
+    EXPECT_EQ(std::vector<Unit *>({Id(0), Id(3)}), HitsOf(hits, 0));
+    EXPECT_EQ(std::vector<Unit *>({Id(2)}), HitsOf(hits, 1));
+    EXPECT_TRUE(std::is_sorted(hits.begin(), hits.end(),
+            [](const std::pair<size_t, Unit *> &a, const std::pair<size_t, Unit *> &b) {
+                return a.first < b.first;
+            }));
+}
+
+TEST(CollideMap, QueryCapsulesMatchesBruteForce) {
+    std::srand(99);
+    auto coord = [](double range) {
+        return (std::rand() / static_cast<double>(RAND_MAX) - 0.5) * range;
+    };
+    std::vector<std::pair<QVector, float> > spheres;
+    for (int i = 0; i < 3000; ++i) {
+        float radius = (i % 100 == 0) ? 2000.0f : static_cast<float>(5 + std::abs(coord(100)));
+        spheres.push_back(std::make_pair(QVector(coord(40000), coord(4000), coord(4000)), radius));
+    }
+    CollideMap map(Unit::UNIT_ONLY);
+    Fill(map, spheres);
+    std::vector<CollideCapsule> capsules;
+    for (int i = 0; i < 200; ++i) {
+        QVector start(coord(40000), coord(4000), coord(4000));
+        QVector dir(coord(2), coord(2), coord(2));
+        capsules.push_back(CollideCapsule{start, start + dir * 1000.0, static_cast<float>(std::abs(coord(20)))});
+    }
+    std::vector<std::pair<size_t, Unit *> > hits;
+    map.QueryCapsules(capsules, hits);
+    for (size_t c = 0; c < capsules.size(); ++c) {
+        std::vector<Unit *> expected;
+        for (const Collidable &s : map.sorted) {
+            if (CollideMap::CapsuleTouchesSphere(capsules[c], s.position, s.radius)) {
+                expected.push_back(s.ref.unit);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(expected, HitsOf(hits, c)) << "capsule " << c;
+    }
+}
+
+namespace {
+
+Collidable At(double x, float radius) {
+    Collidable c;
+    c.position = QVector(x, 0, 0);
+    c.radius = radius;
+    return c;
+}
+
+bool KeysSorted(const CollideArray::ResizableArray &items) {
+    return std::is_sorted(items.begin(), items.end());
+}
+
+} // namespace
+
+TEST(CollideMap, FlattenSortPicksStrategyByChurn) {
+    CollideArray::ResizableArray kept, added, out;
+    CollideArray::FlattenStats stats;
+    for (int i = 0; i < 1000; ++i) {
+        kept.push_back(At(i * 10.0 - 5000.0, 1));
+    }
+    CollideArray::FlattenSort(kept, added, out, stats);
+    EXPECT_EQ(CollideArray::FLATTEN_SORTED, stats.strategy);
+    EXPECT_EQ(1000U, out.size());
+
+    //a few neighbours swap places
+    kept = out;
+    for (int i = 0; i < 1000; i += 100) {
+        kept[i].position.i += 15.0;
+    }
+    CollideArray::FlattenSort(kept, added, out, stats);
+    EXPECT_EQ(CollideArray::FLATTEN_INSERTION, stats.strategy);
+    EXPECT_EQ(10U, stats.descents);
+    EXPECT_TRUE(KeysSorted(out));
+
+    //everything moved, across zero too
+    kept = out;
+    std::srand(7);
+    for (Collidable &c : kept) {
+        c.position.i = (std::rand() / static_cast<double>(RAND_MAX) - 0.5) * 1e7;
+    }
+    for (int i = 0; i < 50; ++i) {
+        added.push_back(At((std::rand() / static_cast<double>(RAND_MAX) - 0.5) * 1e7, -1));
+    }
+    CollideArray::FlattenSort(kept, added, out, stats);
+    EXPECT_EQ(CollideArray::FLATTEN_RADIX, stats.strategy);
+    EXPECT_EQ(50U, stats.added);
+    EXPECT_EQ(1050U, out.size());
+    EXPECT_TRUE(KeysSorted(out));
+    EXPECT_EQ(1UL, stats.uses[CollideArray::FLATTEN_RADIX]);
+}
+
+namespace {
+
+//not a pass/fail timing: prints how long the flatten sorts took against a plain std::sort
+void FlattenBenchmark(double extent) {
+    const int units = 10000;
+    const int bolts = 20000;
+    const int atoms = 30;
+    const double atom = 0.06;
+    std::srand(2024);
+    auto uniform = [](double lo, double hi) {
+        return lo + (hi - lo) * (std::rand() / static_cast<double>(RAND_MAX));
+    };
+    CollideArray::ResizableArray kept, added, out;
+    std::vector<double> velocity;
+    //each item carries the index of its velocity in ref
+    auto spawn = [&](CollideArray::ResizableArray &into, float radius, double speed) {
+        into.push_back(At(uniform(-extent, extent), radius));
+        into.back().ref.bolt_index = static_cast<unsigned int>(velocity.size());
+        velocity.push_back(uniform(-speed, speed));
+    };
+    for (int i = 0; i < units; ++i) {
+        spawn(kept, 50, 300);
+    }
+    for (int i = 0; i < bolts; ++i) {
+        spawn(kept, -1, 3000);
+    }
+    std::sort(kept.begin(), kept.end());
+    CollideArray::FlattenStats stats;
+    double adaptive = 0.0;
+    double reference = 0.0;
+    for (int a = 0; a < atoms; ++a) {
+        for (Collidable &c : kept) {
+            c.position.i += velocity[c.ref.bolt_index] * atom;
+        }
+        added.clear();
+        for (int i = 0; i < bolts / 50; ++i) {
+            spawn(added, -1, 3000);
+        }
+        CollideArray::ResizableArray copy(kept);
+        copy.insert(copy.end(), added.begin(), added.end());
+        auto t0 = std::chrono::steady_clock::now();
+        std::sort(copy.begin(), copy.end());
+        auto t1 = std::chrono::steady_clock::now();
+        CollideArray::FlattenSort(kept, added, out, stats);
+        auto t2 = std::chrono::steady_clock::now();
+        reference += std::chrono::duration<double>(t1 - t0).count();
+        adaptive += std::chrono::duration<double>(t2 - t1).count();
+        ASSERT_TRUE(KeysSorted(out));
+        ASSERT_EQ(copy.size(), out.size());
+        //as many bolts expire as were fired; they are marked, then removed in one pass that keeps the order
+        const float expired_radius = -2.0F;
+        for (int expired = 0; expired < bolts / 50;) {
+            Collidable &c = out[std::rand() % out.size()];
+            if (c.radius == -1.0F) {
+                c.radius = expired_radius;
+                ++expired;
+            }
+        }
+        out.erase(std::remove_if(out.begin(), out.end(), [expired_radius](const Collidable &c) {
+            return c.radius == expired_radius;
+        }), out.end());
+        kept.swap(out);
+    }
+    std::cout << "flatten of " << units << " units + " << bolts << " bolts in " << 2 * extent / 1000.0 << " km over "
+            << atoms << " atoms: "
+            << adaptive * 1000.0 << " ms adaptive (" << stats.uses[CollideArray::FLATTEN_SORTED] << " sorted, "
+            << stats.uses[CollideArray::FLATTEN_INSERTION] << " insertion, "
+            << stats.uses[CollideArray::FLATTEN_RADIX] << " radix), " << reference * 1000.0 << " ms std::sort"
+            << std::endl;
+}
+
+} // namespace
+
+//prints timings only and takes seconds, so it only runs when asked for:
+//--gtest_also_run_disabled_tests --gtest_filter=CollideMap.DISABLED_FlattenSortBenchmark10kUnits20kBolts
+TEST(CollideMap, DISABLED_FlattenSortBenchmark10kUnits20kBolts) {
+    //a dogfight, where bolts overtake many neighbours every atom
+    FlattenBenchmark(2e5);
+    //a whole system, where few keys change order
+    FlattenBenchmark(2e8);
+}
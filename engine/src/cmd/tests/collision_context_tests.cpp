@@ -0,0 +1,228 @@
+/*
+ * collision_context_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "collide2/CSopcodecollider.h"
+#include "collide2/csgeom2/optransfrm.h"
+
+namespace {
+
+//an axis aligned cube of the given half size, wound outwards
+std::vector<mesh_polygon> Cube(float h) {
+    static const int faces[6][4] = {
+            {0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}
+    };
+    std::vector<mesh_polygon> polygons;
+    for (const auto &face : faces) {
+        Vector corner[4];
+        for (int i = 0; i < 4; ++i) {
+            int c = face[i];
+            corner[i] = Vector((c & 1) ? h : -h, (c & 2) ? h : -h, (c & 4) ? h : -h);
+        }
+        mesh_polygon tri;
+        tri.v = {corner[0], corner[1], corner[2]};
+        polygons.push_back(tri);
+        tri.v = {corner[0], corner[2], corner[3]};
+        polygons.push_back(tri);
+    }
+    return polygons;
+}
+
+csReversibleTransform At(float x, float y, float z) {
+    csReversibleTransform t;
+    t.SetO2TTranslation(csVector3(x, y, z));
+    return t;
+}
+
+bool RayHits(const csOPCODECollider &collider, csCollisionContext &context, float z, float &distance) {
+    Vector norm;
+    Opcode::Ray ray(Opcode::Point(0.25f, 0.25f, z), Opcode::Point(0, 0, 1));
+    return collider.rayCollide(context, ray, norm, distance);
+}
+
+} // namespace
+
+TEST(CollisionContext, ContextsKeepTheirOwnPairs) {
+    csOPCODECollider a(Cube(1));
+    csOPCODECollider b(Cube(1));
+    a.SetOneHitOnly(false);
+    const csReversibleTransform origin = At(0, 0, 0);
+    const csReversibleTransform near = At(1.5f, 0, 0);
+    const csReversibleTransform far = At(10, 0, 0);
+
+    csCollisionContext touching;
+    csCollisionContext apart;
+    EXPECT_TRUE(a.Collide(touching, b, &origin, &near));
+    EXPECT_FALSE(a.Collide(apart, b, &origin, &far));
+    EXPECT_GT(touching.GetCollisionPairCount(), 0U);
+    EXPECT_EQ(0U, apart.GetCollisionPairCount());
+
+    //pairs accumulate until the context is reset
+    const size_t first = touching.GetCollisionPairCount();
+    EXPECT_TRUE(a.Collide(touching, b, &origin, &near));
+    EXPECT_EQ(2 * first, touching.GetCollisionPairCount());
+    touching.ResetCollisionPairs();
+    EXPECT_EQ(0U, touching.GetCollisionPairCount());
+}
+
+TEST(CollisionContext, StaticShimUsesTheThreadContext) {
+    csOPCODECollider a(Cube(1));
+    csOPCODECollider b(Cube(1));
+    const csReversibleTransform origin = At(0, 0, 0);
+    const csReversibleTransform near = At(1.5f, 0, 0);
+
+    csOPCODECollider::ResetCollisionPairs();
+    EXPECT_TRUE(a.Collide(b, &origin, &near));
+    const size_t count = csOPCODECollider::GetCollisionPairCount();
+    EXPECT_GT(count, 0U);
+    EXPECT_EQ(count, csCollisionContext::ForThisThread().GetCollisionPairCount());
+    EXPECT_EQ(csOPCODECollider::GetCollisions(), csCollisionContext::ForThisThread().GetCollisions());
+
+    //another thread starts with an empty context of its own
+    size_t other_count = 1;
+    std::thread other([&other_count]() {
+        other_count = csOPCODECollider::GetCollisionPairCount();
+    });
+    other.join();
+    EXPECT_EQ(0U, other_count);
+    EXPECT_EQ(count, csOPCODECollider::GetCollisionPairCount());
+    csOPCODECollider::ResetCollisionPairs();
+}
+
+TEST(CollisionContext, ConcurrentRayQueriesAgree) {
+    const csOPCODECollider target(Cube(1));
+    csCollisionContext serial;
+    float expected = 0;
+    ASSERT_TRUE(RayHits(target, serial, -10, expected));
+    EXPECT_NEAR(9.0f, expected, 1e-3f);
+
+    const int threads = 4;
+    std::vector<int> mismatches(threads, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&target, &mismatches, expected, t]() {
+            csCollisionContext context;
+            for (int i = 0; i < 1000; ++i) {
+                float distance = 0;
+                if (!RayHits(target, context, -10, distance) || distance != expected) {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    for (int t = 0; t < threads; ++t) {
+        EXPECT_EQ(0, mismatches[t]);
+    }
+}
+
+TEST(CollisionContext, CoherentPairsReuseTheirAnswerWhileStationKeeping) {
+    csOPCODECollider a(Cube(1));
+    csOPCODECollider b(Cube(2));
+    csCollisionContext context;
+    int ship = 0;
+    int station = 0;
+    csCollisionCoherence &coherence = context.Coherence(&ship, 1, &station, 1);
+
+    //docked: both move, the relative pose does not
+    for (int frame = 0; frame < 5; ++frame) {
+        const csReversibleTransform ship_at = At(100.0f * frame + 2.5f, 0, 0);
+        const csReversibleTransform station_at = At(100.0f * frame, 0, 0);
+        context.ResetCollisionPairs();
+        EXPECT_TRUE(a.Collide(context, coherence, b, &ship_at, &station_at, 0.01f));
+        EXPECT_EQ(1U, context.GetCollisionPairCount());
+    }
+    EXPECT_EQ(1U, context.GetCoherenceStats().walked);
+    EXPECT_EQ(4U, context.GetCoherenceStats().reused);
+    const csCollisionPair first = context.GetCollisions()[0];
+
+    //drifting a little: the last colliding triangles are tried first
+    const csReversibleTransform drifted = At(2.45f, 0.05f, 0);
+    const csReversibleTransform origin = At(0, 0, 0);
+    context.ResetCollisionPairs();
+    EXPECT_TRUE(a.Collide(context, coherence, b, &drifted, &origin, 0.01f));
+    EXPECT_EQ(1U, context.GetCoherenceStats().shortcut);
+    EXPECT_TRUE(first.a1 == context.GetCollisions()[0].a1);
+
+    //separated: the miss is remembered just the same
+    const csReversibleTransform apart = At(5, 0, 0);
+    context.ResetCollisionPairs();
+    EXPECT_FALSE(a.Collide(context, coherence, b, &apart, &origin, 0.01f));
+    EXPECT_FALSE(a.Collide(context, coherence, b, &apart, &origin, 0.01f));
+    EXPECT_EQ(0U, context.GetCollisionPairCount());
+    EXPECT_EQ(2U, context.GetCoherenceStats().walked);
+    EXPECT_EQ(5U, context.GetCoherenceStats().reused);
+
+    //a turn moves the far corners by more than the tolerance
+    csReversibleTransform turned = At(5, 0, 0);
+    turned.SetO2T(csMatrix3(0.99995f, -0.01f, 0, 0.01f, 0.99995f, 0, 0, 0, 1));
+    EXPECT_FALSE(a.Collide(context, coherence, b, &turned, &origin, 0.01f));
+    EXPECT_EQ(3U, context.GetCoherenceStats().walked);
+}
+
+TEST(CollisionContext, CoherenceIsKeptPerPairAndAged) {
+    csCollisionContext context;
+    int first = 0;
+    int second = 0;
+    csCollisionCoherence &entry = context.Coherence(&first, 1, &second, 1);
+    entry.valid = true;
+    EXPECT_TRUE(context.Coherence(&first, 1, &second, 1).valid);
+    EXPECT_FALSE(context.Coherence(&second, 1, &first, 1).valid);
+    EXPECT_EQ(2U, context.CoherentPairs());
+
+    //a new object at the same address starts afresh
+    EXPECT_FALSE(context.Coherence(&first, 2, &second, 1).valid);
+
+    context.AgeCoherence(2);
+    context.Coherence(&first, 2, &second, 1);
+    context.AgeCoherence(2);
+    context.AgeCoherence(2);
+    EXPECT_EQ(1U, context.CoherentPairs());
+    context.AgeCoherence(2);
+    EXPECT_EQ(0U, context.CoherentPairs());
+}
+
+TEST(CollisionContext, CapsuleTouchesOnlyWithinItsRadius) {
+    csOPCODECollider cube(Cube(1));
+    csCollisionContext context;
+    auto capsule = [](float y, float radius) {
+        return Opcode::LSS(Opcode::Segment(Opcode::Point(-5, y, 0), Opcode::Point(5, y, 0)), radius);
+    };
+    EXPECT_TRUE(cube.lssCollide(context, capsule(0, 0.1f)));
+    EXPECT_FALSE(cube.lssCollide(context, capsule(1.5f, 0.25f)));
+    EXPECT_TRUE(cube.lssCollide(context, capsule(1.5f, 0.75f)));
+    //a segment that stops short of the cube
+    EXPECT_FALSE(cube.lssCollide(context,
+            Opcode::LSS(Opcode::Segment(Opcode::Point(-5, 0, 0), Opcode::Point(-2, 0, 0)), 0.5f)));
+}
@@ -0,0 +1,122 @@
+/*
+ * mission_scheduler_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "cmd/script/mission_scheduler.h"
+
+//the scheduler only keys on the address of a mission, so any distinct address will do
+static const Mission *FakeMission(int n) {
+    static char missions[8];
+    return reinterpret_cast<const Mission *>(&missions[n]);
+}
+
+TEST(MissionScheduler, RunsEveryAtomByDefault) {
+    MissionScheduler scheduler;
+    const Mission *mis = FakeMission(0);
+    EXPECT_EQ(scheduler.getTickInterval(mis), MissionScheduler::EVERY_ATOM);
+    for (double t = 0.0; t < 1.0; t += 0.1) {
+        EXPECT_TRUE(scheduler.shouldRun(mis, t));
+    }
+}
+
+TEST(MissionScheduler, TickInterval) {
+    MissionScheduler scheduler;
+    const Mission *mis = FakeMission(1);
+    scheduler.setTickInterval(mis, 1.0);
+    EXPECT_EQ(scheduler.getTickInterval(mis), 1.0);
+
+    //the first atom runs, then nothing until a second has passed
+    EXPECT_TRUE(scheduler.shouldRun(mis, 10.0));
+    EXPECT_FALSE(scheduler.shouldRun(mis, 10.5));
+    EXPECT_FALSE(scheduler.shouldRun(mis, 10.99));
+    EXPECT_TRUE(scheduler.shouldRun(mis, 11.0));
+    EXPECT_FALSE(scheduler.shouldRun(mis, 11.5));
+
+    //a negative interval means events only
+    scheduler.setTickInterval(mis, -3.0);
+    EXPECT_EQ(scheduler.getTickInterval(mis), MissionScheduler::EVENTS_ONLY);
+    EXPECT_FALSE(scheduler.shouldRun(mis, 100.0));
+}
+
+TEST(MissionScheduler, WakeAt) {
+    MissionScheduler scheduler;
+    const Mission *mis = FakeMission(2);
+    scheduler.setTickInterval(mis, MissionScheduler::EVENTS_ONLY);
+    scheduler.wakeAt(mis, 20.0);
+    //an earlier wake up replaces a later one, a later one does not
+    scheduler.wakeAt(mis, 15.0);
+    scheduler.wakeAt(mis, 30.0);
+
+    EXPECT_FALSE(scheduler.shouldRun(mis, 14.9));
+    EXPECT_TRUE(scheduler.shouldRun(mis, 15.0));
+    //the timer fires once
+    EXPECT_FALSE(scheduler.shouldRun(mis, 20.0));
+    EXPECT_FALSE(scheduler.shouldRun(mis, 30.0));
+
+    scheduler.wakeAt(mis, 40.0);
+    scheduler.clearWakeConditions(mis);
+    EXPECT_FALSE(scheduler.shouldRun(mis, 50.0));
+}
+
+TEST(MissionScheduler, WakeConditions) {
+    MissionScheduler scheduler;
+    const Mission *listening = FakeMission(3);
+    const Mission *deaf = FakeMission(4);
+    scheduler.setTickInterval(listening, MissionScheduler::EVENTS_ONLY);
+    scheduler.setTickInterval(deaf, MissionScheduler::EVENTS_ONLY);
+    scheduler.wakeOn(listening, MissionScheduler::WAKE_ON_UNIT_DEATH | MissionScheduler::WAKE_ON_DOCKING);
+
+    scheduler.notify(MissionScheduler::WAKE_ON_SYSTEM_ENTRY);
+    EXPECT_FALSE(scheduler.shouldRun(listening, 1.0));
+
+    scheduler.notify(MissionScheduler::WAKE_ON_DOCKING);
+    EXPECT_TRUE(scheduler.shouldRun(listening, 2.0));
+    EXPECT_FALSE(scheduler.shouldRun(deaf, 2.0));
+    //consumed by the run
+    EXPECT_FALSE(scheduler.shouldRun(listening, 3.0));
+
+    EXPECT_EQ(MissionScheduler::parseWakeCondition("death"), MissionScheduler::WAKE_ON_UNIT_DEATH);
+    EXPECT_EQ(MissionScheduler::parseWakeCondition("docking"), MissionScheduler::WAKE_ON_DOCKING);
+    EXPECT_EQ(MissionScheduler::parseWakeCondition("system_entry"), MissionScheduler::WAKE_ON_SYSTEM_ENTRY);
+}
+
+TEST(MissionScheduler, Accounting) {
+    MissionScheduler scheduler;
+    const Mission *mis = FakeMission(5);
+    scheduler.recordRun(mis, "patrol", 0.002);
+    scheduler.recordRun(mis, "patrol", 0.004);
+    scheduler.recordSkip(mis);
+    const MissionScheduler::Accounting acct = scheduler.getAccounting(mis);
+    EXPECT_EQ(acct.runs, 2u);
+    EXPECT_EQ(acct.skips, 1u);
+    EXPECT_DOUBLE_EQ(acct.total_seconds, 0.006);
+    EXPECT_DOUBLE_EQ(acct.peak_seconds, 0.004);
+
+    scheduler.forget(mis);
+    EXPECT_EQ(scheduler.getAccounting(mis).runs, 0u);
+    EXPECT_TRUE(scheduler.shouldRun(mis, 0.0));
+}
@@ -0,0 +1,196 @@
+/*
+ * opcode_cache_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "collide2/CSopcodecache.h"
+#include "collide2/CSopcodecollider.h"
+
+namespace {
+
+//a lumpy sphere, dense enough that the tree has some depth
+std::vector<mesh_polygon> Sphere(float radius) {
+    const int rings = 12;
+    const int segments = 16;
+    auto point = [radius](int ring, int segment) {
+        float theta = 3.14159265f * ring / rings;
+        float phi = 6.2831853f * segment / segments;
+        float r = radius * (1.0f + 0.1f * std::sin(3.0f * phi));
+        return Vector(r * std::sin(theta) * std::cos(phi), r * std::cos(theta), r * std::sin(theta) * std::sin(phi));
+    };
+    std::vector<mesh_polygon> polygons;
+    for (int ring = 0; ring < rings; ++ring) {
+        for (int segment = 0; segment < segments; ++segment) {
+            mesh_polygon tri;
+            tri.v = {point(ring, segment), point(ring + 1, segment), point(ring + 1, segment + 1)};
+            polygons.push_back(tri);
+            tri.v = {point(ring, segment), point(ring + 1, segment + 1), point(ring, segment + 1)};
+            polygons.push_back(tri);
+        }
+    }
+    return polygons;
+}
+
+class OPCODECache : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vs-opcode-cache-%%%%%%%%");
+        boost::filesystem::create_directories(dir);
+        csOPCODECache::SetDirectory(dir.string());
+    }
+
+    void TearDown() override {
+        csOPCODECache::SetDirectory(std::string());
+        boost::filesystem::remove_all(dir);
+    }
+
+    static size_t Files(const boost::filesystem::path &in) {
+        size_t count = 0;
+        for (boost::filesystem::directory_iterator i(in), end; i != end; ++i) {
+            ++count;
+        }
+        return count;
+    }
+
+    //casts a fan of rays at the collider and returns the hit distances (-1 for a miss)
+    static std::vector<float> Probe(const csOPCODECollider &collider) {
+        std::vector<float> hits;
+        csCollisionContext context;
+        for (int i = -8; i <= 8; ++i) {
+            for (int j = -8; j <= 8; ++j) {
+                Vector norm;
+                float distance = -1;
+                Opcode::Ray ray(Opcode::Point(i * 0.15f, j * 0.15f, -5), Opcode::Point(0, 0, 1));
+                if (!collider.rayCollide(context, ray, norm, distance)) {
+                    distance = -1;
+                }
+                hits.push_back(distance);
+            }
+        }
+        return hits;
+    }
+
+    boost::filesystem::path dir;
+};
+
+} // namespace
+
+TEST_F(OPCODECache, SecondBuildIsLoadedFromTheCache) {
+    const csOPCODECache::Stats before = csOPCODECache::GetStats();
+    csOPCODECollider built(Sphere(1));
+    EXPECT_EQ(before.misses + 1, csOPCODECache::GetStats().misses);
+    EXPECT_EQ(before.stores + 1, csOPCODECache::GetStats().stores);
+    EXPECT_EQ(1U, Files(dir));
+
+    csOPCODECollider cached(Sphere(1));
+    EXPECT_EQ(before.hits + 1, csOPCODECache::GetStats().hits);
+    EXPECT_EQ(1U, Files(dir));
+
+    const std::vector<float> expected = Probe(built);
+    EXPECT_EQ(expected, Probe(cached));
+    EXPECT_NE(std::count(expected.begin(), expected.end(), -1.0f), static_cast<long>(expected.size()));
+
+    //mesh against mesh agrees too
+    csCollisionContext a, b;
+    csReversibleTransform origin;
+    csReversibleTransform offset;
+    offset.SetO2TTranslation(csVector3(1.5f, 0.2f, 0));
+    built.SetOneHitOnly(false);
+    cached.SetOneHitOnly(false);
+    EXPECT_TRUE(built.Collide(a, built, &origin, &offset));
+    EXPECT_TRUE(cached.Collide(b, cached, &origin, &offset));
+    EXPECT_EQ(a.GetCollisionPairCount(), b.GetCollisionPairCount());
+}
+
+TEST_F(OPCODECache, ScaleIsPartOfTheKey) {
+    csOPCODECollider small(Sphere(1));
+    const csOPCODECache::Stats before = csOPCODECache::GetStats();
+    csOPCODECollider large(Sphere(2));
+    EXPECT_EQ(before.hits, csOPCODECache::GetStats().hits);
+    EXPECT_EQ(2U, Files(dir));
+    EXPECT_NEAR(2 * small.GetRadius(), large.GetRadius(), 1e-3f);
+}
+
+TEST_F(OPCODECache, DamagedFilesAreRebuilt) {
+    csOPCODECollider built(Sphere(1));
+    const boost::filesystem::path file = boost::filesystem::directory_iterator(dir)->path();
+    const uintmax_t size = boost::filesystem::file_size(file);
+    boost::filesystem::resize_file(file, size - 7);
+
+    const csOPCODECache::Stats before = csOPCODECache::GetStats();
+    csOPCODECollider rebuilt(Sphere(1));
+    EXPECT_EQ(before.rejected + 1, csOPCODECache::GetStats().rejected);
+    EXPECT_EQ(before.stores + 1, csOPCODECache::GetStats().stores);
+    EXPECT_EQ(size, boost::filesystem::file_size(file));
+    EXPECT_EQ(Probe(built), Probe(rebuilt));
+
+    //a link pointing back up the tree must not be followed
+    {
+        std::fstream patch(file.string().c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        //header, node count and coefficients, then the root's box; its positive link follows
+        patch.seekp(32 + 28 + 12);
+        const uint32_t back_to_root = 0;
+        patch.write(reinterpret_cast<const char *>(&back_to_root), sizeof(back_to_root));
+    }
+    const unsigned int rejected = csOPCODECache::GetStats().rejected;
+    csOPCODECollider again(Sphere(1));
+    EXPECT_EQ(rejected + 1, csOPCODECache::GetStats().rejected);
+    EXPECT_EQ(Probe(built), Probe(again));
+}
+
+TEST_F(OPCODECache, ConcurrentBuildsCountEveryLookup) {
+    const csOPCODECache::Stats before = csOPCODECache::GetStats();
+    const unsigned int builds = 8;
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < builds; ++i) {
+        threads.emplace_back([] {
+            csOPCODECollider collider(Sphere(1));
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    const csOPCODECache::Stats after = csOPCODECache::GetStats();
+    EXPECT_EQ(before.hits + before.misses + builds, after.hits + after.misses);
+    EXPECT_EQ(after.misses - before.misses, after.stores - before.stores);
+    EXPECT_EQ(1U, Files(dir));
+}
+
+TEST_F(OPCODECache, NothingIsWrittenWhenDisabled) {
+    csOPCODECache::SetDirectory(std::string());
+    csOPCODECollider built(Sphere(1));
+    EXPECT_EQ(0U, Files(dir));
+}
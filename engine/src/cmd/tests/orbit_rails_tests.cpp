@@ -0,0 +1,98 @@
+/*
+ * orbit_rails_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "cmd/orbit_rails.h"
+
+static OrbitRails::Elements Ellipse(const QVector &offset, double a, double b, double period, double phase) {
+    OrbitRails::Elements elements;
+    elements.offset = offset;
+    elements.x_axis = QVector(a, 0, 0);
+    elements.y_axis = QVector(0, b, 0.1 * b);
+    elements.angular_velocity = 2.0 * M_PI / period;
+    elements.phase = phase;
+    return elements;
+}
+
+static QVector Around(const OrbitRails::Elements &e, double time) {
+    const double theta = e.phase + e.angular_velocity * (time - e.epoch);
+    return e.offset + e.x_axis * cos(theta) + e.y_axis * sin(theta);
+}
+
+TEST(OrbitRails, MoonFollowsPlanet) {
+    OrbitRails rails;
+    const OrbitRails::Elements planet = Ellipse(QVector(-1.0e9, 0, 0), 1.5e11, 1.4e11, 3.0e7, 0.3);
+    OrbitRails::Elements moon = Ellipse(QVector(0, 0, 0), 4.0e8, 3.9e8, 2.3e6, 2.0);
+    moon.epoch = 1000.0;
+    const unsigned int p = rails.Add(planet, OrbitRails::NO_PARENT);
+    const unsigned int m = rails.Add(moon, p);
+    ASSERT_EQ(rails.Parent(m), p);
+
+    for (double time : {0.0, 1000.0, 12345.6, 7.0e6}) {
+        rails.Evaluate(time);
+        const QVector planet_position = Around(planet, time);
+        const QVector moon_position = planet_position + Around(moon, time);
+        EXPECT_NEAR((rails.Position(p) - planet_position).Magnitude(), 0.0, 1e-3);
+        EXPECT_NEAR((rails.Position(m) - moon_position).Magnitude(), 0.0, 1e-3);
+
+        //the velocity is the derivative of the position
+        const double h = 1.0;
+        const QVector numeric = (Around(planet, time + h) + Around(moon, time + h)
+                - Around(planet, time - h) - Around(moon, time - h)) * (0.5 / h);
+        const Vector velocity = rails.Velocity(m);
+        EXPECT_NEAR(velocity.i, numeric.i, 1e-2 * std::abs(numeric.i) + 1e-3);
+        EXPECT_NEAR(velocity.j, numeric.j, 1e-2 * std::abs(numeric.j) + 1e-3);
+        EXPECT_NEAR(velocity.k, numeric.k, 1e-2 * std::abs(numeric.k) + 1e-3);
+    }
+}
+
+TEST(OrbitRails, RemovingAPlanetDropsItsMoons) {
+    OrbitRails rails;
+    const unsigned int sun = rails.Add(Ellipse(QVector(0, 0, 0), 0, 0, 1, 0), OrbitRails::NO_PARENT);
+    const unsigned int planet = rails.Add(Ellipse(QVector(0, 0, 0), 1.0e11, 1.0e11, 3.0e7, 0), sun);
+    const unsigned int other = rails.Add(Ellipse(QVector(0, 0, 0), 2.0e11, 2.0e11, 6.0e7, 1), sun);
+    const unsigned int moon = rails.Add(Ellipse(QVector(0, 0, 0), 4.0e8, 4.0e8, 2.0e6, 0), planet);
+    const unsigned int station = rails.Add(Ellipse(QVector(0, 0, 0), 1.0e7, 1.0e7, 1.0e4, 0), moon);
+    const unsigned int other_moon = rails.Add(Ellipse(QVector(0, 0, 0), 3.0e8, 3.0e8, 1.0e6, 0), other);
+
+    std::vector<unsigned int> remap;
+    EXPECT_FALSE(rails.Compact(remap));
+    rails.Remove(planet);
+    EXPECT_TRUE(rails.Compact(remap));
+    ASSERT_EQ(rails.Size(), 3u);
+    EXPECT_EQ(remap[sun], 0u);
+    EXPECT_EQ(remap[planet], OrbitRails::NO_PARENT);
+    EXPECT_EQ(remap[other], 1u);
+    EXPECT_EQ(remap[moon], OrbitRails::NO_PARENT);
+    EXPECT_EQ(remap[station], OrbitRails::NO_PARENT);
+    EXPECT_EQ(remap[other_moon], 2u);
+    EXPECT_EQ(rails.Parent(remap[other]), remap[sun]);
+    EXPECT_EQ(rails.Parent(remap[other_moon]), remap[other]);
+    EXPECT_DOUBLE_EQ(rails.GetElements(remap[other_moon]).angular_velocity, 2.0 * M_PI / 1.0e6);
+}
@@ -0,0 +1,269 @@
+/*
+ * physics_priority_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "cmd/physics_priority_ladder.h"
+
+using namespace PhysicsPriorityLadder;
+
+static Levels DistinctLevels() {
+    Levels levels;
+    levels.missile = 2;
+    levels.dockable = 3;
+    levels.asteroid_parent = 4;
+    levels.asteroid_high = 5;
+    levels.player = 6;
+    levels.high = 7;
+    levels.medium_high = 8;
+    levels.medium = 9;
+    levels.low = 10;
+    levels.inert = 11;
+    levels.system_orbit = 12;
+    levels.not_visible_combat_high = 13;
+    levels.not_visible_combat_medium = 14;
+    levels.not_visible_combat_low = 15;
+    levels.no_enemies = 16;
+    return levels;
+}
+
+//The ladder getPhysicsPriority ran before it was split into bands, past the live player checks
+static uint_fast32_t OldLadder(const Inputs &in, const TargetMeasure &target, const Thresholds &th, const Levels &p) {
+    if (in.missile) {
+        return p.missile;
+    }
+    if (in.docking) {
+        return p.dockable;
+    }
+    if (in.schedule == SCHEDULE_ASTEROID_FIELD) {
+        return p.asteroid_parent;
+    }
+    if (in.schedule == SCHEDULE_ASTEROID || in.asteroid) {
+        return p.asteroid_high;
+    }
+    const float dist = in.distance;
+    const float tooclose = in.too_close;
+    const float gun_range = th.gun_range;
+    const float missile_range = th.missile_range;
+    if (in.targets_player) {
+        if (in.jumppoint) {
+            return p.player;
+        } else if (in.player_target_distance <= th.player_threat_factor * std::max(gun_range, missile_range)) {
+            return p.high;
+        } else {
+            return p.medium_high;
+        }
+    }
+    if (in.ramping) {
+        if (in.warp_ramping || in.time_ramped < th.lowest_priority_time) {
+            return p.medium;
+        }
+        if (dist < gun_range) {
+            return p.medium;
+        }
+        if (in.time_ramped < th.lowest_priority_time * 2) {
+            return p.low;
+        }
+    }
+    if (in.system_installation || in.inert_faction) {
+        if (dist < tooclose) {
+            return p.medium;
+        } else {
+            if (in.system_installation) {
+                return p.system_orbit;
+            }
+            return p.inert;
+        }
+    }
+    if (in.busy_directive) {
+        return p.medium;
+    }
+    if (dist < 2 * th.player_threat_factor * std::max(missile_range, gun_range)) {
+        if (dist < tooclose * th.player_threat_factor) {
+            return p.medium_high;
+        } else if (dist < 2 * gun_range * th.player_threat_factor) {
+            return p.medium;
+        } else {
+            return p.low;
+        }
+    }
+    if (in.has_target) {
+        if (target.distance <= 2.0 * static_cast<double>(target.gun_range) * th.threat_factor) {
+            return p.not_visible_combat_high;
+        }
+        if (target.distance < 2.0 * static_cast<double>(target.missile_range) * th.threat_factor) {
+            return p.not_visible_combat_medium;
+        }
+        return p.not_visible_combat_low;
+    }
+    if (dist < tooclose * th.threat_factor) {
+        return p.medium_high;
+    } else {
+        return p.no_enemies;
+    }
+}
+
+class PhysicsPriorityLadderTest : public ::testing::Test {
+protected:
+    std::mt19937 random{20260};
+
+    bool Chance(double p) {
+        return std::bernoulli_distribution(p)(random);
+    }
+
+    //spread over several orders of magnitude so every threshold gets crossed
+    float Distance() {
+        return std::exp(std::uniform_real_distribution<float>(0.0F, 12.0F)(random));
+    }
+
+    Thresholds RandomThresholds() {
+        Thresholds th;
+        th.gun_range = Chance(0.2) ? 0.0F : Distance();
+        th.missile_range = Chance(0.3) ? 0.0F : Distance();
+        th.lowest_priority_time = 1.0F;
+        th.player_threat_factor = std::uniform_real_distribution<double>(0.5, 4.0)(random);
+        th.threat_factor = std::uniform_real_distribution<double>(0.5, 4.0)(random);
+        return th;
+    }
+
+    Inputs RandomInputs() {
+        Inputs in;
+        in.missile = Chance(0.05);
+        in.docking = Chance(0.05);
+        in.schedule = Chance(0.9) ? SCHEDULE_DEFAULT : Chance(0.5) ? SCHEDULE_ASTEROID_FIELD : SCHEDULE_ASTEROID;
+        in.asteroid = Chance(0.05);
+        in.has_target = Chance(0.4);
+        in.targets_player = in.has_target && Chance(0.3);
+        in.jumppoint = in.targets_player && Chance(0.2);
+        in.player_target_distance = Distance();
+        in.ramping = Chance(0.15);
+        in.warp_ramping = in.ramping && Chance(0.3);
+        in.time_ramped = std::uniform_real_distribution<float>(0.0F, 3.0F)(random);
+        in.system_installation = Chance(0.2);
+        in.inert_faction = Chance(0.15);
+        in.busy_directive = Chance(0.15);
+        in.distance = Chance(0.05) ? FLT_MAX : Distance();
+        in.too_close = Chance(0.3) ? 0.0F : Distance();
+        return in;
+    }
+
+    TargetMeasure RandomTarget() {
+        TargetMeasure target;
+        target.distance = Distance();
+        target.gun_range = Distance();
+        target.missile_range = Distance();
+        return target;
+    }
+};
+
+TEST_F(PhysicsPriorityLadderTest, MatchesOldLadder) {
+    const Levels levels = DistinctLevels();
+    for (int i = 0; i < 200000; ++i) {
+        const Thresholds th = RandomThresholds();
+        const Inputs in = RandomInputs();
+        const TargetMeasure target = RandomTarget();
+        Interval interval;
+        const uint32_t bands = Classify(in, th, interval, [&target]() {
+            return target;
+        });
+        ASSERT_EQ(Resolve(bands, levels), OldLadder(in, target, th, levels)) << "case " << i;
+    }
+}
+
+TEST_F(PhysicsPriorityLadderTest, TargetMeasuredOnlyWhenNeeded) {
+    Thresholds th = RandomThresholds();
+    Inputs in;
+    in.has_target = true;
+    in.system_installation = true;
+    int measured = 0;
+    Interval interval;
+    Classify(in, th, interval, [&measured]() {
+        ++measured;
+        return TargetMeasure();
+    });
+    EXPECT_EQ(measured, 0);
+
+    in.system_installation = false;
+    in.distance = FLT_MAX;
+    Classify(in, th, interval, [&measured]() {
+        ++measured;
+        return TargetMeasure();
+    });
+    EXPECT_EQ(measured, 1);
+}
+
+//Units drifting around the thresholds: whatever the cache hands out must match a fresh classification
+TEST_F(PhysicsPriorityLadderTest, CachedBandsMatchFreshClassification) {
+    const Levels levels = DistinctLevels();
+    const int units = 64;
+    std::vector<Inputs> inputs(units);
+    std::vector<BandCache> caches(units);
+    for (Inputs &in : inputs) {
+        in = RandomInputs();
+    }
+    Thresholds th = RandomThresholds();
+    unsigned int generation = 1;
+    int hits = 0;
+    for (int step = 0; step < 20000; ++step) {
+        if (Chance(0.01)) {
+            th = RandomThresholds();
+            ++generation;
+        }
+        for (int u = 0; u < units; ++u) {
+            Inputs &in = inputs[u];
+            if (Chance(0.02)) {
+                in = RandomInputs();
+            } else {
+                std::uniform_real_distribution<float> drift(0.97F, 1.03F);
+                if (in.distance != FLT_MAX) {
+                    in.distance *= drift(random);
+                }
+                in.too_close *= drift(random);
+            }
+            const TargetMeasure target = RandomTarget();
+            const auto measure = [&target]() {
+                return target;
+            };
+            const int cockpit = Chance(0.01) ? 1 : 0;
+            if (caches[u].Holds(in, generation, cockpit)) {
+                ++hits;
+                Interval fresh;
+                ASSERT_EQ(caches[u].bands, Classify(in, th, fresh, measure)) << "step " << step << " unit " << u;
+            } else {
+                Interval interval;
+                const uint32_t bands = Classify(in, th, interval, measure);
+                caches[u].Store(in, generation, cockpit, interval, bands);
+            }
+            ASSERT_EQ(Resolve(caches[u].bands, levels), OldLadder(in, target, th, levels));
+        }
+    }
+    //most units sit well inside their bands most of the time
+    EXPECT_GT(hits, units * 20000 / 2);
+}
@@ -0,0 +1,157 @@
+/*
+ * rigid_body_batch_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "cmd/rigid_body_batch.h"
+
+static Vector RandomVector(std::mt19937 &rng, float extent) {
+    std::uniform_real_distribution<float> component(-extent, extent);
+    const float i = component(rng);
+    const float j = component(rng);
+    const float k = component(rng);
+    return Vector(i, j, k);
+}
+
+//Ships, missiles and debris: a mix of thrusting, spinning, massless-moment and rate limited bodies
+static RigidBodyBatch RandomBodies(size_t count) {
+    std::mt19937 rng(2718);
+    std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+    RigidBodyBatch batch;
+    for (size_t n = 0; n < count; ++n) {
+        RigidBodyBatch::Body body;
+        const Vector axis = RandomVector(rng, 1.0F);
+        body.orientation = Quaternion(unit(rng), axis);
+        body.orientation.Normalize();
+        body.position = RandomVector(rng, 1.0F).Cast() * 1.0e9;
+        body.velocity = RandomVector(rng, 3000.0F);
+        //some bodies barely turn, some turn more than half a revolution an atom
+        const float spin[] = {0.0F, 0.00001F, 0.5F, 3.0F, 400.0F};
+        body.angular_velocity = RandomVector(rng, spin[n % 5]);
+        body.local_force = RandomVector(rng, 1.0e6F);
+        body.local_torque = RandomVector(rng, 1.0e5F);
+        body.force = n % 3 ? Vector(0, 0, 0) : RandomVector(rng, 1.0e5F);
+        body.torque = n % 4 ? Vector(0, 0, 0) : RandomVector(rng, 1.0e4F);
+        body.mass = 1.0F + 1000.0F * unit(rng);
+        body.moment = n % 7 ? 0.01F + 50.0F * unit(rng) : 0.0F;
+        body.max_rotation_rate = 0.5F + 5.0F * unit(rng);
+        body.time_step = (n % 2 + 1) * 0.05F;
+        batch.Add(body);
+    }
+    return batch;
+}
+
+static void ExpectNear(const Vector &a, const Vector &b, float tolerance) {
+    EXPECT_NEAR(a.i, b.i, tolerance);
+    EXPECT_NEAR(a.j, b.j, tolerance);
+    EXPECT_NEAR(a.k, b.k, tolerance);
+}
+
+TEST(RigidBodyBatch, BatchedMatchesScalarReference) {
+    //an odd count, so the scalar tail of the batched path runs too
+    RigidBodyBatch batched = RandomBodies(1001);
+    RigidBodyBatch scalar = batched;
+
+    batched.ResolveForces();
+    scalar.ResolveForcesScalar();
+    for (size_t b = 0; b < batched.Size(); ++b) {
+        const float speed = scalar.Velocity(b).Magnitude();
+        ExpectNear(batched.Velocity(b), scalar.Velocity(b), 1.0e-5F * std::max(1.0F, speed));
+        ExpectNear(batched.AngularVelocity(b), scalar.AngularVelocity(b), 1.0e-4F);
+    }
+
+    batched.Advance();
+    scalar.AdvanceScalar();
+    for (size_t b = 0; b < batched.Size(); ++b) {
+        const Quaternion qa = batched.Orientation(b);
+        const Quaternion qb = scalar.Orientation(b);
+        EXPECT_NEAR(qa.s, qb.s, 1.0e-5F);
+        ExpectNear(qa.v, qb.v, 1.0e-5F);
+        const QVector pa = batched.Position(b);
+        const QVector pb = scalar.Position(b);
+        EXPECT_NEAR(pa.i, pb.i, 1.0e-2);
+        EXPECT_NEAR(pa.j, pb.j, 1.0e-2);
+        EXPECT_NEAR(pa.k, pb.k, 1.0e-2);
+    }
+}
+
+TEST(RigidBodyBatch, FastSpinMatchesScalarReference) {
+    //without the rate limit of ResolveForces some bodies turn several times an atom
+    RigidBodyBatch batched = RandomBodies(1001);
+    RigidBodyBatch scalar = batched;
+    batched.Advance();
+    scalar.AdvanceScalar();
+    for (size_t b = 0; b < batched.Size(); ++b) {
+        const Quaternion qa = batched.Orientation(b);
+        const Quaternion qb = scalar.Orientation(b);
+        EXPECT_NEAR(qa.s, qb.s, 1.0e-5F);
+        ExpectNear(qa.v, qb.v, 1.0e-5F);
+    }
+}
+
+TEST(RigidBodyBatch, IntegratesForcesAndSpin) {
+    RigidBodyBatch batch;
+    for (int n = 0; n < 4; ++n) {
+        RigidBodyBatch::Body body;
+        body.orientation = identity_quaternion;
+        body.position = QVector(1.0e10, 0, 0);
+        body.velocity = Vector(0, 0, 0);
+        body.angular_velocity = Vector(0, 0, 0);
+        //thrust along the body's forward axis plus a world space push
+        body.local_force = Vector(0, 0, 100.0F);
+        body.force = Vector(50.0F, 0, 0);
+        body.local_torque = Vector(0, 0, 2.0F);
+        body.torque = Vector(0, 0, 0);
+        body.mass = 10.0F;
+        body.moment = n ? 4.0F : 0.0F;
+        body.max_rotation_rate = n == 3 ? 0.1F : 100.0F;
+        body.time_step = 0.5F;
+        batch.Add(body);
+    }
+
+    batch.ResolveForces();
+    for (size_t b = 0; b < 4; ++b) {
+        ExpectNear(batch.Velocity(b), Vector(2.5F, 0, 5.0F), 1.0e-5F);
+    }
+    //no moment leaves the torque as it is; the last body is rate limited
+    ExpectNear(batch.AngularVelocity(0), Vector(0, 0, 1.0F), 1.0e-6F);
+    ExpectNear(batch.AngularVelocity(1), Vector(0, 0, 0.25F), 1.0e-6F);
+    ExpectNear(batch.AngularVelocity(3), Vector(0, 0, 0.1F), 1.0e-6F);
+
+    batch.SetDrift(2, Vector(0, 0, 0));
+    batch.Advance();
+    EXPECT_NEAR(batch.Position(0).i, 1.0e10 + 1.25, 1.0e-5);
+    EXPECT_NEAR(batch.Position(0).k, 2.5, 1.0e-5);
+    EXPECT_EQ(batch.Position(2).i, 1.0e10);
+    //half a radian about the roll axis
+    const Quaternion roll = batch.Orientation(0);
+    EXPECT_NEAR(roll.s, std::cos(0.25F), 1.0e-6F);
+    EXPECT_NEAR(roll.v.k, std::sin(0.25F), 1.0e-6F);
+    EXPECT_NEAR(roll.v.i, 0.0F, 1.0e-6F);
+}
@@ -0,0 +1,121 @@
+/*
+ * spatial_hash_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "cmd/spatial_hash.h"
+
+typedef SpatialHash3d<int> Grid;
+
+static std::vector<int> Near(const Grid &grid, const QVector &mini, const QVector &maxi) {
+    std::vector<int> retval;
+    grid.Get(mini, maxi, retval);
+    return retval;
+}
+
+TEST(SpatialHash, DistantCellsDoNotAlias) {
+    Grid grid(128.0);
+    grid.Put(QVector(10, 10, 10), QVector(20, 20, 20), 1);
+    //the old 20 cell table wrapped every 1280 units
+    grid.Put(QVector(1280 * 1000 + 10, 10, 10), QVector(1280 * 1000 + 20, 20, 20), 2);
+    EXPECT_EQ(std::vector<int>({1}), Near(grid, QVector(0, 0, 0), QVector(30, 30, 30)));
+    EXPECT_EQ(std::vector<int>({2}), Near(grid, QVector(1280 * 1000, 0, 0), QVector(1280 * 1000 + 30, 30, 30)));
+    EXPECT_EQ(2U, grid.CellCount());
+}
+
+TEST(SpatialHash, LargeObjectsUseCoarseCells) {
+    Grid grid(128.0);
+    Grid::Placement p = grid.Put(QVector(-50000, -50000, -50000), QVector(50000, 50000, 50000), 7);
+    EXPECT_FALSE(p.Overflow());
+    EXPECT_GT(p.level, 0);
+    EXPECT_LE(grid.CellCount(), 8U);
+    EXPECT_EQ(std::vector<int>({7}), Near(grid, QVector(100, 100, 100), QVector(101, 101, 101)));
+    EXPECT_TRUE(Near(grid, QVector(1e6, 1e6, 1e6), QVector(1e6 + 1, 1e6 + 1, 1e6 + 1)).empty());
+    EXPECT_TRUE(grid.Remove(QVector(-50000, -50000, -50000), QVector(50000, 50000, 50000), 7));
+    EXPECT_EQ(0U, grid.CellCount());
+}
+
+TEST(SpatialHash, OutOfRangeBoxesOverflow) {
+    Grid grid(128.0);
+    Grid::Placement p = grid.Put(QVector(-1e30, 0, 0), QVector(1e30, 1, 1), 3);
+    EXPECT_TRUE(p.Overflow());
+    EXPECT_EQ(std::vector<int>({3}), Near(grid, QVector(5, 5, 5), QVector(6, 6, 6)));
+    EXPECT_TRUE(grid.Eradicate(3));
+    EXPECT_TRUE(grid.GetOverflow().empty());
+}
+
+TEST(SpatialHash, PlacementTracksCellChanges) {
+    Grid grid(128.0);
+    EXPECT_EQ(grid.Place(QVector(1, 1, 1), QVector(2, 2, 2)), grid.Place(QVector(3, 3, 3), QVector(4, 4, 4)));
+    EXPECT_NE(grid.Place(QVector(1, 1, 1), QVector(2, 2, 2)), grid.Place(QVector(130, 1, 1), QVector(131, 2, 2)));
+    EXPECT_NE(grid.Place(QVector(1, 1, 1), QVector(2, 2, 2)), grid.Place(QVector(-2, 1, 1), QVector(-1, 2, 2)));
+}
+
+TEST(SpatialHash, MatchesBruteForce) {
+    struct Box {
+        QVector mini;
+        QVector maxi;
+    };
+    std::srand(1234);
+    auto coord = [](double range) {
+        return (std::rand() / static_cast<double>(RAND_MAX) - 0.5) * range;
+    };
+    Grid grid(128.0);
+    std::vector<Box> boxes;
+    for (int i = 0; i < 2000; ++i) {
+        QVector center(coord(1e6), coord(1e6), coord(1e6));
+        double half = (i % 50 == 0) ? std::abs(coord(2e5)) : std::abs(coord(400));
+        QVector extent(half, half * 0.5, half * 2);
+        boxes.push_back(Box{center - extent, center + extent});
+        grid.Put(boxes.back().mini, boxes.back().maxi, i);
+    }
+    for (int q = 0; q < 200; ++q) {
+        const Box &probe = boxes[std::rand() % boxes.size()];
+        std::vector<int> got = Near(grid, probe.mini, probe.maxi);
+        for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+            const Box &b = boxes[i];
+            bool overlaps = b.mini.i <= probe.maxi.i && b.maxi.i >= probe.mini.i
+                    && b.mini.j <= probe.maxi.j && b.maxi.j >= probe.mini.j
+                    && b.mini.k <= probe.maxi.k && b.maxi.k >= probe.mini.k;
+            if (overlaps) {
+                EXPECT_TRUE(std::binary_search(got.begin(), got.end(), i)) << "box " << i << " query " << q;
+            }
+        }
+    }
+    for (int i = 0; i < static_cast<int>(boxes.size()); i += 2) {
+        EXPECT_TRUE(grid.Remove(boxes[i].mini, boxes[i].maxi, i));
+    }
+    for (int i = 1; i < static_cast<int>(boxes.size()); i += 2) {
+        EXPECT_TRUE(grid.Eradicate(i));
+    }
+    EXPECT_EQ(0U, grid.CellCount());
+    for (int level = 0; level < Grid::kLevels; ++level) {
+        EXPECT_EQ(0U, grid.LevelEntries(level));
+    }
+}
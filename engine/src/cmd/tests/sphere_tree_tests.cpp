@@ -0,0 +1,126 @@
+/*
+ * sphere_tree_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <random>
+
+#include "cmd/sphere_tree.h"
+
+//A star system's worth of bodies: planets spread over a few AU, moons close to them
+static void RandomSystem(std::vector<QVector> &centers, std::vector<double> &reaches, size_t count) {
+    std::mt19937 rng(1618);
+    std::uniform_real_distribution<double> orbit(-5.0e11, 5.0e11);
+    std::uniform_real_distribution<double> moon(-5.0e8, 5.0e8);
+    std::uniform_real_distribution<double> size(1.0e6, 7.0e7);
+    for (size_t n = 0; n < count; ++n) {
+        if (n % 3 && !centers.empty()) {
+            centers.push_back(centers[n - n % 3] + QVector(moon(rng), moon(rng), moon(rng)));
+        } else {
+            centers.push_back(QVector(orbit(rng), orbit(rng), orbit(rng) * 0.05));
+        }
+        reaches.push_back(size(rng));
+    }
+}
+
+static SphereTree::Nearest BruteForce(const std::vector<QVector> &centers, const std::vector<double> &reaches,
+        const QVector &point) {
+    SphereTree::Nearest best;
+    best.margin = DBL_MAX;
+    best.runner_up = DBL_MAX;
+    for (size_t i = 0; i < centers.size(); ++i) {
+        const double margin = (point - centers[i]).Magnitude() - reaches[i];
+        if (margin < best.margin) {
+            best.runner_up = best.margin;
+            best.margin = margin;
+            best.index = i;
+        } else if (margin < best.runner_up) {
+            best.runner_up = margin;
+        }
+    }
+    return best;
+}
+
+TEST(SphereTree, MatchesBruteForce) {
+    std::vector<QVector> centers;
+    std::vector<double> reaches;
+    RandomSystem(centers, reaches, 61);
+    SphereTree tree;
+    tree.Build(centers, reaches);
+    ASSERT_EQ(tree.Size(), centers.size());
+
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<double> anywhere(-6.0e11, 6.0e11);
+    std::uniform_int_distribution<size_t> body(0, centers.size() - 1);
+    for (int q = 0; q < 2000; ++q) {
+        //half the queries close to a body, where it matters which one is nearest
+        const QVector point = q % 2 ? QVector(anywhere(rng), anywhere(rng), anywhere(rng))
+                : centers[body(rng)] + QVector(anywhere(rng), anywhere(rng), anywhere(rng)) * 0.001;
+        const SphereTree::Nearest expected = BruteForce(centers, reaches, point);
+        const SphereTree::Nearest found = tree.FindNearest(point);
+        EXPECT_EQ(found.index, expected.index);
+        EXPECT_DOUBLE_EQ(found.margin, expected.margin);
+        EXPECT_DOUBLE_EQ(found.runner_up, expected.runner_up);
+    }
+}
+
+TEST(SphereTree, RefitFollowsMovingBodies) {
+    std::vector<QVector> centers;
+    std::vector<double> reaches;
+    RandomSystem(centers, reaches, 40);
+    SphereTree tree;
+    tree.Build(centers, reaches);
+
+    //swing every body a long way, so the split the tree was built with is a poor one
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> swing(-2.0e11, 2.0e11);
+    double furthest = 0;
+    for (QVector &center : centers) {
+        const QVector offset(swing(rng), swing(rng), swing(rng));
+        furthest = std::max(furthest, offset.Magnitude());
+        center += offset;
+    }
+    EXPECT_NEAR(tree.Refit(centers), furthest, 1.0);
+
+    std::uniform_real_distribution<double> anywhere(-7.0e11, 7.0e11);
+    for (int q = 0; q < 1000; ++q) {
+        const QVector point(anywhere(rng), anywhere(rng), anywhere(rng));
+        EXPECT_EQ(tree.FindNearest(point).index, BruteForce(centers, reaches, point).index);
+    }
+}
+
+TEST(SphereTree, EmptyAndSingle) {
+    SphereTree tree;
+    tree.Build(std::vector<QVector>(), std::vector<double>());
+    EXPECT_EQ(tree.FindNearest(QVector(1, 2, 3)).index, SphereTree::npos);
+
+    tree.Build(std::vector<QVector>(1, QVector(100, 0, 0)), std::vector<double>(1, 10.0));
+    const SphereTree::Nearest nearest = tree.FindNearest(QVector(0, 0, 0));
+    EXPECT_EQ(nearest.index, 0u);
+    EXPECT_DOUBLE_EQ(nearest.margin, 90.0);
+    EXPECT_EQ(nearest.runner_up, DBL_MAX);
+}
@@ -0,0 +1,92 @@
+/*
+ * unit_pool_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "cmd/unit_pool.h"
+
+TEST(UnitPool, GenerationChangesOnRelease) {
+    void *slot = UnitPool::Allocate(200);
+    const uint32_t generation = UnitPool::Generation(slot);
+    EXPECT_NE(0U, generation);
+    UnitPool::Release(slot, 200);
+    EXPECT_NE(generation, UnitPool::Generation(slot));
+    UnitPool::Reclaim();
+}
+
+TEST(UnitPool, ReleasedSlotsWaitForReclaim) {
+    void *first = UnitPool::Allocate(312);
+    UnitPool::Release(first, 312);
+    void *second = UnitPool::Allocate(312);
+    EXPECT_NE(first, second);
+    UnitPool::Release(second, 312);
+    UnitPool::Reclaim();
+    void *third = UnitPool::Allocate(312);
+    EXPECT_TRUE(third == first || third == second);
+    UnitPool::Release(third, 312);
+    UnitPool::Reclaim();
+}
+
+TEST(UnitPool, SizesAreSegregated) {
+    void *small = UnitPool::Allocate(100);
+    UnitPool::Release(small, 100);
+    UnitPool::Reclaim();
+    void *large = UnitPool::Allocate(4000);
+    EXPECT_NE(small, large);
+    UnitPool::Release(large, 4000);
+    UnitPool::Reclaim();
+}
+
+TEST(UnitPool, ForeignPointersHaveNoGeneration) {
+    alignas(16) static char buffer[64] = {};
+    EXPECT_EQ(0U, UnitPool::Generation(buffer + 32));
+    EXPECT_EQ(0U, UnitPool::Generation(nullptr));
+}
+
+TEST(UnitPool, InteriorPointersHaveNoGeneration) {
+    char *slot = static_cast<char *>(UnitPool::Allocate(256));
+    EXPECT_NE(0U, UnitPool::Generation(slot));
+    EXPECT_EQ(0U, UnitPool::Generation(slot + 16));
+    UnitPool::Release(slot, 256);
+    UnitPool::Reclaim();
+}
+
+TEST(UnitPool, GenerationWordFollowsTheSlot) {
+    void *slot = UnitPool::Allocate(200);
+    const uint32_t *word = UnitPool::GenerationWord(slot);
+    const uint32_t generation = *word;
+    EXPECT_EQ(generation, UnitPool::Generation(slot));
+    UnitPool::Release(slot, 200);
+    //the same word sees the slot die without looking it up again
+    EXPECT_NE(generation, *word);
+    EXPECT_EQ(UnitPool::Generation(slot), *word);
+    UnitPool::Reclaim();
+    alignas(16) static char buffer[64] = {};
+    EXPECT_EQ(0U, *UnitPool::GenerationWord(buffer + 32));
+    EXPECT_EQ(0U, *UnitPool::GenerationWord(nullptr));
+}
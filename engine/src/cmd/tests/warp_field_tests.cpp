@@ -0,0 +1,132 @@
+/*
+ * warp_field_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "cmd/warp_field.h"
+
+//the units are only keys to the service, so any distinct addresses will do
+static Unit *FakeUnit(int i) {
+    static char units[64];
+    return reinterpret_cast<Unit *>(&units[i]);
+}
+
+static size_t BruteForceNearest(const std::vector<WarpFieldService::Well> &planets, const QVector &position) {
+    size_t best = 0;
+    for (size_t i = 1; i < planets.size(); ++i) {
+        if ((position - planets[i].center).Magnitude() - planets[i].reach
+                < (position - planets[best].center).Magnitude() - planets[best].reach) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+TEST(WarpFieldService, NearestWellFollowsTheUnit) {
+    WarpFieldService service;
+    std::vector<WarpFieldService::Well> planets = {
+            {FakeUnit(0), 1, QVector(0, 0, 0), 100},
+            {FakeUnit(1), 1, QVector(10000, 0, 0), 100},
+    };
+    service.UpdateWells(planets);
+    const Unit *ship = FakeUnit(10);
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, QVector(1000, 0, 0)), 0U);
+    //a short hop answers from the cache, crossing the midpoint does not
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, QVector(1100, 0, 0)), 0U);
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, QVector(5100, 0, 0)), 1U);
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, QVector(4900, 0, 0)), 0U);
+}
+
+TEST(WarpFieldService, NearestWellFollowsDriftingPlanets) {
+    WarpFieldService service;
+    std::vector<WarpFieldService::Well> planets = {
+            {FakeUnit(0), 1, QVector(0, 0, 0), 100},
+            {FakeUnit(1), 1, QVector(10000, 0, 0), 100},
+    };
+    service.UpdateWells(planets);
+    const Unit *ship = FakeUnit(10);
+    const QVector parked(3000, 0, 0);
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, parked), 0U);
+    //the second planet swings in toward the parked ship, a bit every atom
+    for (int atom = 0; atom < 60; ++atom) {
+        planets[1].center.i -= 100;
+        service.UpdateWells(planets);
+        EXPECT_EQ(service.NearestWellIndex(ship, 1, parked), BruteForceNearest(planets, parked)) << atom;
+    }
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, parked), 1U);
+}
+
+TEST(WarpFieldService, ReplacedPlanetsAndUnitsAreLookedUpAgain) {
+    WarpFieldService service;
+    std::vector<WarpFieldService::Well> planets = {
+            {FakeUnit(0), 1, QVector(0, 0, 0), 100},
+            {FakeUnit(1), 1, QVector(10000, 0, 0), 100},
+    };
+    service.UpdateWells(planets);
+    const Unit *ship = FakeUnit(10);
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, QVector(4000, 0, 0)), 0U);
+    //the far planet is destroyed and something much bigger takes its slot
+    planets[1].generation = 2;
+    planets[1].reach = 8000;
+    service.UpdateWells(planets);
+    EXPECT_EQ(service.NearestWellIndex(ship, 1, QVector(4000, 0, 0)), 1U);
+    //a new unit in the ship's old slot does not get the ship's answer
+    planets.pop_back();
+    service.UpdateWells(planets);
+    EXPECT_EQ(service.NearestWellIndex(ship, 2, QVector(4000, 0, 0)), 0U);
+}
+
+TEST(WarpFieldService, CachedAnswersMatchBruteForce) {
+    std::mt19937 random(49);
+    std::uniform_real_distribution<double> coordinate(-1.0e6, 1.0e6);
+    std::uniform_real_distribution<double> reach(1.0e3, 5.0e4);
+    std::uniform_real_distribution<double> step(-2.0e3, 2.0e3);
+    std::vector<WarpFieldService::Well> planets;
+    for (int i = 0; i < 40; ++i) {
+        planets.push_back({FakeUnit(i), 1, QVector(coordinate(random), coordinate(random), 0), reach(random)});
+    }
+    std::vector<QVector> ships;
+    for (int i = 0; i < 8; ++i) {
+        ships.push_back(QVector(coordinate(random), coordinate(random), 0));
+    }
+    WarpFieldService service;
+    for (int atom = 0; atom < 2000; ++atom) {
+        for (WarpFieldService::Well &planet : planets) {
+            planet.center.i += step(random) * 0.1;
+            planet.center.j += step(random) * 0.1;
+        }
+        service.UpdateWells(planets);
+        for (size_t i = 0; i < ships.size(); ++i) {
+            ships[i].i += step(random) * 10;
+            ships[i].j += step(random) * 10;
+            const size_t nearest = service.NearestWellIndex(FakeUnit(40 + static_cast<int>(i)), 1, ships[i]);
+            ASSERT_EQ(nearest, BruteForceNearest(planets, ships[i])) << "atom " << atom << " ship " << i;
+        }
+    }
+}
@@ -74,6 +74,7 @@ bool isCloseEnoughToDock(const Unit *my_unit, const Unit *un);
 bool isCapitalShip(const Unit *my_unit);
 bool isDockableUnit(const Unit *my_unit);
 bool isAsteroid(const Unit *my_unit);
+bool hasDockingUnits(const Unit *my_unit);
 bool isSun(const Unit *my_unit);
 void switchFg(Unit *my_unit, string arg);
 int communicateTo(Unit *my_unit, Unit *other_unit, float mood);
@@ -2557,6 +2557,12 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 ai.pirate_nav_select_time_flt = boost::json::value_to<float>(*pirate_nav_select_time_value_ptr);
             }
 
+            const boost::json::value * python_think_interval_value_ptr = ai_object.if_contains("python_think_interval");
+            if (python_think_interval_value_ptr != nullptr) {
+                ai.python_think_interval_dbl = boost::json::value_to<double>(*python_think_interval_value_ptr);
+                ai.python_think_interval_flt = boost::json::value_to<float>(*python_think_interval_value_ptr);
+            }
+
             const boost::json::value * random_response_range_value_ptr = ai_object.if_contains("random_response_range");
             if (random_response_range_value_ptr != nullptr) {
                 ai.random_response_range_dbl = boost::json::value_to<double>(*random_response_range_value_ptr);
@@ -5427,6 +5433,16 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 graphics.num_times_to_draw_shine = boost::json::value_to<int>(*num_times_to_draw_shine_value_ptr);
             }
 
+            const boost::json::value * occlusion_raster_height_value_ptr = graphics_object.if_contains("occlusion_raster_height");
+            if (occlusion_raster_height_value_ptr != nullptr) {
+                graphics.occlusion_raster_height = boost::json::value_to<int>(*occlusion_raster_height_value_ptr);
+            }
+
+            const boost::json::value * occlusion_raster_width_value_ptr = graphics_object.if_contains("occlusion_raster_width");
+            if (occlusion_raster_width_value_ptr != nullptr) {
+                graphics.occlusion_raster_width = boost::json::value_to<int>(*occlusion_raster_width_value_ptr);
+            }
+
             const boost::json::value * offset_sprites_by_pos_value_ptr = graphics_object.if_contains("offset_sprites_by_pos");
             if (offset_sprites_by_pos_value_ptr != nullptr) {
                 graphics.offset_sprites_by_pos = boost::json::value_to<bool>(*offset_sprites_by_pos_value_ptr);
@@ -5724,6 +5740,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 graphics.star_allowable_sectors = boost::json::value_to<std::string>(*star_allowable_sectors_value_ptr);
             }
 
+            const boost::json::value * star_cache_systems_value_ptr = graphics_object.if_contains("star_cache_systems");
+            if (star_cache_systems_value_ptr != nullptr) {
+                graphics.star_cache_systems = boost::json::value_to<int>(*star_cache_systems_value_ptr);
+            }
+
             const boost::json::value * star_blend_value_ptr = graphics_object.if_contains("star_blend");
             if (star_blend_value_ptr != nullptr) {
                 graphics.star_blend = boost::json::value_to<bool>(*star_blend_value_ptr);
@@ -5869,6 +5890,21 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 graphics.texture = boost::json::value_to<std::string>(*texture_value_ptr);
             }
 
+            const boost::json::value * texture_budget_mb_value_ptr = graphics_object.if_contains("texture_budget_mb");
+            if (texture_budget_mb_value_ptr != nullptr) {
+                graphics.texture_budget_mb = boost::json::value_to<int>(*texture_budget_mb_value_ptr);
+            }
+
+            const boost::json::value * texture_idle_frames_value_ptr = graphics_object.if_contains("texture_idle_frames");
+            if (texture_idle_frames_value_ptr != nullptr) {
+                graphics.texture_idle_frames = boost::json::value_to<int>(*texture_idle_frames_value_ptr);
+            }
+
+            const boost::json::value * texture_transfers_per_frame_value_ptr = graphics_object.if_contains("texture_transfers_per_frame");
+            if (texture_transfers_per_frame_value_ptr != nullptr) {
+                graphics.texture_transfers_per_frame = boost::json::value_to<int>(*texture_transfers_per_frame_value_ptr);
+            }
+
             const boost::json::value * texture_compression_value_ptr = graphics_object.if_contains("texture_compression");
             if (texture_compression_value_ptr != nullptr) {
                 graphics.texture_compression = boost::json::value_to<int>(*texture_compression_value_ptr);
@@ -7106,6 +7142,18 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.asteroid_difficulty_flt = boost::json::value_to<float>(*asteroid_difficulty_value_ptr);
             }
 
+            const boost::json::value * asteroid_promotion_distance_value_ptr = physics_object.if_contains("asteroid_promotion_distance");
+            if (asteroid_promotion_distance_value_ptr != nullptr) {
+                physics.asteroid_promotion_distance_dbl = boost::json::value_to<double>(*asteroid_promotion_distance_value_ptr);
+                physics.asteroid_promotion_distance_flt = boost::json::value_to<float>(*asteroid_promotion_distance_value_ptr);
+            }
+
+            const boost::json::value * asteroid_promotion_scan_interval_value_ptr = physics_object.if_contains("asteroid_promotion_scan_interval");
+            if (asteroid_promotion_scan_interval_value_ptr != nullptr) {
+                physics.asteroid_promotion_scan_interval_dbl = boost::json::value_to<double>(*asteroid_promotion_scan_interval_value_ptr);
+                physics.asteroid_promotion_scan_interval_flt = boost::json::value_to<float>(*asteroid_promotion_scan_interval_value_ptr);
+            }
+
             const boost::json::value * asteroid_weapon_collision_value_ptr = physics_object.if_contains("asteroid_weapon_collision");
             if (asteroid_weapon_collision_value_ptr != nullptr) {
                 physics.asteroid_weapon_collision = boost::json::value_to<bool>(*asteroid_weapon_collision_value_ptr);
@@ -7246,6 +7294,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.autotracking_flt = boost::json::value_to<float>(*autotracking_value_ptr);
             }
 
+            const boost::json::value * batched_integration_value_ptr = physics_object.if_contains("batched_integration");
+            if (batched_integration_value_ptr != nullptr) {
+                physics.batched_integration = boost::json::value_to<bool>(*batched_integration_value_ptr);
+            }
+
             const boost::json::value * can_auto_through_planets_value_ptr = physics_object.if_contains("can_auto_through_planets");
             if (can_auto_through_planets_value_ptr != nullptr) {
                 physics.can_auto_through_planets = boost::json::value_to<bool>(*can_auto_through_planets_value_ptr);
@@ -7289,6 +7342,17 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.collidemap_sanity_check = boost::json::value_to<bool>(*collidemap_sanity_check_value_ptr);
             }
 
+            const boost::json::value * collision_coherence_max_idle_frames_value_ptr = physics_object.if_contains("collision_coherence_max_idle_frames");
+            if (collision_coherence_max_idle_frames_value_ptr != nullptr) {
+                physics.collision_coherence_max_idle_frames = boost::json::value_to<int>(*collision_coherence_max_idle_frames_value_ptr);
+            }
+
+            const boost::json::value * collision_coherence_tolerance_value_ptr = physics_object.if_contains("collision_coherence_tolerance");
+            if (collision_coherence_tolerance_value_ptr != nullptr) {
+                physics.collision_coherence_tolerance_dbl = boost::json::value_to<double>(*collision_coherence_tolerance_value_ptr);
+                physics.collision_coherence_tolerance_flt = boost::json::value_to<float>(*collision_coherence_tolerance_value_ptr);
+            }
+
             const boost::json::value * collision_inertial_time_value_ptr = physics_object.if_contains("collision_inertial_time");
             if (collision_inertial_time_value_ptr != nullptr) {
                 physics.collision_inertial_time_dbl = boost::json::value_to<double>(*collision_inertial_time_value_ptr);
@@ -7301,6 +7365,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.collision_scale_factor_flt = boost::json::value_to<float>(*collision_scale_factor_value_ptr);
             }
 
+            const boost::json::value * collision_tree_cache_value_ptr = physics_object.if_contains("collision_tree_cache");
+            if (collision_tree_cache_value_ptr != nullptr) {
+                physics.collision_tree_cache = boost::json::value_to<bool>(*collision_tree_cache_value_ptr);
+            }
+
             const boost::json::value * component_based_upgrades_value_ptr = physics_object.if_contains("component_based_upgrades");
             if (component_based_upgrades_value_ptr != nullptr) {
                 physics.component_based_upgrades = boost::json::value_to<bool>(*component_based_upgrades_value_ptr);
@@ -7615,6 +7684,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.launch_speed_flt = boost::json::value_to<float>(*launch_speed_value_ptr);
             }
 
+            const boost::json::value * lightweight_asteroid_fields_value_ptr = physics_object.if_contains("lightweight_asteroid_fields");
+            if (lightweight_asteroid_fields_value_ptr != nullptr) {
+                physics.lightweight_asteroid_fields = boost::json::value_to<bool>(*lightweight_asteroid_fields_value_ptr);
+            }
+
             const boost::json::value * lock_cone_value_ptr = physics_object.if_contains("lock_cone");
             if (lock_cone_value_ptr != nullptr) {
                 physics.lock_cone_dbl = boost::json::value_to<double>(*lock_cone_value_ptr);
@@ -7865,6 +7939,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.orbit_averaging_flt = boost::json::value_to<float>(*orbit_averaging_value_ptr);
             }
 
+            const boost::json::value * orbit_rails_value_ptr = physics_object.if_contains("orbit_rails");
+            if (orbit_rails_value_ptr != nullptr) {
+                physics.orbit_rails = boost::json::value_to<bool>(*orbit_rails_value_ptr);
+            }
+
             const boost::json::value * out_of_arc_fire_disrupts_lock_value_ptr = physics_object.if_contains("out_of_arc_fire_disrupts_lock");
             if (out_of_arc_fire_disrupts_lock_value_ptr != nullptr) {
                 physics.out_of_arc_fire_disrupts_lock = boost::json::value_to<bool>(*out_of_arc_fire_disrupts_lock_value_ptr);
@@ -8125,6 +8204,11 @@ void vega_config::Configuration::load_config(const std::string& json_text) {
                 physics.velocity_max_flt = boost::json::value_to<float>(*velocity_max_value_ptr);
             }
 
+            const boost::json::value * warp_all_wells_value_ptr = physics_object.if_contains("warp_all_wells");
+            if (warp_all_wells_value_ptr != nullptr) {
+                physics.warp_all_wells = boost::json::value_to<bool>(*warp_all_wells_value_ptr);
+            }
+
             const boost::json::value * warp_behind_angle_value_ptr = physics_object.if_contains("warp_behind_angle");
             if (warp_behind_angle_value_ptr != nullptr) {
                 physics.warp_behind_angle_dbl = boost::json::value_to<double>(*warp_behind_angle_value_ptr);
@@ -984,6 +984,8 @@ namespace vega_config {
         float pirate_bonus_for_empty_hold_flt = 0.75;
         double pirate_nav_select_time_dbl = 400.0;
         float pirate_nav_select_time_flt = 400.0;
+        double python_think_interval_dbl = 0.0;
+        float python_think_interval_flt = 0.0;
         double random_response_range_dbl = 0.8;
         float random_response_range_flt = 0.8;
         double random_spacing_factor_dbl = 4.0;
@@ -1804,6 +1806,8 @@ namespace vega_config {
         int num_messages = 10;
         int num_near_stars = 1000;
         int num_times_to_draw_shine = 2;
+        int occlusion_raster_height = 64;
+        int occlusion_raster_width = 128;
         bool offset_sprites_by_pos = true;
         bool only_scanner_modes_static = true;
         bool only_stretch_in_warp = true;
@@ -1877,6 +1881,7 @@ namespace vega_config {
         std::string splash_screen = "load_splash.ani";
         bool split_dead_subunits = true;
         std::string star_allowable_sectors = "Vega Sol";
+        int star_cache_systems = 4;
         bool star_blend = true;
         double star_color_average_dbl = 0.6;
         float star_color_average_flt = 0.6;
@@ -1918,6 +1923,9 @@ namespace vega_config {
         double text_speed_dbl = 0.025;
         float text_speed_flt = 0.025;
         std::string texture = "supernova.bmp";
+        int texture_budget_mb = 1024;
+        int texture_idle_frames = 1800;
+        int texture_transfers_per_frame = 2;
         int texture_compression = 0;
         double torque_star_streak_scale_dbl = 1.0;
         float torque_star_streak_scale_flt = 1.0;
@@ -2255,6 +2263,10 @@ namespace vega_config {
         bool allow_special_and_normal_gun_combo = true;
         double asteroid_difficulty_dbl = 0.1;
         float asteroid_difficulty_flt = 0.1;
+        double asteroid_promotion_distance_dbl = 500.0;
+        float asteroid_promotion_distance_flt = 500.0;
+        double asteroid_promotion_scan_interval_dbl = 0.5;
+        float asteroid_promotion_scan_interval_flt = 0.5;
         bool asteroid_weapon_collision = false;
         double auto_docking_speed_boost_dbl = 20.0;
         float auto_docking_speed_boost_flt = 20.0;
@@ -2295,6 +2307,7 @@ namespace vega_config {
         bool automatic_undock = true;
         double autotracking_dbl = 0.93;
         float autotracking_flt = 0.93;
+        bool batched_integration = true;
         bool can_auto_through_planets = true;
         double capship_size_dbl = 500.0;
         float capship_size_flt = 500.0;
@@ -2306,10 +2319,14 @@ namespace vega_config {
         double close_enough_to_autotrack_dbl = 4.0;
         float close_enough_to_autotrack_flt = 4.0;
         bool collidemap_sanity_check = false;
+        int collision_coherence_max_idle_frames = 8;
+        double collision_coherence_tolerance_dbl = 0.01;
+        float collision_coherence_tolerance_flt = 0.01;
         double collision_inertial_time_dbl = 1.25;
         float collision_inertial_time_flt = 1.25;
         double collision_scale_factor_dbl = 1.0;
         float collision_scale_factor_flt = 1.0;
+        bool collision_tree_cache = true;
         bool component_based_upgrades = true;
         double computer_warp_ramp_up_time_dbl = 10.0;
         float computer_warp_ramp_up_time_flt = 10.0;
@@ -2400,6 +2417,7 @@ namespace vega_config {
         bool jump_weapon_collision = false;
         double launch_speed_dbl = -1.0;
         float launch_speed_flt = -1.0;
+        bool lightweight_asteroid_fields = true;
         double lock_cone_dbl = 0.8;
         float lock_cone_flt = 0.8;
         bool match_speed_with_target = true;
@@ -2474,6 +2492,7 @@ namespace vega_config {
         bool only_show_best_downgrade = true;
         double orbit_averaging_dbl = 16.0;
         float orbit_averaging_flt = 16.0;
+        bool orbit_rails = true;
         bool out_of_arc_fire_disrupts_lock = false;
         double percent_missile_match_target_velocity_dbl = 1.0;
         float percent_missile_match_target_velocity_flt = 1.0;
@@ -2546,6 +2565,7 @@ namespace vega_config {
         bool use_max_shield_energy_usage = false;
         double velocity_max_dbl = 10000.0;
         float velocity_max_flt = 10000.0;
+        bool warp_all_wells = false;
         double warp_behind_angle_dbl = 150.0;
         float warp_behind_angle_flt = 150.0;
         double warp_cruise_mult_dbl = 15000.0;
@@ -39,11 +39,12 @@
 #include "root_generic/vs_globals.h"
 #include "root_generic/vega_random.h"
 #include "gldrv/gl_globals.h"
-#include <set>
 #include <cmath>
 
-using std::set;
-static set<AnimatedTexture *> anis;
+//the shared clock of running animations
+static AnimationClock ani_clock;
+//running animations timed by a sound source, the only ones needing per frame work
+static std::vector<AnimatedTexture *> timed_anis;
 
 static inline unsigned int intmin(unsigned int a, unsigned int b) {
     return a < b ? a : b;
@@ -75,6 +76,12 @@ static void ActivateWhite(int stage) {
 }
 
 void AnimatedTexture::MakeActive(int stage, int pass) {
+    drawn_frame = ani_clock.frame;
+    if (timed_index >= 0 && synced_frame != ani_clock.frame) {
+        //not drawn last frame, so UpdateAllFrame skipped it
+        SyncTimeSource(realTime());
+    }
+    double curtime = curTime();
     // Set active frame and texture coordinates
     if (timeperframe && !vidSource) {
         unsigned int numframes = numFrames();
@@ -237,54 +244,79 @@ bool AnimatedTexture::SetupPass(int pass, int stage, const enum BLENDFUNC src, c
     }
 }
 
-void AnimatedTexture::UpdateAllPhysics() {
-    for (set<AnimatedTexture *>::iterator iter = anis.begin(); iter != anis.end(); iter++) {
-        (*iter)->physicsactive -= SIMULATION_ATOM;
-    }                      // simulation_atom_var?
+void AnimatedTexture::StartClock() {
+    anitime.Start(ani_clock);
+    UpdateTimedSet();
+}
+
+void AnimatedTexture::StopClock() {
+    anitime.Stop(ani_clock);
+    UpdateTimedSet();
+}
+
+void AnimatedTexture::UpdateTimedSet() {
+    const bool timed = anitime.Running() && (options & optSoundTiming);
+    if (timed && timed_index < 0) {
+        timed_index = timed_anis.size();
+        timed_anis.push_back(this);
+    } else if (!timed && timed_index >= 0) {
+        timed_anis[timed_index] = timed_anis.back();
+        timed_anis[timed_index]->timed_index = timed_index;
+        timed_anis.pop_back();
+        timed_index = -1;
+    }
+}
+
+void AnimatedTexture::SyncTimeSource(double realtime) {
+    synced_frame = ani_clock.frame;
+    // lazy init
+    if (lastrealtime == 0) {
+        lastrealtime = realtime;
+    }
+
+    // de-jitter, playtime reporting tends to have some jitter
+    double newcurtime = GetTimeSource()->getPlayingTime();
+    double delta = realtime - lastrealtime;
+    double drift = newcurtime - lastcurtime - delta;
+    if (fabs(drift) > 4.0) {
+        lastcurtime = newcurtime - delta;
+        lastrealtime = realtime;
+    } else if (drift > 0.2 || drift < -1.0) {
+        //  ^ asymmetric threshold because we don't want to skip back often
+        double catchup = drift * ((delta > 0.5) ? 0.5 : delta);
+        lastcurtime += catchup;
+        lastrealtime = realtime;
+    }
+    setTime(lastcurtime + delta);
 }
 
 void AnimatedTexture::UpdateAllFrame() {
-    double elapsed = GetElapsedTime();
+    ani_clock.Advance(GetElapsedTime());
     double realtime = realTime();
-    for (set<AnimatedTexture *>::iterator iter = anis.begin(); iter != anis.end(); iter++) {
-        AnimatedTexture *ani = *iter;
-        if (ani->options & optSoundTiming) {
-            // lazy init
-            if (ani->lastrealtime == 0) {
-                ani->lastrealtime = realtime;
-            }
-
-            // de-jitter, playtime reporting tends to have some jitter
-            double newcurtime = ani->GetTimeSource()->getPlayingTime();
-            double delta = realtime - ani->lastrealtime;
-            double drift = newcurtime - ani->lastcurtime - delta;
-            if (fabs(drift) > 4.0) {
-                ani->lastcurtime = newcurtime - delta;
-                ani->lastrealtime = realtime;
-            } else if (drift > 0.2 || drift < -1.0) {
-                //  ^ asymmetric threshold because we don't want to skip back often
-                double catchup = drift * ((delta > 0.5) ? 0.5 : delta);
-                ani->lastcurtime += catchup;
-                ani->lastrealtime = realtime;
-            }
-            ani->setTime(ani->lastcurtime + delta);
-        } else {
-            ani->setTime(ani->curTime() + elapsed);
+    for (size_t i = 0; i < timed_anis.size(); ++i) {
+        AnimatedTexture *ani = timed_anis[i];
+        //sound timed animations off screen catch up when next made active
+        if (ani_clock.DrawnLastFrame(ani->drawn_frame)) {
+            ani->SyncTimeSource(realtime);
         }
     }
 }
 
+double AnimatedTexture::curTime() const {
+    return anitime.Time(ani_clock);
+}
+
 bool AnimatedTexture::Done() const {
     //return physicsactive<0;
     //Explosions aren't working right, and this would fix them.
     //I don't see the reason for using physics frames as reference, all AnimatedTextures
     //I've seen are gaphic-only entities (bolts use their own time-keeping system, for instance)
     //If I'm wrong, and the above line is crucial, well... feel free to fix it.
-    return vidSource ? done : curtime >= numframes * timeperframe;
+    return vidSource ? done : curTime() >= numframes * timeperframe;
 }
 
 void AnimatedTexture::setTime(double tim) {
-    curtime = tim;
+    anitime.Set(ani_clock, tim);
 }
 
 using namespace VSFileSystem;
@@ -317,8 +349,10 @@ void AnimatedTexture::AniInit() {
 
     Decal = NULL;
     activebound = -1;
-    physicsactive = 0;
     loadSuccess = false;
+    anitime = AnimationTime();
+    timed_index = -1;
+    drawn_frame = synced_frame = 0;
     vidMode = false;
     detailTex = false;
     ismipmapped = BILINEAR;
@@ -334,7 +368,7 @@ void AnimatedTexture::AniInit() {
     active = 0;
     nextactive = 0;
     active_fraction = 0;
-    curtime = lastcurtime = lastrealtime = 0;
+    lastcurtime = lastrealtime = 0;
     constframerate = true;
     done = false;
 }
@@ -364,15 +398,18 @@ const Texture *AnimatedTexture::Original() const {
 
 Texture *AnimatedTexture::Clone() {
     AnimatedTexture *retval = new AnimatedTexture();
-    if (Decal) {
+    if (Decal || vidSource) {
         *retval = *this;
+        //the copy starts out stopped, at this animation's time
+        retval->anitime.Stop(ani_clock);
+        retval->timed_index = -1;
+    }
+    if (Decal) {
         int nf = vidMode ? 1 : numframes;
         retval->Decal = new Texture *[nf];
         for (int i = 0; i < nf; i++) {
             retval->Decal[i] = Decal[i]->Clone();
         }
-    } else if (vidSource) {
-        *retval = *this;
     }
     if (vidSource) {
         retval->name = -1;
@@ -381,8 +418,8 @@ Texture *AnimatedTexture::Clone() {
         f.OpenReadOnly(wrapper_file_path, wrapper_file_type);
         retval->LoadVideoSource(f);
     } else if (Decal) {
-        //LoadVideoSource adds to anis, otherwise we'll have to add ourselves
-        anis.insert(retval);
+        //LoadVideoSource starts the clock, otherwise we'll have to start it ourselves
+        retval->StartClock();
     }
     return retval;
 }
@@ -399,7 +436,7 @@ AnimatedTexture::AnimatedTexture() {
 }
 
 void AnimatedTexture::Destroy() {
-    anis.erase(this);
+    StopClock();
     if (vidSource) {
         delete vidSource;
         vidSource = nullptr;
@@ -415,11 +452,10 @@ void AnimatedTexture::Destroy() {
 }
 
 void AnimatedTexture::Reset() {
-    curtime = 0;
+    AnimatedTexture::setTime(0);
     active = 0;
     activebound = -1;
     img_sides = SIDE_SINGLE;
-    physicsactive = numframes * timeperframe;
     done = false;
 }
 
@@ -439,7 +475,7 @@ static void alltrim(char *_str) {
 }
 
 void AnimatedTexture::Load(VSFileSystem::VSFile &f, int stage, enum FILTER ismipmapped, bool detailtex) {
-    curtime = 0;
+    AnimatedTexture::setTime(0);
     frames.clear();
     frames_maxtc.clear();
     frames_mintc.clear();
@@ -463,9 +499,9 @@ void AnimatedTexture::LoadVideoSource(VSFileSystem::VSFile &f) {
         vidSource = new ::VidFile();
         vidSource->open(wrapper_file_path, configuration().graphics.max_movie_dimension, configuration().graphics.pot_video_textures);
 
-        physicsactive = vidSource->getDuration();
+        double duration = vidSource->getDuration();
         timeperframe = 1.0 / vidSource->getFrameRate();
-        numframes = (unsigned int) (physicsactive * timeperframe);
+        numframes = (unsigned int) (duration * timeperframe);
 
         loadSuccess = true;
     }
@@ -496,7 +532,7 @@ void AnimatedTexture::LoadVideoSource(VSFileSystem::VSFile &f) {
             mintcoord.y /= sizeY;
         }
 
-        anis.insert(this);
+        StartClock();
     }
 }
 
@@ -667,10 +703,10 @@ void AnimatedTexture::LoadAni(VSFileSystem::VSFile &f, int stage, enum FILTER is
     original = NULL;
     loadSuccess = true;
 
-    anis.insert(this);
+    StartClock();
 
     //Needed - must do housekeeping, tcoord stuff and the like.
-    setTime(curtime);
+    setTime(curTime());
 }
 
 void AnimatedTexture::LoadFrame(int frame) {
@@ -773,9 +809,11 @@ void AnimatedTexture::SetTimeSource(SharedPtr<Audio::Source> source) {
     } else {
         options &= ~optSoundTiming;
     }
+    UpdateTimedSet();
 }
 
 void AnimatedTexture::ClearTimeSource() {
     timeSource.reset();
     options &= ~optSoundTiming;
+    UpdateTimedSet();
 }
@@ -38,15 +38,35 @@
 
 #include "audio/Types.h"
 #include "audio/Source.h"
+#include "gfx/animation_clock.h"
 
+/**
+ * A texture cycling through frames, or playing a video.
+ *
+ * Loaded animations run on one shared animation clock: they only remember
+ * the clock reading their time started at, so advancing every animation is
+ * a single addition and the current frame is worked out when drawn. Only
+ * the animations timed by a sound source need per frame work, and they are
+ * kept in their own list and skipped while not drawn.
+ */
 class AnimatedTexture : public Texture {
     Texture **Decal;
     unsigned int activebound; //For video mode
-    double physicsactive;
     bool loadSuccess;
 
     void AniInit();
 
+    //Animation clock
+    AnimationTime anitime;
+    int timed_index; //position in the sound timed list, -1 if not in it
+    unsigned int drawn_frame; //clock frame this was last made active in
+    unsigned int synced_frame; //clock frame the sound time was last read in
+
+    void StartClock();
+    void StopClock();
+    void UpdateTimedSet();
+    void SyncTimeSource(double realtime);
+
     //For video mode
     bool vidMode;
     bool detailTex;
@@ -83,7 +103,6 @@ protected:
     unsigned int active;
     unsigned int nextactive; //It is computable, but it's much more convenient this way
     float active_fraction; //For interpolated animations
-    double curtime;
 
     // for video de-jittering
     double lastcurtime;
@@ -95,9 +114,7 @@ protected:
 public:
     void setTime(double tim) override;
 
-    double curTime() const override {
-        return curtime;
-    }
+    double curTime() const override;
 
     unsigned int numFrames() const override {
         return numframes;
@@ -201,8 +218,7 @@ public:
 
     void ClearTimeSource();
 
-    static void UpdateAllPhysics();
-
+    ///advances the clock of every running animation by the frame's elapsed time
     static void UpdateAllFrame();
 
     //resets the animation to beginning
@@ -380,15 +380,14 @@ void Animation::DrawAsVSSprite(VSSprite *spr) {
     }
 }
 
-void Animation::DrawNoTransform(bool cross, bool blendoption) {
+template<typename DRAW>
+void Animation::DrawPasses(bool blendoption, DRAW draw) {
     if (g_game.use_animations == 0 && g_game.use_textures == 0) {
     } else if (!Done() || (options & ani_repeat)) {
         size_t lyr;
         size_t numlayers = numLayers();
         bool multitex = (numlayers > 1);
         size_t numpasses = numPasses();
-        float ms = mintcoord.i, Ms = maxtcoord.i;
-        float mt = mintcoord.j, Mt = maxtcoord.j;
         if (blendoption) {
             if (options & ani_alpha) {
                 GFXEnable(DEPTHWRITE);
@@ -409,44 +408,7 @@ void Animation::DrawNoTransform(bool cross, bool blendoption) {
             if (SetupPass(pass, 0, src, dst)) {
                 MakeActive(0, pass);
                 GFXTextureEnv(0, GFXMODULATETEXTURE);
-                int vnum = cross ? 12 : 4;
-                if (!multitex) {
-                    const float verts[12 * (3 + 2)] = {
-                            -width, -height, 0.0f, ms, Mt,    //lower left
-                            width, -height, 0.0f, Ms, Mt,    //upper left
-                            width, height, 0.0f, Ms, mt,    //upper right
-                            -width, height, 0.0f, ms, mt,    //lower right
-
-                            -width, 0.0f, -height, ms, Mt,    //lower left
-                            width, 0.0f, -height, Ms, Mt,    //upper left
-                            width, 0.0f, height, Ms, mt,    //upper right
-                            -width, 0.0f, height, ms, mt,    //lower right
-
-                            0.0f, -height, -height, ms, Mt,    //lower left
-                            0.0f, height, -height, Ms, Mt,    //upper left
-                            0.0f, height, height, Ms, mt,    //upper right
-                            0.0f, -height, height, ms, mt,    //lower right
-                    };
-                    GFXDraw(GFXQUAD, verts, vnum, 3, 0, 2);
-                } else {
-                    const float verts[12 * (3 + 4)] = {
-                            -width, -height, 0.0f, ms, Mt, ms, Mt,
-                            width, -height, 0.0f, Ms, Mt, Ms, Mt,
-                            width, height, 0.0f, Ms, mt, Ms, mt,
-                            -width, height, 0.0f, ms, mt, ms, mt,
-
-                            -width, 0.0f, -height, ms, Mt, ms, Mt,
-                            width, 0.0f, -height, Ms, Mt, Ms, Mt,
-                            width, 0.0f, height, Ms, mt, Ms, mt,
-                            -width, 0.0f, height, ms, mt, ms, mt,
-
-                            0.0f, -height, -height, ms, Mt, ms, Mt,
-                            0.0f, height, -height, Ms, Mt, Ms, Mt,
-                            0.0f, height, height, Ms, mt, Ms, mt,
-                            0.0f, -height, height, ms, mt, ms, mt,
-                    };
-                    GFXDraw(GFXQUAD, verts, vnum, 3, 0, 2, 2);
-                }
+                draw(multitex);
             }
         }
         SetupPass(-1, 0, src, dst);
@@ -461,6 +423,62 @@ void Animation::DrawNoTransform(bool cross, bool blendoption) {
     }
 }
 
+void Animation::DrawNoTransform(bool cross, bool blendoption) {
+    const float ms = mintcoord.i, Ms = maxtcoord.i;
+    const float mt = mintcoord.j, Mt = maxtcoord.j;
+    const float width = this->width, height = this->height;
+    DrawPasses(blendoption, [&](bool multitex) {
+        int vnum = cross ? 12 : 4;
+        if (!multitex) {
+            const float verts[12 * (3 + 2)] = {
+                    -width, -height, 0.0f, ms, Mt,    //lower left
+                    width, -height, 0.0f, Ms, Mt,    //upper left
+                    width, height, 0.0f, Ms, mt,    //upper right
+                    -width, height, 0.0f, ms, mt,    //lower right
+
+                    -width, 0.0f, -height, ms, Mt,    //lower left
+                    width, 0.0f, -height, Ms, Mt,    //upper left
+                    width, 0.0f, height, Ms, mt,    //upper right
+                    -width, 0.0f, height, ms, mt,    //lower right
+
+                    0.0f, -height, -height, ms, Mt,    //lower left
+                    0.0f, height, -height, Ms, Mt,    //upper left
+                    0.0f, height, height, Ms, mt,    //upper right
+                    0.0f, -height, height, ms, mt,    //lower right
+            };
+            GFXDraw(GFXQUAD, verts, vnum, 3, 0, 2);
+        } else {
+            const float verts[12 * (3 + 4)] = {
+                    -width, -height, 0.0f, ms, Mt, ms, Mt,
+                    width, -height, 0.0f, Ms, Mt, Ms, Mt,
+                    width, height, 0.0f, Ms, mt, Ms, mt,
+                    -width, height, 0.0f, ms, mt, ms, mt,
+
+                    -width, 0.0f, -height, ms, Mt, ms, Mt,
+                    width, 0.0f, -height, Ms, Mt, Ms, Mt,
+                    width, 0.0f, height, Ms, mt, Ms, mt,
+                    -width, 0.0f, height, ms, mt, ms, mt,
+
+                    0.0f, -height, -height, ms, Mt, ms, Mt,
+                    0.0f, height, -height, Ms, Mt, Ms, Mt,
+                    0.0f, height, height, Ms, mt, Ms, mt,
+                    0.0f, -height, height, ms, mt, ms, mt,
+            };
+            GFXDraw(GFXQUAD, verts, vnum, 3, 0, 2, 2);
+        }
+    });
+}
+
+void Animation::DrawVertices(const float *data, int vnum, bool blendoption) {
+    DrawPasses(blendoption, [&](bool multitex) {
+        GFXDraw(GFXQUAD, data, vnum, 3, 4, 2, multitex ? 2 : 0);
+    });
+}
+
+int Animation::TextureSets() const {
+    return (numLayers() > 1) ? 2 : 1;
+}
+
 void Animation::Draw() {
     if (g_game.use_animations != 0 || g_game.use_textures != 0) {
         Vector camp, camq, camr;
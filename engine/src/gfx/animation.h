@@ -54,6 +54,10 @@ class Animation : public AnimatedTexture {
 
     void InitAnimation();
 
+    ///Runs draw(multitex) once per texture pass, with the layers set up as for a quad of this animation
+    template<typename DRAW>
+    void DrawPasses(bool blendoption, DRAW draw);
+
 public:
     Animation();
 
@@ -80,6 +84,12 @@ public:
 
     void DrawNoTransform(bool cross = true, bool blendoption = false);
 
+    ///Draws GFXQUAD vertices laid out as x y z, r g b a, then TextureSets() s t pairs, with this animation's passes
+    void DrawVertices(const float *data, int vnum, bool blendoption = false);
+
+    ///s t pairs per vertex DrawVertices expects
+    int TextureSets() const;
+
     void DrawAsVSSprite(class VSSprite *spr);
 
     static void ProcessDrawQueue(std::vector<Animation *> &, float);
@@ -0,0 +1,89 @@
+/*
+ * animation_clock.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_ANIMATION_CLOCK_H
+#define VEGA_STRIKE_ENGINE_GFX_ANIMATION_CLOCK_H
+
+///A clock shared by many animations: advancing it advances every one running on it
+struct AnimationClock {
+    double now = 0;
+    unsigned int frame = 0; //how many times it has been advanced
+
+    void Advance(double elapsed) {
+        now += elapsed;
+        ++frame;
+    }
+
+    ///whether something last drawn in drawn_frame was drawn in the frame before this one
+    bool DrawnLastFrame(unsigned int drawn_frame) const {
+        return drawn_frame + 1 >= frame;
+    }
+};
+
+/**
+ * One animation's time on an AnimationClock.
+ *
+ * While running it only remembers the clock reading its time 0 fell on, so
+ * nothing needs doing per animation as the clock advances. Stopped, the time
+ * stays put until started again.
+ */
+class AnimationTime {
+    bool running = false;
+    double start = 0; //clock reading at time 0, while running
+    double stopped = 0; //the time, while stopped
+
+public:
+    bool Running() const {
+        return running;
+    }
+
+    double Time(const AnimationClock &clock) const {
+        return running ? clock.now - start : stopped;
+    }
+
+    void Set(const AnimationClock &clock, double time) {
+        stopped = time;
+        if (running) {
+            start = clock.now - time;
+        }
+    }
+
+    void Start(const AnimationClock &clock) {
+        if (!running) {
+            running = true;
+            start = clock.now - stopped;
+        }
+    }
+
+    void Stop(const AnimationClock &clock) {
+        if (running) {
+            stopped = Time(clock);
+            running = false;
+        }
+    }
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_ANIMATION_CLOCK_H
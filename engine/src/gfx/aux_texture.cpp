@@ -39,6 +39,11 @@
 #include "src/main_loop.h"
 #include "gfx/aux_texture.h"
 #include "root_generic/configxml.h"
+#include "src/vs_logging.h"
+#include "configuration/configuration.h"
+
+#include <algorithm>
+#include <vector>
 
 using std::string;
 using namespace VSFileSystem;
@@ -47,6 +52,18 @@ using namespace XMLSupport;
 Hashtable<string, Texture, 4007> texHashTable;
 Hashtable<string, bool, 4007> badtexHashTable;
 
+//never destroyed, as textures may outlive the other statics
+static TextureResidency &residency_manager() {
+    static TextureResidency *manager = new TextureResidency();
+    return *manager;
+}
+
+///the original of each managed texture, by residency id
+static std::vector<Texture *> &resident_textures() {
+    static std::vector<Texture *> *textures = new std::vector<Texture *>();
+    return *textures;
+}
+
 Texture *Texture::Exists(string s, string a) {
     return Texture::Exists(s + a);
 }
@@ -122,6 +139,9 @@ void Texture::InitTexture() {
     mintcoord = Vector(0.0f, 0.0f, 0.0f);
     maxtcoord = Vector(1.0f, 1.0f, 1.0f);
     address_mode = DEFAULT_ADDRESS_MODE;
+    reload_maxdimension = 65536;
+    reload_detail = GFXFALSE;
+    residency = -1;
 }
 
 void Texture::setold() {
@@ -160,6 +180,7 @@ Texture *Texture::Clone() {
         retval->original = NULL;
     }
     retval->refcount = 0;
+    retval->residency = -1;
     return retval;
     //assert (!original->original);
 }
@@ -350,6 +371,8 @@ void Texture::Load(const char *FileName,
         }
     }
     bool shared = (err == Shared);
+    reload_file = FileName;
+    reload_alpha = (err2 <= Ok) ? string(t) : string();
     free(t);
     if (err <= Ok && g_game.use_textures == 0 && !force_load) {
         f.Close();
@@ -383,6 +406,8 @@ void Texture::Load(const char *FileName,
                 ismipmapped = NEAREST;
             }
         }
+        reload_maxdimension = maxdimension;
+        reload_detail = detailtexture;
         if (main) {
             Bind(main, maxdimension, detailtexture);
         } else {
@@ -392,6 +417,7 @@ void Texture::Load(const char *FileName,
         data = NULL;
         if (!nocache) {
             setold();
+            ManageResidency(main);
         }
     } else {
         FileNotFound(texfilename);
@@ -505,6 +531,8 @@ void Texture::Load(const char *FileNameRGB,
             FileNameA = 0;
         }
     }
+    reload_file = FileNameRGB;
+    reload_alpha = (err1 <= Ok) ? string(FileNameA) : string();
     if (err1 > Ok) {
         data = this->ReadImage(&f, NULL, true, NULL);
     } else {
@@ -517,6 +545,8 @@ void Texture::Load(const char *FileNameRGB,
                 ismipmapped = NEAREST;
             }
         }
+        reload_maxdimension = maxdimension;
+        reload_detail = detailtexture;
         if (main) {
             Bind(main, maxdimension, detailtexture);
         } else {
@@ -526,6 +556,7 @@ void Texture::Load(const char *FileNameRGB,
         data = NULL;
         if (!nocache) {
             setold();
+            ManageResidency(main);
         }
     } else {
         FileNotFound(texfilename);
@@ -546,6 +577,11 @@ Texture::~Texture() {
          *             data = NULL;
          *     }
          */
+        if (residency >= 0 && !STATIC_VARS_DESTROYED) {
+            residency_manager().Unregister(residency);
+            resident_textures()[residency] = nullptr;
+            residency = -1;
+        }
         UnBind();
         if (palette != nullptr) {
             free(palette);
@@ -680,6 +716,114 @@ void Texture::Prioritize(float priority) {
     GFXPrioritizeTexture(name, priority);
 }
 
+void Texture::ManageResidency(Texture *main) {
+    if (main != nullptr) {
+        //this texture shares the name of main, which has to stay as it is
+        const Texture *shared = main->Original();
+        if (shared->residency >= 0) {
+            residency_manager().Pin(shared->residency);
+        }
+        return;
+    }
+    Texture *owner = Original();
+    if (owner == this || owner->name < 0 || reload_file.empty() || mode == _8BIT || reload_maxdimension == 44) {
+        return;
+    }
+    unsigned int width = sizeX;
+    unsigned int height = sizeY;
+    TextureResidency::Fit(width, height, (reload_maxdimension == 65536)
+            ? configuration().graphics.max_texture_dimension : reload_maxdimension);
+    float bytes_per_texel = 4;
+    if (mode == _DXT1 || mode == _DXT1RGBA) {
+        bytes_per_texel = 0.5F;
+    } else if (mode == _DXT3 || mode == _DXT5) {
+        bytes_per_texel = 1;
+    }
+    const unsigned int sides = (img_sides == SIDE_SINGLE) ? 1 : 6;
+    const TextureResidency::Category category = (texture_target == CUBEMAP || sides > 1)
+            ? TextureResidency::CATEGORY_ENVIRONMENT : TextureResidency::CATEGORY_SPRITE;
+    owner->residency = residency_manager().Register(width, height, bytes_per_texel,
+            (ismipmapped & (MIPMAP | TRILINEAR)) != 0, sides, category);
+    std::vector<Texture *> &textures = resident_textures();
+    if (textures.size() <= static_cast<size_t>(owner->residency)) {
+        textures.resize(owner->residency + 1, nullptr);
+    }
+    textures[owner->residency] = owner;
+}
+
+bool Texture::Retransfer(unsigned int max_dimension) {
+    if (max_dimension <= TextureResidency::STUB_DIMENSION) {
+        //a flat grey stand in, until the texture is used again
+        static std::vector<unsigned char> stub(
+                TextureResidency::STUB_DIMENSION * TextureResidency::STUB_DIMENSION * 4, 128);
+        unsigned int width = sizeX;
+        unsigned int height = sizeY;
+        TextureResidency::Fit(width, height, max_dimension);
+        return GFXTransferTexture(stub.data(), name, width, height, RGBA32, image_target, max_dimension)
+                != GFXFALSE;
+    }
+    VSFile f;
+    if (f.OpenReadOnly(reload_file, TextureFile) > Ok) {
+        return false;
+    }
+    VSFile f1;
+    const bool alpha = !reload_alpha.empty() && f1.OpenReadOnly(reload_alpha, TextureFile) <= Ok;
+    data = this->ReadImage(&f, NULL, true, alpha ? &f1 : NULL);
+    f.Close();
+    if (alpha) {
+        f1.Close();
+    }
+    if (!data) {
+        return false;
+    }
+    Transfer(max_dimension, reload_detail);
+    free(data);
+    data = NULL;
+    return true;
+}
+
+void Texture::NoteScreenSize(float pixels) {
+    const Texture *owner = Original();
+    if (owner->residency >= 0) {
+        residency_manager().NoteScreenSize(owner->residency, pixels);
+    }
+}
+
+void Texture::UpdateResidency() {
+    TextureResidency &manager = residency_manager();
+    TextureResidency::Settings settings = manager.GetSettings();
+    settings.budget_bytes = static_cast<size_t>(std::max(0, configuration().graphics.texture_budget_mb)) * 1024 * 1024;
+    settings.idle_frames = std::max(1, configuration().graphics.texture_idle_frames);
+    settings.transfers_per_frame = std::max(0, configuration().graphics.texture_transfers_per_frame);
+    manager.SetSettings(settings);
+
+    const std::vector<TextureResidency::Transfer> &transfers = manager.Plan();
+    for (const TextureResidency::Transfer &transfer : transfers) {
+        Texture *texture = resident_textures()[transfer.id];
+        if (texture->Retransfer(transfer.max_dimension)) {
+            manager.Resident(transfer.id, transfer.max_dimension);
+        } else {
+            VS_LOG(warning, (boost::format("Could not transfer texture %1% again, leaving it as it is")
+                    % texture->reload_file));
+            manager.Pin(transfer.id);
+        }
+    }
+    if (!transfers.empty()) {
+        static const char *const names[TextureResidency::NUM_CATEGORIES] = {"mesh", "sprite", "environment"};
+        for (int c = 0; c < TextureResidency::NUM_CATEGORIES; ++c) {
+            const TextureResidency::Stats stats = manager.GetStats(static_cast<TextureResidency::Category>(c));
+            VS_LOG(debug, (boost::format("Textures (%1%): %2% resident in %3% of %4% bytes, %5% evicted,"
+                            " %6% reduced; %7% evictions, %8% downscales, %9% reloads")
+                    % names[c] % stats.textures % stats.resident_bytes % stats.full_bytes % stats.evicted
+                    % stats.reduced % stats.evictions % stats.downscales % stats.reloads));
+        }
+    }
+}
+
+const TextureResidency &Texture::Residency() {
+    return residency_manager();
+}
+
 static void ActivateWhite(int stage) {
     static Texture *white = new Texture("white.bmp", 0, MIPMAP, TEXTURE2D, TEXTURE_2D, 1);
     if (white->LoadSuccess()) {
@@ -688,6 +832,10 @@ static void ActivateWhite(int stage) {
 }
 
 void Texture::MakeActive(int stag, int pass) {
+    const Texture *owner = Original();
+    if (owner->residency >= 0) {
+        residency_manager().Touch(owner->residency);
+    }
     if ((name == -1) || (pass != 0)) {
         ActivateWhite(stag);
     } else {
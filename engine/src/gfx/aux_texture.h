@@ -28,6 +28,7 @@
 #define VEGA_STRIKE_ENGINE_GFX_TEXTURE_H
 
 #include "gfx/vsimage.h"
+#include "gfx/texture_residency.h"
 #include "src/gfxlib.h"
 #include "src/gfxlib_struct.h"
 #include "src/SharedPool.h"
@@ -83,6 +84,14 @@ public:
     ///The address mode being used with this texture
     enum ADDRESSMODE address_mode;
 
+    ///What the texture was loaded from, so the residency manager can transfer it again
+    std::string reload_file, reload_alpha;
+    int reload_maxdimension;
+    GFXBOOL reload_detail;
+
+    ///The id of this texture in the residency manager, -1 if it is not managed
+    int residency;
+
     ///Returns if this texture is actually already loaded
     GFXBOOL checkold(const std::string &s, bool shared, std::string &hashname);
     void modold(const std::string &s, bool shared, std::string &hashname);
@@ -106,6 +115,12 @@ protected:
     ///Transfers this texture to GFX library
     void Transfer(int maxdimension, GFXBOOL detailtexture);
 
+    ///Hands a freshly loaded texture over to the residency manager
+    void ManageResidency(Texture *main);
+
+    ///Transfers the texture again from its file at a new max dimension, or a stub in its place
+    bool Retransfer(unsigned int max_dimension);
+
 public:
 
     ///Binds this texture to the same name as the given texture - for multipart textures
@@ -282,6 +297,14 @@ public:
 
     ///Changes priority of texture
     virtual void Prioritize(float);
+
+    ///Tells the residency manager the texture is drawn this frame, about this many pixels across
+    void NoteScreenSize(float pixels);
+
+    ///Does the transfers the residency manager asks for; once a frame, before drawing
+    static void UpdateResidency();
+
+    static const TextureResidency &Residency();
 };
 
 #endif //VEGA_STRIKE_ENGINE_GFX_TEXTURE_H
@@ -0,0 +1,72 @@
+/*
+ * lru_list.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_LRU_LIST_H
+#define VEGA_STRIKE_ENGINE_GFX_LRU_LIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * A short list of cached items that evicts the least recently used one.
+ *
+ * Meant for a handful of large entries, so finding one is a linear scan and
+ * using it rotates it to the back; the front is always the next to go.
+ */
+template<typename T>
+class LruList {
+    std::vector<T> items; //least recently used first
+
+public:
+    ///the first item match accepts, marked as most recently used, or nullptr
+    template<typename Match>
+    T *Find(Match match) {
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (match(items[i])) {
+                std::rotate(items.begin() + i, items.begin() + i + 1, items.end());
+                return &items.back();
+            }
+        }
+        return nullptr;
+    }
+
+    ///makes room for a new item, evicting the least recently used down to capacity, and returns it
+    T &Add(size_t capacity) {
+        capacity = std::max(capacity, static_cast<size_t>(1));
+        if (items.size() >= capacity) {
+            items.erase(items.begin(), items.begin() + (items.size() - capacity + 1));
+        }
+        items.emplace_back();
+        return items.back();
+    }
+
+    size_t size() const {
+        return items.size();
+    }
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_LRU_LIST_H
@@ -41,6 +41,8 @@
 #include "gfx/camera.h"
 #include "gfx/animation.h"
 #include "gfx/technique.h"
+#include "gfx/mesh_sort_key.h"
+#include "gfx/radix_sort.h"
 #include "gfx_generic/mesh_xml.h"
 #include "gldrv/gl_globals.h"
 #include "gldrv/gl_light.h"
@@ -112,6 +114,7 @@ public:
     unsigned int zsort{1};
     unsigned int passno{14};
     int sequence{16};
+    uint64_t key{};
 
     OrigMeshContainer() {
         orig = nullptr;
@@ -134,11 +137,34 @@ public:
                 ) ? 0 : 1;
         this->zsort = (transparent
                 && ((pass.blendMode != Pass::Default) || (orig->blendDst != ONE) || (orig->blendSrc != ONE))) ? 1 : 0;
+        this->key = sortKey(pass);
 
         assert(this->passno == passno);
         assert(this->sequence == pass.sequence);
     }
 
+    //Packs the ordering of operator< into one key for the radix sort, see MeshSortKey
+    uint64_t sortKey(const Pass &pass) const {
+        return MeshSortKey(sequence, transparent, zsort, d, passno, program, textureSetHash(pass));
+    }
+
+    uint16_t textureSetHash(const Pass &pass) const {
+        uint64_t h = 14695981039346656037ULL;
+        auto mix = [&h](const Texture *t) {
+            h = (h ^ reinterpret_cast<uintptr_t>(t ? t->Original() : nullptr)) * 1099511628211ULL;
+        };
+        if (program == 0) {
+            if (!orig->Decal.empty()) {
+                mix(orig->Decal[0]);
+            }
+        } else {
+            for (size_t i = 0, n = pass.getNumTextureUnits(); i < n; ++i) {
+                mix(orig->resolveTextureUnit(pass.getTextureUnit(i)));
+            }
+        }
+        return static_cast<uint16_t>(h ^ (h >> 16) ^ (h >> 32) ^ (h >> 48));
+    }
+
     #define SLESSX(a, b)                            \
     do {if ( !( (a) == (b) ) ) return ( (a) < (b) );  \
     }                                                 \
@@ -246,6 +272,72 @@ typedef std::vector<OrigMeshContainer> OrigMeshVector;
 const int UNDRAWN_MESHES_SIZE = NUM_MESH_SEQUENCE;
 
 OrigMeshVector undrawn_meshes[NUM_MESH_SEQUENCE];
+static OrigMeshVector undrawn_meshes_scratch;
+
+static void SortUndrawnMeshes(OrigMeshVector &meshes) {
+    RadixSort(meshes, undrawn_meshes_scratch, [](const OrigMeshContainer &c) {
+        return c.key;
+    });
+}
+
+//State a shader pass leaves bound while a sorted draw queue is being processed.
+//The next draw that would set up exactly the same state skips doing so, and the
+//state is only torn down once a draw needs something different.
+struct BoundShaderPassState {
+    const Pass *pass = nullptr;
+    bool zwrite = false;
+    BLENDFUNC blendSrc = ONE;
+    BLENDFUNC blendDst = ZERO;
+    int material = 0;
+    unsigned char alphatest = 0;
+    GFXBOOL cullForcedOn = GFXFALSE;
+    GFXBOOL cullForcedOff = GFXFALSE;
+    GFXBOOL envMap = GFXFALSE;
+    //set only when the pass reads the mesh's detail planes
+    const Mesh *detailPlanesOf = nullptr;
+    std::vector<const Texture *> textures;
+};
+
+static bool batch_draw_state = false;
+static BoundShaderPassState bound_pass_state;
+
+static void RestoreShaderPassState(const Pass &pass) {
+    GFXEnable(CULLFACE);
+    GFXEnable(COLORWRITE);
+    GFXEnable(DEPTHWRITE);
+    GFXCullFace(GFXBACK);
+    GFXPolygonMode(GFXFILLMODE);
+    GFXPolygonOffset(0, 0);
+    GFXDepthFunc(LEQUAL);
+    if (pass.polyMode == Pass::Line) {
+        GFXLineWidth(1);
+    }
+    //Restore blend mode
+    GFXPopBlendMode();
+}
+
+static void RestoreTextureUnits() {
+    for (unsigned int i = 0; i < gl_options.Multitexture; ++i) {
+        GFXToggleTexture(i < 2, i);
+    }
+}
+
+static void FlushBoundPassState() {
+    if (bound_pass_state.pass != nullptr) {
+        RestoreShaderPassState(*bound_pass_state.pass);
+        RestoreTextureUnits();
+        bound_pass_state.pass = nullptr;
+    }
+}
+
+static void BeginDrawStateBatch() {
+    batch_draw_state = true;
+}
+
+static void EndDrawStateBatch() {
+    FlushBoundPassState();
+    batch_draw_state = false;
+}
 
 Texture *Mesh::TempGetTexture(MeshXML *xml, std::string filename, std::string factionname, GFXBOOL detail) const {
     static FILTER fil =
@@ -479,6 +571,12 @@ void Mesh::Draw(float lod,
                 const MeshFX *mfx) //short fix
 {
     Mesh *origmesh = getLOD(lod);
+    for (Texture *decal : origmesh->Decal) {
+        if (decal) {
+            //lod is the projected radius in pixels
+            decal->NoteScreenSize(2 * lod);
+        }
+    }
     if (origmesh->rSize() > 0) {
         //Vector pos (local_pos.Transform(m));
         MeshDrawContext c(m);
@@ -614,12 +712,14 @@ void Mesh::ProcessZFarMeshes(bool nocamerasetup) {
             _Universe->AccessCamera()->UpdateGFXFrustum(GFXTRUE, configuration().graphics.zfar_flt * far_margin, 0);
         }
 
-        std::sort(undrawn_meshes[a].begin(), undrawn_meshes[a].end());
+        SortUndrawnMeshes(undrawn_meshes[a]);
+        BeginDrawStateBatch();
         for (OrigMeshVector::iterator it = undrawn_meshes[a].begin(); it < undrawn_meshes[a].end(); ++it) {
             Mesh *m = it->orig;
             m->ProcessDrawQueue(it->passno, a, it->zsort, _Universe->AccessCamera()->GetPosition());
             m->will_be_drawn &= (~(1 << a));           //not accurate any more
         }
+        EndDrawStateBatch();
         for (OrigMeshVector::iterator it = undrawn_meshes[a].begin(); it < undrawn_meshes[a].end(); ++it) {
             Mesh *m = it->orig;
             m->draw_queue[a].clear();
@@ -669,12 +769,14 @@ void Mesh::ProcessUndrawnMeshes(bool pushSpecialEffects, bool nocamerasetup) {
         } else { // less correct (svn r13721) but working on nav computer
             _Universe->AccessCamera()->UpdateGFXFrustum(GFXTRUE, configuration().graphics.znear_flt, configuration().graphics.zfar_flt);
         }
-        std::sort(undrawn_meshes[a].begin(), undrawn_meshes[a].end());
+        SortUndrawnMeshes(undrawn_meshes[a]);
+        BeginDrawStateBatch();
         for (OrigMeshVector::iterator it = undrawn_meshes[a].begin(); it < undrawn_meshes[a].end(); ++it) {
             Mesh *m = it->orig;
             m->ProcessDrawQueue(it->passno, a, it->zsort, _Universe->AccessCamera()->GetPosition());
             m->will_be_drawn &= (~(1 << a));               //not accurate any more
         }
+        EndDrawStateBatch();
         for (OrigMeshVector::iterator it = undrawn_meshes[a].begin(); it < undrawn_meshes[a].end(); ++it) {
             Mesh *m = it->orig;
             m->draw_queue[a].clear();
@@ -1072,11 +1174,35 @@ void Mesh::ProcessDrawQueue(size_t whichpass, int whichdrawqueue, bool zsort, co
     if (pass.type == Pass::ShaderPass) {
         ProcessShaderDrawQueue(whichpass, whichdrawqueue, zsort, sortctr);
     } else {
+        FlushBoundPassState();
         ProcessFixedDrawQueue(whichpass, whichdrawqueue, zsort, sortctr);
     }
-    //Restore texture units
-    for (unsigned int i = 0; i < gl_options.Multitexture; ++i) {
-        GFXToggleTexture(i < 2, i);
+    //Restore texture units, unless the shader pass left them bound for the next draw
+    if (bound_pass_state.pass == nullptr) {
+        RestoreTextureUnits();
+    }
+}
+
+const Texture *Mesh::resolveTextureUnit(const Pass::TextureUnit &tu, bool deflt) const {
+    //Mirrors the source selection of activateTextureUnit, without binding anything
+    int sourceIndex = deflt ? tu.defaultIndex : tu.sourceIndex;
+    switch (deflt ? tu.defaultType : tu.sourceType) {
+        case Pass::TextureUnit::File:
+            return tu.texture.get();
+        case Pass::TextureUnit::Detail:
+            if (detailTexture) {
+                return detailTexture;
+            }
+            return deflt ? nullptr : resolveTextureUnit(tu, true);
+        case Pass::TextureUnit::Decal:
+            if ((sourceIndex < static_cast<int>(Decal.size())) && Decal[sourceIndex]) {
+                return Decal[sourceIndex];
+            }
+            return deflt ? nullptr : resolveTextureUnit(tu, true);
+        case Pass::TextureUnit::Environment: //the universe light map, the same for every mesh
+        case Pass::TextureUnit::None:
+        default:
+            return nullptr;
     }
 }
 
@@ -1353,14 +1479,55 @@ void Mesh::ProcessShaderDrawQueue(size_t whichpass, int whichdrawqueue, bool zso
 
     vector<MeshDrawContext> &cur_draw_queue = draw_queue[whichdrawqueue];
 
-    GFXPushBlendMode();
-    setupGLState(pass, zwrite, blendSrc, blendDst, myMatNum, alphatest, whichdrawqueue);
+    //Everything set up below only depends on this signature, so if the previous draw
+    //of the batch left the very same state bound, it is used as is
+    static BoundShaderPassState state;
+    state.pass = &pass;
+    state.zwrite = zwrite;
+    state.blendSrc = blendSrc;
+    state.blendDst = blendDst;
+    state.material = myMatNum;
+    state.alphatest = alphatest;
+    state.cullForcedOn = getCullFaceForcedOn();
+    state.cullForcedOff = getCullFaceForcedOff();
+    state.envMap = getEnvMap();
+    state.detailPlanesOf = nullptr;
+    for (size_t spi = 0; spi < pass.getNumShaderParams(); ++spi) {
+        const Pass::ShaderParam &sp = pass.getShaderParam(spi);
+        if (sp.id >= 0
+                && (sp.semantic == Pass::ShaderParam::DetailPlane0 || sp.semantic == Pass::ShaderParam::DetailPlane1)) {
+            state.detailPlanesOf = this;
+        }
+    }
+    state.textures.clear();
+    for (size_t tui = 0; tui < pass.getNumTextureUnits(); ++tui) {
+        state.textures.push_back(resolveTextureUnit(pass.getTextureUnit(tui)));
+    }
+    const bool reuse = bound_pass_state.pass == state.pass
+            && bound_pass_state.zwrite == state.zwrite
+            && bound_pass_state.blendSrc == state.blendSrc
+            && bound_pass_state.blendDst == state.blendDst
+            && bound_pass_state.material == state.material
+            && bound_pass_state.alphatest == state.alphatest
+            && bound_pass_state.cullForcedOn == state.cullForcedOn
+            && bound_pass_state.cullForcedOff == state.cullForcedOff
+            && bound_pass_state.envMap == state.envMap
+            && bound_pass_state.detailPlanesOf == state.detailPlanesOf
+            && bound_pass_state.textures == state.textures;
+
+    if (!reuse) {
+        FlushBoundPassState();
+        GFXPushBlendMode();
+        setupGLState(pass, zwrite, blendSrc, blendDst, myMatNum, alphatest, whichdrawqueue);
+    }
     if (pass.cullMode == Pass::DefaultFace) {
         SelectCullFace(whichdrawqueue);
     } // Default not handled by setupGLState, it depends on mesh data
 
     //Activate shader
-    GFXActivateShader(pass.getCompiledProgram());
+    if (!reuse) {
+        GFXActivateShader(pass.getCompiledProgram());
+    }
 
     //Set shader parameters (instance-independent only)
     int activeLightsArrayParam = -1;
@@ -1371,19 +1538,29 @@ void Mesh::ProcessShaderDrawQueue(size_t whichpass, int whichdrawqueue, bool zso
         if (sp.id >= 0) {
             switch (sp.semantic) {
                 case Pass::ShaderParam::Constant:
-                    GFXShaderConstant(sp.id, sp.value);
+                    if (!reuse) {
+                        GFXShaderConstant(sp.id, sp.value);
+                    }
                     break;
                 case Pass::ShaderParam::EnvColor:
-                    GFXShaderConstant(sp.id, getEnvMap() ? envmaprgba : noenvmaprgba);
+                    if (!reuse) {
+                        GFXShaderConstant(sp.id, getEnvMap() ? envmaprgba : noenvmaprgba);
+                    }
                     break;
                 case Pass::ShaderParam::DetailPlane0:
-                    GFXShaderConstant(sp.id, detailPlanes[0]);
+                    if (!reuse) {
+                        GFXShaderConstant(sp.id, detailPlanes[0]);
+                    }
                     break;
                 case Pass::ShaderParam::DetailPlane1:
-                    GFXShaderConstant(sp.id, detailPlanes[1]);
+                    if (!reuse) {
+                        GFXShaderConstant(sp.id, detailPlanes[1]);
+                    }
                     break;
                 case Pass::ShaderParam::GameTime:
-                    GFXShaderConstant(sp.id, UniverseUtil::GetGameTime());
+                    if (!reuse) {
+                        GFXShaderConstant(sp.id, UniverseUtil::GetGameTime());
+                    }
                     break;
                 case Pass::ShaderParam::NumLights:
                     numLightsParam = sp.id;
@@ -1403,7 +1580,7 @@ void Mesh::ProcessShaderDrawQueue(size_t whichpass, int whichdrawqueue, bool zso
     //Activate texture units
     size_t tui;
     size_t tuimask = 0;
-    for (tui = 0; tui < pass.getNumTextureUnits(); ++tui) {
+    for (tui = 0; !reuse && tui < pass.getNumTextureUnits(); ++tui) {
         const Pass::TextureUnit &tu = pass.getTextureUnit(tui);
         if (tu.targetIndex < 0) {
             continue;
@@ -1430,7 +1607,7 @@ void Mesh::ProcessShaderDrawQueue(size_t whichpass, int whichdrawqueue, bool zso
             }
         }
     }
-    for (tui = 0; tui < gl_options.Multitexture; ++tui) {
+    for (tui = 0; !reuse && tui < gl_options.Multitexture; ++tui) {
         GFXToggleTexture(((tuimask & (1 << tui)) != 0), tui, TEXTURE2D);
     }
     //Render all instances, no specific order if not necessary
@@ -1578,19 +1755,13 @@ void Mesh::ProcessShaderDrawQueue(size_t whichpass, int whichdrawqueue, bool zso
     }
     vlist->EndDrawState();
 
-    //Restore state
-    GFXEnable(CULLFACE);
-    GFXEnable(COLORWRITE);
-    GFXEnable(DEPTHWRITE);
-    GFXCullFace(GFXBACK);
-    GFXPolygonMode(GFXFILLMODE);
-    GFXPolygonOffset(0, 0);
-    GFXDepthFunc(LEQUAL);
-    if (pass.polyMode == Pass::Line) {
-        GFXLineWidth(1);
+    //Restore state, or leave it bound for the next draw of the batch.
+    //Per-light iteration changes the blend mode between instances, so that state is never kept.
+    if (batch_draw_state && pass.perLightIteration == 0) {
+        std::swap(bound_pass_state, state);
+    } else {
+        RestoreShaderPassState(pass);
     }
-    //Restore blend mode
-    GFXPopBlendMode();
 }
 
 #define GETDECAL(pass) ( (Decal[pass]) )
@@ -0,0 +1,56 @@
+/*
+ * mesh_sort_key.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_MESH_SORT_KEY_H
+#define VEGA_STRIKE_ENGINE_GFX_MESH_SORT_KEY_H
+
+#include <algorithm>
+#include <cstdint>
+
+#include "gfx/radix_sort.h"
+
+/**
+ * Packs the draw queue ordering of a mesh pass into one key for RadixSort,
+ * most significant first:
+ * sequence:8 transparent:1 zsort:1 depth:24 passno:4 program:10 textures:16
+ *
+ * depth only counts for z-sorted passes, and sorts ascending (pass the
+ * negated distance to draw far to near). Program and textures only serve to
+ * group like state together, so masking and hashing them is harmless.
+ */
+inline uint64_t MeshSortKey(int sequence, unsigned int transparent, unsigned int zsort, float depth,
+        unsigned int passno, int program, uint16_t textures) {
+    uint64_t k = static_cast<uint64_t>(std::min(std::max(sequence, 0), 255));
+    k = (k << 1) | (transparent ? 1 : 0);
+    k = (k << 1) | (zsort ? 1 : 0);
+    k = (k << 24) | (zsort ? (FloatSortKey(depth) >> 8) : 0);
+    k = (k << 4) | std::min(passno, 15U);
+    k = (k << 10) | (static_cast<unsigned int>(program) & 0x3ff);
+    k = (k << 16) | textures;
+    return k;
+}
+
+#endif //VEGA_STRIKE_ENGINE_GFX_MESH_SORT_KEY_H
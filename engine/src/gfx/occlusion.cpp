@@ -43,7 +43,10 @@
 
 #include "gldrv/gl_globals.h"
 #include "src/physics.h"
+#include "gfx_generic/occlusion_raster.h"
+#include "configuration/configuration.h"
 
+#include <algorithm>
 #include <limits>
 #include <set>
 #include "src/heap.h"
@@ -223,6 +226,24 @@ static VS::priority_queue<Occluder> dynamic_occluders;
 static QVector biggestLightPos;
 static float biggestLightSize;
 
+static OcclusionRaster raster(0, 0);
+
+static void setupRaster() {
+    const unsigned int width = std::max(0, configuration().graphics.occlusion_raster_width);
+    const unsigned int height = std::max(0, configuration().graphics.occlusion_raster_height);
+    if (width != raster.Width() || height != raster.Height()) {
+        raster.Resize(width, height);
+    }
+    raster.Clear();
+
+    float left, right, bottom, top, nearval, farval;
+    GFXGetFrustumVars(true, &left, &right, &bottom, &top, &nearval, &farval);
+    Camera *camera = _Universe->AccessCamera();
+    Vector p, q, r;
+    camera->GetOrientation(p, q, r);
+    raster.SetView(camera->GetPosition(), p, q, r, left, right, bottom, top, nearval);
+}
+
 void /*GFXDRVAPI*/ start() {
     end();
 
@@ -247,16 +268,20 @@ void /*GFXDRVAPI*/ start() {
         biggestLightPos = QVector(0, 0, 0);
         biggestLightSize = 1.f;
     }
+
+    setupRaster();
 }
 
 void /*GFXDRVAPI*/ end() {
-    VS_LOG(trace, (boost::format("Occluders: %1% forced and %2% dynamic")
+    VS_LOG(trace, (boost::format("Occluders: %1% forced, %2% dynamic and %3% rasterized")
             % forced_occluders.size()
-            % dynamic_occluders.size()));
+            % dynamic_occluders.size()
+            % raster.Occluders()));
     // FIXME - I think these three lines are memory leaks -- stephengtuggy 2019-10-01
     forced_occluders.clear();
     forced_occluders_set.clear();
     dynamic_occluders.clear();
+    raster.Clear();
 }
 
 void /*GFXDRVAPI*/ addOccluder(const QVector &pos, float rSize, bool significant) {
@@ -310,4 +335,16 @@ float /*GFXDRVAPI*/ testOcclusion(const QVector &lightPos, float lightSize, cons
     return rv;
 }
 
+void /*GFXDRVAPI*/ addSolidOccluder(const QVector &pos, float rSize) {
+    raster.AddOccluder(pos, rSize);
+}
+
+bool /*GFXDRVAPI*/ isHidden(const QVector &pos, float rSize) {
+    return raster.IsOccluded(pos, rSize);
+}
+
+const OcclusionRaster & /*GFXDRVAPI*/ solidOccluders() {
+    return raster;
+}
+
 } /* namespace Occlusion */
@@ -32,6 +32,8 @@
 #include "src/gfxlib.h"
 #include "gfx_generic/vec.h"
 
+class OcclusionRaster;
+
 namespace Occlusion {
 
 /// Initialize occlusion system for a new frame
@@ -65,6 +67,31 @@ void /*GFXDRVAPI*/ addOccluder(const QVector &pos, float rSize, bool significant
  */
 float /*GFXDRVAPI*/ testOcclusion(const QVector &lightPos, float lightSize, const QVector &pos, float rSize);
 
+/**
+ * Rasterize a solid occluder into the frame's occlusion raster
+ *
+ * Unlike addOccluder, the sphere must be fully opaque (ie: a planet's
+ * surface), since everything found behind it will be culled.
+ *
+ * @param pos The occluder's center
+ * @param rSize The radius of its opaque surface
+ */
+void /*GFXDRVAPI*/ addSolidOccluder(const QVector &pos, float rSize);
+
+/**
+ * Test whether an object is hidden from the camera
+ *
+ * @param pos The object's center
+ * @param rSize The object's radius
+ *
+ * @returns true only if the whole object is certainly behind
+ *          the solid occluders added this frame.
+ */
+bool /*GFXDRVAPI*/ isHidden(const QVector &pos, float rSize);
+
+/// The raster addSolidOccluder fills, for testing whole batches against it
+const OcclusionRaster & /*GFXDRVAPI*/ solidOccluders();
+
 }
 
 #endif //VEGA_STRIKE_ENGINE_GFX_OCCLUSION_H
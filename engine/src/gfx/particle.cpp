@@ -37,41 +37,17 @@
 #include "gldrv/gl_globals.h"
 #include "src/universe.h"
 
-#include <iterator>
-#include <limits>
+#include <algorithm>
 
-#include "aligned.h"
 #include "root_generic/vega_random.h"
 #include "src/vs_logging.h"
 
-ParticleTrail particleTrail("sparkle", 500, SRCALPHA, ONE, 0.05f, false, true);
-ParticleTrail smokeTrail("smoke", 500, SRCALPHA, INVSRCALPHA);
-ParticleTrail debrisTrail("debris", 500, SRCALPHA, INVSRCALPHA, 0.5, true);
+ParticleTrail particleTrail("sparkle", 100000, SRCALPHA, ONE, 0.05f, false, true);
+ParticleTrail smokeTrail("smoke", 100000, SRCALPHA, INVSRCALPHA);
+ParticleTrail debrisTrail("debris", 100000, SRCALPHA, INVSRCALPHA, 0.5, true);
 
 void ParticleTrail::ChangeMax(unsigned int max) {
-    unsigned int vertices_per_particle;
-    unsigned int indices_per_particle;
-
-    if (config.use_points) {
-        vertices_per_particle = indices_per_particle = 1;
-    } else {
-        vertices_per_particle = indices_per_particle = 12;
-    }
-
-    if (gl_options.max_array_vertices > 0 &&
-            (max * vertices_per_particle) > gl_options.max_array_vertices) {
-        max = gl_options.max_array_vertices / vertices_per_particle;
-        if (max > 0) {
-            max--;
-        } // for a margin
-    }
-    if (gl_options.max_array_indices > 0 &&
-            (max * indices_per_particle) > gl_options.max_array_indices) {
-        max = gl_options.max_array_indices / indices_per_particle;
-        if (max > 0) {
-            max--;
-        } // for a margin
-    }
+    //The GL vertex array limits no longer cap this, Draw splits the particles into as many calls as needed
     if (max < 4) {
         max = 4;
     }
@@ -79,13 +55,31 @@ void ParticleTrail::ChangeMax(unsigned int max) {
     this->max_particles = max;
 }
 
+//Draws the vertices of nparticles whole particles, in batches that fit the GL vertex array limit
+static void DrawParticleVertices(enum POLYTYPE type,
+        const std::vector<float> &vertices,
+        size_t nparticles,
+        size_t vertsPerParticle,
+        int csize,
+        int tsize) {
+    const size_t stride = vertsPerParticle * (3 + csize + tsize);
+    size_t batch = nparticles;
+    if (gl_options.max_array_vertices > 0) {
+        batch = std::max<size_t>(1, gl_options.max_array_vertices / vertsPerParticle);
+    }
+    for (size_t first = 0; first < nparticles; first += batch) {
+        const size_t count = std::min(batch, nparticles - first);
+        GFXDraw(type, &vertices[first * stride], count * vertsPerParticle, 3, csize, tsize);
+    }
+}
+
 //Write 12 * 3 pos and 12 * 4 col and 12 * 2 tex float values into v and increment v by 108
 static inline void SetQuadVertex(const QVector &loc,
         const GFXColor &col,
         const float psize,
         const float grow,
         const float trans,
-        std::back_insert_iterator<std::vector<float> > &v,
+        float *&v,
         const QVector &campos) {
     float size = psize * (grow * (1 - col.a) + col.a);
     float maxsize = (psize > size) ? psize : size;
@@ -208,19 +202,6 @@ static inline void SetQuadVertex(const QVector &loc,
     *v++ = 0;
 }
 
-template<typename R, typename T>
-class IndexCompare {
-    const std::vector<R> &ref;
-
-public:
-    explicit IndexCompare(const std::vector<R> &ref_) : ref(ref_) {
-    }
-
-    bool operator()(const T &a, const T &b) const {
-        return ref[a] > ref[b];
-    }
-};
-
 ParticleTrail::Config::Config(const std::string &prefix) {
     texture = nullptr;
     initialized = false;
@@ -275,7 +256,17 @@ void ParticleEmitter::Config::init(const std::string &prefix) {
     fixedSize = false;
 }
 
-void ParticleTrail::DrawAndUpdate() {
+void ParticleTrail::Update(float elapsed) {
+    if (!config.use || particles.size() == 0) {
+        return;
+    }
+    particles.Update(elapsed, config.pfade, fadeColor);
+    // Remove dead particles, moving the last one into each hole
+    const float ptrans = config.ptrans;
+    particles.RemoveFaded((ptrans > 0.0f) ? sqrtf(alphaMask / ptrans) : 0.0f);
+}
+
+void ParticleTrail::Draw(float offset) {
     // Short-circuit, not only an optimization, it avoids assertion failures in GFXDraw
     if (!config.initialized) {
         config.init();
@@ -283,7 +274,7 @@ void ParticleTrail::DrawAndUpdate() {
         VS_LOG(info,
                 (boost::format("Configured particle system %1% with %2% particles") % config.prefix % max_particles));
     }
-    if (!config.use || particles.empty()) {
+    if (!config.use || particles.size() == 0) {
         return;
     }
 
@@ -291,10 +282,14 @@ void ParticleTrail::DrawAndUpdate() {
     bool pblend = config.pblend;
     float pgrow = config.pgrow;
     float ptrans = config.ptrans;
-    float pfade = config.pfade;
 
     const QVector kCameraPosition = _Universe->AccessCamera()->GetPosition();
     size_t nparticles = particles.size();
+    const std::vector<float> &sizes = particles.sizes;
+    const std::vector<float> &col_r = particles.col_r;
+    const std::vector<float> &col_g = particles.col_g;
+    const std::vector<float> &col_b = particles.col_b;
+    const std::vector<float> &col_a = particles.col_a;
 
     // Draw particles
     GFXDisable(CULLFACE);
@@ -316,31 +311,28 @@ void ParticleTrail::DrawAndUpdate() {
             GFXBlendMode(ONE, ZERO);
         }
 
-        particleVert.clear();
-        particleVert.reserve(particles.size() * (3 + 4));
-        std::back_insert_iterator<std::vector<float> > v(particleVert);
+        particleVert.resize(nparticles * (3 + 4));
+        float *v = particleVert.data();
         for (size_t i = 0; i < nparticles; ++i) {
-            const QVector &loc = particles[i].location;
-            std::back_insert_iterator<std::vector<float>> &v_1 = v;
-            float size = particles[i].size * (pgrow * (1.0f - particles[i].color.a) + particles[i].color.a);
-            float maxsize = (particles[i].size > size) ? particles[i].size : size;
-            float minsize = (particles[i].size <= size) ? particles[i].size : size;
+            float size = sizes[i] * (pgrow * (1.0f - col_a[i]) + col_a[i]);
+            float maxsize = (sizes[i] > size) ? sizes[i] : size;
+            float minsize = (sizes[i] <= size) ? sizes[i] : size;
 
             //Squared, surface-linked decay - looks nicer, more real for emissive gasses
             //NOTE: maxsize/minsize allows for inverted growth (shrinkage) while still fading correctly. Cheers!
-            GFXColor c_1 =
-                    particles[i].color * (particles[i].color.a * ptrans * (minsize / ((maxsize > 0) ? maxsize : 1.0F)));
-            QVector l = loc - kCameraPosition;
-
-            *v_1++ = l.x;
-            *v_1++ = l.y;
-            *v_1++ = l.y;
-            *v_1++ = c_1.r;
-            *v_1++ = c_1.g;
-            *v_1++ = c_1.b;
-            *v_1++ = c_1.a;
+            GFXColor c_1 = GFXColor(col_r[i], col_g[i], col_b[i], col_a[i])
+                    * (col_a[i] * ptrans * (minsize / ((maxsize > 0) ? maxsize : 1.0F)));
+            QVector l = particles.Location(i, offset) - kCameraPosition;
+
+            *v++ = l.x;
+            *v++ = l.y;
+            *v++ = l.z;
+            *v++ = c_1.r;
+            *v++ = c_1.g;
+            *v++ = c_1.b;
+            *v++ = c_1.a;
         }
-        GFXDraw(GFXPOINT, &particleVert[0], particles.size(), 3, 4);
+        DrawParticleVertices(GFXPOINT, particleVert, nparticles, 1, 4, 0);
 
         glDisable(GL_POINT_SMOOTH);
         GFXPointSize(1);
@@ -362,61 +354,21 @@ void ParticleTrail::DrawAndUpdate() {
         }
         t->MakeActive();
 
-        if (dosort) {
-            // Must sort
-            distances.clear();
-            distances.reserve(nparticles);
-            {
-                for (const auto & it : particles) {
-                    distances.push_back((kCameraPosition - it.location).MagnitudeSquared());
-                }
-            }
-            IndexCompare<float, unsigned short> dcomp(distances);
-
-            unsigned short nindices;
-            if (nparticles >= (size_t) std::numeric_limits<unsigned short>::max() / vertsPerParticle) {
-                nindices = (unsigned short) std::numeric_limits<unsigned short>::max() / vertsPerParticle;
-            } else {
-                nindices = (unsigned short) nparticles;
-            }
-            pointIndices.clear();
-            pointIndices.reserve(nindices);
-            {
-                for (unsigned short i = 0; i < nindices; ++i) {
-                    pointIndices.push_back(i);
-                }
-            }
-
-            std::sort(pointIndices.begin(), pointIndices.end(), dcomp);
-
-            indices.clear();
-            indices.reserve(static_cast<size_t>(nindices) * vertsPerParticle);
-            {
-                for (unsigned short point_index : pointIndices) {
-                    for (int i = 0; i < vertsPerParticle; ++i) {
-                        indices.push_back(point_index * vertsPerParticle + i);
-                    }
-                }
-            }
-        }
+        // Must sort, farthest first
+        const std::vector<ParticleArrays::DepthKey> *depthOrder =
+                dosort ? &particles.SortByDepth(kCameraPosition, offset) : nullptr;
 
-        particleVert.clear();
-        particleVert.reserve(nparticles * vertsPerParticle * (3 + 4 + 2));
-        std::back_insert_iterator<std::vector<float> > v(particleVert);
-        for (size_t i = 0; i < nparticles; ++i) {
-            SetQuadVertex(particles[i].location, particles[i].color, particles[i].size, pgrow, ptrans, v, kCameraPosition);
+        particleVert.resize(nparticles * vertsPerParticle * (3 + 4 + 2));
+        float *v = particleVert.data();
+        for (size_t n = 0; n < nparticles; ++n) {
+            const size_t i = dosort ? (*depthOrder)[n].index : n;
+            SetQuadVertex(particles.Location(i, offset), GFXColor(col_r[i], col_g[i], col_b[i], col_a[i]),
+                    sizes[i], pgrow, ptrans, v, kCameraPosition);
         }
 
-        if (dosort) {
-            VS_LOG(trace, (boost::format("Drawing %1%/%2% sorted particles") % nparticles % max_particles));
-            GFXDrawElements(GFXQUAD,
-                    &particleVert[0], nparticles * vertsPerParticle,
-                    &indices[0], indices.size(),
-                    3, 4, 2);
-        } else {
-            VS_LOG(trace, (boost::format("Drawing %1%/%2% unsorted particles") % nparticles % max_particles));
-            GFXDraw(GFXQUAD, &particleVert[0], nparticles * 12, 3, 4, 2);
-        }
+        VS_LOG(trace, (boost::format("Drawing %1%/%2% %3% particles") % nparticles % max_particles
+                % (dosort ? "sorted" : "unsorted")));
+        DrawParticleVertices(GFXQUAD, particleVert, nparticles, vertsPerParticle, 4, 2);
 
         if (alphaMask > 0) {
             GFXAlphaTest(ALWAYS, 0);
@@ -425,77 +377,6 @@ void ParticleTrail::DrawAndUpdate() {
         GFXBlendMode(ONE, ZERO);
     }
     GFXLoadIdentity(MODEL);
-
-    // Update particles
-    const double elapsed_time_as_double = GetElapsedTime();
-    const float elapsed_time_as_float = static_cast<float>(elapsed_time_as_double);
-    if (fadeColor) {
-        float fadetimef = pfade * elapsed_time_as_double;
-        _ALIGNED(16) GFXColor fadetime = GFXColor(fadetimef, fadetimef, fadetimef, fadetimef);
-
-        for (auto & particle : particles) {
-            particle.location += particle.velocity * elapsed_time_as_double;
-            particle.color = particle.color - fadetime;
-            particle.color.clamp();
-        }
-    } else {
-        for (auto & particle : particles) {
-            particle.location += particle.velocity * elapsed_time_as_double;
-            particle.color.a = std::max(0.0F, particle.color.a - pfade * elapsed_time_as_float);
-        }
-    }
-
-    // Compute alpha for dead particles
-    float min_alpha = (ptrans > 0.0f) ? sqrtf(alphaMask / ptrans) : 0.0f;
-
-    //if (nparticles) {
-    //VS_LOG(trace, (boost::format("Drawn %1% particles, min_alpha %2%") % nparticles % min_alpha));
-    //}
-
-//    // Quickly remove dead particles at the end
-//    while (!particleColor.empty() && particleColor.back().a <= min_alpha) {
-//        particleVel.pop_back();
-//        particleLoc.pop_back();
-//        particleColor.pop_back();
-//        particleSize.pop_back();
-//    }
-
-    // Remove dead particles anywhere
-    auto first_to_remove = std::stable_partition(particles.begin(), particles.end(), [min_alpha](Particle& item){ return item.color.a > min_alpha; });
-//    std::for_each(first_to_remove, particles.end(), [](Particle& particle){ delete });
-    particles.erase(first_to_remove, particles.end());
-//    vector<Vector, aligned_allocator<Vector> >::iterator v = particleVel.begin();
-//    vector<QVector, aligned_allocator<QVector> >::iterator loc = particleLoc.begin();
-//    vector<GFXColor, aligned_allocator<GFXColor> >::iterator col = particleColor.begin();
-//    vector<float, aligned_allocator<float> >::iterator sz = particleSize.begin();
-//    while (col != particleColor.end()) {
-//        if (!(col->a > min_alpha)) {
-//            vector<Vector, aligned_allocator<Vector> >::iterator vlast = particleVel.end() - 1;
-//            vector<QVector, aligned_allocator<QVector> >::iterator loclast = particleLoc.end() - 1;
-//            vector<GFXColor, aligned_allocator<GFXColor> >::iterator collast = particleColor.end() - 1;
-//            vector<float, aligned_allocator<float> >::iterator szlast = particleSize.end() - 1;
-//            if (col != collast) {
-//                *v = *vlast;
-//                *loc = *loclast;
-//                *col = *collast;
-//                *sz = *szlast;
-//            }
-//            size_t index = col - particleColor.begin();
-//            particleColor.pop_back();
-//            particleVel.pop_back();
-//            particleLoc.pop_back();
-//            particleSize.pop_back();
-//            col = particleColor.begin() + index;
-//            v = particleVel.begin() + index;
-//            loc = particleLoc.begin() + index;
-//            sz = particleSize.begin() + index;
-//        } else {
-//            ++loc;
-//            ++col;
-//            ++sz;
-//            ++v;
-//        }
-//    }
 }
 
 void ParticleTrail::AddParticle(const ParticlePoint &P, const Vector &V, float size) {
@@ -506,17 +387,10 @@ void ParticleTrail::AddParticle(const ParticlePoint &P, const Vector &V, float s
         return;
     }
 
-    Particle particle{};
-    particle.velocity = V;
-    particle.location = P.loc;
-    particle.color = P.col;
-    particle.size = P.size;
-
     if (particles.size() >= max_particles) {
-        const size_t off = VegaRandom::Instance().RandomSizeTLessThan(particles.size());
-        particles.at(off) = particle;
+        particles.Set(VegaRandom::Instance().RandomSizeTLessThan(particles.size()), P.loc, V, P.col, P.size);
     } else {
-        particles.push_back(particle);
+        particles.Add(P.loc, V, P.col, P.size);
     }
 }
 
@@ -27,12 +27,13 @@
 #ifndef VEGA_STRIKE_ENGINE_GFX_PARTICLE_H
 #define VEGA_STRIKE_ENGINE_GFX_PARTICLE_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
 #include <string>
-#include "aligned.h"
 #include "gfx_generic/vec.h"
+#include "gfx_generic/particle_arrays.h"
 #include "src/gfxlib_struct.h"
 
 class Texture;
@@ -43,25 +44,20 @@ struct ParticlePoint {
     float size;
 };
 
-struct Particle {
-    Vector velocity{};
-    QVector location{};
-    GFXColor color{};
-    float size{};
-};
-
 /**
- * Particle system class, contains regularly updated geometry for all active
- * particles of the same kind.
+ * Particle system class, contains all active particles of the same kind.
+ *
+ * Particles are kept as one array per field. Update() advances them during
+ * the simulation phase and removes the dead ones; Draw() only generates
+ * geometry, moved on to the frame's interpolated time and back to front
+ * where blending needs it, into a vertex buffer that keeps its capacity
+ * from frame to frame.
  *
  * Can be instantiated statically.
  */
 class ParticleTrail {
-    std::vector<Particle, aligned_allocator<Particle>> particles;
+    ParticleArrays particles;
     std::vector<float> particleVert;
-    std::vector<float> distances;
-    std::vector<unsigned short> pointIndices;
-    std::vector<unsigned short> indices;
     unsigned int max_particles{};
     BLENDFUNC blendsrc, blenddst;
     float alphaMask;
@@ -105,9 +101,16 @@ public:
         this->fadeColor = fadeColor;
     }
 
-    void DrawAndUpdate();
+    ///Moves and fades the particles by elapsed seconds, then drops the ones that faded out
+    void Update(float elapsed);
+    ///offset is how many seconds from the last Update() the frame is drawn at
+    void Draw(float offset = 0.0F);
     void AddParticle(const ParticlePoint &, const Vector &, float size);
     void ChangeMax(unsigned int max);
+
+    size_t size() const {
+        return particles.size();
+    }
 };
 
 /**
@@ -0,0 +1,89 @@
+/*
+ * radix_sort.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_RADIX_SORT_H
+#define VEGA_STRIKE_ENGINE_GFX_RADIX_SORT_H
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+///Maps a float onto an unsigned integer that orders the same way (negatives included)
+inline uint32_t FloatSortKey(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/**
+ * Stable LSD radix sort on a 64 bit key, one byte per pass.
+ *
+ * Passes over bytes that are the same for every element are skipped, so
+ * keys that only use a few of their bits cost only a few passes.
+ * scratch is used as the ping-pong buffer and keeps its capacity between
+ * calls, so sorting a queue every frame does not allocate.
+ */
+template<typename T, typename KeyOf>
+void RadixSort(std::vector<T> &items, std::vector<T> &scratch, KeyOf key_of) {
+    const size_t n = items.size();
+    if (n < 2) {
+        return;
+    }
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t key = key_of(items[i]);
+        for (int b = 0; b < 8; ++b) {
+            ++counts[b][(key >> (b * 8)) & 0xff];
+        }
+    }
+    scratch.resize(n);
+    std::vector<T> *src = &items;
+    std::vector<T> *dst = &scratch;
+    for (int b = 0; b < 8; ++b) {
+        size_t *count = counts[b];
+        if (count[(key_of((*src)[0]) >> (b * 8)) & 0xff] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (int d = 0; d < 256; ++d) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            T &item = (*src)[i];
+            (*dst)[count[(key_of(item) >> (b * 8)) & 0xff]++] = std::move(item);
+        }
+        std::swap(src, dst);
+    }
+    if (src != &items) {
+        items.swap(scratch);
+    }
+}
+
+#endif //VEGA_STRIKE_ENGINE_GFX_RADIX_SORT_H
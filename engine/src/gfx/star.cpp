@@ -35,6 +35,7 @@
 #include "root_generic/vs_globals.h"
 #include "gfx/camera.h"
 #include "gfx/cockpit.h"
+#include "gfx/lru_list.h"
 #include "src/config_xml.h"
 #include "root_generic/lin_time.h"
 #include "root_generic/galaxy_xml.h"
@@ -171,32 +172,53 @@ StarVlist::StarVlist(float spread) {
     this->spread = spread;
 }
 
-static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float spread, int *num, int repetition) {
-    const float staroverlap = configuration().graphics.star_overlap_flt;
-    float xyzspread = spread * 2 * staroverlap;
-    const string allowedSectors = configuration().graphics.star_allowable_sectors;
-    if (our_system_name.size() > 0) {
-        string lumi = _Universe->getGalaxyProperty(our_system_name, "luminosity");
-        if (lumi.length() == 0 || strtod(lumi.c_str(), nullptr) == 0) {
-            our_system_name = "";
-        } else {
-            string::size_type slash = our_system_name.find("/");
-            if (slash != string::npos) {
-                string sec = our_system_name.substr(0, slash);
-                if (allowedSectors.find(sec) == string::npos) {
-                    our_system_name = "";
-                }
-            } else {
-                our_system_name = "";
+//A system of the galaxy, as far as the background stars care
+struct GalaxyStar {
+    bool has_xyz;
+    float x, y, z;
+    bool has_luminosity;
+    float luminosity;
+    bool has_color;
+    float r, g, b;
+};
+
+//The galaxy's systems in StarIter order, parsed once rather than twice for every system entered
+static std::vector<GalaxyStar> galaxy_stars;
+
+static const std::vector<GalaxyStar> &GalaxyStars() {
+    const unsigned int count = NumStarsInGalaxy();
+    if (galaxy_stars.size() != count) {
+        galaxy_stars.clear();
+        galaxy_stars.reserve(count);
+        for (StarIter i; !i.Done(); ++i) {
+            GalaxyStar star = GalaxyStar();
+            star.has_xyz = 3 == sscanf((*i.Get())["xyz"].c_str(), "%f %f %f", &star.x, &star.y, &star.z);
+            star.has_luminosity = 1 == sscanf((*i.Get())["luminosity"].c_str(), "%f", &star.luminosity);
+            std::string radstr = (*i.Get())["sun_radius"];
+            if (radstr.size()) {
+                GFXColor suncolor(StarSystemGent::getStarColorFromRadius(XMLSupport::parse_float(radstr)));
+                star.has_color = true;
+                star.r = suncolor.r;
+                star.g = suncolor.g;
+                star.b = suncolor.b;
             }
+            galaxy_stars.push_back(star);
         }
     }
-    if (!our_system_name.empty()) {
-        *num = NumStarsInGalaxy();
-    }
-    GFXColorVertex *tmpvertex = new GFXColorVertex[(*num) * repetition];
-//    memset( tmpvertex, 0, sizeof (GFXVertex)*(*num)*repetition ); //This is already initialized
-    StarIter si;
+    return galaxy_stars;
+}
+
+static void GenerateVerticesForSystem(const std::string &our_system_name,
+        float spread,
+        int num,
+        int repetition,
+        std::vector<GFXColorVertex> &vertices) {
+    const float staroverlap = configuration().graphics.star_overlap_flt;
+    float xyzspread = spread * 2 * staroverlap;
+    const std::vector<GalaxyStar> &stars = GalaxyStars();
+    vertices.assign(num * repetition, GFXColorVertex());
+    GFXColorVertex *tmpvertex = vertices.data();
+    std::vector<GalaxyStar>::const_iterator si = stars.begin();
     int starcount = 0;
     int j = 0;
     float xcent = 0;
@@ -214,12 +236,11 @@ static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float
                 &xcent,
                 &ycent,
                 &zcent);
-        for (StarIter i; !i.Done(); ++i) {
-            float xx, yy, zz;
-            if (3 == sscanf((*i.Get())["xyz"].c_str(), "%f %f %f", &xx, &yy, &zz)) {
-                xx -= xcent;
-                yy -= ycent;
-                zz -= zcent;
+        for (const GalaxyStar &star : stars) {
+            if (star.has_xyz) {
+                float xx = star.x - xcent;
+                float yy = star.y - ycent;
+                float zz = star.z - zcent;
                 if (xx < starmin.i) {
                     starmin.i = xx;
                 }
@@ -245,8 +266,8 @@ static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float
                 if ((mindistance < 0) || (mindistance > magsqr)) {
                     mindistance = magsqr;
                 }
-                float lumin;
-                if (1 == sscanf((*i.Get())["luminosity"].c_str(), "%f", &lumin)) {
+                if (star.has_luminosity) {
+                    float lumin = star.luminosity;
                     if (lumin > maxlumin) {
                         maxlumin = lumin;
                     }
@@ -269,7 +290,7 @@ static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float
     mindistance = sqrt(mindistance);
     VS_LOG(info, (boost::format("Min (%1$f, %2$f, %3$f) Max(%4$f, %5$f, %6$f) MinLumin %7$f, MaxLumin %8$f")
             % starmin.i % starmin.j % starmin.k % starmax.i % starmax.j % starmax.k % minlumin % maxlumin));
-    for (int y = 0; y < *num; ++y) {
+    for (int y = 0; y < num; ++y) {
         tmpvertex[j + repetition - 1].x = VegaRandom::Instance().RandomFloatInRange(-0.5 * xyzspread, 0.5 * xyzspread);
         tmpvertex[j + repetition - 1].y = VegaRandom::Instance().RandomFloatInRange(-0.5 * xyzspread, 0.5 * xyzspread);
         tmpvertex[j + repetition - 1].z = VegaRandom::Instance().RandomFloatInRange(-0.5 * xyzspread, 0.5 * xyzspread);
@@ -282,34 +303,25 @@ static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float
         tmpvertex[j + repetition - 1].j = .57735;
         tmpvertex[j + repetition - 1].k = .57735;
         int incj = repetition;
-        if (our_system_name.size() > 0 && !si.Done()) {
+        if (our_system_name.size() > 0 && si != stars.end()) {
             starcount++;
-            float xorig, yorig, zorig;
-            if (3 == sscanf((*si.Get())["xyz"].c_str(),
-                    "%f %f %f",
-                    &xorig,
-                    &yorig,
-                    &zorig)) {
-                if (xcent != xorig) {
-                    tmpvertex[j + repetition - 1].x = xorig - xcent;
+            if (si->has_xyz) {
+                if (xcent != si->x) {
+                    tmpvertex[j + repetition - 1].x = si->x - xcent;
                 }
-                if (ycent != yorig) {
-                    tmpvertex[j + repetition - 1].y = yorig - ycent;
+                if (ycent != si->y) {
+                    tmpvertex[j + repetition - 1].y = si->y - ycent;
                 }
-                if (zcent != zorig) {
-                    tmpvertex[j + repetition - 1].z = zorig - zcent;
+                if (zcent != si->z) {
+                    tmpvertex[j + repetition - 1].z = si->z - zcent;
                 }
             }
-            std::string radstr = (*si.Get())["sun_radius"];
-            if (radstr.size()) {
-                float rad = XMLSupport::parse_float(radstr);
-                GFXColor suncolor(StarSystemGent::getStarColorFromRadius(rad));
-                tmpvertex[j + repetition - 1].r = suncolor.r;
-                tmpvertex[j + repetition - 1].g = suncolor.g;
-                tmpvertex[j + repetition - 1].b = suncolor.b;
+            if (si->has_color) {
+                tmpvertex[j + repetition - 1].r = si->r;
+                tmpvertex[j + repetition - 1].g = si->g;
+                tmpvertex[j + repetition - 1].b = si->b;
             }
-            float lumin = 1;
-            sscanf((*si.Get())["luminosity"].c_str(), "%f", &lumin);
+            float lumin = si->has_luminosity ? si->luminosity : 1;
 
             float distance = Vector(tmpvertex[j + repetition - 1].x,
                     tmpvertex[j + repetition - 1].y,
@@ -338,7 +350,62 @@ static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float
         j += incj;
     }
     VS_LOG(info, (boost::format("Read In Star Count %1$d used: %2$d\n") % starcount % (j / 2)));
-    *num = j;
+    vertices.resize(j);
+}
+
+//The starfields of the last few systems visited, so jumping back does not generate them again;
+//the one least recently jumped to is dropped first
+struct StarfieldCacheEntry {
+    std::string system;
+    float spread;
+    int repetition;
+    int requested;
+    std::vector<GFXColorVertex> vertices;
+};
+static LruList<StarfieldCacheEntry> starfield_cache;
+
+static GFXColorVertex *AllocVerticesForSystem(std::string our_system_name, float spread, int *num, int repetition) {
+    //systems without star data all map to "" below, but each gets a random field of its own
+    const std::string system_key = our_system_name;
+    const string allowedSectors = configuration().graphics.star_allowable_sectors;
+    if (our_system_name.size() > 0) {
+        string lumi = _Universe->getGalaxyProperty(our_system_name, "luminosity");
+        if (lumi.length() == 0 || strtod(lumi.c_str(), nullptr) == 0) {
+            our_system_name = "";
+        } else {
+            string::size_type slash = our_system_name.find("/");
+            if (slash != string::npos) {
+                string sec = our_system_name.substr(0, slash);
+                if (allowedSectors.find(sec) == string::npos) {
+                    our_system_name = "";
+                }
+            } else {
+                our_system_name = "";
+            }
+        }
+    }
+    if (!our_system_name.empty()) {
+        *num = NumStarsInGalaxy();
+    }
+
+    const int requested = *num;
+    const StarfieldCacheEntry *found = starfield_cache.Find([&](const StarfieldCacheEntry &entry) {
+        return entry.system == system_key && entry.spread == spread && entry.repetition == repetition
+                && entry.requested == requested;
+    });
+    if (!found) {
+        StarfieldCacheEntry &entry = starfield_cache.Add(std::max(1, configuration().graphics.star_cache_systems));
+        entry.system = system_key;
+        entry.spread = spread;
+        entry.repetition = repetition;
+        entry.requested = *num;
+        GenerateVerticesForSystem(our_system_name, spread, *num, repetition, entry.vertices);
+        found = &entry;
+    }
+
+    *num = found->vertices.size();
+    GFXColorVertex *tmpvertex = new GFXColorVertex[std::max(*num, 1)];
+    std::copy(found->vertices.begin(), found->vertices.end(), tmpvertex);
     return tmpvertex;
 }
 
@@ -0,0 +1,98 @@
+/*
+ * animation_clock_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "gfx/animation_clock.h"
+
+TEST(AnimationClock, RunningTimeFollowsTheClock) {
+    AnimationClock clock;
+    clock.Advance(10.0);
+    AnimationTime a;
+    AnimationTime b;
+    a.Start(clock);
+    clock.Advance(0.5);
+    b.Start(clock);
+    clock.Advance(0.25);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 0.75);
+    EXPECT_DOUBLE_EQ(b.Time(clock), 0.25);
+    EXPECT_EQ(clock.frame, 3U);
+}
+
+TEST(AnimationClock, StoppedTimeStaysPut) {
+    AnimationClock clock;
+    AnimationTime a;
+    a.Start(clock);
+    clock.Advance(1.0);
+    a.Stop(clock);
+    EXPECT_FALSE(a.Running());
+    clock.Advance(5.0);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 1.0);
+    //starting again carries on from where it stopped
+    a.Start(clock);
+    clock.Advance(0.5);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 1.5);
+}
+
+TEST(AnimationClock, SetMovesRunningAndStoppedTime) {
+    AnimationClock clock;
+    clock.Advance(3.0);
+    AnimationTime a;
+    a.Set(clock, 2.0);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 2.0);
+    a.Start(clock);
+    clock.Advance(1.0);
+    a.Set(clock, 0.0);
+    EXPECT_TRUE(a.Running());
+    EXPECT_DOUBLE_EQ(a.Time(clock), 0.0);
+    clock.Advance(0.25);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 0.25);
+}
+
+TEST(AnimationClock, StartAndStopTwiceChangeNothing) {
+    AnimationClock clock;
+    AnimationTime a;
+    a.Start(clock);
+    clock.Advance(1.0);
+    a.Start(clock);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 1.0);
+    a.Stop(clock);
+    clock.Advance(1.0);
+    a.Stop(clock);
+    EXPECT_DOUBLE_EQ(a.Time(clock), 1.0);
+}
+
+TEST(AnimationClock, DrawnLastFrame) {
+    AnimationClock clock;
+    clock.Advance(0.1);
+    const unsigned int drawn = clock.frame;
+    //still drawable this frame, and the one right after
+    EXPECT_TRUE(clock.DrawnLastFrame(drawn));
+    clock.Advance(0.1);
+    EXPECT_TRUE(clock.DrawnLastFrame(drawn));
+    clock.Advance(0.1);
+    EXPECT_FALSE(clock.DrawnLastFrame(drawn));
+}
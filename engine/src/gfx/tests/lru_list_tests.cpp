@@ -0,0 +1,105 @@
+/*
+ * lru_list_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "gfx/lru_list.h"
+
+namespace {
+struct Entry {
+    std::string key;
+    int value = 0;
+};
+
+Entry *FindKey(LruList<Entry> &list, const std::string &key) {
+    return list.Find([&key](const Entry &entry) {
+        return entry.key == key;
+    });
+}
+
+void AddKey(LruList<Entry> &list, const std::string &key, int value, size_t capacity) {
+    Entry &entry = list.Add(capacity);
+    entry.key = key;
+    entry.value = value;
+}
+}
+
+TEST(LruList, FindsWhatWasAdded) {
+    LruList<Entry> list;
+    AddKey(list, "Sol/Sol", 1, 4);
+    AddKey(list, "Vega/Vega", 2, 4);
+    ASSERT_NE(FindKey(list, "Sol/Sol"), nullptr);
+    EXPECT_EQ(FindKey(list, "Sol/Sol")->value, 1);
+    EXPECT_EQ(FindKey(list, "Vega/Vega")->value, 2);
+    EXPECT_EQ(FindKey(list, "Sirius/Sirius"), nullptr);
+}
+
+TEST(LruList, EvictsTheLeastRecentlyUsed) {
+    LruList<Entry> list;
+    AddKey(list, "a", 1, 3);
+    AddKey(list, "b", 2, 3);
+    AddKey(list, "c", 3, 3);
+    //using a makes b the oldest, even though a was added first
+    ASSERT_NE(FindKey(list, "a"), nullptr);
+    AddKey(list, "d", 4, 3);
+    EXPECT_EQ(list.size(), 3U);
+    EXPECT_EQ(FindKey(list, "b"), nullptr);
+    EXPECT_NE(FindKey(list, "a"), nullptr);
+    EXPECT_NE(FindKey(list, "c"), nullptr);
+    EXPECT_NE(FindKey(list, "d"), nullptr);
+}
+
+TEST(LruList, BouncingBetweenTwoSystemsKeepsBoth) {
+    LruList<Entry> list;
+    AddKey(list, "home", 1, 2);
+    AddKey(list, "away", 2, 2);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_NE(FindKey(list, "home"), nullptr);
+        EXPECT_NE(FindKey(list, "away"), nullptr);
+    }
+    AddKey(list, "new", 3, 2);
+    //away was used last, so home goes
+    EXPECT_EQ(FindKey(list, "home"), nullptr);
+    EXPECT_NE(FindKey(list, "away"), nullptr);
+}
+
+TEST(LruList, ShrinkingCapacityEvictsOldestFirst) {
+    LruList<Entry> list;
+    AddKey(list, "a", 1, 4);
+    AddKey(list, "b", 2, 4);
+    AddKey(list, "c", 3, 4);
+    AddKey(list, "d", 4, 4);
+    AddKey(list, "e", 5, 2);
+    EXPECT_EQ(list.size(), 2U);
+    EXPECT_NE(FindKey(list, "d"), nullptr);
+    EXPECT_NE(FindKey(list, "e"), nullptr);
+    //a capacity below one still keeps the newest
+    AddKey(list, "f", 6, 0);
+    EXPECT_EQ(list.size(), 1U);
+    EXPECT_EQ(FindKey(list, "f")->value, 6);
+}
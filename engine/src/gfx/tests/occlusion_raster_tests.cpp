@@ -0,0 +1,162 @@
+/*
+ * occlusion_raster_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "gfx_generic/occlusion_raster.h"
+
+//A camera far from the system origin looking down a skewed axis, with a 4:3 view
+struct TestView {
+    QVector eye;
+    Vector axis_x;
+    Vector axis_y;
+    Vector forward;
+
+    TestView() : eye(1.0e7, -2.0e6, 3.0e6), axis_x(1, 0, 0), axis_y(0, 1, 0), forward(0.3, 0.2, 1) {
+        forward.Normalize();
+        axis_x = axis_y.Cross(forward);
+        axis_x.Normalize();
+        axis_y = forward.Cross(axis_x);
+    }
+
+    void Apply(OcclusionRaster &raster) const {
+        raster.SetView(eye, axis_x, axis_y, forward, -1.33F, 1.33F, -1, 1, 1);
+    }
+
+    //the point at the given screen tangents and distance along the view
+    QVector At(double u, double v, double d) const {
+        return eye + ((axis_x * u + axis_y * v + forward) * d).Cast();
+    }
+};
+
+TEST(OcclusionRaster, PlanetHidesShipsBehindIt) {
+    const TestView view;
+    OcclusionRaster raster;
+    view.Apply(raster);
+    EXPECT_FALSE(raster.IsOccluded(view.At(0, 0, 100000), 50));
+    ASSERT_TRUE(raster.AddOccluder(view.At(0, 0, 20000), 6000));
+    EXPECT_EQ(1U, raster.Occluders());
+
+    EXPECT_TRUE(raster.IsOccluded(view.At(0, 0, 100000), 50));
+    EXPECT_TRUE(raster.IsOccluded(view.At(0.1, -0.1, 40000), 500));
+    //in front of the planet, beside it, and peeking over its limb
+    EXPECT_FALSE(raster.IsOccluded(view.At(0, 0, 10000), 50));
+    EXPECT_FALSE(raster.IsOccluded(view.At(0.5, 0, 100000), 50));
+    EXPECT_FALSE(raster.IsOccluded(view.At(0.3, 0, 100000), 2000));
+    //too big to hide
+    EXPECT_FALSE(raster.IsOccluded(view.At(0, 0, 100000), 60000));
+
+    raster.Clear();
+    EXPECT_EQ(0U, raster.Occluders());
+    EXPECT_FALSE(raster.IsOccluded(view.At(0, 0, 100000), 50));
+}
+
+TEST(OcclusionRaster, RejectsOccludersAroundOrBehindTheEye) {
+    const TestView view;
+    OcclusionRaster raster;
+    view.Apply(raster);
+    EXPECT_FALSE(raster.AddOccluder(view.At(0, 0, 100), 1000));
+    EXPECT_FALSE(raster.AddOccluder(view.At(0, 0, -20000), 6000));
+    //smaller than a texel
+    EXPECT_FALSE(raster.AddOccluder(view.At(0, 0, 20000), 10));
+    EXPECT_EQ(0U, raster.Occluders());
+}
+
+//Ray from the eye along dir (normalized) to the nearest point of the sphere, or -1 if it misses
+static double RayEnter(const QVector &eye, const QVector &dir, const QVector &center, double radius) {
+    const QVector rel = center - eye;
+    const double along = rel.Dot(dir);
+    const double miss2 = rel.MagnitudeSquared() - along * along;
+    if (miss2 > radius * radius || along <= 0) {
+        return -1;
+    }
+    return along - sqrt(radius * radius - miss2);
+}
+
+struct TestSphere {
+    QVector center;
+    float radius;
+};
+
+TEST(OcclusionRaster, HiddenSpheresAreHiddenAlongEveryRay) {
+    const TestView view;
+    OcclusionRaster raster(64, 32);
+    view.Apply(raster);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> tangent(-0.8, 0.8);
+    std::uniform_real_distribution<double> unit(0, 1);
+
+    std::vector<TestSphere> occluders;
+    for (int k = 0; k < 6; ++k) {
+        TestSphere occluder{view.At(tangent(rng), tangent(rng), 20000 + 60000 * unit(rng)),
+                static_cast<float>(2000 + 8000 * unit(rng))};
+        if (raster.AddOccluder(occluder.center, occluder.radius)) {
+            occluders.push_back(occluder);
+        }
+    }
+    ASSERT_GT(occluders.size(), 2U);
+
+    size_t hidden = 0;
+    for (int k = 0; k < 3000; ++k) {
+        const QVector center = view.At(tangent(rng), tangent(rng), 5000 + 200000 * unit(rng));
+        const float radius = static_cast<float>(10 + 3000 * unit(rng));
+        const bool occluded = raster.IsOccluded(center, radius);
+        EXPECT_EQ(raster.IsOccludedScalar(center, radius), occluded) << "sphere " << k;
+        if (!occluded) {
+            continue;
+        }
+        ++hidden;
+        //every sampled ray into the sphere must hit an occluder first
+        for (int s = 0; s < 64; ++s) {
+            QVector target = center + QVector(unit(rng) - 0.5, unit(rng) - 0.5, unit(rng) - 0.5) * radius;
+            QVector dir = target - view.eye;
+            dir.Normalize();
+            //the raster only covers the screen
+            const double along = dir.Dot(view.forward.Cast());
+            if (std::fabs(dir.Dot(view.axis_x.Cast()) / along) >= 1.33
+                    || std::fabs(dir.Dot(view.axis_y.Cast()) / along) >= 1) {
+                continue;
+            }
+            const double enter = RayEnter(view.eye, dir, center, radius);
+            if (enter < 0) {
+                continue;
+            }
+            double blocked = -1;
+            for (const TestSphere &occluder : occluders) {
+                const double t = RayEnter(view.eye, dir, occluder.center, occluder.radius);
+                if (t >= 0 && (blocked < 0 || t < blocked)) {
+                    blocked = t;
+                }
+            }
+            EXPECT_GE(blocked, 0) << "sphere " << k << " sample " << s;
+            EXPECT_LT(blocked, enter) << "sphere " << k << " sample " << s;
+        }
+    }
+    EXPECT_GT(hidden, 100U);
+}
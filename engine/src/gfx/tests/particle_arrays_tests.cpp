@@ -0,0 +1,121 @@
+/*
+ * particle_arrays_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gfx_generic/particle_arrays.h"
+
+TEST(ParticleArrays, UpdateMovesAndFades) {
+    ParticleArrays particles;
+    particles.Add(QVector(1, 2, 3), Vector(10, 0, -4), GFXColor(1, 0.5, 0.25, 1), 2.0F);
+    particles.Add(QVector(-5, 0, 0), Vector(0, 2, 0), GFXColor(1, 1, 1, 0.5), 1.0F);
+    particles.Update(0.5F, 0.2F, false);
+    EXPECT_DOUBLE_EQ(particles.loc_x[0], 6.0);
+    EXPECT_DOUBLE_EQ(particles.loc_y[0], 2.0);
+    EXPECT_DOUBLE_EQ(particles.loc_z[0], 1.0);
+    EXPECT_DOUBLE_EQ(particles.loc_y[1], 1.0);
+    EXPECT_FLOAT_EQ(particles.col_a[0], 0.9F);
+    EXPECT_FLOAT_EQ(particles.col_a[1], 0.4F);
+    //only the alpha fades unless asked for
+    EXPECT_FLOAT_EQ(particles.col_g[0], 0.5F);
+    particles.Update(1.0F, 0.3F, true);
+    EXPECT_FLOAT_EQ(particles.col_r[0], 0.7F);
+    EXPECT_FLOAT_EQ(particles.col_b[0], 0.0F);
+    EXPECT_FLOAT_EQ(particles.col_a[1], 0.1F);
+}
+
+TEST(ParticleArrays, LocationLooksBetweenAtoms) {
+    ParticleArrays particles;
+    particles.Add(QVector(100, 0, 0), Vector(10, 20, 0), GFXColor(1, 1, 1, 1), 1.0F);
+    const QVector l = particles.Location(0, -0.05F);
+    EXPECT_NEAR(l.i, 99.5, 1e-5);
+    EXPECT_NEAR(l.j, -1.0, 1e-5);
+    EXPECT_DOUBLE_EQ(l.k, 0.0);
+}
+
+TEST(ParticleArrays, RemoveMovesTheLastParticleIntoTheHole) {
+    ParticleArrays particles;
+    for (int i = 0; i < 4; ++i) {
+        particles.Add(QVector(i, 0, 0), Vector(0, i, 0), GFXColor(1, 1, 1, 1), static_cast<float>(i));
+    }
+    particles.Remove(1);
+    ASSERT_EQ(particles.size(), 3U);
+    EXPECT_DOUBLE_EQ(particles.loc_x[1], 3.0);
+    EXPECT_FLOAT_EQ(particles.vel_y[1], 3.0F);
+    EXPECT_FLOAT_EQ(particles.sizes[1], 3.0F);
+    EXPECT_DOUBLE_EQ(particles.loc_x[2], 2.0);
+    //the last one goes without moving anything
+    particles.Remove(2);
+    ASSERT_EQ(particles.size(), 2U);
+    EXPECT_DOUBLE_EQ(particles.loc_x[0], 0.0);
+    EXPECT_DOUBLE_EQ(particles.loc_x[1], 3.0);
+}
+
+TEST(ParticleArrays, RemoveFadedKeepsTheRest) {
+    ParticleArrays particles;
+    const float alphas[] = {0.05F, 0.5F, 0.0F, 0.1F, 0.9F, 0.02F};
+    for (int i = 0; i < 6; ++i) {
+        particles.Add(QVector(i, 0, 0), Vector(0, 0, 0), GFXColor(1, 1, 1, alphas[i]), static_cast<float>(i));
+    }
+    particles.RemoveFaded(0.1F);
+    ASSERT_EQ(particles.size(), 2U);
+    //every array was moved along with the alpha
+    for (size_t i = 0; i < particles.size(); ++i) {
+        EXPECT_FLOAT_EQ(particles.col_a[i], alphas[static_cast<int>(particles.sizes[i])]);
+        EXPECT_DOUBLE_EQ(particles.loc_x[i], particles.sizes[i]);
+    }
+    particles.RemoveFaded(1.0F);
+    EXPECT_EQ(particles.size(), 0U);
+}
+
+TEST(ParticleArrays, SortByDepthPutsTheFarthestFirst) {
+    std::mt19937 random(34);
+    std::uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+    ParticleArrays particles;
+    for (int i = 0; i < 500; ++i) {
+        particles.Add(QVector(coordinate(random), coordinate(random), coordinate(random)),
+                Vector(coordinate(random), coordinate(random), coordinate(random)), GFXColor(1, 1, 1, 1), 1.0F);
+    }
+    const QVector camera(1.0e6, -2.0e5, 3.0e5);
+    const float offset = -0.03F;
+    const std::vector<ParticleArrays::DepthKey> &order = particles.SortByDepth(camera, offset);
+    ASSERT_EQ(order.size(), particles.size());
+    std::vector<bool> seen(particles.size());
+    double last = HUGE_VAL;
+    for (const ParticleArrays::DepthKey &k : order) {
+        ASSERT_LT(k.index, particles.size());
+        EXPECT_FALSE(seen[k.index]);
+        seen[k.index] = true;
+        //sorted on float keys, so only as exact as a float
+        const double distance = (particles.Location(k.index, offset) - camera).MagnitudeSquared();
+        EXPECT_LE(distance, last * (1.0 + 1e-6));
+        last = distance;
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * radix_sort_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "gfx/mesh_sort_key.h"
+#include "gfx/radix_sort.h"
+
+namespace {
+struct Item {
+    uint64_t key;
+    size_t index;
+};
+
+uint64_t KeyOf(const Item &item) {
+    return item.key;
+}
+}
+
+TEST(RadixSort, FloatSortKeyOrdersLikeFloats) {
+    const float values[] = {-1.0e30F, -2.5F, -1.0F, -1.0e-30F, 0.0F, 1.0e-30F, 1.0F, 2.5F, 1.0e30F};
+    for (size_t i = 1; i < sizeof(values) / sizeof(values[0]); ++i) {
+        EXPECT_LT(FloatSortKey(values[i - 1]), FloatSortKey(values[i])) << values[i - 1] << " < " << values[i];
+    }
+}
+
+TEST(RadixSort, MatchesStableSort) {
+    std::mt19937_64 rng(7);
+    std::vector<Item> items;
+    for (size_t i = 0; i < 5000; ++i) {
+        //few distinct keys, so stability is actually exercised
+        items.push_back({rng() % 64 * 0x0101010101010101ULL, i});
+    }
+    std::vector<Item> expected = items;
+    std::stable_sort(expected.begin(), expected.end(), [](const Item &a, const Item &b) {
+        return a.key < b.key;
+    });
+    std::vector<Item> scratch;
+    RadixSort(items, scratch, KeyOf);
+    ASSERT_EQ(items.size(), expected.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(items[i].key, expected[i].key);
+        EXPECT_EQ(items[i].index, expected[i].index);
+    }
+}
+
+TEST(RadixSort, SkippedBytesStillSort) {
+    //only byte 5 varies, so an odd number of passes runs and the result lands in scratch first
+    std::vector<Item> items;
+    for (size_t i = 0; i < 100; ++i) {
+        items.push_back({0x1100000000000022ULL | (static_cast<uint64_t>((i * 37) % 100) << 40), i});
+    }
+    std::vector<Item> scratch;
+    RadixSort(items, scratch, KeyOf);
+    ASSERT_EQ(items.size(), 100U);
+    for (size_t i = 1; i < items.size(); ++i) {
+        EXPECT_LT(items[i - 1].key, items[i].key);
+    }
+    //sorting again reuses scratch and leaves the order alone
+    RadixSort(items, scratch, KeyOf);
+    for (size_t i = 1; i < items.size(); ++i) {
+        EXPECT_LT(items[i - 1].key, items[i].key);
+    }
+}
+
+TEST(RadixSort, TrivialInputs) {
+    std::vector<Item> items;
+    std::vector<Item> scratch;
+    RadixSort(items, scratch, KeyOf);
+    EXPECT_TRUE(items.empty());
+    items.push_back({42, 0});
+    RadixSort(items, scratch, KeyOf);
+    ASSERT_EQ(items.size(), 1U);
+    EXPECT_EQ(items[0].key, 42U);
+}
+
+TEST(MeshSortKey, FieldsTakePrecedenceInOrder) {
+    //sequence beats everything after it
+    EXPECT_LT(MeshSortKey(0, 1, 1, 100.0F, 15, 1023, 0xffff), MeshSortKey(1, 0, 0, 0.0F, 0, 0, 0));
+    //opaques before transparents
+    EXPECT_LT(MeshSortKey(3, 0, 0, 0.0F, 15, 1023, 0xffff), MeshSortKey(3, 1, 0, 0.0F, 0, 0, 0));
+    //z-sorted transparents last
+    EXPECT_LT(MeshSortKey(3, 1, 0, 0.0F, 15, 1023, 0xffff), MeshSortKey(3, 1, 1, -1.0e6F, 0, 0, 0));
+    //depth then pass then program then textures
+    EXPECT_LT(MeshSortKey(3, 1, 1, -200.0F, 15, 1023, 0xffff), MeshSortKey(3, 1, 1, -100.0F, 0, 0, 0));
+    EXPECT_LT(MeshSortKey(3, 0, 0, 0.0F, 1, 1023, 0xffff), MeshSortKey(3, 0, 0, 0.0F, 2, 0, 0));
+    EXPECT_LT(MeshSortKey(3, 0, 0, 0.0F, 1, 5, 0xffff), MeshSortKey(3, 0, 0, 0.0F, 1, 6, 0));
+    EXPECT_LT(MeshSortKey(3, 0, 0, 0.0F, 1, 5, 7), MeshSortKey(3, 0, 0, 0.0F, 1, 5, 8));
+}
+
+TEST(MeshSortKey, DepthOnlyCountsWhenZSorted) {
+    EXPECT_EQ(MeshSortKey(2, 1, 0, -10.0F, 1, 4, 9), MeshSortKey(2, 1, 0, -500.0F, 1, 4, 9));
+    EXPECT_NE(MeshSortKey(2, 1, 1, -10.0F, 1, 4, 9), MeshSortKey(2, 1, 1, -500.0F, 1, 4, 9));
+}
+
+TEST(MeshSortKey, OutOfRangeFieldsClamp) {
+    EXPECT_EQ(MeshSortKey(-5, 0, 0, 0.0F, 0, 0, 0), MeshSortKey(0, 0, 0, 0.0F, 0, 0, 0));
+    EXPECT_EQ(MeshSortKey(400, 0, 0, 0.0F, 0, 0, 0), MeshSortKey(255, 0, 0, 0.0F, 0, 0, 0));
+    EXPECT_EQ(MeshSortKey(1, 0, 0, 0.0F, 30, 0, 0), MeshSortKey(1, 0, 0, 0.0F, 15, 0, 0));
+}
@@ -0,0 +1,177 @@
+/*
+ * sphere_cull_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "gfx_generic/occlusion_raster.h"
+#include "gfx_generic/sphere_cull.h"
+#include "src/gfxlib.h"
+
+//A camera far from the system origin, looking down a skewed axis
+static QVector SetupCamera(double frustum[6][4]) {
+    const Vector eye(0.3, 0.2, 1);
+    const QVector center(1.0e7, -2.0e6, 3.0e6);
+    GFXLoadIdentity(MODEL);
+    GFXPerspective(78, 1.33, 1, 1000000, 0);
+    GFXLookAt(eye, center, Vector(0, 1, 0));
+    GFXCalculateFrustum();
+    GFXGetFrustum(frustum);
+    return center + eye.Cast();
+}
+
+struct TestSphere {
+    QVector center;
+    float radius;
+    float max_distance;
+};
+
+static std::vector<TestSphere> RandomSpheres(const QVector &camera, size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> offset(-50000, 50000);
+    std::uniform_real_distribution<float> radius(0.5F, 800.0F);
+    std::uniform_real_distribution<float> distance(0.0F, 60000.0F);
+    std::vector<TestSphere> spheres(count);
+    for (TestSphere &sphere : spheres) {
+        const double i = offset(rng);
+        const double j = offset(rng);
+        const double k = offset(rng);
+        sphere.center = camera + QVector(i, j, k);
+        sphere.radius = radius(rng);
+        sphere.max_distance = distance(rng);
+    }
+    return spheres;
+}
+
+TEST(SphereCuller, BatchedMatchesScalarReference) {
+    double frustum[6][4];
+    const QVector camera = SetupCamera(frustum);
+    SphereCuller culler;
+    culler.SetFrustum(frustum, camera);
+    //an odd count, so the scalar tail of the batched path runs too
+    for (const TestSphere &sphere : RandomSpheres(camera, 10001)) {
+        culler.Add(sphere.center, sphere.radius, sphere.max_distance);
+    }
+
+    culler.CullScalar();
+    const std::vector<unsigned char> reference = culler.Results();
+    const std::vector<unsigned int> reference_visible = culler.Visible();
+    culler.Cull();
+
+    ASSERT_EQ(reference.size(), culler.Results().size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+        EXPECT_EQ(reference[i], culler.Results()[i]) << "sphere " << i;
+    }
+    EXPECT_EQ(reference_visible, culler.Visible());
+    EXPECT_FALSE(reference_visible.empty());
+    EXPECT_LT(reference_visible.size(), reference.size());
+}
+
+TEST(SphereCuller, AgreesWithGFXSphereInFrustum) {
+    double frustum[6][4];
+    const QVector camera = SetupCamera(frustum);
+    SphereCuller culler;
+    culler.SetFrustum(frustum, camera);
+    const std::vector<TestSphere> spheres = RandomSpheres(camera, 2000);
+    for (const TestSphere &sphere : spheres) {
+        culler.Add(sphere.center, sphere.radius);
+    }
+    culler.Cull();
+
+    size_t compared = 0;
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        const QVector &center = spheres[i].center;
+        const float r = spheres[i].radius;
+        //skip spheres grazing a plane, where float and double may round differently
+        bool grazing = false;
+        for (int p = 0; p < 5; ++p) {
+            double d = frustum[p][0] * center.i + frustum[p][1] * center.j + frustum[p][2] * center.k + frustum[p][3];
+            grazing = grazing || std::fabs(d + r) < 1.0;
+        }
+        if (grazing) {
+            continue;
+        }
+        const bool outside = GFXSphereInFrustum(frustum, center, r) == 0;
+        EXPECT_EQ(outside, (culler.Results()[i] & SphereCuller::OUTSIDE_FRUSTUM) != 0) << "sphere " << i;
+        ++compared;
+    }
+    EXPECT_GT(compared, 1900U);
+}
+
+TEST(SphereCuller, DistanceLimitUsesNearestPoint) {
+    double frustum[6][4];
+    const QVector camera = SetupCamera(frustum);
+    //the camera looks down -eye
+    Vector forward(-0.3, -0.2, -1);
+    forward.Normalize();
+    SphereCuller culler;
+    culler.SetFrustum(frustum, camera);
+    culler.Add(camera + (forward * 1000).Cast(), 10, 995);
+    culler.Add(camera + (forward * 1000).Cast(), 10, 985);
+    culler.Add(camera + (forward * 1000).Cast(), 10, 0);
+    culler.Add(camera - (forward * 1000).Cast(), 10, 0);
+    culler.Cull();
+
+    EXPECT_EQ(SphereCuller::VISIBLE, culler.Results()[0]);
+    EXPECT_EQ(SphereCuller::BEYOND_DISTANCE, culler.Results()[1]);
+    EXPECT_EQ(SphereCuller::VISIBLE, culler.Results()[2]);
+    EXPECT_EQ(SphereCuller::OUTSIDE_FRUSTUM, culler.Results()[3]);
+    EXPECT_EQ((std::vector<unsigned int>{0, 2}), culler.Visible());
+}
+
+TEST(SphereCuller, PlanetRasterizedBeforeTheBatchHidesUnitsBehindIt) {
+    double frustum[6][4];
+    const QVector camera = SetupCamera(frustum);
+    Vector forward(-0.3, -0.2, -1);
+    forward.Normalize();
+    Vector axis_x = Vector(0, 1, 0).Cross(forward);
+    axis_x.Normalize();
+    const Vector axis_y = forward.Cross(axis_x);
+    float left, right, bottom, top, nearval, farval;
+    GFXGetFrustumVars(true, &left, &right, &bottom, &top, &nearval, &farval);
+    OcclusionRaster raster;
+    raster.SetView(camera, axis_x, axis_y, forward, left, right, bottom, top, nearval);
+    //as in StarSystem::Draw, the planet is rasterized before the units are culled
+    ASSERT_TRUE(raster.AddOccluder(camera + (forward * 20000).Cast(), 6000));
+
+    SphereCuller culler;
+    culler.SetFrustum(frustum, camera);
+    //behind the planet, in front of it, beside it, and behind the camera
+    culler.Add(camera + (forward * 100000).Cast(), 50);
+    culler.Add(camera + (forward * 10000).Cast(), 50);
+    culler.Add(camera + ((forward + axis_x * 0.5F) * 100000).Cast(), 50);
+    culler.Add(camera - (forward * 1000).Cast(), 10);
+    culler.Cull();
+    culler.Occlude(raster);
+
+    EXPECT_EQ(SphereCuller::HIDDEN, culler.Results()[0]);
+    EXPECT_EQ(SphereCuller::VISIBLE, culler.Results()[1]);
+    EXPECT_EQ(SphereCuller::VISIBLE, culler.Results()[2]);
+    EXPECT_EQ(SphereCuller::OUTSIDE_FRUSTUM, culler.Results()[3]);
+    EXPECT_EQ((std::vector<unsigned int>{1, 2}), culler.Visible());
+}
@@ -0,0 +1,211 @@
+/*
+ * texture_residency_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "gfx/texture_residency.h"
+#include "gldrv/gfx_null.h"
+#include "src/gfxlib.h"
+
+static const size_t MB = 1024 * 1024;
+
+//Plain RGBA textures without mipmaps, so the bookkeeping matches what the null backend counts
+static int AddTexture(TextureResidency &residency, unsigned int dimension) {
+    return residency.Register(dimension, dimension, 4, false, 1, TextureResidency::CATEGORY_SPRITE);
+}
+
+//Does the transfers the way Texture does, and reports them back
+static void Apply(TextureResidency &residency) {
+    for (const TextureResidency::Transfer &transfer : residency.Plan()) {
+        residency.Resident(transfer.id, transfer.max_dimension);
+    }
+}
+
+TEST(TextureResidency, BytesFollowTheMipLevel) {
+    EXPECT_EQ(4 * MB, TextureResidency::Bytes(1024, 1024, 4, false, 1, 65536));
+    EXPECT_EQ(256U * 128U * 4U, TextureResidency::Bytes(1024, 512, 4, false, 1, 256));
+    EXPECT_EQ(256U * 256U * 6U / 2U * 4U / 3U, TextureResidency::Bytes(256, 256, 0.5F, true, 6, 65536));
+    unsigned int width = 512, height = 64;
+    TextureResidency::Fit(width, height, TextureResidency::STUB_DIMENSION);
+    EXPECT_EQ(4U, width);
+    EXPECT_EQ(1U, height);
+}
+
+TEST(TextureResidency, NoBudgetMeansNoTransfers) {
+    TextureResidency residency;
+    for (int i = 0; i < 10; ++i) {
+        AddTexture(residency, 1024);
+    }
+    for (int frame = 0; frame < 5000; ++frame) {
+        EXPECT_TRUE(residency.Plan().empty());
+    }
+    EXPECT_EQ(40 * MB, residency.ResidentBytes());
+}
+
+TEST(TextureResidency, EvictsTheLongestUnusedFirst) {
+    TextureResidency residency;
+    TextureResidency::Settings settings;
+    settings.budget_bytes = 13 * MB;
+    settings.idle_frames = 10;
+    residency.SetSettings(settings);
+    //three 4MB textures, used one after the other, then a fourth in use
+    std::vector<int> ids;
+    for (int i = 0; i < 3; ++i) {
+        ids.push_back(AddTexture(residency, 1024));
+        residency.Touch(ids.back());
+        for (int frame = 0; frame < 5; ++frame) {
+            Apply(residency);
+        }
+    }
+    for (int frame = 0; frame < 10; ++frame) {
+        Apply(residency);
+    }
+    const int in_use = AddTexture(residency, 1024);
+    residency.Touch(in_use);
+    Apply(residency);
+
+    EXPECT_EQ(TextureResidency::STUB_DIMENSION, residency.ResidentDimension(ids[0]));
+    EXPECT_EQ(1024U, residency.ResidentDimension(ids[1]));
+    EXPECT_EQ(1024U, residency.ResidentDimension(ids[2]));
+    EXPECT_EQ(1024U, residency.ResidentDimension(in_use));
+    EXPECT_LE(residency.ResidentBytes(), settings.budget_bytes);
+    EXPECT_EQ(1U, residency.GetStats(TextureResidency::CATEGORY_SPRITE).evicted);
+    EXPECT_EQ(1U, residency.GetStats(TextureResidency::CATEGORY_SPRITE).evictions);
+
+    //bound again, it comes back once there is room
+    residency.Unregister(ids[1]);
+    residency.Unregister(ids[2]);
+    residency.Touch(ids[0]);
+    Apply(residency);
+    EXPECT_EQ(1024U, residency.ResidentDimension(ids[0]));
+    EXPECT_EQ(1U, residency.GetStats(TextureResidency::CATEGORY_SPRITE).reloads);
+}
+
+TEST(TextureResidency, MeshesDrawnSmallGoDownAMip) {
+    TextureResidency residency;
+    TextureResidency::Settings settings;
+    settings.budget_bytes = 8 * MB;
+    settings.transfers_per_frame = 1;
+    residency.SetSettings(settings);
+    const int far_away = AddTexture(residency, 1024);
+    const int close_by = AddTexture(residency, 1024);
+    const int sprite = AddTexture(residency, 512);
+    residency.NoteScreenSize(far_away, 40);
+    residency.NoteScreenSize(close_by, 900);
+    residency.Touch(sprite);
+    Apply(residency);
+
+    //only one transfer a frame, and the far away mesh saves the most
+    EXPECT_EQ(128U, residency.ResidentDimension(far_away));
+    EXPECT_EQ(1024U, residency.ResidentDimension(close_by));
+    EXPECT_EQ(512U, residency.ResidentDimension(sprite));
+    EXPECT_LE(residency.ResidentBytes(), settings.budget_bytes);
+    EXPECT_EQ(1U, residency.GetStats(TextureResidency::CATEGORY_MESH).reduced);
+    EXPECT_EQ(0U, residency.GetStats(TextureResidency::CATEGORY_SPRITE).reduced);
+
+    //coming closer brings it back up, as far as the budget allows
+    residency.NoteScreenSize(far_away, 2000);
+    residency.NoteScreenSize(close_by, 900);
+    Apply(residency);
+    EXPECT_EQ(512U, residency.ResidentDimension(far_away));
+    EXPECT_LE(residency.ResidentBytes(), settings.budget_bytes);
+}
+
+TEST(TextureResidency, PinnedAndEnvironmentTexturesStay) {
+    TextureResidency residency;
+    TextureResidency::Settings settings;
+    settings.budget_bytes = MB;
+    settings.idle_frames = 1;
+    residency.SetSettings(settings);
+    const int cube = residency.Register(512, 512, 4, true, 6, TextureResidency::CATEGORY_ENVIRONMENT);
+    const int pinned = AddTexture(residency, 1024);
+    residency.Pin(pinned);
+    for (int frame = 0; frame < 10; ++frame) {
+        EXPECT_TRUE(residency.Plan().empty());
+    }
+    EXPECT_EQ(512U, residency.ResidentDimension(cube));
+    EXPECT_EQ(1024U, residency.ResidentDimension(pinned));
+}
+
+//The policy driving real texture handles on the null backend, over a session that keeps loading new textures
+TEST(TextureResidency, StaysWithinBudgetOnTheNullBackend) {
+    GFXNull::Reset();
+    GFXNull::SetRecording(true);
+    TextureResidency residency;
+    TextureResidency::Settings settings;
+    settings.budget_bytes = 16 * MB;
+    settings.idle_frames = 30;
+    settings.transfers_per_frame = 4;
+    residency.SetSettings(settings);
+
+    std::map<int, int> handles;
+    std::map<int, unsigned int> dimensions;
+    std::map<int, unsigned int> uploaded;
+    std::vector<int> live;
+    for (int frame = 0; frame < 600; ++frame) {
+        //a new 1MB or 4MB texture every few frames, used for a while
+        if (frame % 5 == 0) {
+            const unsigned int dimension = (frame % 2) ? 512 : 1024;
+            int handle = -1;
+            GFXCreateTexture(dimension, dimension, RGBA32, &handle, nullptr, 0, BILINEAR);
+            GFXTransferTexture(nullptr, handle, dimension, dimension, RGBA32);
+            const int id = AddTexture(residency, dimension);
+            handles[id] = handle;
+            dimensions[id] = dimension;
+            live.push_back(id);
+        }
+        for (size_t i = live.size() > 3 ? live.size() - 3 : 0; i < live.size(); ++i) {
+            residency.Touch(live[i]);
+        }
+        for (const TextureResidency::Transfer &transfer : residency.Plan()) {
+            const unsigned int dimension = dimensions[transfer.id];
+            GFXTransferTexture(nullptr, handles[transfer.id], dimension, dimension, RGBA32, TEXTURE_2D,
+                    transfer.max_dimension);
+            residency.Resident(transfer.id, transfer.max_dimension);
+        }
+        //the textures in use always fit, so the budget holds from one frame to the next
+        EXPECT_LE(residency.ResidentBytes(), settings.budget_bytes + 4 * MB) << "frame " << frame;
+    }
+
+    //what the null backend was last sent for each handle adds up to the resident bytes
+    const std::vector<GFXNull::Command> &log = GFXNull::GetCommandLog();
+    for (size_t c = 0; c < log.size(); ++c) {
+        if (log[c].type == GFXNull::CMD_TRANSFER_TEXTURE) {
+            uploaded[log[c].arg0] = log[c].count;
+        }
+    }
+    GFXNull::SetRecording(false);
+    size_t total = 0;
+    for (const auto &handle : uploaded) {
+        total += handle.second;
+    }
+    EXPECT_EQ(residency.ResidentBytes(), total);
+    const TextureResidency::Stats stats = residency.GetStats(TextureResidency::CATEGORY_SPRITE);
+    EXPECT_GT(stats.evictions, 50U);
+    EXPECT_EQ(stats.textures, live.size());
+}
@@ -0,0 +1,202 @@
+/*
+ * weapon_instances_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "gfx_generic/weapon_instances.h"
+#include "src/gfxlib.h"
+#include "gldrv/gfx_null.h"
+
+static const QVector camera(1.0e9, -2.5e8, 4.0e7);
+
+static void ExpectSameInstance(const WeaponInstances::Instance &a, const WeaponInstances::Instance &b) {
+    for (int c = 0; c < 3; ++c) {
+        EXPECT_FLOAT_EQ(a.position[c], b.position[c]);
+        EXPECT_FLOAT_EQ(a.direction[c], b.direction[c]);
+        EXPECT_FLOAT_EQ(a.up[c], b.up[c]);
+    }
+    EXPECT_EQ(a.length, b.length);
+    EXPECT_EQ(a.radius, b.radius);
+}
+
+static void QueueRandomBolts(WeaponInstances &stream, std::mt19937 &random, int count) {
+    std::uniform_real_distribution<double> offset(-3000.0, 3000.0);
+    std::uniform_real_distribution<float> axis(-1.0F, 1.0F);
+    for (int i = 0; i < count; ++i) {
+        const QVector prev = camera + QVector(offset(random), offset(random), offset(random));
+        const QVector cur = prev + QVector(offset(random), offset(random), offset(random)) * 0.01;
+        const Vector direction(axis(random), axis(random), 1.5F);
+        stream.AddBolt(prev, cur, direction * 3.0F, Vector(0, 2, 0) - direction * (2 * direction.j / direction.Dot(direction)));
+    }
+}
+
+TEST(WeaponInstances, SSEAgreesWithScalar) {
+    std::mt19937 random(17);
+    WeaponInstances simd;
+    WeaponInstances scalar;
+    for (WeaponInstances *stream : {&simd, &scalar}) {
+        stream->Begin(camera, 1.0e-6F, 0.25F);
+        stream->BeginBatch();
+        stream->SetStyle(0.5F, 20.0F, GFXColor(1, 0.5, 0.25, 1), 0, 4.0F);
+    }
+    //an odd count, so the tail is taken by the scalar code in both
+    std::mt19937 same(random);
+    QueueRandomBolts(simd, random, 1003);
+    QueueRandomBolts(scalar, same, 1003);
+    const WeaponInstances::Batch a = simd.EndBatch();
+    const WeaponInstances::Batch b = scalar.EndBatchScalar();
+    ASSERT_EQ(a.instances, b.instances);
+    EXPECT_GT(a.instances, 0U);
+    EXPECT_LT(a.instances, 1003U);
+    for (size_t i = 0; i < a.instances; ++i) {
+        ExpectSameInstance(simd.Instances()[i], scalar.Instances()[i]);
+    }
+}
+
+TEST(WeaponInstances, BlendsAndCullsLikeTheBoltDraw) {
+    WeaponInstances stream;
+    //a bolt of size 4 is not drawn once its squared distance times the pixel angle reaches 4
+    stream.Begin(camera, 0.01F, 0.5F);
+    stream.BeginBatch();
+    stream.SetStyle(1.0F, 10.0F, GFXColor(1, 1, 1, 1), 0, 4.0F);
+    stream.AddBolt(camera + QVector(0, 0, 10), camera + QVector(0, 0, 14), Vector(0, 0, 10), Vector(0, 1, 0));
+    stream.AddBolt(camera + QVector(0, 0, 28), camera + QVector(0, 0, 10), Vector(0, 0, 10), Vector(0, 1, 0));
+    stream.AddBolt(camera + QVector(0, 25, 0), camera + QVector(0, 15, 0), Vector(0, 10, 0), Vector(0, 0, 1));
+    const WeaponInstances::Batch batch = stream.EndBatch();
+    ASSERT_EQ(batch.instances, 2U);
+    EXPECT_FLOAT_EQ(stream.Instances()[0].position[2], 12.0F);
+    EXPECT_FLOAT_EQ(stream.Instances()[0].direction[2], 1.0F);
+    EXPECT_FLOAT_EQ(stream.Instances()[1].position[2], 19.0F);
+}
+
+TEST(WeaponInstances, StylesChangeWithinABatch) {
+    WeaponInstances stream;
+    stream.Begin(camera, 0, 1.0F);
+    stream.BeginBatch();
+    stream.SetStyle(1.0F, 10.0F, GFXColor(1, 0, 0, 1), 0, 1.0F);
+    stream.AddBolt(camera, camera, Vector(0, 0, 1), Vector(0, 1, 0));
+    stream.SetStyle(3.0F, 5.0F, GFXColor(0, 0, 1, 1), 2, 1.0F);
+    stream.AddBolt(camera, camera, Vector(0, 0, 1), Vector(0, 1, 0));
+    const WeaponInstances::Batch batch = stream.EndBatch();
+    ASSERT_EQ(batch.instances, 2U);
+    EXPECT_EQ(stream.Instances()[0].radius, 1.0F);
+    EXPECT_EQ(stream.Instances()[0].color[0], 1.0F);
+    EXPECT_EQ(stream.Instances()[1].radius, 3.0F);
+    EXPECT_EQ(stream.Instances()[1].length, 5.0F);
+    EXPECT_EQ(stream.Instances()[1].frame, 2.0F);
+    EXPECT_EQ(stream.Instances()[1].color[2], 1.0F);
+}
+
+TEST(WeaponInstances, ExpandPlacesTheMeshAlongTheBolt) {
+    WeaponInstances stream;
+    stream.Begin(camera, 0, 1.0F);
+    stream.BeginBatch();
+    stream.SetStyle(2.0F, 10.0F, GFXColor(0.25, 0.5, 0.75, 1), 0, 1.0F);
+    stream.AddBolt(camera + QVector(5, 6, 7), camera + QVector(5, 6, 7), Vector(0, 0, 1), Vector(0, 1, 0));
+    WeaponInstances::Batch batch = stream.EndBatch();
+    GFXVertex mesh[2];
+    mesh[0].SetVertex(Vector(1, 0, 0.5F));
+    mesh[0].SetTexCoord(0.25F, 0.75F);
+    mesh[1].SetVertex(Vector(0, -1, -1));
+    mesh[1].SetTexCoord(1, 0);
+    stream.Expand(batch, mesh, 2, 2);
+    ASSERT_EQ(batch.vertices, 2U);
+    ASSERT_EQ(WeaponInstances::VertexFloats(batch.texture_sets), 11);
+    const float *v = stream.Vertices(batch);
+    const float expected[22] = {
+            7, 6, 12, 0.25F, 0.5F, 0.75F, 1, 0.25F, 0.75F, 0.25F, 0.75F,
+            5, 4, -3, 0.25F, 0.5F, 0.75F, 1, 1, 0, 1, 0,
+    };
+    for (int i = 0; i < 22; ++i) {
+        EXPECT_FLOAT_EQ(v[i], expected[i]) << i;
+    }
+
+    WeaponInstances::Batch scalar = batch;
+    stream.ExpandScalar(scalar, mesh, 2, 2);
+    v = stream.Vertices(batch);
+    const float *w = stream.Vertices(scalar);
+    for (int i = 0; i < 22; ++i) {
+        EXPECT_FLOAT_EQ(v[i], w[i]) << i;
+    }
+}
+
+TEST(WeaponInstances, BeamsAreMovedNextToTheCamera) {
+    WeaponInstances stream;
+    stream.Begin(camera, 0, 1.0F);
+    stream.BeginBeams();
+    Matrix m;
+    Identity(m);
+    m.p = camera + QVector(100, 0, 0);
+    const GFXColorVertex beam[2] = {
+            GFXColorVertex(Vector(0, 1, 0), GFXColor(1, 0, 0, 1), 0, 0.5F),
+            GFXColorVertex(Vector(0, 0, 50), GFXColor(0, 1, 0, 0.5), 1, 0.5F),
+    };
+    stream.AddBeam(m, 50, 1, 0.25F, GFXColor(1, 1, 1, 1), beam, 2);
+    const WeaponInstances::Batch batch = stream.EndBeams();
+    ASSERT_EQ(batch.instances, 1U);
+    ASSERT_EQ(batch.vertices, 2U);
+    EXPECT_FLOAT_EQ(stream.Instances()[0].position[0], 100.0F);
+    EXPECT_FLOAT_EQ(stream.Instances()[0].frame, 0.25F);
+    const float *v = stream.Vertices(batch);
+    EXPECT_FLOAT_EQ(v[0], 100.0F);
+    EXPECT_FLOAT_EQ(v[1], 1.0F);
+    EXPECT_FLOAT_EQ(v[3], 1.0F);
+    EXPECT_FLOAT_EQ(v[9], 100.0F);
+    EXPECT_FLOAT_EQ(v[11], 50.0F);
+    EXPECT_FLOAT_EQ(v[15], 0.5F);
+}
+
+TEST(WeaponInstances, AFirefightIsOneDrawPerType) {
+    GFXNull::Reset();
+    GFXNull::SetRecording(true);
+    std::mt19937 random(5);
+    WeaponInstances stream;
+    stream.Begin(camera, 1.0e-8F, 0.5F);
+    GFXVertex quad[4];
+    quad[0].SetVertex(Vector(-1, -1, 0));
+    quad[1].SetVertex(Vector(1, -1, 0));
+    quad[2].SetVertex(Vector(1, 1, 0));
+    quad[3].SetVertex(Vector(-1, 1, 0));
+    std::vector<WeaponInstances::Batch> batches;
+    size_t bolts = 0;
+    for (int type = 0; type < 3; ++type) {
+        stream.BeginBatch();
+        stream.SetStyle(1.0F, 8.0F, GFXColor(1, 1, 1, 1), 0, 1.0F);
+        QueueRandomBolts(stream, random, 2000);
+        batches.push_back(stream.EndBatch());
+        stream.Expand(batches.back(), quad, 4);
+        bolts += batches.back().instances;
+    }
+    for (const WeaponInstances::Batch &batch : batches) {
+        GFXDraw(GFXQUAD, stream.Vertices(batch), batch.vertices, 3, 4, 2);
+    }
+    EXPECT_EQ(GFXNull::GetCounters().draw_calls, 3U);
+    EXPECT_EQ(GFXNull::GetCounters().vertices, 4 * bolts);
+    EXPECT_EQ(GFXNull::GetCommandLog().size(), 3U);
+    GFXNull::SetRecording(false);
+}
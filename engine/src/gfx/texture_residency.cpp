@@ -0,0 +1,296 @@
+/*
+ * texture_residency.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+
+#include "gfx/texture_residency.h"
+
+const unsigned int TextureResidency::STUB_DIMENSION;
+
+TextureResidency::TextureResidency() : frame(0), resident_bytes(0) {
+}
+
+void TextureResidency::Fit(unsigned int &width, unsigned int &height, unsigned int max_dimension) {
+    //the driver halves both sides until the largest fits, as it picks a lower mip
+    while ((width > max_dimension || height > max_dimension) && (width > 1 || height > 1)) {
+        width = std::max(1U, width >> 1);
+        height = std::max(1U, height >> 1);
+    }
+}
+
+size_t TextureResidency::Bytes(unsigned int width,
+        unsigned int height,
+        float bytes_per_texel,
+        bool mipmapped,
+        unsigned int sides,
+        unsigned int max_dimension) {
+    Fit(width, height, max_dimension);
+    double bytes = static_cast<double>(width) * height * bytes_per_texel * sides;
+    if (mipmapped) {
+        bytes *= 4.0 / 3.0;
+    }
+    return static_cast<size_t>(bytes);
+}
+
+int TextureResidency::Register(unsigned int width,
+        unsigned int height,
+        float bytes_per_texel,
+        bool mipmapped,
+        unsigned int sides,
+        Category category) {
+    int id;
+    if (free_ids.empty()) {
+        id = static_cast<int>(entries.size());
+        entries.emplace_back();
+    } else {
+        id = free_ids.back();
+        free_ids.pop_back();
+        entries[id] = Entry();
+    }
+    Entry &e = entries[id];
+    e.live = true;
+    e.pinned = category == CATEGORY_ENVIRONMENT;
+    e.category = category;
+    e.width = width;
+    e.height = height;
+    e.bytes_per_texel = bytes_per_texel;
+    e.mipmapped = mipmapped;
+    e.sides = std::max(1U, sides);
+    e.full_dimension = e.dimension = std::max(width, height);
+    e.last_frame = frame;
+    resident_bytes += EntryBytes(e, e.dimension);
+    return id;
+}
+
+void TextureResidency::Unregister(int id) {
+    Entry &e = entries[id];
+    if (!e.live) {
+        return;
+    }
+    Stats &retire = retired[e.category];
+    retire.evictions += e.evictions;
+    retire.downscales += e.downscales;
+    retire.reloads += e.reloads;
+    resident_bytes -= EntryBytes(e, e.dimension);
+    e.live = false;
+    free_ids.push_back(id);
+}
+
+void TextureResidency::Pin(int id) {
+    entries[id].pinned = true;
+}
+
+void TextureResidency::Touch(int id) {
+    entries[id].last_frame = frame;
+}
+
+void TextureResidency::NoteScreenSize(int id, float pixels) {
+    Entry &e = entries[id];
+    e.last_frame = frame;
+    e.screen_noted = std::max(e.screen_noted, pixels);
+    if (e.category == CATEGORY_SPRITE) {
+        e.category = CATEGORY_MESH;
+    }
+}
+
+unsigned int TextureResidency::WantedDimension(const Entry &e) const {
+    if (frame - e.last_frame > settings.idle_frames) {
+        return STUB_DIMENSION;
+    }
+    if (e.category != CATEGORY_MESH || !(e.screen > 0)) {
+        return e.full_dimension;
+    }
+    const float texels = e.screen * settings.texels_per_pixel;
+    unsigned int dimension = std::max(1U, settings.min_dimension);
+    while (dimension < e.full_dimension && dimension < texels) {
+        dimension <<= 1;
+    }
+    return std::min(dimension, e.full_dimension);
+}
+
+void TextureResidency::Schedule(int id, unsigned int max_dimension, size_t &projected) {
+    Entry &e = entries[id];
+    e.planned = frame;
+    projected = projected - EntryBytes(e, e.dimension) + EntryBytes(e, max_dimension);
+    transfers.push_back(Transfer{id, max_dimension});
+}
+
+const std::vector<TextureResidency::Transfer> &TextureResidency::Plan() {
+    ++frame;
+    transfers.clear();
+    for (Entry &e : entries) {
+        if (e.screen_noted > 0) {
+            e.screen = e.screen_noted;
+            e.screen_noted = 0;
+        }
+    }
+    const size_t budget = settings.budget_bytes;
+    size_t projected = resident_bytes;
+    unsigned int reloads_left = settings.transfers_per_frame;
+    //what may be moved at all: a stub only pays off on textures bigger than it
+    wanted.assign(entries.size(), 0);
+    movable.clear();
+    for (size_t id = 0; id < entries.size(); ++id) {
+        const Entry &e = entries[id];
+        if (e.live && !e.pinned && e.full_dimension > STUB_DIMENSION) {
+            wanted[id] = WantedDimension(e);
+            movable.push_back(static_cast<int>(id));
+        }
+    }
+    candidates.clear();
+
+    if (budget > 0 && projected > budget) {
+        //evict the textures unused for longest first; stubs need no file, so they are not limited
+        for (int id : movable) {
+            if (wanted[id] == STUB_DIMENSION && entries[id].dimension > STUB_DIMENSION) {
+                candidates.push_back(id);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            return entries[a].last_frame < entries[b].last_frame;
+        });
+        for (int id : candidates) {
+            if (projected <= budget) {
+                break;
+            }
+            Schedule(id, STUB_DIMENSION, projected);
+        }
+
+        //then bring down the textures drawn much smaller than their resolution, the largest savings first
+        candidates.clear();
+        for (int id : movable) {
+            if (entries[id].planned != frame && wanted[id] > STUB_DIMENSION && wanted[id] < entries[id].dimension) {
+                candidates.push_back(id);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            const Entry &ea = entries[a];
+            const Entry &eb = entries[b];
+            return EntryBytes(ea, ea.dimension) - EntryBytes(ea, wanted[a])
+                    > EntryBytes(eb, eb.dimension) - EntryBytes(eb, wanted[b]);
+        });
+        for (int id : candidates) {
+            if (projected <= budget || reloads_left == 0) {
+                break;
+            }
+            Schedule(id, wanted[id], projected);
+            --reloads_left;
+        }
+
+        //still over: halve what is in use, meshes smallest on screen first, sprites last
+        candidates.clear();
+        for (int id : movable) {
+            if (entries[id].planned != frame && wanted[id] > STUB_DIMENSION
+                    && entries[id].dimension > settings.min_dimension) {
+                candidates.push_back(id);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            const Entry &ea = entries[a];
+            const Entry &eb = entries[b];
+            if (ea.category != eb.category) {
+                return ea.category < eb.category;
+            }
+            return ea.screen < eb.screen;
+        });
+        for (int id : candidates) {
+            if (projected <= budget || reloads_left == 0) {
+                break;
+            }
+            Schedule(id, std::max(entries[id].dimension >> 1, settings.min_dimension), projected);
+            --reloads_left;
+        }
+    } else {
+        //bring back what is in use, the most recently used first; keep an eighth of the budget spare so a
+        //texture brought back does not push another one straight out
+        const size_t limit = budget - budget / 8;
+        for (int id : movable) {
+            if (wanted[id] > entries[id].dimension) {
+                candidates.push_back(id);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            const Entry &ea = entries[a];
+            const Entry &eb = entries[b];
+            if (ea.last_frame != eb.last_frame) {
+                return ea.last_frame > eb.last_frame;
+            }
+            return ea.screen > eb.screen;
+        });
+        for (int id : candidates) {
+            if (reloads_left == 0) {
+                break;
+            }
+            const Entry &e = entries[id];
+            unsigned int dimension = wanted[id];
+            const size_t others = projected - EntryBytes(e, e.dimension);
+            while (budget > 0 && dimension > e.dimension && others + EntryBytes(e, dimension) > limit) {
+                dimension >>= 1;
+            }
+            if (dimension > e.dimension && dimension > STUB_DIMENSION) {
+                Schedule(id, dimension, projected);
+                --reloads_left;
+            }
+        }
+    }
+    candidates.clear();
+    return transfers;
+}
+
+void TextureResidency::Resident(int id, unsigned int max_dimension) {
+    Entry &e = entries[id];
+    const unsigned int old = e.dimension;
+    resident_bytes = resident_bytes - EntryBytes(e, old) + EntryBytes(e, max_dimension);
+    if (max_dimension <= STUB_DIMENSION && old > STUB_DIMENSION) {
+        ++e.evictions;
+    } else if (max_dimension < old) {
+        ++e.downscales;
+    } else if (max_dimension > old) {
+        ++e.reloads;
+    }
+    e.dimension = max_dimension;
+}
+
+TextureResidency::Stats TextureResidency::GetStats(Category category) const {
+    Stats stats = retired[category];
+    for (const Entry &e : entries) {
+        if (!e.live || e.category != category) {
+            continue;
+        }
+        ++stats.textures;
+        if (e.dimension <= STUB_DIMENSION && e.full_dimension > STUB_DIMENSION) {
+            ++stats.evicted;
+        } else if (e.dimension < e.full_dimension) {
+            ++stats.reduced;
+        }
+        stats.resident_bytes += EntryBytes(e, e.dimension);
+        stats.full_bytes += EntryBytes(e, e.full_dimension);
+        stats.evictions += e.evictions;
+        stats.downscales += e.downscales;
+        stats.reloads += e.reloads;
+    }
+    return stats;
+}
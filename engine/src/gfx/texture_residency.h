@@ -0,0 +1,197 @@
+/*
+ * texture_residency.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_TEXTURE_RESIDENCY_H
+#define VEGA_STRIKE_ENGINE_GFX_TEXTURE_RESIDENCY_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Keeps the textures Texture can reload from their files within a memory budget.
+ *
+ * Texture registers such textures, and tells the manager which ones were
+ * bound each frame and how many pixels across they were drawn. Once a
+ * frame Plan() hands back the transfers needed to stay within the budget:
+ * textures unused for a while are swapped for a tiny stub, textures drawn
+ * much smaller than their resolution go down to a lower mip, and textures
+ * in use are brought back up as the budget allows. The caller does the
+ * transfers and reports each one that succeeded with Resident().
+ *
+ * Only bookkeeping is done here, so the policy runs without a renderer.
+ */
+class TextureResidency {
+public:
+    enum Category {
+        ///drawn on meshes, with a screen size
+        CATEGORY_MESH,
+        ///drawn without a screen size: sprites, cockpit and base art, effects
+        CATEGORY_SPRITE,
+        ///cube maps, never moved
+        CATEGORY_ENVIRONMENT,
+        NUM_CATEGORIES
+    };
+
+    ///the largest dimension of the stand-in for an evicted texture
+    static const unsigned int STUB_DIMENSION = 4;
+
+    struct Settings {
+        ///0 means no budget
+        size_t budget_bytes = 0;
+        ///frames without a bind before a texture may be evicted
+        unsigned int idle_frames = 1800;
+        ///transfers that reload from a file, per frame; stubbing is not counted
+        unsigned int transfers_per_frame = 2;
+        ///texels wanted for each pixel a mesh covers on screen
+        float texels_per_pixel = 2;
+        ///textures are not downscaled below this
+        unsigned int min_dimension = 64;
+    };
+
+    struct Stats {
+        unsigned int textures = 0;
+        ///resident as a stub
+        unsigned int evicted = 0;
+        ///resident below their full resolution, but not as a stub
+        unsigned int reduced = 0;
+        size_t resident_bytes = 0;
+        ///what the textures would take at full resolution
+        size_t full_bytes = 0;
+        unsigned long evictions = 0;
+        unsigned long downscales = 0;
+        unsigned long reloads = 0;
+    };
+
+    struct Transfer {
+        int id;
+        ///the largest dimension to transfer at; STUB_DIMENSION or less means the stub
+        unsigned int max_dimension;
+    };
+
+    TextureResidency();
+
+    void SetSettings(const Settings &settings) {
+        this->settings = settings;
+    }
+
+    const Settings &GetSettings() const {
+        return settings;
+    }
+
+    ///Starts tracking a texture, resident at full resolution; returns its id
+    int Register(unsigned int width,
+            unsigned int height,
+            float bytes_per_texel,
+            bool mipmapped,
+            unsigned int sides,
+            Category category);
+    void Unregister(int id);
+    ///Keeps the texture as it is from now on, e.g. when it could not be reloaded
+    void Pin(int id);
+
+    ///The texture was bound this frame
+    void Touch(int id);
+    ///The texture was drawn this frame on a mesh about this many pixels across
+    void NoteScreenSize(int id, float pixels);
+
+    ///Starts a new frame and returns the transfers to do for it
+    const std::vector<Transfer> &Plan();
+    ///A transfer of the texture at max_dimension was done
+    void Resident(int id, unsigned int max_dimension);
+
+    unsigned int Frame() const {
+        return frame;
+    }
+
+    size_t ResidentBytes() const {
+        return resident_bytes;
+    }
+
+    Stats GetStats(Category category) const;
+
+    ///The largest dimension the texture is resident at
+    unsigned int ResidentDimension(int id) const {
+        return entries[id].dimension;
+    }
+
+    ///The size a texture is transferred at once its largest dimension is brought down to max_dimension
+    static void Fit(unsigned int &width, unsigned int &height, unsigned int max_dimension);
+
+    ///Bytes taken by a texture once its largest dimension is brought down to max_dimension
+    static size_t Bytes(unsigned int width,
+            unsigned int height,
+            float bytes_per_texel,
+            bool mipmapped,
+            unsigned int sides,
+            unsigned int max_dimension);
+
+private:
+    struct Entry {
+        bool live = false;
+        bool pinned = false;
+        Category category = CATEGORY_SPRITE;
+        unsigned int width = 0;
+        unsigned int height = 0;
+        float bytes_per_texel = 0;
+        bool mipmapped = false;
+        unsigned int sides = 1;
+        ///largest dimension at full resolution, and as resident now
+        unsigned int full_dimension = 0;
+        unsigned int dimension = 0;
+        unsigned int last_frame = 0;
+        ///the frame a transfer was last planned on
+        unsigned int planned = 0;
+        ///largest screen size noted since the last Plan, and the one in use
+        float screen_noted = 0;
+        float screen = 0;
+        unsigned long evictions = 0;
+        unsigned long downscales = 0;
+        unsigned long reloads = 0;
+    };
+
+    size_t EntryBytes(const Entry &e, unsigned int max_dimension) const {
+        return Bytes(e.width, e.height, e.bytes_per_texel, e.mipmapped, e.sides, max_dimension);
+    }
+
+    ///The dimension the texture should have, ignoring the budget
+    unsigned int WantedDimension(const Entry &e) const;
+    void Schedule(int id, unsigned int max_dimension, size_t &projected);
+
+    Settings settings;
+    unsigned int frame;
+    size_t resident_bytes;
+    std::vector<Entry> entries;
+    std::vector<int> free_ids;
+    ///cumulative counters of unregistered textures, by category
+    Stats retired[NUM_CATEGORIES];
+    std::vector<Transfer> transfers;
+    ///scratch space for Plan
+    std::vector<unsigned int> wanted;
+    std::vector<int> movable;
+    std::vector<int> candidates;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_TEXTURE_RESIDENCY_H
@@ -0,0 +1,49 @@
+/*
+ * gfxlib_struct_color.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+//GFXColor's ImGui conversions, apart from gfxlib_struct.cpp so they link with either GFX backend
+
+#include "src/gfxlib_struct.h"
+#include "imgui.h"
+
+// Implicit conversion FROM ImU32
+GFXColor::GFXColor(ImU32 col) {
+    r = ((col >> IM_COL32_R_SHIFT) & 0xFF) / 255.0f;
+    g = ((col >> IM_COL32_G_SHIFT) & 0xFF) / 255.0f;
+    b = ((col >> IM_COL32_B_SHIFT) & 0xFF) / 255.0f;
+    a = ((col >> IM_COL32_A_SHIFT) & 0xFF) / 255.0f;
+}
+
+// Implicit conversion TO ImU32
+GFXColor::operator ImU32() const {
+    ImU32 R = (ImU32)(r * 255.0f + 0.5f);
+    ImU32 G = (ImU32)(g * 255.0f + 0.5f);
+    ImU32 B = (ImU32)(b * 255.0f + 0.5f);
+    ImU32 A = (ImU32)(a * 255.0f + 0.5f);
+
+    return IM_COL32(R, G, B, A);
+}
@@ -0,0 +1,1257 @@
+/*
+ * gfx_null.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <stack>
+#include <string>
+
+#include "gfx_null.h"
+#include "gl_globals.h"
+#include "gl_light.h"
+#include "src/gfxlib.h"
+#include "gfx_generic/matrix.h"
+#include "gl_matrix.h"
+#include "configuration/configuration.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace GFXMatrices;
+
+static const int NULL_TEXTURE_STAGES = 8;
+
+static GFXNull::Counters counters;
+static bool recording = false;
+static std::vector<GFXNull::Command> command_log;
+static int bound_textures[NULL_TEXTURE_STAGES] = {-1, -1, -1, -1, -1, -1, -1, -1};
+static std::vector<bool> live_textures;
+
+static int light_context = 0;
+static std::vector<GFXColor> ambient_light;
+static std::vector<GFXLight> lights;
+static std::vector<char> light_flags;
+static const char LIGHT_USED = 1;
+static const char LIGHT_GLOBAL = 2;
+static int global_effects_depth = 0;
+static QVector light_offset(0, 0, 0);
+
+static std::vector<GFXMaterial> materials;
+
+static BLENDFUNC blend_src = ONE;
+static BLENDFUNC blend_dst = ZERO;
+static std::stack<std::pair<BLENDFUNC, BLENDFUNC> > blend_stack;
+static DEPTHFUNC depth_func = LESS;
+static DEPTHFUNC stencil_func = ALWAYS;
+static int stencil_ref = 0;
+static unsigned int stencil_mask = ~0U;
+static unsigned int stencil_write_mask = ~0U;
+static STENCILOP stencil_fail = KEEP;
+static STENCILOP stencil_zfail = KEEP;
+static STENCILOP stencil_zpass = KEEP;
+static float polygon_offset_factor = 0;
+static float polygon_offset_units = 0;
+static GFXColor current_color(1, 1, 1, 1);
+
+static int next_display_list = 1;
+static int next_program = 1;
+static std::map<std::string, int> uniform_locations;
+static std::vector<PickData> picked_objects;
+
+//Counting lives apart from the recording so a command log replays to the very same numbers
+static void Tally(GFXNull::Counters &c, int bound[], const GFXNull::Command &cmd) {
+    switch (cmd.type) {
+        case GFXNull::CMD_END_SCENE:
+            ++c.frames;
+            break;
+        case GFXNull::CMD_DRAW:
+        case GFXNull::CMD_DRAW_ELEMENTS:
+        case GFXNull::CMD_DRAW_LIST:
+            ++c.draw_calls;
+            c.vertices += cmd.count;
+            break;
+        case GFXNull::CMD_CALL_LIST:
+            ++c.draw_calls;
+            break;
+        case GFXNull::CMD_ENABLE:
+        case GFXNull::CMD_DISABLE:
+        case GFXNull::CMD_BLEND_MODE:
+        case GFXNull::CMD_RASTER_STATE:
+        case GFXNull::CMD_COLOR:
+            ++c.state_changes;
+            break;
+        case GFXNull::CMD_SELECT_TEXTURE:
+            ++c.texture_binds;
+            if (cmd.arg1 >= 0 && cmd.arg1 < NULL_TEXTURE_STAGES) {
+                if (bound[cmd.arg1] == cmd.arg0) {
+                    ++c.redundant_texture_binds;
+                }
+                bound[cmd.arg1] = cmd.arg0;
+            }
+            break;
+        case GFXNull::CMD_TRANSFER_TEXTURE:
+            ++c.texture_uploads;
+            c.texture_bytes += cmd.count;
+            break;
+        case GFXNull::CMD_LOAD_MATRIX:
+            ++c.matrix_loads;
+            break;
+        case GFXNull::CMD_SELECT_MATERIAL:
+            ++c.material_changes;
+            break;
+        case GFXNull::CMD_LIGHT:
+            ++c.light_changes;
+            break;
+        case GFXNull::CMD_ACTIVATE_SHADER:
+            ++c.shader_changes;
+            break;
+        case GFXNull::CMD_SHADER_CONSTANT:
+            ++c.shader_constants;
+            break;
+        case GFXNull::CMD_BEGIN_SCENE:
+        case GFXNull::CMD_CLEAR:
+        default:
+            break;
+    }
+}
+
+static void Record(GFXNull::CommandType type, int arg0 = 0, int arg1 = 0, unsigned int count = 0) {
+    GFXNull::Command cmd = {type, arg0, arg1, count};
+    Tally(counters, bound_textures, cmd);
+    if (recording) {
+        command_log.push_back(cmd);
+    }
+}
+
+void GFXNull::Reset() {
+    counters = Counters();
+    command_log.clear();
+    for (int i = 0; i < NULL_TEXTURE_STAGES; ++i) {
+        bound_textures[i] = -1;
+    }
+}
+
+const GFXNull::Counters &GFXNull::GetCounters() {
+    return counters;
+}
+
+void GFXNull::SetRecording(bool record) {
+    recording = record;
+}
+
+bool GFXNull::IsRecording() {
+    return recording;
+}
+
+const std::vector<GFXNull::Command> &GFXNull::GetCommandLog() {
+    return command_log;
+}
+
+GFXNull::Counters GFXNull::Replay(const std::vector<Command> &log) {
+    Counters replayed;
+    int bound[NULL_TEXTURE_STAGES];
+    for (int i = 0; i < NULL_TEXTURE_STAGES; ++i) {
+        bound[i] = -1;
+    }
+    for (const Command &cmd : log) {
+        Tally(replayed, bound, cmd);
+    }
+    return replayed;
+}
+
+int GFXNull::BoundTexture(int stage) {
+    return (stage >= 0 && stage < NULL_TEXTURE_STAGES) ? bound_textures[stage] : -1;
+}
+
+int GFXNull::LiveTextures() {
+    int live = 0;
+    for (bool t : live_textures) {
+        live += t ? 1 : 0;
+    }
+    return live;
+}
+
+//Init functions
+
+void /*GFXDRVAPI*/ GFXInit(int, char **) {
+    Identity(model);
+    Identity(view);
+    Identity(rotview);
+    GFXLoadIdentity(PROJECTION);
+    int context;
+    GFXCreateLightContext(context);
+    GFXSetLightContext(context);
+}
+
+void /*GFXDRVAPI*/ GFXLoop(void main_loop()) {
+    //there is no window to close, main_loop leaves through VSExit like it does under GL
+    while (true) {
+        main_loop();
+    }
+}
+
+void /*GFXDRVAPI*/ GFXShutdown() {
+    GFXDestroyAllTextures();
+    lights.clear();
+    light_flags.clear();
+    materials.clear();
+}
+
+//Misc functions
+
+void /*GFXDRVAPI*/ GFXBeginScene() {
+    GFXLoadIdentity(MODEL);
+    Record(GFXNull::CMD_BEGIN_SCENE);
+}
+
+void /*GFXDRVAPI*/ GFXEndScene() {
+    Record(GFXNull::CMD_END_SCENE);
+}
+
+void /*GFXDRVAPI*/ GFXClear(const GFXBOOL colorbuffer, const GFXBOOL depthbuffer, const GFXBOOL stencilbuffer) {
+    Record(GFXNull::CMD_CLEAR, (colorbuffer ? 1 : 0) | (depthbuffer ? 2 : 0) | (stencilbuffer ? 4 : 0));
+}
+
+//Lights
+
+void /*GFXDRVAPI*/ GFXCreateLightContext(int &con_number) {
+    con_number = static_cast<int>(ambient_light.size());
+    ambient_light.push_back(GFXColor(0, 0, 0, 1));
+}
+
+void /*GFXDRVAPI*/ GFXDeleteLightContext(const int) {
+}
+
+void /*GFXDRVAPI*/ GFXSetLightContext(const int con_number) {
+    light_context = con_number;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXLightContextAmbient(const GFXColor &amb) {
+    if (light_context < 0 || light_context >= static_cast<int>(ambient_light.size())) {
+        return GFXFALSE;
+    }
+    ambient_light[light_context] = amb;
+    return GFXTRUE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXGetLightContextAmbient(GFXColor &amb) {
+    if (light_context < 0 || light_context >= static_cast<int>(ambient_light.size())) {
+        return GFXFALSE;
+    }
+    amb = ambient_light[light_context];
+    return GFXTRUE;
+}
+
+static bool LightUsable(const int light) {
+    return light >= 0 && light < static_cast<int>(lights.size()) && (light_flags[light] & LIGHT_USED);
+}
+
+void /*GFXDRVAPI*/ GFXPickLights(const Vector &center, const float radius) {
+    std::vector<int> picked;
+    GFXPickLights(center, radius, picked, 8, false);
+    GFXPickLights(picked.begin(), picked.end());
+}
+
+void /*GFXDRVAPI*/ GFXPickLights(const Vector &center,
+        const float radius,
+        vector<int> &picked,
+        const int maxlights,
+        const bool pickglobals) {
+    picked.clear();
+    for (size_t i = 0; i < lights.size() && static_cast<int>(picked.size()) < maxlights; ++i) {
+        if (!LightUsable(i) || !(lights[i].options & GFX_LIGHT_ENABLED)) {
+            continue;
+        }
+        if (light_flags[i] & LIGHT_GLOBAL) {
+            if (pickglobals) {
+                picked.push_back(i);
+            }
+        } else if ((lights[i].getPosition() - center).Magnitude() <= radius + lights[i].getSize()) {
+            picked.push_back(i);
+        }
+    }
+}
+
+void /*GFXDRVAPI*/ GFXPickLights(vector<int>::const_iterator begin, vector<int>::const_iterator end) {
+    for (vector<int>::const_iterator i = begin; i != end; ++i) {
+        Record(GFXNull::CMD_LIGHT, *i, 1);
+    }
+}
+
+void /*GFXDRVAPI*/ GFXGlobalLights(vector<int> &picked, const Vector &, const float) {
+    GFXGlobalLights(picked);
+}
+
+void /*GFXDRVAPI*/ GFXGlobalLights(vector<int> &picked) {
+    for (size_t i = 0; i < lights.size(); ++i) {
+        if (LightUsable(i) && (light_flags[i] & LIGHT_GLOBAL) && (lights[i].options & GFX_LIGHT_ENABLED)) {
+            picked.push_back(i);
+        }
+    }
+}
+
+void /*GFXDRVAPI*/ GFXSetLightOffset(const QVector &offset) {
+    light_offset = offset;
+}
+
+QVector /*GFXDRVAPI*/ GFXGetLightOffset() {
+    return light_offset;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXSetSeparateSpecularColor(const GFXBOOL) {
+    return GFXTRUE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXSetCutoff(const float cutoff) {
+    return cutoff < 0 ? GFXFALSE : GFXTRUE;
+}
+
+void /*GFXDRVAPI*/ GFXSetOptimalIntensity(const float, const float) {
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXSetOptimalNumLights(const int numlights) {
+    return numlights > 0 ? GFXTRUE : GFXFALSE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXCreateLight(int &light, const GFXLight &templatecopy, const bool global) {
+    light = 0;
+    while (light < static_cast<int>(lights.size()) && (light_flags[light] & LIGHT_USED)) {
+        ++light;
+    }
+    if (light == static_cast<int>(lights.size())) {
+        lights.push_back(templatecopy);
+        light_flags.push_back(0);
+    } else {
+        lights[light] = templatecopy;
+    }
+    lights[light].target = -1;
+    light_flags[light] = LIGHT_USED | (global ? LIGHT_GLOBAL : 0);
+    return GFXTRUE;
+}
+
+void /*GFXDRVAPI*/ GFXDeleteLight(const int light) {
+    if (LightUsable(light)) {
+        light_flags[light] = 0;
+    }
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXEnableLight(const int light) {
+    if (!LightUsable(light)) {
+        return GFXFALSE;
+    }
+    lights[light].enable();
+    Record(GFXNull::CMD_LIGHT, light, 1);
+    return GFXTRUE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXDisableLight(const int light) {
+    if (!LightUsable(light)) {
+        return GFXFALSE;
+    }
+    lights[light].disable();
+    Record(GFXNull::CMD_LIGHT, light, 0);
+    return GFXTRUE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXSetLight(const int light, const enum LIGHT_TARGET lt, const GFXColor &color) {
+    if (!LightUsable(light)) {
+        return GFXFALSE;
+    }
+    lights[light].SetProperties(lt, color);
+    return GFXTRUE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXSetLight(const int light, const enum LIGHT_TARGET lt, const Vector &vector) {
+    if (!LightUsable(light)) {
+        return GFXFALSE;
+    }
+    lights[light].SetProperties(lt, vector);
+    return GFXTRUE;
+}
+
+const GFXLight & /*GFXDRVAPI*/ GFXGetLight(const int light) {
+    static GFXLight no_light;
+    return LightUsable(light) ? lights[light] : no_light;
+}
+
+void /*GFXDRVAPI*/ GFXPushGlobalEffects() {
+    ++global_effects_depth;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXPopGlobalEffects() {
+    if (global_effects_depth == 0) {
+        return GFXFALSE;
+    }
+    --global_effects_depth;
+    return GFXTRUE;
+}
+
+//Materials
+
+void /*GFXDRVAPI*/ GFXSetMaterial(unsigned int &number, const GFXMaterial &material) {
+    number = static_cast<unsigned int>(materials.size());
+    materials.push_back(material);
+}
+
+void /*GFXDRVAPI*/ GFXModifyMaterial(const unsigned int number, const GFXMaterial &material) {
+    if (number < materials.size()) {
+        materials[number] = material;
+    }
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXGetMaterial(const unsigned int number, GFXMaterial &material) {
+    if (number >= materials.size()) {
+        return GFXFALSE;
+    }
+    material = materials[number];
+    return GFXTRUE;
+}
+
+const GFXMaterial &GFXGetMaterial(const unsigned int number) {
+    static GFXMaterial no_material;
+    return number < materials.size() ? materials[number] : no_material;
+}
+
+void /*GFXDRVAPI*/ GFXSelectMaterialHighlights(const unsigned int number,
+        const GFXColor &,
+        const GFXColor &,
+        const GFXColor &,
+        const GFXColor &) {
+    Record(GFXNull::CMD_SELECT_MATERIAL, number);
+}
+
+void /*GFXDRVAPI*/ GFXSelectMaterial(const unsigned int number) {
+    Record(GFXNull::CMD_SELECT_MATERIAL, number);
+}
+
+//Matrices: the CPU side state is kept exactly like the GL driver keeps it, so culling still works
+
+static void LoadModelView() {
+    Record(GFXNull::CMD_LOAD_MATRIX, MODEL);
+}
+
+static void LoadProjection() {
+    Record(GFXNull::CMD_LOAD_MATRIX, PROJECTION);
+}
+
+void /*GFXDRVAPI*/ GFXHudMode(const bool Enter) {
+    if (Enter) {
+        LoadModelView();
+        LoadProjection();
+    }
+}
+
+void /*GFXDRVAPI*/ GFXRestoreHudMode() {
+    LoadModelView();
+    LoadProjection();
+}
+
+void /*GFXDRVAPI*/ GFXCenterCamera(const bool Enter) {
+    static QVector tmp;
+    if (Enter) {
+        tmp = view.p;
+        view.p.Set(0, 0, 0);
+        LoadModelView();
+    } else {
+        view.p = tmp;
+        GFXLoadIdentity(MODEL);
+    }
+}
+
+void /*GFXDRVAPI*/ GFXTranslateView(const QVector &r) {
+    view.p += TransformNormal(view, r);
+    LoadModelView();
+}
+
+void /*GFXDRVAPI*/ GFXLoadMatrixView(const Matrix &matrix) {
+    CopyMatrix(view, matrix);
+    LoadModelView();
+    LoadProjection();
+}
+
+void /*GFXDRVAPI*/ GFXGetMatrixView(Matrix &m) {
+    CopyMatrix(m, view);
+}
+
+void /*GFXDRVAPI*/ GFXTranslateProjection(const Vector &a) {
+    projection[12] += a.i * projection[0] + a.j * projection[4] + a.k * projection[8];
+    projection[13] += a.i * projection[1] + a.j * projection[5] + a.k * projection[9];
+    projection[14] += a.i * projection[2] + a.j * projection[6] + a.k * projection[10];
+    LoadProjection();
+}
+
+void /*GFXDRVAPI*/ GFXTranslateModel(const QVector &r) {
+    model.p += TransformNormal(model, r);
+    LoadModelView();
+}
+
+void /*GFXDRVAPI*/ GFXMultMatrixModel(const Matrix &matrix) {
+    Matrix t;
+    MultMatrix(t, model, matrix);
+    CopyMatrix(model, t);
+    LoadModelView();
+}
+
+void /*GFXDRVAPI*/ GFXLoadMatrixModel(const Matrix &matrix) {
+    CopyMatrix(model, matrix);
+    LoadModelView();
+}
+
+void /*GFXDRVAPI*/ GFXLoadMatrixProjection(const float matrix[16]) {
+    memcpy(projection, matrix, 16 * sizeof(float));
+    LoadProjection();
+}
+
+void /*GFXDRVAPI*/ GFXLoadIdentity(const MATRIXMODE mode) {
+    switch (mode) {
+        case MODEL:
+            Identity(model);
+            LoadModelView();
+            break;
+        case PROJECTION:
+            for (int i = 0; i < 16; ++i) {
+                projection[i] = (i % 5 == 0) ? 1 : 0;
+            }
+            LoadProjection();
+            break;
+        case VIEW:
+            Identity(view);
+            LoadModelView();
+            LoadProjection();
+            break;
+    }
+}
+
+void /*GFXDRVAPI*/ GFXGetMatrixModel(Matrix &matrix) {
+    CopyMatrix(matrix, model);
+}
+
+float /*GFXDRVAPI*/ GFXGetXInvPerspective() {
+    return invprojection[0];
+}
+
+float /*GFXDRVAPI*/ GFXGetYInvPerspective() {
+    return invprojection[5];
+}
+
+void /*GFXDRVAPI*/ GFXPerspective(float fov, float aspect, float znear, float zfar, float cockpit_offset) {
+    znear *= GFX_SCALE;
+    zfar *= GFX_SCALE;
+    cockpit_offset *= GFX_SCALE;
+    float ymax = znear * tanf(fov * M_PI / ((float) 360.0));
+    float ymin = -ymax;
+    float xmin = (ymin - cockpit_offset / 2) * aspect;
+    float xmax = (ymax + cockpit_offset / 2) * aspect;
+    ymin -= cockpit_offset;
+    GFXGetFrustumVars(false, &xmin, &xmax, &ymin, &ymax, &znear, &zfar);
+    GFXFrustum(projection, invprojection, xmin, xmax, ymin, ymax, znear, zfar);
+    LoadProjection();
+}
+
+void /*GFXDRVAPI*/ GFXParallel(float left, float right, float bottom, float top, float znear, float zfar) {
+    float *m = projection;
+    for (int i = 0; i < 16; ++i) {
+        m[i] = 0;
+    }
+    m[0] = 2.0 / (right - left);
+    m[5] = 2.0 / (top - bottom);
+    m[10] = -2.0 / (zfar - znear);
+    m[12] = -(right + left) / (right - left);
+    m[13] = -(top + bottom) / (top - bottom);
+    m[14] = -(zfar + znear) / (zfar - znear);
+    m[15] = 1.0F;
+    GFXLoadMatrixProjection(projection);
+    GFXGetFrustumVars(false, &left, &right, &bottom, &top, &znear, &zfar);
+}
+
+void /*GFXDRVAPI*/ GFXViewPort(int, int, int, int) {
+}
+
+void /*GFXDRVAPI*/ GFXLookAt(Vector eye, QVector center, Vector up) {
+    Vector z = eye;
+    z.Normalize();
+    Vector x = up.Cross(z);
+    x.Normalize();
+    Vector y = z.Cross(x);
+    y.Normalize();
+    VectorAndPositionToMatrix(view,
+            Vector(x.i, y.i, z.i),
+            Vector(x.j, y.j, z.j),
+            Vector(x.k, y.k, z.k),
+            center + eye.Cast());
+    GFXLoadMatrixView(view);
+}
+
+//Textures
+
+static unsigned int TextureBytes(enum TEXTUREFORMAT format, unsigned int width, unsigned int height) {
+    switch (format) {
+        case PALETTE8:
+        case PNGPALETTE8:
+            return width * height;
+        case RGB16:
+        case RGBA16:
+            return width * height * 2;
+        case RGB24:
+        case PNGRGB24:
+            return width * height * 3;
+        case DXT1:
+        case DXT1RGBA:
+            return width * height / 2;
+        case DXT3:
+        case DXT5:
+            return width * height;
+        default:
+            return width * height * 4;
+    }
+}
+
+static bool TextureLive(int handle) {
+    return handle >= 0 && handle < static_cast<int>(live_textures.size()) && live_textures[handle];
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXCreateTexture(int,
+        int,
+        TEXTUREFORMAT,
+        int *handle,
+        char *,
+        int,
+        enum FILTER,
+        enum TEXTURE_TARGET,
+        enum ADDRESSMODE) {
+    int h = 0;
+    while (h < static_cast<int>(live_textures.size()) && live_textures[h]) {
+        ++h;
+    }
+    if (h == static_cast<int>(live_textures.size())) {
+        live_textures.push_back(true);
+    } else {
+        live_textures[h] = true;
+    }
+    *handle = h;
+    return GFXTRUE;
+}
+
+void /*GFXDRVAPI*/ GFXPrioritizeTexture(unsigned int, float) {
+}
+
+void /*GFXDRVAPI*/ GFXAttachPalette(unsigned char *, int) {
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXTransferTexture(unsigned char *,
+        int handle,
+        int inWidth,
+        int inHeight,
+        enum TEXTUREFORMAT internalformat,
+        enum TEXTURE_IMAGE_TARGET image2D,
+        int max_texture_dimension,
+        GFXBOOL,
+        unsigned int) {
+    if (!TextureLive(handle)) {
+        return GFXFALSE;
+    }
+    //like the GL driver, larger textures go down to the mip that fits max_texture_dimension
+    unsigned int width = std::max(inWidth, 1);
+    unsigned int height = std::max(inHeight, 1);
+    const unsigned int max_dimension = std::max(max_texture_dimension, 1);
+    while ((width > max_dimension || height > max_dimension) && (width > 1 || height > 1)) {
+        width = std::max(1U, width >> 1);
+        height = std::max(1U, height >> 1);
+    }
+    Record(GFXNull::CMD_TRANSFER_TEXTURE, handle, image2D, TextureBytes(internalformat, width, height));
+    return GFXTRUE;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXTransferSubTexture(unsigned char *,
+        int handle,
+        int,
+        int,
+        unsigned int width,
+        unsigned int height,
+        enum TEXTURE_IMAGE_TARGET image2D) {
+    if (!TextureLive(handle)) {
+        return GFXFALSE;
+    }
+    Record(GFXNull::CMD_TRANSFER_TEXTURE, handle, image2D, width * height * 4);
+    return GFXTRUE;
+}
+
+void /*GFXDRVAPI*/ GFXDeleteTexture(size_t handle) {
+    if (TextureLive(static_cast<int>(handle))) {
+        live_textures[handle] = false;
+        for (int i = 0; i < NULL_TEXTURE_STAGES; ++i) {
+            if (bound_textures[i] == static_cast<int>(handle)) {
+                bound_textures[i] = -1;
+            }
+        }
+    }
+}
+
+void /*GFXDRVAPI*/ GFXDestroyAllTextures() {
+    live_textures.clear();
+    for (int i = 0; i < NULL_TEXTURE_STAGES; ++i) {
+        bound_textures[i] = -1;
+    }
+}
+
+void /*GFXDRVAPI*/ GFXSelectTexture(int handle, int stage) {
+    Record(GFXNull::CMD_SELECT_TEXTURE, handle, stage);
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXCapture(char *) {
+    return GFXFALSE;
+}
+
+//Fixed function state
+
+void /*GFXDRVAPI*/ GFXEnable(const enum STATE state) {
+    Record(GFXNull::CMD_ENABLE, state);
+}
+
+void /*GFXDRVAPI*/ GFXDisable(const enum STATE state) {
+    Record(GFXNull::CMD_DISABLE, state);
+}
+
+void /*GFXDRVAPI*/ GFXToggleTexture(bool, int whichstage, enum TEXTURE_TARGET) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_TEXTURE, whichstage);
+}
+
+void /*GFXDRVAPI*/ GFXTextureAddressMode(const ADDRESSMODE, enum TEXTURE_TARGET) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_TEXTURE);
+}
+
+void /*GFXDRVAPI*/ GFXBlendMode(const enum BLENDFUNC src, const enum BLENDFUNC dst) {
+    blend_src = src;
+    blend_dst = dst;
+    Record(GFXNull::CMD_BLEND_MODE, src, dst);
+}
+
+void /*GFXDRVAPI*/ GFXGetBlendMode(enum BLENDFUNC &src, enum BLENDFUNC &dst) {
+    src = blend_src;
+    dst = blend_dst;
+}
+
+void /*GFXDRVAPI*/ GFXColorMaterial(int LIGHTTARG) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_COLOR_MATERIAL, LIGHTTARG);
+}
+
+void /*GFXDRVAPI*/ GFXPointSize(const float) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_POINT_LINE);
+}
+
+void /*GFXDRVAPI*/ GFXLineWidth(const float) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_POINT_LINE);
+}
+
+void /*GFXDRVAPI*/ GFXPushBlendMode() {
+    blend_stack.push(std::make_pair(blend_src, blend_dst));
+}
+
+void /*GFXDRVAPI*/ GFXPopBlendMode() {
+    if (!blend_stack.empty()) {
+        GFXBlendMode(blend_stack.top().first, blend_stack.top().second);
+        blend_stack.pop();
+    }
+}
+
+void /*GFXDRVAPI*/ GFXActiveTexture(const int) {
+}
+
+enum DEPTHFUNC /*GFXDRVAPI*/ GFXDepthFunc() {
+    return depth_func;
+}
+
+void /*GFXDRVAPI*/ GFXDepthFunc(const enum DEPTHFUNC func) {
+    depth_func = func;
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_DEPTH, func);
+}
+
+enum DEPTHFUNC /*GFXDRVAPI*/ GFXStencilFunc() {
+    return stencil_func;
+}
+
+void /*GFXDRVAPI*/ GFXStencilFunc(enum DEPTHFUNC *pFunc, int *pRef, int *pMask) {
+    if (pFunc) {
+        *pFunc = stencil_func;
+    }
+    if (pRef) {
+        *pRef = stencil_ref;
+    }
+    if (pMask) {
+        *pMask = stencil_mask;
+    }
+}
+
+void /*GFXDRVAPI*/ GFXStencilFunc(enum DEPTHFUNC sfunc, int ref, unsigned int mask) {
+    stencil_func = sfunc;
+    stencil_ref = ref;
+    stencil_mask = mask;
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_STENCIL);
+}
+
+void /*GFXDRVAPI*/ GFXStencilOp(enum STENCILOP *pFail, enum STENCILOP *pZfail, enum STENCILOP *pZpass) {
+    if (pFail) {
+        *pFail = stencil_fail;
+    }
+    if (pZfail) {
+        *pZfail = stencil_zfail;
+    }
+    if (pZpass) {
+        *pZpass = stencil_zpass;
+    }
+}
+
+void /*GFXDRVAPI*/ GFXStencilOp(enum STENCILOP fail, enum STENCILOP zfail, enum STENCILOP zpass) {
+    stencil_fail = fail;
+    stencil_zfail = zfail;
+    stencil_zpass = zpass;
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_STENCIL);
+}
+
+unsigned int /*GFXDRVAPI*/ GFXStencilMask() {
+    return stencil_write_mask;
+}
+
+void /*GFXDRVAPI*/ GFXStencilMask(unsigned int mask) {
+    stencil_write_mask = mask;
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_STENCIL);
+}
+
+void /*GFXDRVALP*/ GFXAlphaTest(const enum DEPTHFUNC func, const float) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_ALPHA_TEST, func);
+}
+
+void GFXTextureWrap(int stage, GFXTEXTUREWRAPMODES, enum TEXTURE_TARGET) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_TEXTURE, stage);
+}
+
+void GFXTextureEnv(int stage, GFXTEXTUREENVMODES, float) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_TEXTURE, stage);
+}
+
+bool GFXMultiTexAvailable() {
+    return true;
+}
+
+void /*GFXDRVAPI*/ GFXPolygonOffset(float factor, float units) {
+    polygon_offset_factor = factor;
+    polygon_offset_units = units;
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_POLYGON);
+}
+
+void GFXGetPolygonOffset(float *factor, float *units) {
+    *factor = polygon_offset_factor;
+    *units = polygon_offset_units;
+}
+
+void /*GFXDRVAPI*/ GFXPolygonMode(const enum POLYMODE mode) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_POLYGON, mode);
+}
+
+void /*GFXDRVAPI*/ GFXCullFace(const enum POLYFACE face) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_CULL_FACE, face);
+}
+
+void /*GFXDRVAPI*/ GFXColorf(const GFXColor &col) {
+    current_color = col;
+    Record(GFXNull::CMD_COLOR);
+}
+
+void /*GFXDRVAPI*/ GFXBlendColor(const GFXColor &) {
+    Record(GFXNull::CMD_COLOR);
+}
+
+void /*GFXDRVAPI*/ GFXColor4f(const float r, const float g, const float b, const float a) {
+    GFXColorf(GFXColor(r, g, b, a));
+}
+
+GFXColor /*GFXDRVAPI*/ GFXColorf() {
+    return current_color;
+}
+
+//Drawing
+
+void /*GFXDRVAPI*/ GFXCircle(float, float, float wid, float hei) {
+    //same tessellation as the GL driver, so the vertex counts match
+    float segmag = (Vector(wid * configuration().graphics.resolution_x, 0, 0)
+            - Vector(static_cast<double>(wid) * configuration().graphics.resolution_x * cos(2.0 * M_PI / 360.0),
+                    static_cast<double>(hei) * configuration().graphics.resolution_y * sin(2.0 * M_PI / 360.0),
+                    0)).Magnitude();
+    int accuracy = (int) (360.0f * configuration().graphics.circle_accuracy_flt * (1.0f < segmag ? 1.0f : segmag));
+    if (accuracy < 4) {
+        accuracy = 4;
+    }
+    Record(GFXNull::CMD_DRAW, GFXLINESTRIP, 0, accuracy + 1);
+}
+
+unsigned int /*GFXDRVAPI*/ PolyLookup(POLYTYPE poly) {
+    return poly;
+}
+
+void /*GFXDRVAPI*/ GFXDraw(POLYTYPE type, const float[], int vnum,
+        int, int, int, int) {
+    if (vnum <= 0) {
+        return;
+    }
+    Record(GFXNull::CMD_DRAW, type, 0, vnum);
+    ++gl_batches_this_frame;
+    gl_vertices_this_frame += vnum;
+}
+
+static void DrawElements(POLYTYPE type, int vnum, int nelem) {
+    if (vnum <= 0 || nelem <= 0) {
+        return;
+    }
+    Record(GFXNull::CMD_DRAW_ELEMENTS, type, 0, nelem);
+    ++gl_batches_this_frame;
+    gl_vertices_this_frame += nelem;
+}
+
+void /*GFXDRVAPI*/ GFXDrawElements(POLYTYPE type,
+        const float[], int vnum, const unsigned char[], int nelem,
+        int, int, int, int) {
+    DrawElements(type, vnum, nelem);
+}
+
+void /*GFXDRVAPI*/ GFXDrawElements(POLYTYPE type,
+        const float[], int vnum, const unsigned short[], int nelem,
+        int, int, int, int) {
+    DrawElements(type, vnum, nelem);
+}
+
+void /*GFXDRVAPI*/ GFXDrawElements(POLYTYPE type,
+        const float[], int vnum, const unsigned int[], int nelem,
+        int, int, int, int) {
+    DrawElements(type, vnum, nelem);
+}
+
+void GFXBindBuffer(unsigned int) {
+}
+
+void GFXBindElementBuffer(unsigned int) {
+}
+
+//Fog
+
+void GFXFogMode(const FOGMODE fog) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_FOG, fog);
+}
+
+void GFXFogDensity(const float) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_FOG);
+}
+
+void GFXFogLimits(const float, const float) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_FOG);
+}
+
+void GFXFogColor(GFXColor) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_FOG);
+}
+
+void GFXFogIndex(const int) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_FOG);
+}
+
+//Display lists
+
+int /*GFXDRVAPI*/ GFXCreateList() {
+    return next_display_list++;
+}
+
+GFXBOOL /*GFXDRVAPI*/ GFXEndList() {
+    return GFXTRUE;
+}
+
+void /*GFXDRVAPI*/ GFXCallList(int list) {
+    Record(GFXNull::CMD_CALL_LIST, list);
+}
+
+void /*GFXDRVAPI*/ GFXDeleteList(int) {
+}
+
+//Picking
+
+void /*GFXDRVAPI*/ GFXBeginPick(int, int, int, int) {
+    picked_objects.clear();
+}
+
+void /*GFXDRVAPI*/ GFXSetPickName(int) {
+}
+
+vector<PickData> * /*GFXDRVAPI*/ GFXEndPick() {
+    return &picked_objects;
+}
+
+void /*GFXDRVAPI*/ GFXSubwindow(int, int, int, int) {
+}
+
+void /*GFXDRVAPI*/ GFXSubwindow(float, float, float, float) {
+}
+
+Vector /*GFXDRVAPI*/ GFXDeviceToEye(int x, int y) {
+    float l, r, b, t, n, f;
+    GFXGetFrustumVars(true, &l, &r, &b, &t, &n, &f);
+    return Vector((l + (r - l) * float(x) / configuration().graphics.resolution_x),
+            (t + (b - t) * float(y) / configuration().graphics.resolution_y),
+            n);
+}
+
+void GFXTextureCoordGenMode(int stage, GFXTEXTURECOORDMODE, const float[4], const float[4]) {
+    Record(GFXNull::CMD_RASTER_STATE, GFXNull::RS_TEXTURE, stage);
+}
+
+//Shaders: programs and uniforms only get ids, so the callers take their shader paths
+
+int GFXCreateProgram(const char *, const char *, const char *) {
+    return next_program++;
+}
+
+void GFXDestroyProgram(int) {
+}
+
+int GFXActivateShader(const char *program) {
+    return GFXActivateShader(program == nullptr ? 0 : next_program - 1);
+}
+
+int GFXActivateShader(int program) {
+    Record(GFXNull::CMD_ACTIVATE_SHADER, program);
+    return program;
+}
+
+void GFXDeactivateShader() {
+    GFXActivateShader(0);
+}
+
+int GFXNamedShaderConstant(char *, const char *name) {
+    return GFXNamedShaderConstant(0, name);
+}
+
+int GFXNamedShaderConstant(int, const char *name) {
+    std::map<std::string, int>::iterator i = uniform_locations.find(name);
+    if (i == uniform_locations.end()) {
+        i = uniform_locations.insert(std::make_pair(std::string(name), static_cast<int>(uniform_locations.size()))).first;
+    }
+    return i->second;
+}
+
+static int ShaderConstant(int name, unsigned int numvals) {
+    Record(GFXNull::CMD_SHADER_CONSTANT, name, 0, numvals);
+    return 1;
+}
+
+int GFXShaderConstant(int name, Vector) {
+    return ShaderConstant(name, 3);
+}
+
+int GFXShaderConstant(int name, GFXColor) {
+    return ShaderConstant(name, 4);
+}
+
+int GFXShaderConstant(int name, const float *) {
+    return ShaderConstant(name, 4);
+}
+
+int GFXShaderConstanti(int name, int) {
+    return ShaderConstant(name, 1);
+}
+
+int GFXShaderConstant(int name, float, float, float, float) {
+    return ShaderConstant(name, 4);
+}
+
+int GFXShaderConstant(int name, float) {
+    return ShaderConstant(name, 1);
+}
+
+int GFXShaderConstant4v(int name, unsigned int numvals, const float *) {
+    return ShaderConstant(name, numvals * 4);
+}
+
+int GFXShaderConstantv(int name, unsigned int numvals, const float *) {
+    return ShaderConstant(name, numvals);
+}
+
+int GFXShaderConstantv(int name, unsigned int numvals, const int *) {
+    return ShaderConstant(name, numvals);
+}
+
+bool GFXDefaultShaderSupported() {
+    return true;
+}
+
+void GFXReloadDefaultShader() {
+}
+
+void GFXUploadLightState(int,
+        int,
+        int,
+        bool,
+        vector<int>::const_iterator begin,
+        vector<int>::const_iterator end) {
+    for (vector<int>::const_iterator i = begin; i != end; ++i) {
+        Record(GFXNull::CMD_LIGHT, *i, 1);
+    }
+}
+
+bool GFXShaderReloaded() {
+    return false;
+}
+
+int GFXGetProgramVersion() {
+    return 0;
+}
+
+//The GL facing half of GFXVertexList; the rest lives in gl_vertex_list.cpp
+
+void GFXVertexList::RefreshDisplayList() {
+}
+
+void GFXVertexList::BeginDrawState(GFXBOOL) {
+}
+
+void GFXVertexList::EndDrawState(GFXBOOL) {
+}
+
+void GFXVertexList::Draw(enum POLYTYPE poly, int numV) {
+    INDEX index;
+    index.b = nullptr;
+    Draw(&poly, index, 1, &numV);
+}
+
+void GFXVertexList::Draw(enum POLYTYPE poly, int numV, unsigned char *index) {
+    INDEX tmp;
+    tmp.b = index;
+    Draw(&poly, tmp, 1, &numV);
+}
+
+void GFXVertexList::Draw(enum POLYTYPE poly, int numV, unsigned short *index) {
+    INDEX tmp;
+    tmp.s = index;
+    Draw(&poly, tmp, 1, &numV);
+}
+
+void GFXVertexList::Draw(enum POLYTYPE poly, int numV, unsigned int *index) {
+    INDEX tmp;
+    tmp.i = index;
+    Draw(&poly, tmp, 1, &numV);
+}
+
+void GFXVertexList::DrawOnce() {
+    LoadDrawState();
+    BeginDrawState(GFXFALSE);
+    Draw();
+    EndDrawState(GFXFALSE);
+}
+
+void GFXVertexList::Draw() {
+    Draw(mode, index, numlists, offsets);
+}
+
+void GFXVertexList::Draw(enum POLYTYPE *mode, const INDEX, const int numlists, const int *offsets) {
+    for (int i = 0; i < numlists; ++i) {
+        Record(GFXNull::CMD_DRAW_LIST, mode[i], i, offsets[i]);
+        ++gl_batches_this_frame;
+        gl_vertices_this_frame += offsets[i];
+    }
+}
+
+GFXVertexList::~GFXVertexList() {
+    if (offsets != nullptr) {
+        delete[] offsets;
+        offsets = nullptr;
+    }
+    if (mode != nullptr) {
+        delete[] mode;
+        mode = nullptr;
+    }
+    if (changed & HAS_COLOR) {
+        if (data.colors != nullptr) {
+            free(data.colors);
+            data.colors = nullptr;
+        }
+    } else if (data.vertices != nullptr) {
+        free(data.vertices);
+        data.vertices = nullptr;
+    }
+}
+
+union GFXVertexList::VDAT *GFXVertexList::Map(bool, bool) {
+    return &data;
+}
+
+void GFXVertexList::UnMap() {
+}
+
+union GFXVertexList::VDAT *GFXVertexList::BeginMutate(int) {
+    return this->Map(false, true);
+}
+
+void GFXVertexList::EndMutate(int newvertexsize) {
+    if (!(changed & CHANGE_MUTABLE)) {
+        changed |= CHANGE_CHANGE;
+    }
+    if (newvertexsize) {
+        numVertices = newvertexsize;
+        if (numlists == 1) {
+            *offsets = numVertices;
+        }
+    }
+    RenormalizeNormals();
+    if (changed & CHANGE_CHANGE) {
+        changed &= (~CHANGE_CHANGE);
+    }
+}
+
+GFXVertexList::GFXVertexList() :
+        numVertices(0),
+        mode(0),
+        unique_mode(0),
+        display_list(0),
+        vbo_data(0),
+        numlists(0),
+        offsets(0),
+        changed(0) {
+}
+
+POLYTYPE *GFXVertexList::GetPolyType() const {
+    return mode;
+}
+
+int *GFXVertexList::GetOffsets() const {
+    return offsets;
+}
+
+int GFXVertexList::GetNumLists() const {
+    return numlists;
+}
+
+void GFXSphereVertexList::ProceduralModification() {
+}
@@ -0,0 +1,134 @@
+/*
+ * gfx_null.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GLDRV_GFX_NULL_H
+#define VEGA_STRIKE_ENGINE_GLDRV_GFX_NULL_H
+
+#include <vector>
+
+/**
+ * The null GFX backend implements the whole gfxlib.h API without touching
+ * GL. It is linked in place of the GL driver (the vegastrike_gfx_null
+ * library, which the vegastrike bin links instead of the driver when
+ * configured with -DVS_GFX_BACKEND=null) so the CPU side of the draw path
+ * can be run and measured on machines with no GPU.
+ *
+ * Every draw call, state change, texture bind and matrix load is counted,
+ * and can also be appended to a command log which may be replayed later to
+ * recompute the counters, e.g. to compare a captured frame with a new run.
+ */
+namespace GFXNull {
+enum CommandType {
+    CMD_BEGIN_SCENE,
+    CMD_END_SCENE,
+    CMD_CLEAR,
+    /// GFXDraw; arg0 is the POLYTYPE, count the number of vertices
+    CMD_DRAW,
+    /// GFXDrawElements; arg0 is the POLYTYPE, count the number of indices
+    CMD_DRAW_ELEMENTS,
+    /// one list of a GFXVertexList; arg0 is the POLYTYPE, count the number of vertices
+    CMD_DRAW_LIST,
+    /// GFXCallList; arg0 is the display list
+    CMD_CALL_LIST,
+    /// GFXEnable/GFXDisable; arg0 is the STATE
+    CMD_ENABLE,
+    CMD_DISABLE,
+    /// arg0 and arg1 are the source and destination BLENDFUNC
+    CMD_BLEND_MODE,
+    /// any other fixed function state; arg0 is a RasterState
+    CMD_RASTER_STATE,
+    /// arg0 is the texture handle, arg1 the stage
+    CMD_SELECT_TEXTURE,
+    /// arg0 is the texture handle, count the number of bytes uploaded
+    CMD_TRANSFER_TEXTURE,
+    /// arg0 is the MATRIXMODE
+    CMD_LOAD_MATRIX,
+    /// arg0 is the material
+    CMD_SELECT_MATERIAL,
+    /// arg0 is the light, arg1 is 1 when enabled and 0 when disabled
+    CMD_LIGHT,
+    /// arg0 is the program, 0 for the fixed function pipeline
+    CMD_ACTIVATE_SHADER,
+    /// arg0 is the uniform location, count the number of values
+    CMD_SHADER_CONSTANT,
+    CMD_COLOR,
+};
+
+enum RasterState {
+    RS_DEPTH,
+    RS_STENCIL,
+    RS_ALPHA_TEST,
+    RS_CULL_FACE,
+    RS_POLYGON,
+    RS_TEXTURE,
+    RS_FOG,
+    RS_POINT_LINE,
+    RS_COLOR_MATERIAL,
+};
+
+struct Command {
+    CommandType type;
+    int arg0;
+    int arg1;
+    unsigned int count;
+};
+
+struct Counters {
+    unsigned long frames = 0;
+    unsigned long draw_calls = 0;
+    unsigned long vertices = 0;
+    unsigned long state_changes = 0;
+    unsigned long texture_binds = 0;
+    /// binds of the texture that was already bound to that stage
+    unsigned long redundant_texture_binds = 0;
+    unsigned long texture_uploads = 0;
+    unsigned long texture_bytes = 0;
+    unsigned long matrix_loads = 0;
+    unsigned long material_changes = 0;
+    unsigned long light_changes = 0;
+    unsigned long shader_changes = 0;
+    unsigned long shader_constants = 0;
+};
+
+/// clears the counters, the command log and the bound textures
+void Reset();
+const Counters &GetCounters();
+
+/// turns the command log on or off; the counters are always kept
+void SetRecording(bool record);
+bool IsRecording();
+const std::vector<Command> &GetCommandLog();
+
+/// recomputes the counters a command log would produce
+Counters Replay(const std::vector<Command> &log);
+
+/// the texture handle currently selected on the stage, -1 if none
+int BoundTexture(int stage);
+/// number of textures created and not yet deleted
+int LiveTextures();
+}
+
+#endif //VEGA_STRIKE_ENGINE_GLDRV_GFX_NULL_H
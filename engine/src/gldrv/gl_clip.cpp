@@ -31,6 +31,7 @@
 #include "gl_matrix.h"
 #include "root_generic/lin_time.h"
 #include <stdio.h>
+#include <string.h>
 using namespace GFXMatrices;  //causes problems with g_game
 double BoxFrust[6][4];
 double frust[6][4];
@@ -202,8 +203,60 @@ void GFXGetFrustumVars(bool retr, float *l, float *r, float *b, float *t, float
     }
 }
 
+void GFXFrustum(float *m, float *i, float left, float right, float bottom, float top, float nearval, float farval) {
+    float x, y, a, b, c, d;
+    x = (((float) 2.0) * nearval) / (right - left);
+    y = (((float) 2.0) * nearval) / (top - bottom);
+    a = (right + left) / (right - left);
+    b = (top + bottom) / (top - bottom);
+    //If farval == 0, we'll build an infinite-farplane projection matrix.
+    if (farval == 0) {
+        c = -1.0;
+        d = -1.99 * nearval;         //-2*nearval, but using exactly -2 might create artifacts
+    } else {
+        c = -(farval + nearval) / (farval - nearval);
+        d = -(((float) 2.0) * farval * nearval) / (farval - nearval);
+    }
+#define M(row, col) m[col*4+row]
+    M(0, 0) = x;
+    M(0, 1) = 0.0F;
+    M(0, 2) = a;
+    M(0, 3) = 0.0F;
+    M(1, 0) = 0.0F;
+    M(1, 1) = y;
+    M(1, 2) = b;
+    M(1, 3) = 0.0F;
+    M(2, 0) = 0.0F;
+    M(2, 1) = 0.0F;
+    M(2, 2) = c;
+    M(2, 3) = d;
+    M(3, 0) = 0.0F;
+    M(3, 1) = 0.0F;
+    M(3, 2) = -1.0F;
+    M(3, 3) = 0.0F;
+#undef M
+#define M(row, col) i[col*4+row]
+    M(0, 0) = 1. / x;
+    M(0, 1) = 0.0F;
+    M(0, 2) = 0.0F;
+    M(0, 3) = a / x;
+    M(1, 0) = 0.0F;
+    M(1, 1) = 1. / y;
+    M(1, 2) = 0.0F;
+    M(1, 3) = b / y;
+    M(2, 0) = 0.0F;
+    M(2, 1) = 0.0F;
+    M(2, 2) = 0.0F;
+    M(2, 3) = -1.0F;
+    M(3, 0) = 0.0F;
+    M(3, 1) = 0.0F;
+    M(3, 2) = 1.F / d;
+    M(3, 3) = (float) c / d;
+#undef M
+}
+
 void /*GFXDRVAPI*/ GFXGetFrustum(double f[6][4]) {
-    f = frust;
+    memcpy(f, frust, sizeof(frust));
 }
 
 void /*GFXDRVAPI*/ GFXBoxInFrustumModel(const Matrix &model) {
@@ -95,150 +95,6 @@ GFXBOOL /*GFXDRVAPI*/ GFXPopGlobalEffects() {
     return true;
 }
 
-GFXLight::GFXLight(const bool enabled,
-        const GFXColor &vect,
-        const GFXColor &diffuse,
-        const GFXColor &specular,
-        const GFXColor &ambient,
-        const GFXColor &attenuate,
-        const GFXColor &direction,
-        float exp,
-        float cutoff,
-        float size) {
-    target = -1;
-    options = 0;
-    memcpy(this->vect, &vect, sizeof(float) * 3);
-    memcpy(this->diffuse, &diffuse, sizeof(float) * 4);
-    memcpy(this->specular, &specular, sizeof(float) * 4);
-    memcpy(this->ambient, &ambient, sizeof(float) * 4);
-    memcpy(this->attenuate, &attenuate, sizeof(float) * 3);
-    memcpy(this->direction, &direction, sizeof(this->direction));
-    this->exp = exp;
-    this->cutoff = cutoff;
-    this->size = size;
-    apply_attenuate(attenuated());
-    if (enabled) {
-        this->enable();
-    } else {
-        this->disable();
-    }
-}
-
-void GFXLight::disable() {
-    options &= (~GFX_LIGHT_ENABLED);
-}
-
-void GFXLight::enable() {
-    options |= GFX_LIGHT_ENABLED;
-}
-
-bool GFXLight::attenuated() const {
-    return (attenuate[0] != 1) || (attenuate[1] != 0) || (attenuate[2] != 0);
-}
-
-void GFXLight::apply_attenuate(bool attenuated) {
-    options = attenuated
-            ? (options | GFX_ATTENUATED)
-            : (options & (~GFX_ATTENUATED));
-}
-
-void /*GFXDRVAPI*/ GFXLight::SetProperties(enum LIGHT_TARGET lighttarg, const GFXColor &color) {
-    switch (lighttarg) {
-        case DIFFUSE:
-            diffuse[0] = color.r;
-            diffuse[1] = color.g;
-            diffuse[2] = color.b;
-            diffuse[3] = color.a;
-            break;
-        case SPECULAR:
-            specular[0] = color.r;
-            specular[1] = color.g;
-            specular[2] = color.b;
-            specular[3] = color.a;
-            break;
-        case AMBIENT:
-            ambient[0] = color.r;
-            ambient[1] = color.g;
-            ambient[2] = color.b;
-            ambient[3] = color.a;
-            break;
-        case POSITION:
-            vect[0] = color.r;
-            vect[1] = color.g;
-            vect[2] = color.b;
-            break;
-        case ATTENUATE:
-            attenuate[0] = color.r;
-            attenuate[1] = color.g;
-            attenuate[2] = color.b;
-            break;
-        case EMISSION:
-        default:
-            break;
-    }
-    apply_attenuate(attenuated());
-}
-
-void /*GFXDRVAPI*/ GFXLight::SetProperties(const enum LIGHT_TARGET light_target, const Vector& vector) {
-    switch (light_target) {
-        case DIFFUSE:
-        case SPECULAR:
-        case AMBIENT:
-            VS_LOG(error, (boost::format("%1%: Called wrong overload for this property, with Vector& instead of GFXColor&")
-                    % __FUNCTION__));
-            break;
-        case POSITION:
-            vect[0] = vector.i;
-            vect[1] = vector.j;
-            vect[2] = vector.k;
-            break;
-        case ATTENUATE:
-            attenuate[0] = vector.i;
-            attenuate[1] = vector.j;
-            attenuate[2] = vector.k;
-            break;
-        case EMISSION:
-        default:
-            break;
-    }
-    apply_attenuate(attenuated());
-}
-
-GFXColor /*GFXDRVAPI*/ GFXLight::GetProperties(enum LIGHT_TARGET lighttarg) const {
-    switch (lighttarg) {
-        case SPECULAR:
-            return GFXColor(specular[0],
-                    specular[1],
-                    specular[2],
-                    specular[3]);
-
-        case AMBIENT:
-            return GFXColor(ambient[0],
-                    ambient[1],
-                    ambient[2],
-                    ambient[3]);
-
-        case POSITION:
-            return GFXColor(vect[0],
-                    vect[1],
-                    vect[2]);
-
-            break;
-        case ATTENUATE:
-            return GFXColor(
-                    attenuate[0],
-                    attenuate[1],
-                    attenuate[2]);
-
-        case DIFFUSE:
-        default:     //just for kicks
-            return GFXColor(diffuse[0],
-                    diffuse[1],
-                    diffuse[2],
-                    diffuse[3]);
-    }
-}
-
 GFXBOOL /*GFXDRVAPI*/ GFXSetCutoff(const float ttcutoff) {
     if (ttcutoff < 0) {
         return GFXFALSE;
@@ -375,7 +231,7 @@ void /*GFXDRVAPI*/ GFXSetLightContext(const int con_number) {
     unpicklights();
     int GLLindex = 0;
     unsigned int i;
-    lighttable.Clear();
+    invalidate_light_index();
     _currentContext = con_number;
     _llights = &_local_lights_dat[con_number];
     glLightModelfv(GL_LIGHT_MODEL_AMBIENT, (GLfloat *) &(_ambient_light[con_number]));
@@ -385,9 +241,7 @@ void /*GFXDRVAPI*/ GFXSetLightContext(const int con_number) {
     }
     for (i = 0; i < _llights->size() && GLLindex < GFX_MAX_LIGHTS; i++) {
         if ((*_llights)[i].enabled()) {
-            if ((*_llights)[i].LocalLight()) {
-                (*_llights)[i].AddToTable();
-            } else {
+            if (!(*_llights)[i].LocalLight()) {
                 GLLights[GLLindex].index = -1;                 //make it clobber completley! no trace of old light.
                 (*_llights)[i].ClobberGLLight(GLLindex);
                 GLLindex++;
@@ -402,7 +256,7 @@ void /*GFXDRVAPI*/ GFXSetLightContext(const int con_number) {
 }
 
 void GFXDestroyAllLights() {
-    lighttable.Clear();
+    invalidate_light_index();
     if (GLLights != nullptr) {
         free(GLLights);
         GLLights = nullptr;
@@ -28,7 +28,6 @@
 #define VEGA_STRIKE_ENGINE_GLDRV_GL_LIGHT_H
 
 #include "src/gfxlib.h"
-#include "hashtable_3d.h"
 #include "gl_globals.h"
 extern GLint GFX_MAX_LIGHTS;
 extern GLint GFX_OPTIMAL_LIGHTS;
@@ -40,7 +39,6 @@ extern GFXBOOL GFXLIGHTING;
 //#define GFX_LIGHT_POS 16
 #define GFX_LIGHT_ENABLED 32
 #define GFX_LOCAL_LIGHT 64
-const unsigned int lighthuge = 20 * 20 * 20;
 /**
  * This stores the state of a given GL Light in its fullness
  * It inherits all values a light may have, and gains a number of functions
@@ -102,42 +100,34 @@ public:
 
     /**
      * for global lights, clobbers SOMETHING for sure, calls GLenable
-     * for local lights, puts it into the light table
+     * for local lights, marks the light index for a rebuild
      */
     void Enable();
 
     /**
      * for global lights, GLdisables it.
-     * for local lights, removes it from the table. and trashes it form GLlights.
+     * for local lights, marks the light index for a rebuild and trashes it form GLlights.
      */
     void Disable();
 
     /** sets properties, making minimum GL state changes for global,
-     *  for local lights, removes it from table, trashes it from GLlights,
-     *  if enabled, puts it back in table.
+     *  for local lights, marks the light index for a rebuild and trashes it from GLlights.
      */
     void ResetProperties(const enum LIGHT_TARGET light_targ, const GFXColor &color);
 
     /** sets properties, making minimum GL state changes for global,
-     *  for local lights, removes it from table, trashes it from GLlights,
-     *  if enabled, puts it back in table.
+     *  for local lights, marks the light index for a rebuild and trashes it from GLlights.
      */
     void ResetProperties(const enum LIGHT_TARGET light_target, const Vector &vector);
 
-    ///Adds this light to table (assume local)
-    void AddToTable();
-
-    ///Removes this light from light table
-    bool RemoveFromTable(bool shouldremove = true, const GFXLight &t = GFXLight());
-
     ///Trash this light from active GLLights
     void TrashFromGLLights();
 
     ///Do all enables from picking
     static void dopickenables();
 
-    ///calculates bounds for the table given cutoffs!
-    LineCollide CalculateBounds(bool &err);
+    ///calculates how far the light reaches given cutoffs! err if it has no finite reach
+    float CalculateRange(bool &err) const;
 };
 
 namespace OpenGLL {
@@ -162,6 +152,8 @@ void light_rekey_frame();
 ///picks doubtless changed position
 void unpicklights();
 void removelightfromnewpick(int whichlight);
+///Local lights changed; the light index is rebuilt at the next pick
+void invalidate_light_index();
 ///The curren tlight context
 extern int _currentContext;
 ///The light data _llights points to one of these
@@ -176,33 +168,9 @@ extern int _GLLightsEnabled;
 ///currently stored GL lights!
 extern OpenGLLights *GLLights;
 
-///A sortable line collide object that will sort by object addr for dup elim
-struct LineCollideStar {
-    LineCollide *lc;
-
-    LineCollideStar() {
-        lc = NULL;
-    }
-
-    bool operator==(const LineCollideStar &b) const {
-        return lc->object.i == b.lc->object.i;
-    }
-
-    bool operator<(const LineCollideStar &b) const {
-        return *((int *) &(lc->object.i)) < *((int *) &(b.lc->object.i));
-    }
-
-    inline int GetIndex() {
-        return *((int *) (&lc->object.i));
-    }
-};
 ///Finds the local lights that are clobberable for new lights (permanent perhaps)
 int findLocalClobberable();
 
-#define CTACC 40000
-///table to store local lights, numerical pointers to _llights (eg indices)
-extern Hashtable3d<LineCollideStar, 20, CTACC, lighthuge> lighttable;
-
 ///something that would normally round down
 extern float intensity_cutoff;
 ///optimization globals
@@ -0,0 +1,223 @@
+/*
+ * gl_light_cluster.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cmath>
+
+#include "gl_light_cluster.h"
+
+static unsigned int ClampedCell(double f, unsigned int n) {
+    if (!(f > 0)) {
+        return 0;
+    }
+    if (f >= n) {
+        return n - 1;
+    }
+    return static_cast<unsigned int>(f);
+}
+
+LightClusterIndex::LightClusterIndex(unsigned int tiles_x, unsigned int tiles_y, unsigned int slices) :
+        tiles_x(std::max(1U, tiles_x)),
+        tiles_y(std::max(1U, tiles_y)),
+        slices(std::max(1U, slices)),
+        has_view(false),
+        tan_left(-1),
+        tan_right(1),
+        tan_bottom(-1),
+        tan_top(1),
+        znear(1),
+        slice_scale(1),
+        query_stamp(0) {
+}
+
+void LightClusterIndex::SetView(const QVector &eye,
+        const Vector &axis_x,
+        const Vector &axis_y,
+        const Vector &forward,
+        float left,
+        float right,
+        float bottom,
+        float top,
+        float znear,
+        float zfar) {
+    has_view = znear > 0 && right > left && top > bottom;
+    if (!has_view) {
+        return;
+    }
+    this->eye = eye;
+    this->axis_x = axis_x.Cast();
+    this->axis_y = axis_y.Cast();
+    this->forward = forward.Cast();
+    tan_left = left / znear;
+    tan_right = right / znear;
+    tan_bottom = bottom / znear;
+    tan_top = top / znear;
+    this->znear = znear;
+    //an infinite far plane still needs a last slice to end on
+    const double far_plane = (zfar > znear) ? zfar : znear * 1000000.0;
+    slice_scale = slices / log(far_plane / znear);
+}
+
+void LightClusterIndex::Clear() {
+    light_ids.clear();
+    positions.clear();
+    ranges.clear();
+    unbinned.clear();
+    cluster_start.clear();
+    cluster_lights.clear();
+}
+
+void LightClusterIndex::AddLight(int light, const QVector &position, float range) {
+    light_ids.push_back(light);
+    positions.push_back(position);
+    ranges.push_back(range);
+}
+
+bool LightClusterIndex::ClusterRange(const QVector &center,
+        float radius,
+        unsigned int lo[3],
+        unsigned int hi[3]) const {
+    if (!has_view) {
+        return false;
+    }
+    const QVector rel = center - eye;
+    const double d = rel.Dot(forward);
+    const double dmin = d - radius;
+    if (dmin < znear) {
+        return false;
+    }
+    const double dmax = d + radius;
+    const double x = rel.Dot(axis_x);
+    const double y = rel.Dot(axis_y);
+    //x / d over the box around the sphere is extreme at its corners
+    const double x0 = std::min((x - radius) / dmin, (x - radius) / dmax);
+    const double x1 = std::max((x + radius) / dmin, (x + radius) / dmax);
+    const double y0 = std::min((y - radius) / dmin, (y - radius) / dmax);
+    const double y1 = std::max((y + radius) / dmin, (y + radius) / dmax);
+
+    const double xscale = tiles_x / (tan_right - tan_left);
+    const double yscale = tiles_y / (tan_top - tan_bottom);
+    lo[0] = ClampedCell((x0 - tan_left) * xscale, tiles_x);
+    hi[0] = ClampedCell((x1 - tan_left) * xscale, tiles_x);
+    lo[1] = ClampedCell((y0 - tan_bottom) * yscale, tiles_y);
+    hi[1] = ClampedCell((y1 - tan_bottom) * yscale, tiles_y);
+    lo[2] = ClampedCell(log(dmin / znear) * slice_scale, slices);
+    hi[2] = ClampedCell(log(dmax / znear) * slice_scale, slices);
+    return true;
+}
+
+void LightClusterIndex::Build() {
+    const size_t nlights = light_ids.size();
+    const unsigned int nclusters = tiles_x * tiles_y * slices;
+    unbinned.clear();
+    cluster_start.assign(nclusters + 1, 0);
+    light_bounds.resize(nlights * 6);
+    if (seen.size() < nlights) {
+        seen.resize(nlights, 0);
+    }
+
+    //count the lights of each cluster, shifted by one for the prefix sum
+    for (size_t l = 0; l < nlights; ++l) {
+        unsigned int *b = &light_bounds[l * 6];
+        if (!ClusterRange(positions[l], ranges[l], b, b + 3)) {
+            unbinned.push_back(l);
+            continue;
+        }
+        for (unsigned int z = b[2]; z <= b[5]; ++z) {
+            for (unsigned int y = b[1]; y <= b[4]; ++y) {
+                const unsigned int row = (z * tiles_y + y) * tiles_x;
+                for (unsigned int x = b[0]; x <= b[3]; ++x) {
+                    ++cluster_start[row + x + 1];
+                }
+            }
+        }
+    }
+    for (unsigned int c = 0; c < nclusters; ++c) {
+        cluster_start[c + 1] += cluster_start[c];
+    }
+    cluster_lights.resize(cluster_start[nclusters]);
+
+    //fill, walking the same clusters; cluster_start[c] is used as the cursor and ends up at c + 1's start
+    std::vector<unsigned int>::iterator unbinned_light = unbinned.begin();
+    for (size_t l = 0; l < nlights; ++l) {
+        if (unbinned_light != unbinned.end() && *unbinned_light == l) {
+            ++unbinned_light;
+            continue;
+        }
+        const unsigned int *b = &light_bounds[l * 6];
+        for (unsigned int z = b[2]; z <= b[5]; ++z) {
+            for (unsigned int y = b[1]; y <= b[4]; ++y) {
+                const unsigned int row = (z * tiles_y + y) * tiles_x;
+                for (unsigned int x = b[0]; x <= b[3]; ++x) {
+                    cluster_lights[cluster_start[row + x]++] = l;
+                }
+            }
+        }
+    }
+    //shift the cursors back into starts
+    for (unsigned int c = nclusters; c > 0; --c) {
+        cluster_start[c] = cluster_start[c - 1];
+    }
+    cluster_start[0] = 0;
+}
+
+void LightClusterIndex::TestLight(unsigned int l, const QVector &center, float radius, std::vector<int> &lights) {
+    if (seen[l] == query_stamp) {
+        return;
+    }
+    seen[l] = query_stamp;
+    const double reach = static_cast<double>(ranges[l]) + radius;
+    if ((positions[l] - center).MagnitudeSquared() <= reach * reach) {
+        lights.push_back(light_ids[l]);
+    }
+}
+
+void LightClusterIndex::Query(const QVector &center, float radius, std::vector<int> &lights) {
+    if (++query_stamp == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        query_stamp = 1;
+    }
+    unsigned int lo[3], hi[3];
+    if (cluster_start.empty() || !ClusterRange(center, radius, lo, hi)) {
+        for (unsigned int l = 0; l < light_ids.size(); ++l) {
+            TestLight(l, center, radius, lights);
+        }
+        return;
+    }
+    for (unsigned int l : unbinned) {
+        TestLight(l, center, radius, lights);
+    }
+    for (unsigned int z = lo[2]; z <= hi[2]; ++z) {
+        for (unsigned int y = lo[1]; y <= hi[1]; ++y) {
+            const unsigned int row = (z * tiles_y + y) * tiles_x;
+            for (unsigned int c = row + lo[0]; c <= row + hi[0]; ++c) {
+                for (unsigned int i = cluster_start[c]; i < cluster_start[c + 1]; ++i) {
+                    TestLight(cluster_lights[i], center, radius, lights);
+                }
+            }
+        }
+    }
+}
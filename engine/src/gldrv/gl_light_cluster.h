@@ -0,0 +1,114 @@
+/*
+ * gl_light_cluster.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GLDRV_GL_LIGHT_CLUSTER_H
+#define VEGA_STRIKE_ENGINE_GLDRV_GL_LIGHT_CLUSTER_H
+
+#include <vector>
+#include "gfx_generic/vec.h"
+
+/**
+ * Bins local lights into a view space cluster grid so the lights reaching an
+ * object can be found without looking at every light.
+ *
+ * The grid is cut into tiles across the view frustum and exponential slices
+ * along the view direction. Each light goes into every cluster its range
+ * sphere may touch, once per build; a query walks the clusters the object's
+ * sphere may touch and returns each light whose range sphere overlaps it.
+ * Spheres that reach behind the near plane cannot be placed in the grid:
+ * such lights are checked by every query, and such objects check every
+ * light. Positions and ranges are in world space; the view only decides
+ * how the work is split, so a stale view costs time, not correctness.
+ *
+ * No GL calls are made, the driver feeds it from its light list.
+ */
+class LightClusterIndex {
+public:
+    LightClusterIndex(unsigned int tiles_x = 16, unsigned int tiles_y = 8, unsigned int slices = 24);
+
+    /**
+     * Sets the view the grid is laid out in. The axes are the camera's right,
+     * up and viewing directions; left..right and bottom..top is the frustum
+     * at distance znear, as set by GFXGetFrustumVars. A zfar not beyond znear
+     * means an infinite far plane.
+     */
+    void SetView(const QVector &eye,
+            const Vector &axis_x,
+            const Vector &axis_y,
+            const Vector &forward,
+            float left,
+            float right,
+            float bottom,
+            float top,
+            float znear,
+            float zfar);
+
+    void Clear();
+
+    ///light is the caller's index for it, range how far from position it still needs picking
+    void AddLight(int light, const QVector &position, float range);
+
+    ///Bins the lights added since Clear
+    void Build();
+
+    ///Appends, once each, the lights whose range overlaps the sphere
+    void Query(const QVector &center, float radius, std::vector<int> &lights);
+
+    size_t Size() const {
+        return light_ids.size();
+    }
+
+private:
+    ///the clusters a sphere may touch; false if it reaches behind the near plane
+    bool ClusterRange(const QVector &center, float radius, unsigned int lo[3], unsigned int hi[3]) const;
+
+    void TestLight(unsigned int l, const QVector &center, float radius, std::vector<int> &lights);
+
+    unsigned int tiles_x, tiles_y, slices;
+
+    bool has_view;
+    QVector eye, axis_x, axis_y, forward;
+    double tan_left, tan_right, tan_bottom, tan_top;
+    double znear, slice_scale;
+
+    std::vector<int> light_ids;
+    std::vector<QVector> positions;
+    std::vector<float> ranges;
+
+    ///lights reaching behind the near plane
+    std::vector<unsigned int> unbinned;
+    ///cluster_start[c] .. cluster_start[c + 1] indexes cluster_lights for cluster c
+    std::vector<unsigned int> cluster_start;
+    std::vector<unsigned int> cluster_lights;
+    ///per light clusters, kept from the counting pass of Build for the filling pass
+    std::vector<unsigned int> light_bounds;
+
+    ///stamp of the last query that returned each light, so a light in several clusters is returned once
+    std::vector<unsigned int> seen;
+    unsigned int query_stamp;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GLDRV_GL_LIGHT_CLUSTER_H
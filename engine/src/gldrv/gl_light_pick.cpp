@@ -27,6 +27,9 @@
 
 
 #include "gl_light.h"
+#include "gl_light_cluster.h"
+#include "gfx_generic/matrix.h"
+#include "gl_matrix.h"
 #include "root_generic/options.h"
 #include <queue>
 #include <list>
@@ -36,7 +39,6 @@
 #include <vector>
 #include <algorithm>
 using std::priority_queue;
-#include "hashtable_3d.h"
 //using std::list;
 using std::vector;
 //optimization globals
@@ -83,10 +85,6 @@ void removelightfromnewpick(int index) {
     }
 }
 
-inline int getIndex(const LineCollide &t) {
-    return t.object.i;
-}
-
 static void swappicked() {
     if (newpicked == &pickedlights[0]) {
         newpicked = &pickedlights[1];
@@ -143,10 +141,8 @@ static float attenuatedIntensity(const gfx_light &light, const Vector &center, c
     }
 }
 
-static bool picklight(const LineCollide &lightcollide,
-        const Vector &center,
+static bool picklight(const Vector &center,
         const float rad,
-        const int lightsenabled,
         const int lightindex,
         float &attenuated,
         float &occlusion) {
@@ -171,7 +167,39 @@ struct lightsort {
     }
 };
 
-typedef vector<LineCollideStar> veclinecol;
+//local lights binned by where they reach, rebuilt on the first pick after lights or the view changed
+static LightClusterIndex light_index;
+static bool light_index_stale = true;
+
+void invalidate_light_index() {
+    light_index_stale = true;
+}
+
+static void rebuild_light_index() {
+    using GFXMatrices::view;
+    float left, right, bottom, top, znear, zfar;
+    GFXGetFrustumVars(true, &left, &right, &bottom, &top, &znear, &zfar);
+    //the camera axes are the columns of the view rotation, and it looks down -z
+    light_index.SetView(view.p,
+            Vector(view.r[0], view.r[3], view.r[6]),
+            Vector(view.r[1], view.r[4], view.r[7]),
+            Vector(-view.r[2], -view.r[5], -view.r[8]),
+            left, right, bottom, top, znear, zfar);
+    light_index.Clear();
+    for (size_t i = 0; i < _llights->size(); ++i) {
+        const gfx_light &light = (*_llights)[i];
+        if (!light.enabled() || !light.LocalLight()) {
+            continue;
+        }
+        bool err;
+        float range = light.CalculateRange(err);
+        if (!err) {
+            light_index.AddLight(i, QVector(light.vect[0], light.vect[1], light.vect[2]), range);
+        }
+    }
+    light_index.Build();
+    light_index_stale = false;
+}
 
 void GFXGlobalLights(vector<int> &lights, const Vector &center, const float radius) {
     for (int i = 0; i < GFX_MAX_LIGHTS; ++i) {
@@ -193,35 +221,36 @@ void GFXGlobalLights(vector<int> &lights) {
     }
 }
 
+//Appends the local lights that reach the sphere and stay bright enough after occlusion
+static void pick_local_lights(const Vector &center, const float radius, vector<int> &lights) {
+    if (light_index_stale) {
+        rebuild_light_index();
+    }
+    const size_t first_local = lights.size();
+    light_index.Query(center.Cast(), radius, lights);
+    size_t kept = first_local;
+    for (size_t k = first_local; k < lights.size(); ++k) {
+        const int ix = lights[k];
+        float attenuated = 0, occlusion = 0;
+        if (picklight(center, radius, ix, attenuated, occlusion)) {
+            (*_llights)[ix].occlusion = occlusion;
+            lights[kept++] = ix;
+        }
+    }
+    lights.resize(kept);
+}
+
 void GFXPickLights(const Vector &center,
         const float radius,
         vector<int> &lights,
         const int maxlights,
         const bool pickglobals) {
-    QVector tmp;
-    int lightsenabled = _GLLightsEnabled;
-    tmp = QVector(radius, radius, radius);
-
-    if (lightsenabled && pickglobals) {
+    if (_GLLightsEnabled && pickglobals) {
         GFXGlobalLights(lights, center, radius);
     }
-
-    veclinecol *tmppickt[2];
-    lighttable.Get(center.Cast(), tmppickt);
-
-    for (int j = 0; j < 2; j++) {
-        veclinecol::iterator i;
-        float attenuated = 0, occlusion = 0;
-
-        for (i = tmppickt[j]->begin(); i != tmppickt[j]->end(); i++) {
-            if (picklight(*i->lc, center, radius, lightsenabled, i->GetIndex(), attenuated, occlusion)) {
-                int ix = i->GetIndex();
-                gfx_light &l = (*_llights)[ix];
-                l.occlusion = occlusion;
-                lights.push_back(ix);
-                lightsenabled++;
-            }
-        }
+    //what the camera cannot see behind a planet is not worth lighting
+    if (!Occlusion::isHidden(center.Cast(), radius)) {
+        pick_local_lights(center, radius, lights);
     }
     std::sort(lights.begin(), lights.end(), lightsort(center, radius));
 }
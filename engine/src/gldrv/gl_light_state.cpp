@@ -30,8 +30,8 @@
 #include <cstring>
 //#include <vegastrike.h>
 #include "gl_globals.h"
-#include "hashtable_3d.h"
 #include "gl_light.h"
+#include "src/vs_logging.h"
 
 #include <math.h>
 #include "gfx_generic/matrix.h"
@@ -187,7 +187,6 @@ const float atten0scale = 1;
 const float atten1scale = 1. / GFX_SCALE;
 const float atten2scale = 1. / (GFX_SCALE * GFX_SCALE);
 int _GLLightsEnabled = 0;
-Hashtable3d<LineCollideStar, 20, CTACC, lighthuge> lighttable;
 
 GFXLight gfx_light::operator=(const GFXLight &tmp) {   // Let's see if I can write a better copy operator
 //    memcpy( this, &tmp, sizeof (GFXLight) );
@@ -273,7 +272,7 @@ bool gfx_light::Create(const GFXLight &temp, bool global) {
 }
 
 void gfx_light::Kill() {
-    Disable();     //first disables it...which _will_ remove it from the light table.
+    Disable();     //first disables it...which _will_ drop it from the light index.
     if (target >= 0) {
         TrashFromGLLights();          //then if not already done, trash from GLlights;
     }
@@ -391,16 +390,9 @@ void gfx_light::ClobberGLLight(const int target) {
 }
 
 void gfx_light::ResetProperties(const enum LIGHT_TARGET light_targ, const GFXColor &color) {
-    bool changed = false;
     if (LocalLight()) {
-        GFXLight t;
-        t = *this;
-        t.SetProperties(light_targ, color);
-        changed = RemoveFromTable(false, t);
-        *this = t;
-        if (changed) {
-            AddToTable();
-        }
+        SetProperties(light_targ, color);
+        invalidate_light_index();
         if (target >= 0) {
             TrashFromGLLights();
         }
@@ -464,18 +456,10 @@ void gfx_light::ResetProperties(const enum LIGHT_TARGET light_targ, const GFXCol
 }
 
 void gfx_light::ResetProperties(const enum LIGHT_TARGET light_target, const Vector& vector) {
-    bool changed = false;
     if (LocalLight())
     {
-        GFXLight t;
-        t = *this;
-        t.SetProperties(light_target, vector);
-        changed = RemoveFromTable(false, t);
-        *this = t;
-        if (changed)
-        {
-            AddToTable();
-        }
+        SetProperties(light_target, vector);
+        invalidate_light_index();
         if (target >= 0)
         {
             TrashFromGLLights();
@@ -528,53 +512,11 @@ void gfx_light::TrashFromGLLights() {
     target = -1;
 }
 
-void gfx_light::AddToTable() {
-    LineCollideStar tmp;
-    bool err;
-    LineCollide *coltarg = new LineCollide(CalculateBounds(err));     //leak??
-    if (err) {
-        return;
-    }
-    tmp.lc = coltarg;
-    lighttable.Put(coltarg, tmp);
-}
-
-bool gfx_light::RemoveFromTable(bool shouldremove, const GFXLight &t) {
-    LineCollideStar tmp;
-    bool err;
-    LineCollide coltarg(CalculateBounds(err));
-    if (!shouldremove) {
-        bool err2;
-        LineCollide coltarg2(CalculateBounds(err2));
-        if (lighttable.hash_int(coltarg2.Mini.i) == lighttable.hash_int(coltarg.Mini.i)
-                && lighttable.hash_int(coltarg2.Mini.j) == lighttable.hash_int(coltarg.Mini.j)
-                && lighttable.hash_int(coltarg2.Mini.k) == lighttable.hash_int(coltarg.Mini.k)
-                && lighttable.hash_int(coltarg2.Maxi.i) == lighttable.hash_int(coltarg.Maxi.i)
-                && lighttable.hash_int(coltarg2.Maxi.j) == lighttable.hash_int(coltarg.Maxi.j)
-                && lighttable.hash_int(coltarg2.Maxi.k) == lighttable.hash_int(coltarg.Maxi.k)) {
-            return false;
-        }
-    }
-    if (err) {
-        return false;
-    }
-    tmp.lc = &coltarg;
-    if (lighttable.Remove(&coltarg, tmp)) {
-        if (tmp.lc != nullptr) {
-            delete tmp.lc;
-            tmp.lc = nullptr;
-        } else {
-            assert(tmp.lc);
-        }
-    }
-    return true;
-}
-
 //unimplemented
 void gfx_light::Enable() {
     if (!enabled()) {
         if (LocalLight()) {
-            AddToTable();
+            invalidate_light_index();
         } else {
             if (target == -1) {
                 int newtarg = findGlobalClobberable();
@@ -602,11 +544,8 @@ void gfx_light::Disable() {
             }
             GLLights[this->target].options &= (~(OpenGLL::GL_ENABLED | OpenGLL::GLL_ON));
         }
-        if (LocalLight() && enabled()) {
-            RemoveFromTable();
-            if (target >= 0) {
-                TrashFromGLLights();
-            }
+        if (LocalLight()) {
+            invalidate_light_index();
         }
     }
 }
@@ -615,7 +554,7 @@ void gfx_light::Disable() {
 //d= (-Bi + sqrtf (B*i*B*i - 4*Ci*(Ai-tot)))/ (2Ci)
 //d= (-B + sqrtf (B*B + 4*C*(tot/i-A)))/ (2C)
 
-LineCollide gfx_light::CalculateBounds(bool &error) {
+float gfx_light::CalculateRange(bool &error) const {
     error = false;
     float tot_intensity = ((specular[0] + specular[1] + specular[2]) * specular[3]
             + (diffuse[0] + diffuse[1] + diffuse[2]) * diffuse[3]
@@ -628,20 +567,16 @@ LineCollide gfx_light::CalculateBounds(bool &error) {
     ffastmathreallysucksd = sqrt(tot_intensity / intensity_cutoff - ambient[0]);
 
     ffastmathreallysucksq = sqrt(attenuate[2] + attenuate[1]);
-    if (ffastmathreallysucksq == 0 || ffastmathreallysucksd <= 0) {
+    if (ffastmathreallysucksq == 0 || !(ffastmathreallysucksd > 0)) {
         error = true;
+        return 0;
     }
-    ffastmathreallysucksd /= ffastmathreallysucksq;
-
-    QVector st(vect[0] - ffastmathreallysucksd, vect[1] - ffastmathreallysucksd, vect[2] - ffastmathreallysucksd);
-    QVector end(vect[0] + ffastmathreallysucksd, vect[1] + ffastmathreallysucksd, vect[2] + ffastmathreallysucksd);
-    LineCollide retval(NULL, LineCollide::UNIT, st, end);
-    *((int *) (&retval.object)) = lightNum();       //put in a lightNum
-    return retval;
+    return static_cast<float>(ffastmathreallysucksd / ffastmathreallysucksq);
 }
 
 void light_rekey_frame() {
     unpicklights();     //picks doubtless changed position
+    invalidate_light_index();     //and the view the index is laid out in
     for (int i = 0; i < GFX_MAX_LIGHTS; i++) {
         if (GLLights[i].options & OpenGLL::GL_ENABLED) {
             if (GLLights[i].index >= 0) {
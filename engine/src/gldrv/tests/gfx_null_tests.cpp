@@ -0,0 +1,122 @@
+/*
+ * gfx_null_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "gldrv/gfx_null.h"
+#include "src/gfxlib.h"
+
+static const float triangle[] = {
+        0, 0, 0,
+        1, 0, 0,
+        0, 1, 0,
+};
+
+TEST(GFXNull, CountsDrawCallsAndVertices) {
+    GFXNull::Reset();
+    GFXBeginScene();
+    GFXDraw(GFXTRI, triangle, 3);
+    const unsigned short indices[] = {0, 1, 2, 2, 1, 0};
+    GFXDrawElements(GFXTRI, triangle, 3, indices, 6);
+    GFXDraw(GFXTRI, triangle, 0);
+    GFXEndScene();
+
+    const GFXNull::Counters &counters = GFXNull::GetCounters();
+    EXPECT_EQ(1U, counters.frames);
+    EXPECT_EQ(2U, counters.draw_calls);
+    EXPECT_EQ(9U, counters.vertices);
+}
+
+TEST(GFXNull, VertexListDrawsEachList) {
+    GFXNull::Reset();
+    GFXVertex vertices[7];
+    POLYTYPE modes[2] = {GFXTRI, GFXLINE};
+    int offsets[2] = {3, 4};
+    GFXVertexList list(modes, 7, vertices, 2, offsets);
+    list.DrawOnce();
+
+    EXPECT_EQ(2U, GFXNull::GetCounters().draw_calls);
+    EXPECT_EQ(7U, GFXNull::GetCounters().vertices);
+}
+
+TEST(GFXNull, TracksBoundTextures) {
+    GFXNull::Reset();
+    int handle = -1;
+    ASSERT_TRUE(GFXCreateTexture(64, 64, RGBA32, &handle));
+    EXPECT_TRUE(GFXTransferTexture(nullptr, handle, 64, 64, RGBA32));
+    GFXSelectTexture(handle, 0);
+    GFXSelectTexture(handle, 0);
+    GFXSelectTexture(handle, 1);
+    EXPECT_EQ(handle, GFXNull::BoundTexture(0));
+    EXPECT_EQ(handle, GFXNull::BoundTexture(1));
+
+    const GFXNull::Counters &counters = GFXNull::GetCounters();
+    EXPECT_EQ(3U, counters.texture_binds);
+    EXPECT_EQ(1U, counters.redundant_texture_binds);
+    EXPECT_EQ(1U, counters.texture_uploads);
+    EXPECT_EQ(64U * 64U * 4U, counters.texture_bytes);
+
+    GFXDeleteTexture(handle);
+    EXPECT_EQ(-1, GFXNull::BoundTexture(0));
+    EXPECT_FALSE(GFXTransferTexture(nullptr, handle, 64, 64, RGBA32));
+}
+
+TEST(GFXNull, ReplayReproducesCounters) {
+    GFXNull::Reset();
+    GFXNull::SetRecording(true);
+    GFXBeginScene();
+    GFXBlendMode(SRCALPHA, INVSRCALPHA);
+    GFXEnable(DEPTHTEST);
+    GFXSelectTexture(3, 0);
+    GFXSelectTexture(3, 0);
+    GFXDraw(GFXTRI, triangle, 3);
+    GFXEndScene();
+    GFXNull::SetRecording(false);
+
+    const GFXNull::Counters live = GFXNull::GetCounters();
+    const GFXNull::Counters replayed = GFXNull::Replay(GFXNull::GetCommandLog());
+    EXPECT_EQ(live.frames, replayed.frames);
+    EXPECT_EQ(live.draw_calls, replayed.draw_calls);
+    EXPECT_EQ(live.vertices, replayed.vertices);
+    EXPECT_EQ(live.state_changes, replayed.state_changes);
+    EXPECT_EQ(live.texture_binds, replayed.texture_binds);
+    EXPECT_EQ(live.redundant_texture_binds, replayed.redundant_texture_binds);
+    EXPECT_EQ(live.matrix_loads, replayed.matrix_loads);
+    EXPECT_EQ(2U, replayed.state_changes);
+}
+
+TEST(GFXNull, FrustumFollowsTheMatrices) {
+    GFXLoadIdentity(VIEW);
+    GFXLoadIdentity(MODEL);
+    GFXPerspective(90, 1, 1, 100000, 0);
+    GFXCalculateFrustum();
+
+    EXPECT_GT(GFXSphereInFrustum(QVector(0, 0, -1000), 10), 0);
+    EXPECT_EQ(0, GFXSphereInFrustum(QVector(0, 0, 1000), 10));
+    EXPECT_EQ(0, GFXSphereInFrustum(QVector(5000, 0, -1000), 10));
+}
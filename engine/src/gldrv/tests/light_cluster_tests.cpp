@@ -0,0 +1,134 @@
+/*
+ * light_cluster_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "gldrv/gl_light_cluster.h"
+
+struct TestSphere {
+    QVector center;
+    float radius;
+};
+
+//Spheres all around the camera, so some are behind it or straddle the near plane
+static std::vector<TestSphere> RandomSpheres(std::mt19937 &rng, const QVector &eye, size_t count, float max_radius) {
+    std::uniform_real_distribution<double> offset(-3000, 3000);
+    std::uniform_real_distribution<float> radius(0.5F, max_radius);
+    std::vector<TestSphere> spheres(count);
+    for (TestSphere &sphere : spheres) {
+        const double i = offset(rng);
+        const double j = offset(rng);
+        const double k = offset(rng);
+        sphere.center = eye + QVector(i, j, k);
+        sphere.radius = radius(rng);
+    }
+    return spheres;
+}
+
+static std::vector<int> BruteForce(const std::vector<TestSphere> &lights, const TestSphere &object) {
+    std::vector<int> found;
+    for (size_t l = 0; l < lights.size(); ++l) {
+        const double reach = static_cast<double>(lights[l].radius) + object.radius;
+        if ((lights[l].center - object.center).MagnitudeSquared() <= reach * reach) {
+            found.push_back(l);
+        }
+    }
+    return found;
+}
+
+static void ExpectMatchesBruteForce(LightClusterIndex &index,
+        const std::vector<TestSphere> &lights,
+        const std::vector<TestSphere> &objects) {
+    std::vector<int> found;
+    size_t total = 0;
+    for (size_t o = 0; o < objects.size(); ++o) {
+        found.clear();
+        index.Query(objects[o].center, objects[o].radius, found);
+        std::sort(found.begin(), found.end());
+        const std::vector<int> expected = BruteForce(lights, objects[o]);
+        EXPECT_EQ(expected, found) << "object " << o;
+        total += expected.size();
+    }
+    EXPECT_GT(total, 0U);
+}
+
+TEST(LightClusterIndex, MatchesBruteForce) {
+    std::mt19937 rng(1234);
+    const QVector eye(1.0e7, -2.0e6, 3.0e6);
+    const std::vector<TestSphere> lights = RandomSpheres(rng, eye, 500, 400.0F);
+    const std::vector<TestSphere> objects = RandomSpheres(rng, eye, 2000, 60.0F);
+
+    LightClusterIndex index;
+    const Vector forward = Vector(0.3, 0.2, 1).Normalize();
+    const Vector axis_x = Vector(0, 1, 0).Cross(forward).Normalize();
+    index.SetView(eye, axis_x, forward.Cross(axis_x), forward, -1.33F, 1.33F, -1.0F, 1.0F, 1.0F, 5000.0F);
+    for (size_t l = 0; l < lights.size(); ++l) {
+        index.AddLight(l, lights[l].center, lights[l].radius);
+    }
+    index.Build();
+    ExpectMatchesBruteForce(index, lights, objects);
+}
+
+TEST(LightClusterIndex, WorksWithoutViewAndWithInfiniteFar) {
+    std::mt19937 rng(99);
+    const QVector eye(0, 0, 0);
+    const std::vector<TestSphere> lights = RandomSpheres(rng, eye, 200, 800.0F);
+    const std::vector<TestSphere> objects = RandomSpheres(rng, eye, 500, 100.0F);
+
+    LightClusterIndex index(4, 4, 8);
+    for (size_t l = 0; l < lights.size(); ++l) {
+        index.AddLight(l, lights[l].center, lights[l].radius);
+    }
+    index.Build();
+    ExpectMatchesBruteForce(index, lights, objects);
+
+    index.SetView(eye, Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, -1), -0.5F, 0.5F, -0.5F, 0.5F, 0.5F, 0.0F);
+    index.Build();
+    ExpectMatchesBruteForce(index, lights, objects);
+}
+
+TEST(LightClusterIndex, ReturnsEachLightOnce) {
+    LightClusterIndex index;
+    index.SetView(QVector(0, 0, 0), Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1), -1, 1, -1, 1, 1, 10000);
+    //a light spanning most of the grid, and one that reaches behind the near plane
+    index.AddLight(7, QVector(0, 0, 3000), 2500);
+    index.AddLight(9, QVector(0, 0, 0), 100);
+    index.Build();
+
+    std::vector<int> found;
+    index.Query(QVector(0, 0, 1000), 900, found);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(std::vector<int>({7, 9}), found);
+
+    found.clear();
+    index.Clear();
+    index.Build();
+    index.Query(QVector(0, 0, 1000), 900, found);
+    EXPECT_TRUE(found.empty());
+}
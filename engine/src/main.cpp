@@ -67,6 +67,7 @@
 #include "audio/renderers/OpenAL/BorrowedOpenALRenderer.h"
 #include "configuration/configuration.h"
 #include "components/player_ship.h"
+#include "collide2/CSopcodecache.h"
 #include <time.h>
 #if !defined(_WIN32) && !defined (__HAIKU__)
 #include <signal.h>
@@ -344,6 +345,11 @@ int main(int argc, char *argv[]) {
 
     VegaStrikeLogging::VegaStrikeLogger::instance().InitLoggingPart2(g_game.vsdebug, home_subdir_path);
 
+    if (configuration().physics.collision_tree_cache) {
+        VSFileSystem::CreateDirectoryHome("collide_cache");
+        csOPCODECache::SetDirectory(VSFileSystem::homedir + "/collide_cache");
+    }
+
     // can use the vegastrike config variable to read in the default mission
     if (configuration().network.force_client_connect) {
         ignore_network = false;
@@ -70,6 +70,7 @@
 #include "cmd/nebula.h"
 #include "src/vs_logging.h"
 #include "cmd/script/mission.h"
+#include "cmd/script/mission_scheduler.h"
 #include "root_generic/xml_support.h"
 #include "src/config_xml.h"
 #include "cmd/ai/missionscript.h"
@@ -274,6 +275,7 @@ void QuitNow() {
                 active_missions[i]->DirectorEnd();
             }
         }
+        MissionScheduler::getSingleton()->logAccounting();
         if (forcefeedback != nullptr) {
             delete forcefeedback;
             forcefeedback = nullptr;
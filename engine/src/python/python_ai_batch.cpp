@@ -0,0 +1,128 @@
+/*
+ * python_ai_batch.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <boost/python.hpp>
+#include <Python.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "src/python/python_ai_batch.h"
+#include "src/python/init.h"
+#include "src/vegastrike.h"
+#include "src/vs_logging.h"
+#include "configuration/configuration.h"
+
+static std::vector<PythonAIThinker *> pending_thinkers;
+static PythonAIThinker *current_thinker = nullptr;
+static bool flushing = false;
+
+PythonAIThinker::~PythonAIThinker() {
+    PythonAIBatch::Dequeue(this);
+}
+
+bool PythonAIThinker::ThinkDue(PyObject *self) {
+    if (!think_schedule.Started()) {
+        //stagger the first think so a wing spawned together does not think on the same atom
+        think_schedule.Start(PythonAIBatch::ThinkInterval(self),
+                static_cast<float>((reinterpret_cast<uintptr_t>(this) >> 4) % 16) / 16.0F);
+    }
+    return think_schedule.Advance(simulation_atom_var);
+}
+
+void PythonAIBatch::Enqueue(PythonAIThinker *ai) {
+    if (!ai->queued) {
+        ai->queued = true;
+        pending_thinkers.push_back(ai);
+    }
+}
+
+void PythonAIBatch::Dequeue(PythonAIThinker *ai) {
+    if (ai == current_thinker) {
+        current_thinker = nullptr;
+    }
+    if (!ai->queued) {
+        return;
+    }
+    ai->queued = false;
+    if (flushing) {
+        //keep indices stable while the batch is being walked
+        std::replace(pending_thinkers.begin(), pending_thinkers.end(), ai, static_cast<PythonAIThinker *>(nullptr));
+    } else {
+        pending_thinkers.erase(std::remove(pending_thinkers.begin(), pending_thinkers.end(), ai),
+                pending_thinkers.end());
+    }
+}
+
+void PythonAIBatch::Flush() {
+    if (pending_thinkers.empty() || flushing) {
+        return;
+    }
+    flushing = true;
+    PyGILState_STATE gil_state = PyGILState_Ensure();
+    for (size_t i = 0; i < pending_thinkers.size(); ++i) {
+        current_thinker = pending_thinkers[i];
+        if (current_thinker == nullptr) {
+            continue;
+        }
+        current_thinker->queued = false;
+        current_thinker->thinking = true;
+        try {
+            current_thinker->Think();
+        } catch (const boost::python::error_already_set &) {
+            VS_LOG(error, "PythonAIBatch::Flush(): Python AI raised an exception");
+        }
+        Python::reseterrors();
+        //Think() may have destroyed the AI, in which case Dequeue cleared current_thinker
+        if (current_thinker != nullptr) {
+            current_thinker->thinking = false;
+        }
+    }
+    current_thinker = nullptr;
+    pending_thinkers.clear();
+    PyGILState_Release(gil_state);
+    flushing = false;
+}
+
+float PythonAIBatch::ThinkInterval(PyObject *self) {
+    float interval = configuration().ai.python_think_interval_flt;
+    if (self != nullptr && PyObject_HasAttrString(self, "think_interval")) {
+        PyObject *attr = PyObject_GetAttrString(self, "think_interval");
+        if (attr != nullptr) {
+            double value = PyFloat_AsDouble(attr);
+            if (PyErr_Occurred()) {
+                VS_LOG(warning, "PythonAIBatch::ThinkInterval(): think_interval is not a number");
+                PyErr_Clear();
+            } else {
+                interval = static_cast<float>(value);
+            }
+            Py_DECREF(attr);
+        }
+    }
+    return std::max(0.0F, interval);
+}
@@ -0,0 +1,82 @@
+/*
+ * python_ai_batch.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_PYTHON_PYTHON_AI_BATCH_H
+#define VEGA_STRIKE_ENGINE_PYTHON_PYTHON_AI_BATCH_H
+
+#include <Python.h>
+
+#include "src/python/think_schedule.h"
+
+/**
+ * A Python driven AI that can be run at a reduced rate.
+ *
+ * Between two thinks the C++ side of the order keeps executing whatever
+ * the script last asked for (FaceTarget, MoveTo, ...), so the ship keeps
+ * steering without crossing into Python.
+ */
+class PythonAIThinker {
+public:
+    PythonAIThinker() : thinking(false), queued(false) {
+    }
+
+    virtual ~PythonAIThinker();
+
+    /// calls into the Python side of the AI
+    virtual void Think() = 0;
+
+    /// true while Think() runs from the batch, so the default Execute is not run twice
+    bool IsThinking() const {
+        return thinking;
+    }
+
+protected:
+    /// counts the atom down and returns true when a think is due; starts the schedule on first use
+    bool ThinkDue(PyObject *self);
+
+    ThinkSchedule think_schedule;
+
+private:
+    bool thinking;
+    bool queued;
+    friend class PythonAIBatch;
+};
+
+/**
+ * Collects the PythonAIs due to think this atom and runs them together,
+ * under one GIL acquisition, once unit physics is done.
+ */
+class PythonAIBatch {
+public:
+    static void Enqueue(PythonAIThinker *ai);
+    static void Dequeue(PythonAIThinker *ai);
+    static void Flush();
+
+    /// the class attribute think_interval of the Python AI, or the ai.python_think_interval config default
+    static float ThinkInterval(PyObject *self);
+};
+
+#endif //VEGA_STRIKE_ENGINE_PYTHON_PYTHON_AI_BATCH_H
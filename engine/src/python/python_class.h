@@ -56,6 +56,7 @@
 #endif //PY_VERSION_HEX < 0x030B0000
 
 #include "src/python/python_compile.h"
+#include "src/python/python_ai_batch.h"
 #include "cmd/ai/fire.h"
 #include <memory>
 #include "src/vs_logging.h"
@@ -212,12 +213,25 @@ public:
 };
 
 template<class SuperClass>
-class PythonAI : public PythonClass<SuperClass> {
+class PythonAI : public PythonClass<SuperClass>, public PythonAIThinker {
 public:
     PythonAI(PyObject *self_) : PythonClass<SuperClass>(self_) {
     }
 
     virtual void Execute() {
+        if (ThinkDue(this->self)) {
+            if (this->think_schedule.interval <= 0.0F) {
+                //no think interval: call straight into Python every atom, as always
+                PYTHONCALLBACK(void, this->self, "Execute");
+                return;
+            }
+            PythonAIBatch::Enqueue(this);
+        }
+        //keep following the last directive until the batch lets the script think again
+        SuperClass::Execute();
+    }
+
+    virtual void Think() {
         PYTHONCALLBACK(void, this->self, "Execute");
     }
 
@@ -231,6 +245,11 @@ public:
     }
 
     static void default_Execute(SuperClass &self_) {
+        PythonAI *ai = dynamic_cast<PythonAI *>(&self_);
+        if (ai != nullptr && ai->IsThinking()) {
+            //the C++ side already executed this atom before the batch ran
+            return;
+        }
         (self_).SuperClass::Execute();
     }
 
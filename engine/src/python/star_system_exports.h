@@ -81,6 +81,11 @@ EXPORT_UTIL(SafeEntrancePoint, (10000000, 0, 0))
 voidEXPORT_UTIL(setScratchVector)
 EXPORT_UTIL(getScratchVector, (0, 0, 0))
 EXPORT_UTIL(numActiveMissions, 1)
+voidEXPORT_UTIL(setMissionTickInterval)
+voidEXPORT_UTIL(wakeMissionAt)
+voidEXPORT_UTIL(wakeMissionOn)
+voidEXPORT_UTIL(clearMissionWakeups)
+EXPORT_UTIL(getMissionCPUTime, 0)
 voidEXPORT_UTIL(SetAutoStatus)
 voidEXPORT_UTIL(LoadMission)
 voidEXPORT_UTIL(LoadMissionScript)
@@ -0,0 +1,87 @@
+/*
+ * think_schedule_tests.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "src/python/think_schedule.h"
+
+static int CountThinks(ThinkSchedule &schedule, float atom, int atoms) {
+    int thinks = 0;
+    for (int i = 0; i < atoms; ++i) {
+        thinks += schedule.Advance(atom) ? 1 : 0;
+    }
+    return thinks;
+}
+
+TEST(ThinkSchedule, NoIntervalThinksEveryAtom) {
+    ThinkSchedule schedule;
+    EXPECT_FALSE(schedule.Started());
+    schedule.Start(0.0F, 0.5F);
+    EXPECT_TRUE(schedule.Started());
+    EXPECT_EQ(CountThinks(schedule, 0.1F, 10), 10);
+}
+
+TEST(ThinkSchedule, NegativeIntervalCountsAsNone) {
+    ThinkSchedule schedule;
+    schedule.Start(-3.0F, 0.0F);
+    EXPECT_TRUE(schedule.Started());
+    EXPECT_EQ(schedule.interval, 0.0F);
+    EXPECT_EQ(CountThinks(schedule, 0.1F, 4), 4);
+}
+
+TEST(ThinkSchedule, ThinksOncePerInterval) {
+    ThinkSchedule schedule;
+    schedule.Start(0.5F, 0.0F);
+    //due straight away, then every fifth atom of a tenth of a second
+    EXPECT_TRUE(schedule.Advance(0.1F));
+    EXPECT_EQ(CountThinks(schedule, 0.1F, 4), 0);
+    EXPECT_TRUE(schedule.Advance(0.1F));
+    EXPECT_EQ(CountThinks(schedule, 0.1F, 100), 20);
+}
+
+TEST(ThinkSchedule, StaggerDelaysTheFirstThink) {
+    ThinkSchedule early;
+    ThinkSchedule late;
+    early.Start(1.0F, 0.0F);
+    late.Start(1.0F, 0.75F);
+    EXPECT_TRUE(early.Advance(0.25F));
+    EXPECT_FALSE(late.Advance(0.25F));
+    EXPECT_FALSE(late.Advance(0.25F));
+    EXPECT_TRUE(late.Advance(0.25F));
+    //after that both keep the interval
+    EXPECT_EQ(CountThinks(early, 0.25F, 40), 10);
+    EXPECT_EQ(CountThinks(late, 0.25F, 40), 10);
+}
+
+TEST(ThinkSchedule, LongAtomDoesNotOweThinks) {
+    ThinkSchedule schedule;
+    schedule.Start(0.5F, 0.0F);
+    EXPECT_TRUE(schedule.Advance(0.125F));
+    //ten intervals in one atom are one think, not ten to catch up on
+    EXPECT_TRUE(schedule.Advance(5.0F));
+    //the next atom thinks, then every fourth: catching up would think on all eight
+    EXPECT_EQ(CountThinks(schedule, 0.125F, 8), 3);
+}
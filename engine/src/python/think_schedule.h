@@ -0,0 +1,65 @@
+/*
+ * think_schedule.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_PYTHON_THINK_SCHEDULE_H
+#define VEGA_STRIKE_ENGINE_PYTHON_THINK_SCHEDULE_H
+
+#include <algorithm>
+
+/**
+ * When an AI that thinks every interval seconds is due.
+ *
+ * The first think comes after a fraction of the interval, so AIs started
+ * together spread their thinks over it. An AI that fell behind, e.g. over
+ * a long atom, thinks at most once per atom rather than catching up.
+ */
+struct ThinkSchedule {
+    ///negative until started; 0 thinks every time
+    float interval = -1.0F;
+    float countdown = 0.0F;
+
+    bool Started() const {
+        return interval >= 0.0F;
+    }
+
+    ///stagger in [0, 1) is the fraction of the interval before the first think
+    void Start(float think_interval, float stagger) {
+        interval = std::max(0.0F, think_interval);
+        countdown = interval * stagger;
+    }
+
+    ///counts elapsed seconds down and returns true when a think is due
+    bool Advance(float elapsed) {
+        countdown -= elapsed;
+        if (countdown > 0.0F) {
+            return false;
+        }
+        countdown = std::max(0.0F, countdown + interval);
+        return true;
+    }
+};
+
+#endif //VEGA_STRIKE_ENGINE_PYTHON_THINK_SCHEDULE_H
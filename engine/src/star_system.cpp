@@ -50,6 +50,7 @@
 
 #include "cmd/planet.h"
 #include "cmd/unit_collide.h"
+#include "collide2/CSopcodecollider.h"
 #include "cmd/collection.h"
 #include "cmd/click_list.h"
 #include "cmd/cont_terrain.h"
@@ -57,17 +58,22 @@
 #include "cmd/unit_find.h"
 #include "cmd/script/flightgroup.h"
 #include "cmd/script/mission.h"
+#include "cmd/script/mission_scheduler.h"
+#include "src/python/python_ai_batch.h"
 #include "cmd/atmosphere.h"
 #include "cmd/music.h"
 #include "cmd/bolt.h"
 #include "cmd/beam.h"
 #include "cmd/unit_generic.h"
 #include "cmd/unit_util.h"
+#include "cmd/physics_priority.h"
+#include "cmd/planetary_orbit.h"
 #include "cmd/missile.h"
 
 #include "gfx_generic/boltdrawmanager.h"
 #include "gfx/particle.h"
 #include "gfx_generic/lerp.h"
+#include "gfx_generic/sphere_cull.h"
 #include "gfx/warptrail.h"
 #include "gfx/halo.h"
 #include "gfx/background.h"
@@ -136,6 +142,12 @@ StarSystem::StarSystem(const string filename, const Vector &centr, const float t
 }
 
 StarSystem::~StarSystem() {
+    //the units only get killed here, so their orders outlive the rails
+    for (PlanetaryOrbit *orbit : rails_orbits) {
+        if (orbit != nullptr) {
+            orbit->DropRails(orbit_time);
+        }
+    }
     if (_Universe->getNumActiveStarSystem()) {
         _Universe->activeStarSystem()->SwapOut();
     }
@@ -235,6 +247,25 @@ extern bool cam_setup_phase;
 class UnitDrawer {
     struct empty {};
     vsUMap<void *, struct empty> gravunits;
+    std::vector<Unit *> candidates;
+    SphereCuller culler;
+
+    //A sphere around the unit's current physics position that bounds all of its meshes
+    //wherever Draw interpolates them to this frame
+    static float precullRadius(const Unit *unit, float camera_speed) {
+        float radius = unit->rSize();
+        for (const Mesh *mesh : unit->meshdata) {
+            if (mesh != nullptr) {
+                radius = std::max(radius, mesh->Position().Magnitude() + mesh->rSize());
+            }
+        }
+        const Matrix &m = unit->cumulative_transformation_matrix;
+        const float scale = std::max(1.0F, std::sqrt((m.getP().MagnitudeSquared() + m.getR().MagnitudeSquared()) * 0.5F));
+        const float motion = 2.0F * (camera_speed + unit->Velocity.Magnitude()) * simulation_atom_var
+                * std::max(1U, unit->sim_atom_multiplier);
+        return radius * scale * 1.01F + motion;
+    }
+
 public:
     Unit *parent;
     Unit *parenttarget;
@@ -248,9 +279,67 @@ public:
     // by template in UnitWithinRangeLocator
     bool acquire(Unit *unit, float distance) {
         if (gravunits.find(unit) == gravunits.end()) {
-            return draw(unit);
-        } else {
-            return true;
+            //drawn by drawCandidates, once the whole set has been culled
+            candidates.push_back(unit);
+        }
+        return true;
+    }
+
+    //Culls the gathered units as one batch, then draws them in the order they were found.
+    //Culled units, including those hidden behind planets, are still drawn, as Draw also updates their
+    //transformation; they just skip their meshes.
+    void drawCandidates() {
+        Camera *camera = _Universe->AccessCamera();
+        const float camera_speed = camera->GetVelocity().Magnitude();
+        double frustum[6][4];
+        GFXGetFrustum(frustum);
+        culler.Clear();
+        culler.SetFrustum(frustum, camera->GetPosition());
+
+        //Meshes are skipped once their radius is under a pixel threshold, which with a symmetric
+        //projection turns into a distance limit for each sphere
+        float left, right, bottom, top, nearval, farval;
+        GFXGetFrustumVars(true, &left, &right, &bottom, &top, &nearval, &farval);
+        float pixels_per_radius = 0;
+        if (g_game.detaillevel > 0 && right != left && std::fabs((right + left) / (right - left)) < 1.0e-6F) {
+            const float min_pixel_radius = std::max(2.5F, 0.5F / g_game.detaillevel);
+            pixels_per_radius = static_cast<float>(configuration().graphics.resolution_x) * 2.0F * nearval
+                    / (right - left) / min_pixel_radius;
+        }
+        for (Unit *unit : candidates) {
+            const float radius = precullRadius(unit, camera_speed);
+            const float max_distance = pixels_per_radius > 0
+                    ? std::max(radius * pixels_per_radius, configuration().graphics.znear_flt) : 0.0F;
+            culler.Add(unit->curr_physical_state.position, radius, max_distance);
+        }
+        culler.Cull();
+        //the planets were rasterized by addOccluders before any of them was drawn
+        culler.Occlude(Occlusion::solidOccluders());
+
+        const std::vector<unsigned char> &results = culler.Results();
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            Unit *unit = candidates[i];
+            //subunits are placed relative to their owner, and the camera's own units get special treatment
+            if (!unit->isSubUnit() && unit != parent && unit != parenttarget) {
+                unit->precull = results[i];
+            }
+            draw(unit);
+            //in case this unit's Draw did not consume it
+            unit->precull = SphereCuller::VISIBLE;
+        }
+        candidates.clear();
+    }
+
+    //Planets are the solid occluders. They are drawn apart from the candidates, so they are rasterized here,
+    //before anything is drawn, so the units behind them are hidden whatever order they are drawn in.
+    //The surface is shrunk a little for the tessellation of the mesh
+    static void addOccluders(UnitCollection &gravitational_units) {
+        Unit *unit;
+        for (un_iter iter = gravitational_units.createIterator(); (unit = *iter); ++iter) {
+            if (unit->getUnitType() == Vega_UnitType::planet && !unit->isJumppoint()) {
+                const Planet *planet = static_cast<const Planet *>(unit);
+                Occlusion::addSolidOccluder(planet->curr_physical_state.position, planet->getRadius() * 0.98F);
+            }
         }
     }
 
@@ -435,6 +524,7 @@ void StarSystem::Draw(bool DrawCockpit) {
     if ((drawer.action.parent = _Universe->AccessCockpit()->GetParent()) != nullptr) {
         drawer.action.parenttarget = drawer.action.parent->Target();
     }
+    UnitDrawer::addOccluders(this->gravitational_units);
     for (un_iter iter = this->gravitational_units.createIterator(); (unit = *iter); ++iter) {
         float distance = (drawstartpos - unit->Position()).Magnitude() - unit->rSize();
         if (distance < configuration().graphics.precull_dist_dbl) {
@@ -446,6 +536,7 @@ void StarSystem::Draw(bool DrawCockpit) {
     //Need to get iterator to approx camera position
     CollideMap::iterator parent = collide_map[Unit::UNIT_ONLY]->lower_bound(key_iterator);
     findObjectsFromPosition(this->collide_map[Unit::UNIT_ONLY], parent, &drawer, drawstartpos, 0, true);
+    drawer.action.drawCandidates();
     drawer.action.drawParents(); //draw units targeted by camera
     //FIXME  maybe we could do bolts & units instead of unit only--and avoid bolt drawing step
 
@@ -507,7 +598,8 @@ void StarSystem::Draw(bool DrawCockpit) {
     GFXFogMode(FOG_OFF);
     Animation::ProcessDrawQueue();
     Halo::ProcessDrawQueue();
-    particleTrail.DrawAndUpdate();
+    //the sparks only move once per atom, so they are drawn between the last two like the units
+    particleTrail.Draw((interpolation_blend_factor - 1.0) * simulation_atom_var);
     StarSystem::DrawJumpStars();
     ConditionalCursorDraw(false);
     if (DrawCockpit) {
@@ -528,7 +620,6 @@ void StarSystem::Draw(bool DrawCockpit) {
 extern void update_ani_cache();
 
 void UpdateAnimatedTexture() {
-    AnimatedTexture::UpdateAllPhysics();
     update_ani_cache();
 }
 
@@ -973,9 +1064,11 @@ void StarSystem::RequestPhysics(Unit *un, unsigned int queue) {
 //randomization on priority changes, so we're fine.
 void StarSystem::UpdateUnitsPhysics(bool firstframe) {
     static int batchcount = SIM_QUEUE_SIZE - 1;
+    static std::vector<Unit *> bucket_units;
 #if defined(LOG_TIME_TAKEN_DETAILS)
     double collide_time = 0.0;
     double bolt_time = 0.0;
+    double flatten_time = 0.0;
     double time_on_two_arg_UpdateUnitPhysics = 0.0;
 #endif
     targetpick = 0.0;
@@ -987,6 +1080,15 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
 #if defined(LOG_TIME_TAKEN_DETAILS)
         const double before_calling_two_arg_UpdateUnitPhysics = realTime();
 #endif
+        PhysicsPriorityService::getSingleton()->BeginFrame();
+        bucket_units.clear();
+        for (un_iter iter = physics_buffer[current_sim_location].createIterator(); *iter; ++iter) {
+            bucket_units.push_back(*iter);
+        }
+        PhysicsPriorityService::getSingleton()->PrepareBatch(bucket_units);
+        warp_field.Refresh(gravitational_units);
+        EvaluateOrbitRails(bucket_units);
+        Movable::QueueIntegration(configuration().physics.batched_integration);
         try {
             UnitCollection col = physics_buffer[current_sim_location];
             un_iter iter = physics_buffer[current_sim_location].createIterator();
@@ -1003,18 +1105,31 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
             }
             throw;
         }
+        Movable::IntegrateQueued();
 #if defined(LOG_TIME_TAKEN_DETAILS)
         const double c0 = realTime();
 #endif
         Bolt::UpdatePhysics(this);
+        Beam::ProcessCollideQueue(this);
 #if defined(LOG_TIME_TAKEN_DETAILS)
         const double cc = realTime();
 #endif
         last_collisions.clear();
+        csCollisionContext::ForThisThread().AgeCoherence(configuration().physics.collision_coherence_max_idle_frames);
+#if defined(LOG_TIME_TAKEN_DETAILS)
+        const double before_flatten = realTime();
+#endif
         collide_map[Unit::UNIT_BOLT]->flatten();
         if (Unit::NUM_COLLIDE_MAPS > 1) {
             collide_map[Unit::UNIT_ONLY]->flatten(*collide_map[Unit::UNIT_BOLT]);
         }
+#if defined(LOG_TIME_TAKEN_DETAILS)
+        flatten_time += realTime() - before_flatten;
+        const CollideArray::FlattenStats &flatten_stats = collide_map[Unit::UNIT_BOLT]->GetFlattenStats();
+        VS_LOG(trace, (boost::format("Collide map flatten: %1% kept, %2% out of order, %3% insertion moves, %4% added; %5%")
+                % flatten_stats.kept % flatten_stats.descents % flatten_stats.moves % flatten_stats.added
+                % CollideArray::FlattenStrategyName(flatten_stats.strategy)));
+#endif
         Unit *unit;
         for (un_iter iter = physics_buffer[current_sim_location].createIterator(); (unit = *iter);) {
             const unsigned int priority = unit->sim_atom_multiplier;
@@ -1039,6 +1154,7 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
         bolt_time += cc - c0;
 #endif
         current_sim_location = (current_sim_location + 1) % SIM_QUEUE_SIZE;
+        orbit_time += simulation_atom_var;
         ++physicsframecounter;
         totalprocessed += theunitcounter;
         theunitcounter = 0;
@@ -1047,9 +1163,55 @@ void StarSystem::UpdateUnitsPhysics(bool firstframe) {
     VS_LOG(trace, (boost::format("Time taken by two-arg UpdateUnitPhysics: %1%") % time_on_two_arg_UpdateUnitPhysics));
     VS_LOG(trace, (boost::format("Time taken by unit->CollideAll() ('collidetime'): %1%") % collide_time));
     VS_LOG(trace, (boost::format("Time taken by Bolt::UpdatePhysics(this) ('bolttime'): %1%") % bolt_time));
+    VS_LOG(trace, (boost::format("Time taken by collide map flatten: %1%") % flatten_time));
 #endif
 }
 
+void StarSystem::EvaluateOrbitRails(const std::vector<Unit *> &units) {
+    if (rails_compact) {
+        rails_compact = false;
+        orbit_rails.Compact(rails_remap);
+        //bodies only move down, so this can be done in place
+        for (size_t i = 0; i < rails_orbits.size(); ++i) {
+            PlanetaryOrbit *orbit = rails_orbits[i];
+            if (orbit == nullptr) {
+                continue;
+            }
+            if (rails_remap[i] == OrbitRails::NO_PARENT) {
+                //what it orbited came off the rails
+                orbit->DropRails(orbit_time);
+            } else {
+                rails_orbits[rails_remap[i]] = orbit;
+                orbit->RailsMoved(rails_remap[i]);
+            }
+        }
+        rails_orbits.resize(orbit_rails.Size());
+    }
+    orbit_rails.Evaluate(orbit_time);
+    //bodies simulated in another atom keep their state until then, or their interpolation would jump
+    for (Unit *unit : units) {
+        PlanetaryOrbit *orbit = dynamic_cast<PlanetaryOrbit *>(unit->getAIState());
+        if (orbit != nullptr) {
+            orbit->FollowRails();
+        }
+    }
+}
+
+unsigned int StarSystem::BoardOrbitRails(PlanetaryOrbit *orbit,
+        const OrbitRails::Elements &elements,
+        unsigned int parent) {
+    rails_orbits.push_back(orbit);
+    return orbit_rails.Add(elements, parent);
+}
+
+void StarSystem::LeaveOrbitRails(unsigned int body) {
+    if (body < rails_orbits.size()) {
+        rails_orbits[body] = nullptr;
+        orbit_rails.Remove(body);
+        rails_compact = true;
+    }
+}
+
 void StarSystem::UpdateUnitPhysics(bool firstframe, Unit *unit) {
     uint_fast32_t priority = UnitUtil::getPhysicsPriority(unit);
     //Doing spreading here and only on priority changes, so as to make AI easier
@@ -1105,16 +1267,25 @@ extern float getTimeCompression();
 //server
 void ExecuteDirector() {
     unsigned int curcockpit = _Universe->CurrentCockpit();
+    MissionScheduler *scheduler = MissionScheduler::getSingleton();
     {
         for (unsigned int i = 0; i < active_missions.size(); ++i) {
             if (active_missions[i]) {
+                if (!scheduler->shouldRun(active_missions[i], Mission::gametime)) {
+                    //sleeping missions still have to keep their clocks in step
+                    active_missions[i]->DirectorSkip();
+                    scheduler->recordSkip(active_missions[i]);
+                    continue;
+                }
                 _Universe->SetActiveCockpit(active_missions[i]->player_num);
                 StarSystem *ss = _Universe->AccessCockpit()->activeStarSystem;
                 if (ss) {
                     _Universe->pushActiveStarSystem(ss);
                 }
                 mission = active_missions[i];
+                const double director_start = realTime();
                 active_missions[i]->DirectorLoop();
+                scheduler->recordRun(active_missions[i], active_missions[i]->mission_name, realTime() - director_start);
                 if (ss) {
                     _Universe->popActiveStarSystem();
                 }
@@ -1174,6 +1345,7 @@ void StarSystem::Update(float priority) {
             }
             UpdateMissiles();                    //do explosions
             UpdateUnitsPhysics(firstframe);
+            PythonAIBatch::Flush();
 
             firstframe = false;
             time -= SIMULATION_ATOM;
@@ -1243,9 +1415,9 @@ void StarSystem::Update(float priority, bool executeDirector) {
                         AUDRefreshSounds();
                     }
                 }
-                for (unsigned int i = 0; i < active_missions.size(); ++i) {
-                    //waste of frakkin time
-                    active_missions[i]->BriefingUpdate();
+                //BriefingUpdate never starts or ends a briefing, so iterating in place is safe
+                for (Mission *mis : MissionScheduler::getSingleton()->briefingsInProgress()) {
+                    mis->BriefingUpdate();
                 }
 #if defined(LOG_TIME_TAKEN_DETAILS)
                 const double missionSimulationStageEndTime = realTime();
@@ -1261,11 +1433,15 @@ void StarSystem::Update(float priority, bool executeDirector) {
                 const double processUnitStageStartTime = realTime();
 #endif
                 UpdateUnitsPhysics(firstframe);
+                PythonAIBatch::Flush();
 #if defined(LOG_TIME_TAKEN_DETAILS)
                 const double updateUnitsPhysicsDoneTime = realTime();
                 updateUnitsPhysicsTimeSubtotal += (updateUnitsPhysicsDoneTime - processUnitStageStartTime);
 #endif
                 UpdateMissiles(); //do explosions
+                if (this == _Universe->getActiveStarSystem(0)) {
+                    particleTrail.Update(simulation_atom_var);
+                }
 #if defined(LOG_TIME_TAKEN_DETAILS)
                 const double updateMissilesDoneTime = realTime();
                 updateMissilesTimeSubtotal += (updateMissilesDoneTime - updateUnitsPhysicsDoneTime);
@@ -31,6 +31,8 @@
 #include "cmd/container.h"
 
 #include "gfx_generic/vec.h"
+#include "cmd/warp_field.h"
+#include "cmd/orbit_rails.h"
 #include "src/gfxlib.h"
 #include "src/gfxlib_struct.h"
 
@@ -50,6 +52,7 @@ class CollideMap;
 
 class ContinuousTerrain;
 class Planet;
+class PlanetaryOrbit;
 
 class Stars;
 
@@ -119,6 +122,15 @@ protected:
     UnitCollection gravitational_units;
     UnitCollection physics_buffer[SIM_QUEUE_SIZE + 1];
     unsigned int current_sim_location = 0;
+    ///the planets limiting SPEC, refreshed every atom
+    WarpFieldService warp_field;
+    ///the bodies orbiting in closed form, and the orders that put them there
+    OrbitRails orbit_rails;
+    vector<PlanetaryOrbit *> rails_orbits;
+    vector<unsigned int> rails_remap;
+    bool rails_compact = false;
+    ///game time the orbits are evaluated at, advanced every sim atom
+    double orbit_time = 0;
 
     ///The moving, fading stars
     Stars *stars = nullptr;
@@ -163,6 +175,21 @@ public:
     virtual void UpdateMissiles();
     void UpdateUnitsPhysics(bool firstframe);
     void UpdateUnitPhysics(bool firstframe, Unit *unit);
+    ///Works out where every body on the orbit rails is at the start of this sim atom, and moves the ones simulated now
+    void EvaluateOrbitRails(const std::vector<Unit *> &units);
+
+    ///Puts an orbit on the rails, after the body it orbits; returns its body in orbitRails()
+    unsigned int BoardOrbitRails(PlanetaryOrbit *orbit, const OrbitRails::Elements &elements, unsigned int parent);
+    ///Takes an orbit, and whatever orbits it, off the rails by the next sim atom
+    void LeaveOrbitRails(unsigned int body);
+
+    const OrbitRails &orbitRails() const {
+        return orbit_rails;
+    }
+
+    double getOrbitTime() const {
+        return orbit_time;
+    }
 
     ///Requeues the unit so that it is simulated ASAP.
     void RequestPhysics(Unit *un, unsigned int queue);
@@ -193,6 +220,10 @@ public:
         return gravitational_units;
     }
 
+    WarpFieldService &warpField() {
+        return warp_field;
+    }
+
     Unit *nextSignificantUnit();
     /// returns xy sorted bounding spheres of all units in current view
     ///Adds to draw list
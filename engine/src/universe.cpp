@@ -410,6 +410,7 @@ void Universe::StartDraw() {
 #ifndef WIN32
     RESETTIME();
 #endif
+    Texture::UpdateResidency();
     GFXBeginScene();
     // ImGui Init
     ImGui_ImplOpenGL3_NewFrame();
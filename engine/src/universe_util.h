@@ -322,6 +322,17 @@ void setMissionOwner(int);
 ///returns number missions running to tweak difficulty
 int numActiveMissions();
 
+///how often (game seconds) this mission's director runs: 0 is every frame (default), negative only on wake ups
+void setMissionTickInterval(float seconds);
+///runs this mission's director once game time reaches the given value
+void wakeMissionAt(float gametime);
+///runs this mission's director whenever "death", "system" (entry) or "dock" happens
+void wakeMissionOn(std::string condition);
+///stops waking this mission on any condition or timer
+void clearMissionWakeups();
+///total real seconds spent running this mission's director
+float getMissionCPUTime();
+
 ///this sends an IO message... I'm not sure if delay currently works, but from, to and message do :-) ... if you want to send to the bar do "bar" as the to string... if you want to make news for the news room specify "news"
 void IOmessage(int delay, std::string from, std::string to, std::string message);
 
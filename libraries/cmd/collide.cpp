@@ -113,21 +113,20 @@ void collideTrees::Dec() {
 }
 
 bool TableLocationChanged(const QVector &Mini, const QVector &minz) {
-    return _Universe->activeStarSystem()->collide_table->c.hash_int(Mini.i)
-            != _Universe->activeStarSystem()->collide_table->c.hash_int(minz.i)
-            || _Universe->activeStarSystem()->collide_table->c.hash_int(Mini.j)
-                    != _Universe->activeStarSystem()->collide_table->c.hash_int(minz.j)
-            || _Universe->activeStarSystem()->collide_table->c.hash_int(Mini.k)
-                    != _Universe->activeStarSystem()->collide_table->c.hash_int(minz.k);
+    const SpatialHash3d<Unit *> &table = _Universe->activeStarSystem()->collide_table->c;
+    return table.Place(Mini, Mini) != table.Place(minz, minz);
 }
 
 bool TableLocationChanged(const LineCollide &lc, const QVector &minx, const QVector &maxx) {
-    return TableLocationChanged(lc.Mini, minx) || TableLocationChanged(lc.Maxi, maxx);
+    const SpatialHash3d<Unit *> &table = _Universe->activeStarSystem()->collide_table->c;
+    return table.Place(lc.Mini, lc.Maxi) != table.Place(minx, maxx);
 }
 
 void KillCollideTable(LineCollide *lc, StarSystem *ss) {
     if (lc->type == LineCollide::UNIT) {
-        ss->collide_table->c.Remove(lc, lc->object.u);
+        if (!ss->collide_table->c.Remove(lc->Mini, lc->Maxi, lc->object.u)) {
+            VS_LOG(error, "Nonfatal Collide Error\n");
+        }
     } else {
         VS_LOG(warning, (boost::format("such collide types as %1$d not allowed") % lc->type));
     }
@@ -144,7 +143,7 @@ bool EradicateCollideTable(LineCollide *lc, StarSystem *ss) {
 
 void AddCollideQueue(LineCollide &tmp, StarSystem *ss) {
     if (tmp.type == LineCollide::UNIT) {
-        ss->collide_table->c.Put(&tmp, tmp.object.u);
+        tmp.hhuge = ss->collide_table->c.Put(tmp.Mini, tmp.Maxi, tmp.object.u).Overflow();
     } else {
         VS_LOG(warning, (boost::format("such collide types as %1$d not allowed") % tmp.type));
     }
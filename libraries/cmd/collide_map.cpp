@@ -28,6 +28,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include "src/vega_cast_utils.h"
 #include "cmd/collide_map.h"
 #include "cmd/unit_generic.h"
@@ -150,37 +153,155 @@ public:
     }
 };
 
-void CollideArray::flatten() {
-    sorted.resize(count);
-    max_radius.resize(count);
-    size_t len = unsorted.size();
-    size_t index = count;
-    RadiusUpdate<-1, true> collideUpdate(this);
-    for (ptrdiff_t i = len; i >= 0; i--) {
-        Collidable *tmp;
-        if (i < static_cast<ptrdiff_t>(len) && (tmp = &unsorted[i])->radius != 0.0f) {
-            sorted[--index] = *tmp;
-            collideUpdate(*tmp, index);
+const char *CollideArray::FlattenStrategyName(FlattenStrategy strategy) {
+    switch (strategy) {
+        case FLATTEN_SORTED:
+            return "sorted";
+        case FLATTEN_INSERTION:
+            return "insertion";
+        case FLATTEN_RADIX:
+            return "radix";
+        default:
+            return "unknown";
+    }
+}
+
+//arrays this small are always insertion sorted
+static const size_t kSmallFlatten = 32;
+
+//maps a double key to an unsigned integer with the same order
+static uint64_t RadixKey(double key) {
+    uint64_t bits;
+    memcpy(&bits, &key, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+//stable LSD radix sort by key, a byte per pass, skipping the bytes every key shares
+static void RadixSortKeys(CollideArray::ResizableArray &items) {
+    typedef std::pair<uint64_t, uint32_t> KeyIndex;
+    static std::vector<KeyIndex> from;
+    static std::vector<KeyIndex> to;
+    static CollideArray::ResizableArray gathered;
+    const size_t n = items.size();
+    from.resize(n);
+    to.resize(n);
+    size_t histogram[8][256] = {};
+    for (size_t i = 0; i < n; ++i) {
+        from[i] = KeyIndex(RadixKey(items[i].getKey()), static_cast<uint32_t>(i));
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histogram[pass][(from[i].first >> (pass * 8)) & 0xff];
+        }
+    }
+    for (int pass = 0; pass < 8; ++pass) {
+        const int shift = pass * 8;
+        size_t *counts = histogram[pass];
+        if (n == 0 || counts[(from[0].first >> shift) & 0xff] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (int byte = 0; byte < 256; ++byte) {
+            size_t c = counts[byte];
+            counts[byte] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            to[counts[(from[i].first >> shift) & 0xff]++] = from[i];
+        }
+        from.swap(to);
+    }
+    gathered.clear();
+    gathered.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        gathered.push_back(items[from[i].second]);
+    }
+    items.swap(gathered);
+}
+
+//insertion passes; gives up, leaving items partly sorted, once more than budget moves were needed
+static bool InsertionSortKeys(CollideArray::ResizableArray &items, size_t budget, size_t &moves) {
+    for (size_t i = 1; i < items.size(); ++i) {
+        if (!(items[i] < items[i - 1])) {
+            continue;
         }
+        Collidable tmp = items[i];
+        size_t j = i;
+        do {
+            items[j] = items[j - 1];
+            --j;
+            ++moves;
+        } while (j > 0 && tmp < items[j - 1]);
+        items[j] = tmp;
+        if (moves > budget) {
+            return false;
+        }
+    }
+    return true;
+}
 
-        for (auto j = toflattenhints[i].begin();
-                j != toflattenhints[i].end();
-                ++j) {
-            if (j->radius != 0) {
-                sorted[--index] = *j;
-                collideUpdate(*j, index);
-            }
+void CollideArray::FlattenSort(ResizableArray &kept, ResizableArray &added, ResizableArray &out, FlattenStats &stats) {
+    const size_t n = kept.size();
+    stats.kept = n;
+    stats.added = added.size();
+    stats.descents = 0;
+    stats.moves = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (kept[i] < kept[i - 1]) {
+            ++stats.descents;
         }
-        toflattenhints[i].resize(0);
     }
+    if (stats.descents == 0) {
+        stats.strategy = FLATTEN_SORTED;
+    } else if (n <= kSmallFlatten) {
+        InsertionSortKeys(kept, n * n, stats.moves);
+        stats.strategy = FLATTEN_INSERTION;
+    } else if (stats.descents * 16 <= n && InsertionSortKeys(kept, 8 * n, stats.moves)) {
+        stats.strategy = FLATTEN_INSERTION;
+    } else {
+        RadixSortKeys(kept);
+        stats.strategy = FLATTEN_RADIX;
+    }
+    ++stats.uses[stats.strategy];
+    if (added.empty()) {
+        out.swap(kept);
+        return;
+    }
+    //new items arrive grouped by the slot they were inserted at, so are mostly in order already
+    size_t added_moves = 0;
+    if (added.size() > kSmallFlatten && !InsertionSortKeys(added, 8 * added.size(), added_moves)) {
+        RadixSortKeys(added);
+    } else if (added.size() <= kSmallFlatten) {
+        InsertionSortKeys(added, added.size() * added.size(), added_moves);
+    }
+    out.resize(n + added.size());
+    std::merge(kept.begin(), kept.end(), added.begin(), added.end(), out.begin());
+}
 
-    std::sort(sorted.begin(), sorted.end());
+void CollideArray::flatten() {
+    //the survivors of the last flatten, still in its order but with their new keys
+    unsorted.erase(std::remove_if(unsorted.begin(), unsorted.end(), [](const Collidable &c) {
+        return c.radius == 0.0f;
+    }), unsorted.end());
+    flatten_added.clear();
+    for (auto &hints : toflattenhints) {
+        for (auto &j : hints) {
+            if (j.radius != 0) {
+                flatten_added.push_back(j);
+            }
+        }
+        hints.resize(0);
+    }
+    FlattenSort(unsorted, flatten_added, sorted, flatten_stats);
     unsorted = sorted;
 
-    toflattenhints.resize(count + 1);
+    const size_t size = sorted.size();
+    toflattenhints.resize(size + 1);
+    max_radius.resize(size);
+    RadiusUpdate<-1, true> collideUpdate(this);
+    for (size_t i = size; i-- > 0;) {
+        collideUpdate(sorted[i], i);
+    }
     if (location_index == Unit::UNIT_BOLT) {
         size_t i = 0;
-        size_t size = sorted.size();
         auto iter = sorted.begin();
         UpdateBackpointers<Unit::UNIT_BOLT> update;
         RadiusUpdate<1, false> radUpdate(this);
@@ -605,3 +726,85 @@ bool CollideMap::CheckUnitCollisions(Unit *un, const Collidable &updated) {
     return CollideChecker<Unit, false>::CheckCollisions(this, un, updated, Unit::UNIT_ONLY);
 }
 
+
+bool CollideMap::CapsuleTouchesSphere(const CollideCapsule &capsule, const QVector &center, float radius) {
+    QVector axis = capsule.end - capsule.start;
+    QVector rel = center - capsule.start;
+    double len2 = axis.Dot(axis);
+    double t = len2 > 0 ? std::min(1.0, std::max(0.0, rel.Dot(axis) / len2)) : 0.0;
+    QVector nearest = rel - axis * t;
+    double reach = static_cast<double>(capsule.radius) + radius;
+    return nearest.Dot(nearest) <= reach * reach;
+}
+
+//the largest units are tested against every capsule instead of widening everyone's sweep window
+static const size_t kCapsuleBigUnits = 16;
+
+void CollideMap::QueryCapsules(const std::vector<CollideCapsule> &capsules,
+        std::vector<std::pair<size_t, Unit *> > &hits) {
+    hits.clear();
+    if (capsules.empty() || sorted.empty()) {
+        return;
+    }
+    std::vector<float> radii;
+    radii.reserve(sorted.size());
+    for (const Collidable &c : sorted) {
+        if (c.radius > 0) {
+            radii.push_back(c.radius);
+        }
+    }
+    float small_radius = 0;
+    if (radii.size() > kCapsuleBigUnits) {
+        std::nth_element(radii.begin(), radii.begin() + kCapsuleBigUnits, radii.end(), std::greater<float>());
+        small_radius = radii[kCapsuleBigUnits];
+    }
+    std::vector<const Collidable *> big;
+    for (const Collidable &c : sorted) {
+        if (c.radius > small_radius) {
+            big.push_back(&c);
+        }
+    }
+
+    struct Window {
+        double lo;
+        double hi;
+        size_t capsule;
+
+        bool operator<(const Window &other) const {
+            return lo < other.lo;
+        }
+    };
+    std::vector<Window> windows;
+    windows.reserve(capsules.size());
+    for (size_t i = 0; i < capsules.size(); ++i) {
+        const CollideCapsule &c = capsules[i];
+        double reach = static_cast<double>(c.radius) + small_radius;
+        windows.push_back(Window{std::min(c.start.i, c.end.i) - reach, std::max(c.start.i, c.end.i) + reach, i});
+    }
+    std::sort(windows.begin(), windows.end());
+
+    //windows are visited by increasing lower bound, so the start of the scan only moves forward
+    const size_t size = sorted.size();
+    size_t first = 0;
+    for (const Window &w : windows) {
+        const CollideCapsule &capsule = capsules[w.capsule];
+        while (first < size && sorted[first].getKey() < w.lo) {
+            ++first;
+        }
+        for (size_t i = first; i < size && sorted[i].getKey() <= w.hi; ++i) {
+            const Collidable &c = sorted[i];
+            if (c.radius > 0 && c.radius <= small_radius && CapsuleTouchesSphere(capsule, c.position, c.radius)) {
+                hits.push_back(std::make_pair(w.capsule, c.ref.unit));
+            }
+        }
+        for (const Collidable *c : big) {
+            if (CapsuleTouchesSphere(capsule, c->position, c->radius)) {
+                hits.push_back(std::make_pair(w.capsule, c->ref.unit));
+            }
+        }
+    }
+    std::stable_sort(hits.begin(), hits.end(),
+            [](const std::pair<size_t, Unit *> &a, const std::pair<size_t, Unit *> &b) {
+                return a.first < b.first;
+            });
+}
@@ -33,6 +33,7 @@
 #if defined (_WIN32) || __GNUC__ != 2
 #include <limits>
 #endif
+#include <utility>
 #include <vector>
 /* Arbitrarily use Set for ALL PLATFORMS -hellcatv */
 class Unit;
@@ -177,9 +178,52 @@ public:
         this->location_index = location_index;
     }
 
+    ///how flatten() brought the array back into key order
+    enum FlattenStrategy {
+        FLATTEN_SORTED,     ///< the kept items were still in order
+        FLATTEN_INSERTION,  ///< insertion passes over nearly sorted keys
+        FLATTEN_RADIX,      ///< LSD radix sort on the keys, when too much moved
+        FLATTEN_STRATEGIES
+    };
+
+    struct FlattenStats {
+        FlattenStrategy strategy = FLATTEN_SORTED;
+        ///items kept from the last flatten, and items inserted since, merged in bulk
+        size_t kept = 0;
+        size_t added = 0;
+        ///adjacent kept items found out of order, and the insertion moves made
+        size_t descents = 0;
+        size_t moves = 0;
+        ///flattens done with each strategy
+        unsigned long uses[FLATTEN_STRATEGIES] = {};
+    };
+
+    static const char *FlattenStrategyName(FlattenStrategy strategy);
+
+    /**
+     * Sorts kept, which is nearly in order when keys move little between
+     * atoms, with the cheapest strategy for the churn it finds; then sorts
+     * added on its own and merges both into out.
+     */
+    static void FlattenSort(ResizableArray &kept, ResizableArray &added, ResizableArray &out, FlattenStats &stats);
+
+    const FlattenStats &GetFlattenStats() const {
+        return flatten_stats;
+    }
+
+    FlattenStats flatten_stats;
+    ResizableArray flatten_added;
+
     // TODO: Add virtual destructor?
 };
 
+///a segment with a radius (OPCODE's LSS); start == end makes it a sphere
+struct CollideCapsule {
+    QVector start;
+    QVector end;
+    float radius;
+};
+
 #ifdef VS_ENABLE_COLLIDE_KEY
 class CollideMap : public KeyMutableSet< Collidable >
 {
@@ -203,6 +247,17 @@ public:
     bool CheckUnitCollisions(Unit *un,
             const Collidable &updated); //DANGER must be used on lists that are only populated with Units, not bolts
 
+    /**
+     * Finds the units whose bounding spheres touch each capsule, with one
+     * sweep over the sorted array for the whole batch. hits gets a
+     * (capsule index, unit) pair per touch, grouped by capsule in capsule
+     * order. Only units present at the last flatten are found.
+     */
+    void QueryCapsules(const std::vector<CollideCapsule> &capsules,
+            std::vector<std::pair<size_t, Unit *> > &hits);
+
+    static bool CapsuleTouchesSphere(const CollideCapsule &capsule, const QVector &center, float radius);
+
     // TODO: Add virtual destructor?
 };
 
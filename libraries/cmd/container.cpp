@@ -29,19 +29,20 @@
 #include <stdlib.h>
 #include "cmd/container.h"
 #include "cmd/unit_generic.h"
+#include "cmd/unit_pool.h"
 
-UnitContainer::UnitContainer() : unit(nullptr) {
+UnitContainer::UnitContainer() : unit(nullptr), generation(0), slot_generation(nullptr) {
     VSCONSTRUCT1('U')
 }
 
-UnitContainer::UnitContainer(Unit *un) : unit(nullptr) {
+UnitContainer::UnitContainer(Unit *un) : unit(nullptr), generation(0), slot_generation(nullptr) {
     SetUnit(un);
     VSCONSTRUCT1('U');
 }
 
 UnitContainer::~UnitContainer() {
     VSDESTRUCT1
-    if (unit) {
+    if (unit && *slot_generation == generation) {
         unit->UnRef();
     }
     //bad idea...arrgh!
@@ -49,6 +50,10 @@ UnitContainer::~UnitContainer() {
 
 void UnitContainer::SetUnit(Unit *un) {
     //if the unit is null then go here otherwise if the unit is killed then go here
+    if (unit && *slot_generation != generation) {
+        UnitPool::ReportStale(unit, generation);
+        unit = NULL;
+    }
     if (un != NULL ? un->Killed() == true : true) {
         if (unit) {
             unit->UnRef();
@@ -61,6 +66,8 @@ void UnitContainer::SetUnit(Unit *un) {
         }
         unit = un;
         unit->Ref();
+        slot_generation = UnitPool::GenerationWord(un);
+        generation = *slot_generation;
     }
 }
 
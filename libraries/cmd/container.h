@@ -27,6 +27,8 @@
 #ifndef VEGA_STRIKE_ENGINE_CMD_UNITCONTAINER_H
 #define VEGA_STRIKE_ENGINE_CMD_UNITCONTAINER_H
 
+#include <cstdint>
+
 #include "src/debug_vs.h"
 
 class Unit;
@@ -34,6 +36,10 @@ class Unit;
 class UnitContainer {
 protected:
     Unit *unit;
+    //UnitPool generation of unit when it was set, to catch references outliving the unit
+    uint32_t generation;
+    //where that generation lives, looked up once in SetUnit
+    const uint32_t *slot_generation;
 public:
     UnitContainer();
     UnitContainer(Unit *);
@@ -41,6 +47,8 @@ public:
     UnitContainer(const UnitContainer &un) {
         VSCONSTRUCT1('U')
         unit = 0;
+        generation = 0;
+        slot_generation = nullptr;
         SetUnit(un.unit);
     }
 
@@ -33,6 +33,7 @@
 #include "gfx_generic/mesh.h"
 #include "gfx_generic/quaternion.h"
 #include "gfx_generic/lerp.h"
+#include "gfx_generic/sphere_cull.h"
 #include "gfx/occlusion.h"
 
 #include "cmd/unit_generic.h"
@@ -217,6 +218,10 @@ void Drawable::Draw(const Transformation &parent, const Matrix &parentMatrix) {
         wmat = unit->WarpMatrix(*ctm);
     }
 
+    //The pre-cull sphere bounds every mesh, so when it failed no mesh can pass the tests below
+    const unsigned char precull = this->precull;
+    this->precull = SphereCuller::VISIBLE;
+
     if ((!(unit->invisible & unit->INVISUNIT)) && ((!(unit->invisible & unit->INVISCAMERA)) || (!myparent))) {
         bool Unit_On_Screen = false;
         if (!cam_setup_phase) {
@@ -228,7 +233,7 @@ void Drawable::Draw(const Transformation &parent, const Matrix &parentMatrix) {
 
             const unsigned int numKeyFrames = unit->graphicOptions.NumAnimationPoints;
             const unsigned int n = nummesh();
-            for (unsigned int i = 0; i <= n; ++i) {
+            for (unsigned int i = 0; i <= n && precull == SphereCuller::VISIBLE; ++i) {
                 //NOTE LESS THAN OR EQUALS...to cover shield mesh
                 if (this->meshdata[i] == nullptr) {
                     continue;
@@ -293,9 +298,8 @@ void Drawable::Draw(const Transformation &parent, const Matrix &parentMatrix) {
                 }
             }
 
-            Unit_On_Screen = On_Screen || !!GFXSphereInFrustum(
-                    ct->position,
-                    minmeshradius + unit->rSize());
+            Unit_On_Screen = On_Screen || (!(precull & (SphereCuller::OUTSIDE_FRUSTUM | SphereCuller::HIDDEN))
+                    && !!GFXSphereInFrustum(ct->position, minmeshradius + unit->rSize()));
         } else {
             Unit_On_Screen = true;
         }
@@ -381,6 +385,30 @@ void Drawable::AnimationStep() {
 #endif
 }
 
+void Drawable::DrawInstance(const Matrix &mat) {
+    Unit *unit = vega_dynamic_cast_ptr<Unit>(this);
+    Camera *camera = _Universe->AccessCamera();
+    const QVector camerapos = camera->GetPosition();
+    const float avgscale = sqrt((mat.getP().MagnitudeSquared() + mat.getR().MagnitudeSquared()) * 0.5);
+    const float nebdist = (camera->GetNebula() == unit->nebula && unit->nebula != nullptr) ? -1 : 0;
+    //the shield mesh is left out; copies are never hit
+    for (unsigned int i = 0; i < nummesh(); ++i) {
+        if (this->meshdata[i] == nullptr) {
+            continue;
+        }
+        QVector TransformedPosition = Transform(mat, meshdata[i]->Position().Cast());
+        float mSize = meshdata[i]->rSize() * avgscale;
+        double d = (TransformedPosition - camerapos).Magnitude();
+        double rd = d - mSize;
+        float pixradius = mSize * perspectiveFactor(
+                (rd < configuration().graphics.znear_flt) ? configuration().graphics.znear_flt : rd);
+        float lod = pixradius * g_game.detaillevel;
+        if (lod >= 0.5 && pixradius >= 2.5 && GFXSphereInFrustum(TransformedPosition, mSize)) {
+            this->meshdata[i]->Draw(lod, mat, d, unit->cloak, nebdist);
+        }
+    }
+}
+
 void Drawable::DrawNow(const Matrix &mato, float lod) {
     Unit *unit = vega_dynamic_cast_ptr<Unit>(this);
 
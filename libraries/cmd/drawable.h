@@ -73,6 +73,9 @@ public:
 
     double curtime;
 
+    ///SphereCuller::CullResult of the batched pre-cull in StarSystem::Draw, good for the next Draw call only
+    unsigned char precull{};
+
     static unsigned int unitCount;
 
     static std::map<string, Unit *> Units;
@@ -133,6 +136,8 @@ public:
 
     ///Draws this unit with the transformation and matrix (should be equiv) separately
     virtual void DrawNow(const Matrix &m = identity_matrix, float lod = 1000000000);
+    ///Queues the meshes of this unit at m as one more copy of it, with the level of detail and culling of Draw
+    void DrawInstance(const Matrix &m);
     virtual std::string drawableGetName() = 0;
 
     void Sparkle(bool on_screen, const Matrix *ctm);
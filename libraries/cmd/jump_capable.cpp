@@ -29,6 +29,7 @@
 #include "cmd/jump_capable.h"
 #include "cmd/ai/order.h"
 #include "cmd/unit_find.h"
+#include "cmd/warp_field.h"
 #include "src/universe.h"
 #include "src/universe_util.h"
 #include "gfx/warptrail.h"
@@ -375,92 +376,81 @@ float JumpCapable::CalculateNearestWarpUnit(float minmultiplier,
         Unit **nearest_unit,
         bool count_negative_warp_units) const {
     const Unit *unit = vega_dynamic_cast_ptr<const Unit>(this);
+    WarpFieldService &warp_field = _Universe->activeStarSystem()->warpField();
+    const WarpFieldService::Params &params = warp_field.params();
 
-    const float smallwarphack = configuration().physics.min_warp_effect_size_flt;
-    const float bigwarphack = configuration().physics.max_warp_effect_size_flt;
-    //Boundary between multiplier regions 1&2. 2 is "high" mult
-    const double warpregion1 = configuration().physics.warp_region1_dbl;
-    //Boundary between multiplier regions 0&1 0 is mult=1
-    const double warpregion0 = configuration().physics.warp_region0_dbl;
-    //Mult at 1-2 boundary
-    const double warpcruisemult = configuration().physics.warp_cruise_mult_dbl;
-    //degree of curve
-    const double curvedegree = configuration().physics.warp_curve_degree_dbl;
-    //coefficient so as to agree with above
-    const double upcurvek = warpcruisemult / std::pow((warpregion1 - warpregion0), curvedegree);
-    //inverse fractional effect of ship vs real big object
-    const float def_inv_interdiction = 1.0 / configuration().physics.default_interdiction_flt;
-    Unit *planet;
-    Unit *testthis = nullptr;
-    {
-        NearestUnitLocator locatespec;
-        findObjects(_Universe->activeStarSystem()->collide_map[Unit::UNIT_ONLY],
-                unit->location[Unit::UNIT_ONLY],
-                &locatespec);
-        testthis = locatespec.retval.unit;
-    }
-    for (un_fiter iter = _Universe->activeStarSystem()->gravitationalUnits().fastIterator();
-            (planet = *iter) || testthis;
-            ++iter) {
-        if (!planet || !planet->Killed()) {
-            if (planet == nullptr) {
-                planet = testthis;
-                testthis = nullptr;
-            }
-            if (planet == this) {
-                continue;
-            }
-            float shiphack = 1;
-            if (planet->getUnitType() != Vega_UnitType::planet) {
-                shiphack = def_inv_interdiction;
-                double spec_interdiction = planet->ship_functions.Value(Function::ftl_interdiction);
-                if (spec_interdiction != 0 && planet->graphicOptions.specInterdictionOnline != 0
-                        && (spec_interdiction > 0 || count_negative_warp_units)) {
-                    shiphack = 1 / fabs(spec_interdiction);
-                    if (unit->ship_functions.Value(Function::ftl_interdiction) != 0 && unit->graphicOptions.specInterdictionOnline != 0) {
-                        //only counters artificial interdiction ... or maybe it cheap ones shouldn't counter expensive ones!? or
-                        // expensive ones should counter planets...this is safe now, for gameplay
-                        shiphack *= fabs(spec_interdiction);
-                    }
+    auto consider = [&](Unit *planet) {
+        if (planet == nullptr || planet == this || planet->Killed()) {
+            return;
+        }
+        float shiphack = 1;
+        if (planet->getUnitType() != Vega_UnitType::planet) {
+            shiphack = params.def_inv_interdiction;
+            double spec_interdiction = planet->ship_functions.Value(Function::ftl_interdiction);
+            if (spec_interdiction != 0 && planet->graphicOptions.specInterdictionOnline != 0
+                    && (spec_interdiction > 0 || count_negative_warp_units)) {
+                shiphack = 1 / fabs(spec_interdiction);
+                if (unit->ship_functions.Value(Function::ftl_interdiction) != 0 && unit->graphicOptions.specInterdictionOnline != 0) {
+                    //only counters artificial interdiction ... or maybe it cheap ones shouldn't counter expensive ones!? or
+                    // expensive ones should counter planets...this is safe now, for gameplay
+                    shiphack *= fabs(spec_interdiction);
                 }
             }
-            float multipliertemp = 1;
-            float minsizeeffect = (planet->rSize() > smallwarphack) ? planet->rSize() : smallwarphack;
-            float effectiverad = minsizeeffect * (1.0f + UniverseUtil::getPlanetRadiusPercent()) + unit->rSize();
-            if (effectiverad > bigwarphack) {
-                effectiverad = bigwarphack;
-            }
-            QVector dir = unit->Position() - planet->Position();
-            double udist = dir.Magnitude();
-            float sigdist = UnitUtil::getSignificantDistance(unit, planet);
-            if (planet->isPlanet() && udist < (1 << 28)) {
-                //If distance is viable as a float approximation and it's an actual celestial body
-                udist = sigdist;
-            }
-            do {
-                double dist = udist;
-                if (dist < 0) {
-                    dist = 0;
-                }
-                dist *= shiphack;
-                if (dist > (effectiverad + warpregion0)) {
-                    multipliertemp = std::pow((dist - effectiverad - warpregion0), curvedegree) * upcurvek;
-                } else {
-                    multipliertemp = 1;
-                }
-                if (multipliertemp < minmultiplier) {
-                    minmultiplier = multipliertemp;
-                    *nearest_unit = planet;
-                    //eventually use new multiplier to compute
-                } else {
-                    break;
-                }
-            } while (false);
-            if (!testthis) {
+        }
+        float minsizeeffect = (planet->rSize() > params.min_warp_effect_size) ? planet->rSize() : params.min_warp_effect_size;
+        float effectiverad = minsizeeffect * (1.0f + params.planet_radius_percent) + unit->rSize();
+        if (effectiverad > params.max_warp_effect_size) {
+            effectiverad = params.max_warp_effect_size;
+        }
+        QVector dir = unit->Position() - planet->Position();
+        double dist = dir.Magnitude();
+        if (planet->isPlanet() && dist < (1 << 28)) {
+            //If distance is viable as a float approximation and it's an actual celestial body
+            dist = UnitUtil::getSignificantDistance(unit, planet);
+        }
+        if (dist < 0) {
+            dist = 0;
+        }
+        dist *= shiphack;
+        float multipliertemp = 1;
+        if (dist > (effectiverad + params.warp_region0)) {
+            multipliertemp = std::pow((dist - effectiverad - params.warp_region0), params.curve_degree) * params.upcurvek;
+        }
+        if (multipliertemp < minmultiplier) {
+            minmultiplier = multipliertemp;
+            *nearest_unit = planet;
+        }
+    };
+
+    NearestUnitLocator locatespec;
+    findObjects(_Universe->activeStarSystem()->collide_map[Unit::UNIT_ONLY],
+            unit->location[Unit::UNIT_ONLY],
+            &locatespec);
+    if (locatespec.retval.unit == nullptr && !params.all_wells) {
+        //with no ship around only the first gravitational unit limits SPEC, as it always has
+        Unit *planet;
+        for (un_fiter iter = _Universe->activeStarSystem()->gravitationalUnits().fastIterator();
+                (planet = *iter);
+                ++iter) {
+            if (!planet->Killed() && planet != this) {
+                consider(planet);
                 break;
-            } //don't want the ++
+            }
+        }
+        return minmultiplier;
+    }
+    if (unit->isPlanet()) {
+        //the tree would only find the planet itself
+        for (Unit *planet : warp_field.Wells()) {
+            consider(planet);
         }
+    } else {
+        consider(warp_field.NearestWell(unit));
+    }
+    for (Unit *planet : warp_field.ArtificialWells()) {
+        consider(planet);
     }
+    consider(locatespec.retval.unit);
     return minmultiplier;
 }
 
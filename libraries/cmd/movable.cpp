@@ -38,12 +38,14 @@
 #include "src/audiolib.h"
 #include "cmd/audible.h"
 #include "root_generic/configxml.h"
+#include "cmd/rigid_body_batch.h"
 
 
 #include <string>
 #include "src/vega_cast_utils.h"
 #include <climits>
 #include <utility>
+#include <vector>
 
 #include "resource/random_utils.h"
 #include "root_generic/vega_random.h"
@@ -56,6 +58,22 @@ float speedStarHandler(float &input) {
     return input / configuration().physics.game_speed_flt;
 }
 
+namespace {
+struct QueuedIntegration {
+    Movable *movable;
+    Transformation old_physical_state;
+    float time_step;
+    bool lastframe;
+    UnitCollection *uc;
+    float old_speed_squared;
+    size_t body;
+};
+}
+
+static std::vector<QueuedIntegration> integration_queue;
+static RigidBodyBatch integration_batch;
+static bool queue_integration = false;
+
 Movable::Movable() : sim_atom_multiplier(1),
         predicted_priority(1),
         last_processed_sqs(0),
@@ -79,6 +97,15 @@ Movable::Movable() : sim_atom_multiplier(1),
     AngularVelocity = default_angular_velocity;
 }
 
+Movable::~Movable() {
+    //keep the indices into the batch stable while it is being integrated
+    for (QueuedIntegration &queued : integration_queue) {
+        if (queued.movable == this) {
+            queued.movable = nullptr;
+        }
+    }
+}
+
 Movable::graphic_options::graphic_options() {
     FaceCamera = Animating = missilelock = unused1 = WarpRamping = NoDamageParticles = 0;
     specInterdictionOnline = 1;
@@ -164,53 +191,161 @@ void Movable::UpdatePhysics(const Transformation& trans,
 
     UpdatePhysics3(trans, transmat, lastframe, uc, superunit);
 
+    const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(this);
+    if (queue_integration && resolveforces && !graphicOptions.SubUnit && unit->limit_min <= -1) {
+        //IntegrateQueued finishes this unit together with the rest of the atom
+        QueuedIntegration queued;
+        queued.movable = this;
+        queued.old_physical_state = old_physical_state;
+        queued.time_step = simulation_atom_var;
+        queued.lastframe = lastframe;
+        queued.uc = uc;
+        queued.old_speed_squared = 0;
+        queued.body = 0;
+        integration_queue.push_back(queued);
+        return;
+    }
+
     if (resolveforces) {
         //clamp velocity to the resource-backed speed limits
         ResolveForces(trans, transmat);
-        // Enforce the flight computer's set speed on the RESULTING velocity
-        // magnitude (not per-axis), so turning or moving diagonally cannot push
-        // the ship past the speed the pilot set. This runs after the velocity
-        // integration, so it holds for the frame. Warp (SPEC) is exempt.
-        // The limits come from the drive/afterburner Resource values via
-        // MaxSpeed()/MaxAfterburnerSpeed(); the hardcoded velocity_max_flt
-        // per-axis cap is no longer needed.
-        const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(this);
-        if (graphicOptions.WarpFieldStrength == 1.0) {
-            double limit = unit->computer.set_speed;
-            // Allow up to the afterburner speed only when the afterburner is
-            // ACTIVELY engaged (afterburn && CanConsume, set in Movable::Thrust).
-            // A fuel-only proxy (CanConsume) would wrongly lift the limit during
-            // a turn, letting turn overspeed ride up to the afterburn speed.
-            const double mag = Velocity.Magnitude();
+        LimitSpeed();
+    }
+
+    // The 1.0 difficulty is a hack based on the hack in GetVelocityDifficultyMult
+    this->UpdatePhysics2(trans, old_physical_state, Vector(), 1.0, transmat, cum_vel, lastframe, uc);
+}
+
+void Movable::LimitSpeed() {
+    // Enforce the flight computer's set speed on the RESULTING velocity
+    // magnitude (not per-axis), so turning or moving diagonally cannot push
+    // the ship past the speed the pilot set. This runs after the velocity
+    // integration, so it holds for the frame. Warp (SPEC) is exempt.
+    // The limits come from the drive/afterburner Resource values via
+    // MaxSpeed()/MaxAfterburnerSpeed(); the hardcoded velocity_max_flt
+    // per-axis cap is no longer needed.
+    const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(this);
+    if (graphicOptions.WarpFieldStrength == 1.0) {
+        double limit = unit->computer.set_speed;
+        // Allow up to the afterburner speed only when the afterburner is
+        // ACTIVELY engaged (afterburn && CanConsume, set in Movable::Thrust).
+        // A fuel-only proxy (CanConsume) would wrongly lift the limit during
+        // a turn, letting turn overspeed ride up to the afterburn speed.
+        const double mag = Velocity.Magnitude();
+        if (mag > limit) {
+            if (unit->afterburner.active) {
+                limit = unit->MaxAfterburnerSpeed();
+            }
             if (mag > limit) {
-                if (unit->afterburner.active) {
-                    limit = unit->MaxAfterburnerSpeed();
-                }
-                if (mag > limit) {
-                    // Decelerate toward the limit at the max rate the opposing
-                    // thrusters can produce (per-axis drive limits), not an
-                    // instant snap. Overspeed from afterburn release, travel
-                    // mode, or turns bleeds off at the ship's real
-                    // deceleration capability. Use the direction opposite to
-                    // the current velocity so forward motion bleeds via retro
-                    // thrust, sideways via lateral, etc.
-                    const double decel = GetMaxAccelerationInDirectionOf(-Velocity, unit->afterburner.active);
-                    const double bleed = decel * simulation_atom_var;
-                    double newmag = mag - bleed;
-                    if (newmag < limit) {
-                        newmag = limit;
-                    }
-                    Velocity *= (newmag / mag);
+                // Decelerate toward the limit at the max rate the opposing
+                // thrusters can produce (per-axis drive limits), not an
+                // instant snap. Overspeed from afterburn release, travel
+                // mode, or turns bleeds off at the ship's real
+                // deceleration capability. Use the direction opposite to
+                // the current velocity so forward motion bleeds via retro
+                // thrust, sideways via lateral, etc.
+                const double decel = GetMaxAccelerationInDirectionOf(-Velocity, unit->afterburner.active);
+                const double bleed = decel * simulation_atom_var;
+                double newmag = mag - bleed;
+                if (newmag < limit) {
+                    newmag = limit;
                 }
+                Velocity *= (newmag / mag);
             }
         }
     }
+}
 
-    // The 1.0 difficulty is a hack based on the hack in GetVelocityDifficultyMult
-    this->UpdatePhysics2(trans, old_physical_state, Vector(), 1.0, transmat, cum_vel, lastframe, uc);
+void Movable::QueueIntegration(bool queue) {
+    queue_integration = queue;
+}
+
+void Movable::IntegrateQueued() {
+    queue_integration = false;
+    if (integration_queue.empty()) {
+        return;
+    }
+    const float backup = simulation_atom_var;
+    const float player_rotation_rate = configuration().physics.max_player_rotation_rate_flt;
+    const float non_player_rotation_rate = configuration().physics.max_non_player_rotation_rate_flt;
+    const float air_resistance = XMLSupport::parse_floatf(active_missions[0]->getVariable("air_resistance", "0"));
+    const float lateral_air_resistance =
+            XMLSupport::parse_floatf(active_missions[0]->getVariable("lateral_air_resistance", "0"));
+    integration_batch.Clear();
+    for (QueuedIntegration &queued : integration_queue) {
+        Movable *movable = queued.movable;
+        if (movable == nullptr) {
+            continue;
+        }
+        simulation_atom_var = queued.time_step;
+        movable->PrepareResolveForces();
+        const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(movable);
+        RigidBodyBatch::Body body;
+        body.orientation = movable->curr_physical_state.orientation;
+        body.position = movable->curr_physical_state.position;
+        body.velocity = movable->Velocity;
+        body.angular_velocity = movable->AngularVelocity;
+        body.local_force = movable->NetLocalForce;
+        body.local_torque = movable->NetLocalTorque;
+        body.force = movable->NetForce;
+        body.torque = movable->NetTorque;
+        body.mass = static_cast<float>(unit->GetMass());
+        body.moment = movable->GetMoment();
+        //clamp to avoid vomit-comet effects
+        body.max_rotation_rate = unit->IsPlayerShip() ? player_rotation_rate : non_player_rotation_rate;
+        body.time_step = queued.time_step;
+        queued.old_speed_squared = movable->Velocity.MagnitudeSquared();
+        queued.body = integration_batch.Add(body);
+    }
+    integration_batch.ResolveForces();
+
+    for (QueuedIntegration &queued : integration_queue) {
+        Movable *movable = queued.movable;
+        if (movable == nullptr) {
+            continue;
+        }
+        simulation_atom_var = queued.time_step;
+        movable->Velocity = integration_batch.Velocity(queued.body);
+        movable->AngularVelocity = integration_batch.AngularVelocity(queued.body);
+        movable->air_res_coef = air_resistance;
+        movable->lateral_air_res_coef = lateral_air_resistance;
+        movable->FinishResolveForces(queued.old_speed_squared);
+        movable->LimitSpeed();
+        //what AddVelocity would move the unit by, warp included
+        integration_batch.SetDrift(queued.body, movable->RampWarpField());
+    }
+    integration_batch.Advance();
+
+    //anything UpdatePhysics2 does may destroy a unit further down the queue, so go by index
+    for (size_t i = 0; i < integration_queue.size(); ++i) {
+        Movable *movable = integration_queue[i].movable;
+        if (movable == nullptr) {
+            continue;
+        }
+        const QueuedIntegration &queued = integration_queue[i];
+        simulation_atom_var = queued.time_step;
+        movable->curr_physical_state.orientation = integration_batch.Orientation(queued.body);
+        movable->curr_physical_state.position = integration_batch.Position(queued.body);
+        movable->pose_integrated = true;
+        // The 1.0 difficulty is a hack based on the hack in GetVelocityDifficultyMult
+        movable->UpdatePhysics2(identity_transformation, queued.old_physical_state, Vector(), 1.0, identity_matrix,
+                Vector(0, 0, 0), queued.lastframe, queued.uc);
+        if (integration_queue[i].movable != nullptr) {
+            movable->pose_integrated = false;
+        }
+    }
+    integration_queue.clear();
+    simulation_atom_var = backup;
 }
 
 void Movable::AddVelocity(float difficulty) {
+    const Vector v = RampWarpField();
+    curr_physical_state.position = curr_physical_state.position + (v * simulation_atom_var * difficulty).Cast();
+    //now we do this later in update physics
+    //I guess you have to, to be robust
+}
+
+Vector Movable::RampWarpField() {
     const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(this);
     float lastWarpField = graphicOptions.WarpFieldStrength;
 
@@ -267,9 +402,7 @@ void Movable::AddVelocity(float difficulty) {
 
     graphicOptions.WarpFieldStrength =
             lastWarpField * configuration().warp.warp_memory_effect_flt + (1.0 - configuration().warp.warp_memory_effect_flt) * graphicOptions.WarpFieldStrength;
-    curr_physical_state.position = curr_physical_state.position + (v * simulation_atom_var * difficulty).Cast();
-    //now we do this later in update physics
-    //I guess you have to, to be robust
+    return v;
 }
 
 void Movable::UpdatePhysics2(const Transformation &trans,
@@ -281,7 +414,7 @@ void Movable::UpdatePhysics2(const Transformation &trans,
         bool lastframe,
         UnitCollection *uc) {
     //Only in non-networking OR networking && is a player OR SERVER && not a player
-    if (AngularVelocity.i || AngularVelocity.j || AngularVelocity.k) {
+    if (!pose_integrated && (AngularVelocity.i || AngularVelocity.j || AngularVelocity.k)) {
         Rotate(simulation_atom_var * (AngularVelocity));
     }
 
@@ -310,12 +443,16 @@ void Movable::Rotate(const Vector &axis) {
     }
 }
 
+void Movable::PrepareResolveForces() {
+    //Save theoretical instantaneous acceleration (not time-quantized) for GetAcceleration()
+    SavedAccel = GetNetAcceleration();
+    SavedAngAccel = GetNetAngularAcceleration();
+}
+
 Vector Movable::ResolveForces(const Transformation &trans, const Matrix &transmat) {
     const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(this);
 
-    //First, save theoretical instantaneous acceleration (not time-quantized) for GetAcceleration()
-    SavedAccel = GetNetAcceleration();
-    SavedAngAccel = GetNetAngularAcceleration();
+    PrepareResolveForces();
 
     Vector p, q, r;
     GetOrientation(p, q, r);
@@ -359,6 +496,15 @@ Vector Movable::ResolveForces(const Transformation &trans, const Matrix &transma
     Velocity += temp;
     //}
 
+    // stephengtuggy 2020-10-17: These need to be initialized here, because they depend on having an active mission.
+    air_res_coef = XMLSupport::parse_floatf(active_missions[0]->getVariable("air_resistance", "0"));
+    lateral_air_res_coef = XMLSupport::parse_floatf(active_missions[0]->getVariable("lateral_air_resistance", "0"));
+    FinishResolveForces(oldmagsquared);
+    return temp2;
+}
+
+void Movable::FinishResolveForces(float oldmagsquared) {
+    const Unit *unit = vega_dynamic_const_cast_ptr<const Unit>(this);
     float newmagsquared = Velocity.MagnitudeSquared();
 
     bool oldbig = oldmagsquared > cutsqr;
@@ -383,10 +529,6 @@ Vector Movable::ResolveForces(const Transformation &trans, const Matrix &transma
                 1);
     }
 
-    // stephengtuggy 2020-10-17: These need to be initialized here, because they depend on having an active mission.
-    air_res_coef = XMLSupport::parse_floatf(active_missions[0]->getVariable("air_resistance", "0"));
-    lateral_air_res_coef = XMLSupport::parse_floatf(active_missions[0]->getVariable("lateral_air_resistance", "0"));
-
     if (air_res_coef != 0.0F || lateral_air_res_coef != 0.0F) {
         double velmag = Velocity.Magnitude();
         Vector AirResistance = Velocity
@@ -411,8 +553,6 @@ Vector Movable::ResolveForces(const Transformation &trans, const Matrix &transma
         }
     }
     NetForce = NetLocalForce = NetTorque = NetLocalTorque = Vector(0, 0, 0);
-
-    return temp2;
 }
 
 void Movable::SetOrientation(QVector q, QVector r) {
@@ -475,12 +615,14 @@ double Movable::GetMaxWarpFieldStrength(float rampmult) const {
     Vector v = unit->GetWarpRefVelocity();
 //    QVector qv = v.Cast();
 
+    const WarpFieldService::Params &params = _Universe->activeStarSystem()->warpField().params();
+
     //inverse fractional effect of ship vs real big object
-    float minimum_multiplier = configuration().warp.warp_multiplier_max_flt * graphicOptions.MaxWarpMultiplier;
+    float minimum_multiplier = params.warp_multiplier_max * graphicOptions.MaxWarpMultiplier;
     Unit *nearest_unit = nullptr;
     minimum_multiplier = unit->CalculateNearestWarpUnit(minimum_multiplier, &nearest_unit, true);
-    float minWarp = configuration().warp.warp_multiplier_min_flt * graphicOptions.MinWarpMultiplier;
-    float maxWarp = configuration().warp.warp_multiplier_max_flt * graphicOptions.MaxWarpMultiplier;
+    float minWarp = params.warp_multiplier_min * graphicOptions.MinWarpMultiplier;
+    float maxWarp = params.warp_multiplier_max * graphicOptions.MaxWarpMultiplier;
     if (minimum_multiplier < minWarp) {
         minimum_multiplier = minWarp;
     }
@@ -495,7 +637,7 @@ double Movable::GetMaxWarpFieldStrength(float rampmult) const {
     float vmag = sqrt(v.i * v.i + v.j * v.j + v.k * v.k);
 //    static float default_max_warp_effective_velocity = static_cast<float>(M_PI * M_PI * 300000000.0);
 //    const float warp_max_effective_velocity = vega_config::GetGameConfig().GetFloat("physics.warpMaxEfVel", default_max_warp_effective_velocity);
-    const float warp_max_effective_velocity = configuration().warp.max_effective_velocity_flt;
+    const float warp_max_effective_velocity = params.max_effective_velocity;
     if (vmag > warp_max_effective_velocity) {
         v *= warp_max_effective_velocity / vmag; //HARD LIMIT
         minimum_multiplier *= warp_max_effective_velocity / vmag;
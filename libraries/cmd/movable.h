@@ -30,6 +30,7 @@
 #include "gfx_generic/vec.h"
 #include "gfx_generic/quaternion.h"
 #include "src/star_system.h"
+#include "cmd/physics_priority.h"
 
 #include <cfloat>
 
@@ -75,6 +76,8 @@ public:
     unsigned int sim_atom_multiplier;
     //The number of frames ahead this is predicted to be scheduled in the next scheduling round
     unsigned int predicted_priority;
+    //Distance bands and priority last computed by PhysicsPriorityService
+    PhysicsPriorityCache physics_priority_cache;
     //When will physical simulation occur
     unsigned int cur_sim_queue_slot;
     //Used with subunit scheduling, to avoid the complex ickiness of having to synchronize scattered slots
@@ -121,6 +124,8 @@ protected:
     float outcutsqr{0.0F};
     float air_res_coef{0.0F};
     float lateral_air_res_coef{0.0F};
+    //Set while IntegrateQueued has already turned and moved the unit for this atom
+    bool pose_integrated{false};
 
 // Methods
 
@@ -132,12 +137,26 @@ protected:
     Movable(const Movable &) = delete;
     // forbidden
     Movable &operator=(const Movable &) = delete;
-    virtual ~Movable() = default;
+    virtual ~Movable();
+
+    //Saves the accelerations GetAcceleration reports before the forces are resolved
+    virtual void PrepareResolveForces();
+    //The part of ResolveForces after the velocity is integrated: warp stretch, air resistance, clearing the forces
+    void FinishResolveForces(float oldmagsquared);
+    //Bleeds the velocity down to the flight computer's set speed
+    void LimitSpeed();
+    //Ramps the warp field and returns the velocity AddVelocity moves the unit by
+    Vector RampWarpField();
 
 public:
     void AddVelocity(float difficulty);
 //Resolves forces of given unit on a physics frame
-    virtual Vector ResolveForces(const Transformation &, const Matrix &);
+    Vector ResolveForces(const Transformation &, const Matrix &);
+
+    //While set, top level units that resolve forces leave the end of UpdatePhysics to IntegrateQueued
+    static void QueueIntegration(bool queue);
+    //Integrates every unit queued this atom in one RigidBodyBatch, then runs their UpdatePhysics2
+    static void IntegrateQueued();
 
     //Sets the unit-space position
     void SetPosition(const QVector &pos);
@@ -0,0 +1,99 @@
+/*
+ * orbit_rails.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "cmd/orbit_rails.h"
+
+#include <cmath>
+
+const unsigned int OrbitRails::NO_PARENT;
+
+void OrbitRails::Clear() {
+    parent.clear();
+    elements.clear();
+    removed.clear();
+    position.clear();
+    velocity.clear();
+}
+
+unsigned int OrbitRails::Add(const Elements &elements, unsigned int parent) {
+    const unsigned int body = static_cast<unsigned int>(this->parent.size());
+    this->parent.push_back(parent < body ? parent : NO_PARENT);
+    this->elements.push_back(elements);
+    removed.push_back(false);
+    position.push_back(QVector(0, 0, 0));
+    velocity.push_back(QVector(0, 0, 0));
+    return body;
+}
+
+void OrbitRails::Remove(unsigned int body) {
+    if (body < removed.size()) {
+        removed[body] = true;
+    }
+}
+
+bool OrbitRails::Compact(std::vector<unsigned int> &remap) {
+    remap.resize(parent.size());
+    bool changed = false;
+    unsigned int kept = 0;
+    for (unsigned int body = 0; body < parent.size(); ++body) {
+        const unsigned int p = parent[body];
+        //parents come first, so whether they were dropped is already known
+        if (removed[body] || (p != NO_PARENT && remap[p] == NO_PARENT)) {
+            remap[body] = NO_PARENT;
+            changed = true;
+            continue;
+        }
+        remap[body] = kept;
+        parent[kept] = p == NO_PARENT ? NO_PARENT : remap[p];
+        elements[kept] = elements[body];
+        position[kept] = position[body];
+        velocity[kept] = velocity[body];
+        ++kept;
+    }
+    parent.resize(kept);
+    elements.resize(kept);
+    removed.assign(kept, false);
+    position.resize(kept);
+    velocity.resize(kept);
+    return changed;
+}
+
+void OrbitRails::Evaluate(double time) {
+    for (size_t body = 0; body < parent.size(); ++body) {
+        const Elements &e = elements[body];
+        const double theta = e.phase + e.angular_velocity * (time - e.epoch);
+        const double c = cos(theta);
+        const double s = sin(theta);
+        QVector p = e.offset + e.x_axis * c + e.y_axis * s;
+        QVector v = (e.y_axis * c - e.x_axis * s) * e.angular_velocity;
+        if (parent[body] != NO_PARENT) {
+            p += position[parent[body]];
+            v += velocity[parent[body]];
+        }
+        position[body] = p;
+        velocity[body] = v;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * orbit_rails.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_ORBIT_RAILS_H
+#define VEGA_STRIKE_ENGINE_CMD_ORBIT_RAILS_H
+
+#include <vector>
+#include "gfx_generic/vec.h"
+
+/**
+ * The orbiting bodies of a star system, moved along their orbits in
+ * closed form rather than steered there.
+ *
+ * An orbit is the ellipse PlanetaryOrbit flies: offset + cos(theta) x_axis
+ * + sin(theta) y_axis around what the body orbits, theta growing at a
+ * constant rate. Evaluate works out the position and velocity of every
+ * body at a given game time in one pass. Bodies are added in topological
+ * order, each after the body it orbits, so a moon is placed relative to
+ * where its planet is at that same time.
+ */
+class OrbitRails {
+public:
+    static const unsigned int NO_PARENT = ~0U;
+
+    struct Elements {
+        ///from what is orbited to the centre of the ellipse
+        QVector offset;
+        QVector x_axis;
+        QVector y_axis;
+        ///radians per second
+        double angular_velocity = 0;
+        ///theta at game time epoch
+        double phase = 0;
+        double epoch = 0;
+    };
+
+    void Clear();
+
+    ///parent must already have been added, or be NO_PARENT for a body orbiting a fixed point
+    unsigned int Add(const Elements &elements, unsigned int parent);
+
+    ///takes the body, and every body orbiting it, off the rails at the next Compact
+    void Remove(unsigned int body);
+
+    ///Drops the removed bodies; remap then holds the new index of each old one, or NO_PARENT. False if nothing changed
+    bool Compact(std::vector<unsigned int> &remap);
+
+    size_t Size() const {
+        return parent.size();
+    }
+
+    unsigned int Parent(unsigned int body) const {
+        return parent[body];
+    }
+
+    const Elements &GetElements(unsigned int body) const {
+        return elements[body];
+    }
+
+    ///Works out the position and velocity of every body at game time
+    void Evaluate(double time);
+
+    const QVector &Position(unsigned int body) const {
+        return position[body];
+    }
+
+    Vector Velocity(unsigned int body) const {
+        return velocity[body].Cast();
+    }
+
+private:
+    std::vector<unsigned int> parent;
+    std::vector<Elements> elements;
+    std::vector<bool> removed;
+    std::vector<QVector> position;
+    std::vector<QVector> velocity;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_ORBIT_RAILS_H
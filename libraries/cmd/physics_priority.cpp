@@ -0,0 +1,378 @@
+/*
+ * physics_priority.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <boost/python.hpp>
+
+#include <algorithm>
+#include <cfloat>
+
+#include "cmd/physics_priority.h"
+#include "cmd/unit_generic.h"
+#include "cmd/unit_util.h"
+#include "cmd/planetary_orbit.h"
+#include "gfx_generic/cockpit_generic.h"
+#include "root_generic/faction_generic.h"
+#include "root_generic/lin_time.h"
+#include "src/universe.h"
+#include "src/universe_util.h"
+#include "src/vegastrike.h"
+#include "configuration/configuration.h"
+#ifndef NO_GFX
+#include "gfx/cockpit.h"
+#endif
+
+extern Unit *getTopLevelOwner();
+
+template<> PhysicsPriorityService *Singleton<PhysicsPriorityService>::_singletonInstance = 0;
+
+using namespace PhysicsPriorityLadder;
+
+static bool SameThresholds(const Thresholds &a, const Thresholds &b) {
+    return a.gun_range == b.gun_range && a.missile_range == b.missile_range
+            && a.lowest_priority_time == b.lowest_priority_time
+            && a.player_threat_factor == b.player_threat_factor && a.threat_factor == b.threat_factor;
+}
+
+void PhysicsPriorityService::BeginFrame() {
+    ++frame.serial;
+    if (frame.serial == 0) {
+        //wrapped around; 0 is what a fresh cache holds
+        frame.serial = 1;
+    }
+    const double game_time = UniverseUtil::GetGameTime();
+    if (game_time != frame.game_time) {
+        frame.game_time = game_time;
+        const double min_factor = configuration().physics.priorities.dynamic_throttle.min_distance_factor_dbl;
+        const double max_factor = configuration().physics.priorities.dynamic_throttle.max_distance_factor_dbl;
+        const double target_elapsed_time = 1.0 / configuration().physics.priorities.dynamic_throttle.target_fps_dbl;
+        double newfactor = throttle_factor * target_elapsed_time / GetElapsedTime();
+        newfactor = std::max(min_factor, std::min(max_factor, newfactor));
+        throttle_factor = (newfactor * GetElapsedTime() + throttle_factor) / (1.0 + GetElapsedTime());
+    }
+    frame.player_threat_factor = configuration().physics.priorities.player_threat_distance_factor_dbl * throttle_factor;
+    frame.threat_factor = configuration().physics.priorities.threat_distance_factor_dbl * throttle_factor;
+    frame.lowest_priority_time = SIM_QUEUE_SIZE * SIMULATION_ATOM;
+    frame.top_level_owner = getTopLevelOwner();
+    frame.cargo_faction = FactionUtil::GetFactionIndex("cargo");
+    frame.upgrade_faction = FactionUtil::GetUpgradeFaction();
+    frame.neutral_faction = FactionUtil::GetNeutralFaction();
+    frame.current_cockpit = _Universe->CurrentCockpit();
+
+    const auto &priorities = configuration().physics.priorities;
+    Levels &levels = frame.levels;
+    levels.missile = priorities.missile;
+    levels.dockable = priorities.dockable;
+    levels.asteroid_parent = priorities.asteroid_parent;
+    levels.asteroid_high = priorities.asteroid_high;
+    levels.player = priorities.player;
+    levels.high = priorities.high;
+    levels.medium_high = priorities.medium_high;
+    levels.medium = priorities.medium;
+    levels.low = priorities.low;
+    levels.inert = priorities.inert;
+    levels.system_orbit = SIM_QUEUE_SIZE / ORBIT_PRIORITY;
+    levels.not_visible_combat_high = priorities.not_visible_combat_high;
+    levels.not_visible_combat_medium = priorities.not_visible_combat_medium;
+    levels.not_visible_combat_low = priorities.not_visible_combat_low;
+    levels.no_enemies = priorities.no_enemies;
+
+    Thresholds shared;
+    shared.lowest_priority_time = frame.lowest_priority_time;
+    shared.player_threat_factor = frame.player_threat_factor;
+    shared.threat_factor = frame.threat_factor;
+    bool thresholds_changed = !SameThresholds(frame.no_observer, shared);
+    frame.no_observer = shared;
+
+    const unsigned int np = _Universe->numPlayers();
+    if (frame.observers.size() != np) {
+        thresholds_changed = true;
+        frame.observers.resize(np);
+    }
+    for (unsigned int i = 0; i < np; ++i) {
+        Observer &obs = frame.observers[i];
+        Cockpit *cockpit = _Universe->AccessCockpit(i);
+        Unit *player = cockpit->GetParent();
+        obs.has_player = player != nullptr;
+        Thresholds thresholds = shared;
+        if (player) {
+            obs.player_position = player->Position();
+            obs.player_velocity = player->GetVelocity();
+            obs.player_radial_size = player->radial_size;
+            obs.player_rsize = player->rSize();
+            float speed = 0;
+            player->getAverageGunSpeed(speed, thresholds.gun_range, thresholds.missile_range);
+        } else {
+            obs.player_radial_size = 0.0F;
+        }
+        thresholds_changed = thresholds_changed || !SameThresholds(obs.thresholds, thresholds);
+        obs.thresholds = thresholds;
+        obs.has_camera = false;
+#ifndef NO_GFX
+        Camera *cam = cockpit->AccessCamera();
+        if (cam) {
+            obs.has_camera = true;
+            obs.camera_position = cam->GetPosition();
+            obs.camera_velocity = cam->GetVelocity();
+        }
+#endif
+    }
+    if (thresholds_changed) {
+        ++frame.thresholds;
+    }
+}
+
+void PhysicsPriorityService::Invalidate() {
+    ++frame.thresholds;
+    frame.game_time = -1.0;
+}
+
+bool PhysicsPriorityService::SharesSystemWithPlayer(const Unit *un) {
+    const unsigned int np = _Universe->numPlayers();
+    for (unsigned int i = 0; i < np; ++i) {
+        const Unit *player = _Universe->AccessCockpit(i)->GetParent();
+        if (player && player->activeStarSystem == un->activeStarSystem) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PhysicsPriorityService::Measure(const Unit *un, PhysicsPriorityCache &cache) const {
+    const QVector position = un->Position();
+    const Vector velocity = un->GetVelocity();
+    const float rad = un->rSize();
+    float cpdist = FLT_MAX;
+    float tooclose = 0;
+    int nearest = -1;
+    for (size_t i = 0; i < frame.observers.size(); ++i) {
+        const Observer &obs = frame.observers[i];
+        if (obs.has_player) {
+            QVector relpos = position - obs.player_position;
+            float tmpdist = relpos.Magnitude() - rad - obs.player_rsize;
+            if (tmpdist < cpdist) {
+                QVector relvel = velocity - obs.player_velocity;
+                nearest = static_cast<int>(i);
+                cpdist = tmpdist;
+                if (relpos.Dot(relvel) >= 0) {
+                    //No need to be wary if they're getting away
+                    tooclose = 2 * (un->radial_size + obs.player_radial_size)
+                            + relvel.Magnitude() * frame.lowest_priority_time;
+                }
+            }
+        }
+        if (obs.has_camera) {
+            QVector relvel = velocity - obs.camera_velocity;
+            QVector relpos = position - obs.camera_position;
+            double dist = relpos.Magnitude() - rad;
+            if (dist < cpdist) {
+                cpdist = dist;
+                if (relpos.Dot(relvel) >= 0) {
+                    tooclose = 2 * (un->radial_size + obs.player_radial_size)
+                            + relvel.Magnitude() * frame.lowest_priority_time;
+                }
+            }
+        }
+    }
+    cache.frame = frame.serial;
+    cache.nearest_distance = cpdist;
+    cache.too_close = tooclose;
+    cache.nearest_cockpit = nearest;
+}
+
+void PhysicsPriorityService::PrepareBatch(const std::vector<Unit *> &units) {
+    if (units.empty() || frame.observers.empty()) {
+        return;
+    }
+    //units sharing a system with a player never get past the live checks in Evaluate
+    std::vector<Unit *> measured;
+    measured.reserve(units.size());
+    for (Unit *un : units) {
+        if (!SharesSystemWithPlayer(un)) {
+            measured.push_back(un);
+        }
+    }
+    PrepareMeasured(measured);
+}
+
+void PhysicsPriorityService::PrepareMeasured(const std::vector<Unit *> &units) {
+    const size_t count = units.size();
+    const size_t np = frame.observers.size();
+    if (count == 0 || np == 0) {
+        return;
+    }
+    //gather the bucket into flat arrays so the per observer loops below stay tight
+    std::vector<double> px(count), py(count), pz(count);
+    std::vector<float> vx(count), vy(count), vz(count), rad(count), radial(count);
+    std::vector<float> cpdist(count, FLT_MAX), tooclose(count, 0.0F);
+    std::vector<int> nearest(count, -1);
+    for (size_t j = 0; j < count; ++j) {
+        const QVector p = units[j]->Position();
+        const Vector v = units[j]->GetVelocity();
+        px[j] = p.i;
+        py[j] = p.j;
+        pz[j] = p.k;
+        vx[j] = v.i;
+        vy[j] = v.j;
+        vz[j] = v.k;
+        rad[j] = units[j]->rSize();
+        radial[j] = units[j]->radial_size;
+    }
+    const float lpt = frame.lowest_priority_time;
+    for (size_t i = 0; i < np; ++i) {
+        const Observer &obs = frame.observers[i];
+        if (obs.has_player) {
+            const QVector &op = obs.player_position;
+            const Vector &ov = obs.player_velocity;
+            for (size_t j = 0; j < count; ++j) {
+                const double dx = px[j] - op.i, dy = py[j] - op.j, dz = pz[j] - op.k;
+                const float tmpdist = static_cast<float>(sqrt(dx * dx + dy * dy + dz * dz)) - rad[j] - obs.player_rsize;
+                if (tmpdist < cpdist[j]) {
+                    const double rvx = vx[j] - ov.i, rvy = vy[j] - ov.j, rvz = vz[j] - ov.k;
+                    nearest[j] = static_cast<int>(i);
+                    cpdist[j] = tmpdist;
+                    if (dx * rvx + dy * rvy + dz * rvz >= 0) {
+                        tooclose[j] = 2 * (radial[j] + obs.player_radial_size)
+                                + static_cast<float>(sqrt(rvx * rvx + rvy * rvy + rvz * rvz)) * lpt;
+                    }
+                }
+            }
+        }
+        if (obs.has_camera) {
+            const QVector &op = obs.camera_position;
+            const Vector &ov = obs.camera_velocity;
+            for (size_t j = 0; j < count; ++j) {
+                const double dx = px[j] - op.i, dy = py[j] - op.j, dz = pz[j] - op.k;
+                const double dist = sqrt(dx * dx + dy * dy + dz * dz) - rad[j];
+                if (dist < cpdist[j]) {
+                    const double rvx = vx[j] - ov.i, rvy = vy[j] - ov.j, rvz = vz[j] - ov.k;
+                    cpdist[j] = dist;
+                    if (dx * rvx + dy * rvy + dz * rvz >= 0) {
+                        tooclose[j] = 2 * (radial[j] + obs.player_radial_size)
+                                + static_cast<float>(sqrt(rvx * rvx + rvy * rvy + rvz * rvz)) * lpt;
+                    }
+                }
+            }
+        }
+    }
+    for (size_t j = 0; j < count; ++j) {
+        PhysicsPriorityCache &cache = units[j]->physics_priority_cache;
+        cache.frame = frame.serial;
+        cache.nearest_distance = cpdist[j];
+        cache.too_close = tooclose[j];
+        cache.nearest_cockpit = nearest[j];
+    }
+}
+
+Inputs PhysicsPriorityService::Gather(Unit *un, const PhysicsPriorityCache &cache,
+        const Thresholds &thresholds) const {
+    Inputs in;
+    in.missile = un->getUnitType() == Vega_UnitType::missile;
+    in.docking = UnitUtil::hasDockingUnits(un);
+    switch (un->schedule_priority) {
+        case Unit::scheduleDefault:
+            in.schedule = SCHEDULE_DEFAULT;
+            break;
+        case Unit::scheduleAField:
+            in.schedule = SCHEDULE_ASTEROID_FIELD;
+            break;
+        case Unit::scheduleRoid:
+            in.schedule = SCHEDULE_ASTEROID;
+            break;
+    }
+    in.asteroid = UnitUtil::isAsteroid(un);
+    in.distance = cache.nearest_distance;
+    in.too_close = cache.too_close;
+    Unit *targ = un->Target();
+    in.has_target = targ != nullptr;
+    in.targets_player = targ && targ->IsPlayerShip();
+    if (in.targets_player) {
+        in.jumppoint = un->isJumppoint();
+        if (!in.jumppoint) {
+            in.player_target_distance = UnitUtil::getDistance(targ, un);
+        }
+    }
+    in.warp_ramping = un->graphicOptions.WarpRamping;
+    in.ramping = un->graphicOptions.WarpRamping || un->graphicOptions.RampCounter != 0;
+    if (in.ramping) {
+        in.time_ramped = configuration().physics.computer_warp_ramp_up_time_flt - un->graphicOptions.RampCounter;
+        if (!un->ftl_drive.Enabled()) {
+            in.time_ramped = configuration().physics.warp_ramp_down_time_flt - un->graphicOptions.RampCounter;
+        }
+    }
+    in.system_installation = un->owner == frame.top_level_owner;
+    in.inert_faction = un->faction == frame.cargo_faction || un->faction == frame.upgrade_faction
+            || un->faction == frame.neutral_faction;
+    const Flightgroup *fg = un->getFlightgroup();
+    in.busy_directive = fg && !(fg->directive.empty() || fg->directive[0] == 'b');
+    return in;
+}
+
+uint_fast32_t PhysicsPriorityService::Evaluate(Unit *un) {
+    if (configuration().physics.priorities.force_top_priority) {
+        return 1;
+    }
+    //Player related checks stay live: targets and systems change in the middle of a frame
+    const unsigned int np = _Universe->numPlayers();
+    for (unsigned int i = 0; i < np; ++i) {
+        Unit *player = _Universe->AccessCockpit(i)->GetParent();
+        if (player) {
+            if (player->activeStarSystem == un->activeStarSystem) {
+                return configuration().physics.priorities.system_installation;
+            }
+            if (un == player->Target()) {
+                return configuration().physics.priorities.player;
+            }
+        }
+        if (player == un) {
+            return configuration().physics.priorities.player;
+        }
+    }
+    if (frame.game_time != UniverseUtil::GetGameTime() || frame.observers.size() != np) {
+        BeginFrame();
+    }
+    PhysicsPriorityCache &cache = un->physics_priority_cache;
+    if (cache.frame != frame.serial) {
+        Measure(un, cache);
+    }
+    const int cockpit = cache.nearest_cockpit >= 0 ? cache.nearest_cockpit : frame.current_cockpit;
+    const Thresholds &thresholds = cockpit >= 0 && static_cast<size_t>(cockpit) < frame.observers.size()
+            ? frame.observers[cockpit].thresholds : frame.no_observer;
+    const Inputs in = Gather(un, cache, thresholds);
+    if (!cache.bands.Holds(in, frame.thresholds, cockpit)) {
+        Interval interval;
+        const uint32_t bands = Classify(in, thresholds, interval, [un]() {
+            TargetMeasure target;
+            Unit *targ = un->Target();
+            float speed;
+            un->getAverageGunSpeed(speed, target.gun_range, target.missile_range);
+            target.distance = UnitUtil::getDistance(un, targ);
+            return target;
+        });
+        cache.bands.Store(in, frame.thresholds, cockpit, interval, bands);
+    }
+    return Resolve(cache.bands.bands, frame.levels);
+}
@@ -0,0 +1,116 @@
+/*
+ * physics_priority.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_PHYSICS_PRIORITY_H
+#define VEGA_STRIKE_ENGINE_CMD_PHYSICS_PRIORITY_H
+
+#include <cstdint>
+#include <vector>
+
+#include "cmd/physics_priority_ladder.h"
+#include "gfx_generic/vec.h"
+#include "src/Singleton.h"
+
+class Unit;
+
+/**
+ * Per-unit state kept by PhysicsPriorityService.
+ *
+ * The first half is the distance to the nearest player or camera, filled in
+ * by the batched pass over a physics bucket. The second half is the last
+ * classification, together with what it was decided on.
+ */
+struct PhysicsPriorityCache {
+    unsigned int frame = 0;
+    float nearest_distance = 0.0F;
+    float too_close = 0.0F;
+    int nearest_cockpit = -1;
+
+    PhysicsPriorityLadder::BandCache bands;
+};
+
+/**
+ * Computes how often (in sim atoms) each unit gets its physics run.
+ *
+ * Player and camera kinematics, the dynamic throttle and the priority
+ * configuration are gathered once per frame instead of once per unit. The
+ * remaining per-unit work is reduced to a set of distance band tests; as long
+ * as the unit's state is unchanged and its distance stays inside the band it
+ * was classified in, the previous classification is reused.
+ */
+class PhysicsPriorityService : public Singleton<PhysicsPriorityService> {
+public:
+    /// takes a new snapshot of the players and cameras; called at the start of each physics bucket
+    void BeginFrame();
+    /// forgets every cached priority, e.g. after the configuration was reloaded
+    void Invalidate();
+
+    uint_fast32_t Evaluate(Unit *un);
+    /// measures the distance of a whole bucket of units to the players in one pass
+    void PrepareBatch(const std::vector<Unit *> &units);
+
+private:
+    struct Observer {
+        bool has_player;
+        QVector player_position;
+        Vector player_velocity;
+        float player_radial_size;
+        float player_rsize;
+        bool has_camera;
+        QVector camera_position;
+        Vector camera_velocity;
+        PhysicsPriorityLadder::Thresholds thresholds;
+    };
+
+    struct Frame {
+        unsigned int serial = 0;
+        double game_time = -1.0;
+        std::vector<Observer> observers;
+        int current_cockpit = 0;
+        ///bumped whenever the thresholds of any observer change
+        unsigned int thresholds = 0;
+        PhysicsPriorityLadder::Thresholds no_observer;
+        PhysicsPriorityLadder::Levels levels;
+        float lowest_priority_time = 0.0F;
+        double player_threat_factor = 0.0;
+        double threat_factor = 0.0;
+        Unit *top_level_owner = nullptr;
+        int cargo_faction = -1;
+        int upgrade_faction = -1;
+        int neutral_faction = -1;
+    };
+
+    void Measure(const Unit *un, PhysicsPriorityCache &cache) const;
+    void PrepareMeasured(const std::vector<Unit *> &units);
+    PhysicsPriorityLadder::Inputs Gather(Unit *un, const PhysicsPriorityCache &cache,
+            const PhysicsPriorityLadder::Thresholds &thresholds) const;
+    static bool SharesSystemWithPlayer(const Unit *un);
+
+    Frame frame;
+    double throttle_factor = 1.0;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_PHYSICS_PRIORITY_H
@@ -0,0 +1,349 @@
+/*
+ * physics_priority_ladder.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_PHYSICS_PRIORITY_LADDER_H
+#define VEGA_STRIKE_ENGINE_CMD_PHYSICS_PRIORITY_LADDER_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+
+/**
+ * The decisions getPhysicsPriority takes about a unit, split from how the
+ * inputs are gathered so they can be cached and tested without a Unit.
+ *
+ * Classify turns the inputs into a set of bands, one bit per decision taken,
+ * and Resolve maps the bands to a priority. Two units (or one unit on two
+ * frames) with the same bands always get the same priority.
+ */
+namespace PhysicsPriorityLadder {
+
+enum Band : uint32_t {
+    BAND_MISSILE = 1U << 0,
+    BAND_DOCKABLE = 1U << 1,
+    BAND_ASTEROID_FIELD = 1U << 2,
+    BAND_ASTEROID = 1U << 3,
+    BAND_TARGETS_PLAYER = 1U << 4,
+    BAND_JUMPPOINT = 1U << 5,
+    BAND_PLAYER_IN_RANGE = 1U << 6,
+    BAND_RAMPING = 1U << 7,
+    BAND_RAMP_EARLY = 1U << 8,
+    BAND_RAMP_IN_GUN_RANGE = 1U << 9,
+    BAND_RAMP_LATE = 1U << 10,
+    BAND_INERT_FACTION = 1U << 11,
+    BAND_SYSTEM_INSTALLATION = 1U << 12,
+    BAND_TOO_CLOSE = 1U << 13,
+    BAND_BUSY_DIRECTIVE = 1U << 14,
+    BAND_PLAYER_THREAT = 1U << 15,
+    BAND_PLAYER_THREAT_CLOSE = 1U << 16,
+    BAND_PLAYER_THREAT_GUN = 1U << 17,
+    BAND_HAS_TARGET = 1U << 18,
+    BAND_TARGET_GUN = 1U << 19,
+    BAND_TARGET_MISSILE = 1U << 20,
+    BAND_THREAT_CLOSE = 1U << 21,
+};
+
+enum Schedule : uint8_t { SCHEDULE_DEFAULT, SCHEDULE_ASTEROID_FIELD, SCHEDULE_ASTEROID };
+
+/// Everything about a unit the ladder looks at
+struct Inputs {
+    bool missile = false;
+    bool docking = false;
+    Schedule schedule = SCHEDULE_DEFAULT;
+    bool asteroid = false;
+    bool targets_player = false;
+    bool jumppoint = false;
+    ///distance to the player it targets, when targets_player
+    double player_target_distance = 0;
+    bool warp_ramping = false;
+    ///warp ramping, or the ramp counter still running
+    bool ramping = false;
+    float time_ramped = 0;
+    bool system_installation = false;
+    bool inert_faction = false;
+    bool busy_directive = false;
+    bool has_target = false;
+    ///distance to the nearest player or camera
+    float distance = FLT_MAX;
+    float too_close = 0;
+};
+
+/// Only needed by units with a target that get that far down the ladder, so measured on demand
+struct TargetMeasure {
+    double distance = 0;
+    float gun_range = 0;
+    float missile_range = 0;
+};
+
+/// What the ladder compares the inputs with; the same for every unit in a frame
+struct Thresholds {
+    ///weapon ranges of the nearest player
+    float gun_range = 0;
+    float missile_range = 0;
+    float lowest_priority_time = 0;
+    double player_threat_factor = 0;
+    double threat_factor = 0;
+};
+
+struct Levels {
+    uint_fast32_t missile = 1;
+    uint_fast32_t dockable = 1;
+    uint_fast32_t asteroid_parent = 1;
+    uint_fast32_t asteroid_high = 1;
+    uint_fast32_t player = 1;
+    uint_fast32_t high = 1;
+    uint_fast32_t medium_high = 1;
+    uint_fast32_t medium = 1;
+    uint_fast32_t low = 1;
+    uint_fast32_t inert = 1;
+    ///system installations, so the orbit averaging can still keep track of parent jumps
+    uint_fast32_t system_orbit = 1;
+    uint_fast32_t not_visible_combat_high = 1;
+    uint_fast32_t not_visible_combat_medium = 1;
+    uint_fast32_t not_visible_combat_low = 1;
+    uint_fast32_t no_enemies = 1;
+};
+
+/// The distances and too_close values the decisions of a classification hold for
+struct Interval {
+    double lower = -DBL_MAX;
+    double upper = DBL_MAX;
+    double too_close_lower = -DBL_MAX;
+    double too_close_upper = DBL_MAX;
+    ///false when anything besides the distance could move the unit to another band (targets, warp ramping)
+    bool cacheable = true;
+
+    bool Below(double distance, double threshold) {
+        if (distance < threshold) {
+            upper = std::min(upper, threshold);
+            return true;
+        }
+        lower = std::max(lower, threshold);
+        return false;
+    }
+
+    ///distance < too_close * factor; both sides move, so each keeps to its side of the midpoint
+    bool BelowTooClose(double distance, double too_close, double factor) {
+        const double threshold = too_close * factor;
+        if (factor <= 0) {
+            return Below(distance, threshold);
+        }
+        const double middle = distance / 2 + threshold / 2;
+        if (distance < threshold) {
+            upper = std::min(upper, middle);
+            too_close_lower = std::max(too_close_lower, middle / factor);
+            return true;
+        }
+        lower = std::max(lower, middle);
+        too_close_upper = std::min(too_close_upper, middle / factor);
+        return false;
+    }
+
+    bool Contains(double distance, double too_close) const {
+        return distance >= lower && distance < upper && too_close > too_close_lower && too_close <= too_close_upper;
+    }
+};
+
+/// The inputs a cached classification stays valid for, apart from the distance
+inline uint32_t StateKey(const Inputs &in) {
+    return (in.missile ? 1U : 0U) | (in.docking ? 2U : 0U) | (static_cast<uint32_t>(in.schedule) << 2)
+            | (in.asteroid ? 16U : 0U) | (in.targets_player ? 32U : 0U) | (in.ramping ? 64U : 0U)
+            | (in.system_installation ? 128U : 0U) | (in.inert_faction ? 256U : 0U)
+            | (in.busy_directive ? 512U : 0U) | (in.has_target ? 1024U : 0U);
+}
+
+template<typename MeasureTarget>
+uint32_t Classify(const Inputs &in, const Thresholds &th, Interval &interval, MeasureTarget measure_target) {
+    if (in.missile) {
+        return BAND_MISSILE;
+    }
+    if (in.docking) {
+        return BAND_DOCKABLE;
+    }
+    //Units with their own internal scheduling must have constant priority
+    if (in.schedule == SCHEDULE_ASTEROID_FIELD) {
+        return BAND_ASTEROID_FIELD;
+    }
+    if (in.schedule == SCHEDULE_ASTEROID || in.asteroid) {
+        return BAND_ASTEROID;
+    }
+    const float dist = in.distance;
+    uint32_t bands = 0;
+    if (in.targets_player) {
+        interval.cacheable = false;
+        bands |= BAND_TARGETS_PLAYER;
+        if (in.jumppoint) {
+            bands |= BAND_JUMPPOINT;
+        } else if (in.player_target_distance <= th.player_threat_factor * std::max(th.gun_range, th.missile_range)) {
+            bands |= BAND_PLAYER_IN_RANGE;
+        }
+        return bands;
+    }
+    if (in.ramping) {
+        interval.cacheable = false;
+        bands |= BAND_RAMPING;
+        if (in.warp_ramping || in.time_ramped < th.lowest_priority_time) {
+            return bands | BAND_RAMP_EARLY;
+        }
+        if (dist < th.gun_range) {
+            return bands | BAND_RAMP_IN_GUN_RANGE;
+        }
+        if (in.time_ramped < th.lowest_priority_time * 2) {
+            return bands | BAND_RAMP_LATE;
+        }
+    }
+    if (in.system_installation || in.inert_faction) {
+        bands |= in.system_installation ? BAND_SYSTEM_INSTALLATION : BAND_INERT_FACTION;
+        if (interval.BelowTooClose(dist, in.too_close, 1.0)) {
+            bands |= BAND_TOO_CLOSE;
+        }
+        return bands;
+    }
+    if (in.busy_directive) {
+        return bands | BAND_BUSY_DIRECTIVE;
+    }
+    if (interval.Below(dist, 2 * th.player_threat_factor * std::max(th.missile_range, th.gun_range))) {
+        bands |= BAND_PLAYER_THREAT;
+        if (interval.BelowTooClose(dist, in.too_close, th.player_threat_factor)) {
+            bands |= BAND_PLAYER_THREAT_CLOSE;
+        } else if (interval.Below(dist, 2 * th.gun_range * th.player_threat_factor)) {
+            bands |= BAND_PLAYER_THREAT_GUN;
+        }
+        return bands;
+    }
+    if (in.has_target) {
+        interval.cacheable = false;
+        bands |= BAND_HAS_TARGET;
+        const TargetMeasure target = measure_target();
+        if (target.distance <= 2.0 * static_cast<double>(target.gun_range) * th.threat_factor) {
+            bands |= BAND_TARGET_GUN;
+        } else if (target.distance < 2.0 * static_cast<double>(target.missile_range) * th.threat_factor) {
+            bands |= BAND_TARGET_MISSILE;
+        }
+        return bands;
+    }
+    if (interval.BelowTooClose(dist, in.too_close, th.threat_factor)) {
+        bands |= BAND_THREAT_CLOSE;
+    }
+    return bands;
+}
+
+inline uint_fast32_t Resolve(uint32_t bands, const Levels &levels) {
+    if (bands & BAND_MISSILE) {
+        return levels.missile;
+    }
+    if (bands & BAND_DOCKABLE) {
+        return levels.dockable;
+    }
+    if (bands & BAND_ASTEROID_FIELD) {
+        return levels.asteroid_parent;
+    }
+    if (bands & BAND_ASTEROID) {
+        return levels.asteroid_high;
+    }
+    if (bands & BAND_TARGETS_PLAYER) {
+        if (bands & BAND_JUMPPOINT) {
+            return levels.player;
+        } else if (bands & BAND_PLAYER_IN_RANGE) {
+            return levels.high;
+        }
+        //Needs to accurately collide with it...
+        return levels.medium_high;
+    }
+    if (bands & (BAND_RAMP_EARLY | BAND_RAMP_IN_GUN_RANGE)) {
+        return levels.medium;
+    }
+    if (bands & BAND_RAMP_LATE) {
+        return levels.low;
+    }
+    if (bands & (BAND_SYSTEM_INSTALLATION | BAND_INERT_FACTION)) {
+        if (bands & BAND_TOO_CLOSE) {
+            return levels.medium;
+        }
+        if (bands & BAND_SYSTEM_INSTALLATION) {
+            return levels.system_orbit;
+        }
+        return levels.inert;
+    }
+    if (bands & BAND_BUSY_DIRECTIVE) {
+        return levels.medium;
+    }
+    if (bands & BAND_PLAYER_THREAT) {
+        if (bands & BAND_PLAYER_THREAT_CLOSE) {
+            return levels.medium_high;
+        } else if (bands & BAND_PLAYER_THREAT_GUN) {
+            return levels.medium;
+        }
+        return levels.low;
+    }
+    if (bands & BAND_HAS_TARGET) {
+        if (bands & BAND_TARGET_GUN) {
+            return levels.not_visible_combat_high;
+        } else if (bands & BAND_TARGET_MISSILE) {
+            return levels.not_visible_combat_medium;
+        }
+        return levels.not_visible_combat_low;
+    }
+    if (bands & BAND_THREAT_CLOSE) {
+        return levels.medium_high;
+    }
+    //May not have weapons (hence missile_range|gun_range == 0)
+    return levels.no_enemies;
+}
+
+/**
+ * A unit's last classification, and what it was decided on.
+ *
+ * It holds while the unit's state key, the frame's thresholds and the
+ * nearest observer are unchanged, and the distance and too_close have not
+ * crossed out of the interval the bands were decided in.
+ */
+struct BandCache {
+    bool valid = false;
+    uint32_t state = 0;
+    unsigned int thresholds = 0;
+    int cockpit = -1;
+    Interval interval;
+    uint32_t bands = 0;
+
+    bool Holds(const Inputs &in, unsigned int thresholds, int cockpit) const {
+        return valid && state == StateKey(in) && this->thresholds == thresholds && this->cockpit == cockpit
+                && interval.Contains(in.distance, in.too_close);
+    }
+
+    void Store(const Inputs &in, unsigned int thresholds, int cockpit, const Interval &interval, uint32_t bands) {
+        valid = interval.cacheable;
+        state = StateKey(in);
+        this->thresholds = thresholds;
+        this->cockpit = cockpit;
+        this->interval = interval;
+        this->bands = bands;
+    }
+};
+
+}
+
+#endif //VEGA_STRIKE_ENGINE_CMD_PHYSICS_PRIORITY_LADDER_H
@@ -44,7 +44,11 @@ PlanetaryOrbit::PlanetaryOrbit(Unit *p,
         inittheta(initpos),
         x_size(x_axis),
         y_size(y_axis),
-        current_orbit_frame(0) {
+        current_orbit_frame(0),
+        rails_system(nullptr),
+        rails_body(OrbitRails::NO_PARENT),
+        rails_epoch(0),
+        rails_placed(false) {
     for (unsigned int t = 0; t < NUM_ORBIT_AVERAGE; ++t) {
         orbiting_average[t] = QVector(0, 0, 0);
     }
@@ -74,6 +78,65 @@ PlanetaryOrbit::PlanetaryOrbit(Unit *p,
 
 PlanetaryOrbit::~PlanetaryOrbit() {
     parent->SetResolveForces(true);
+    if (rails_system != nullptr) {
+        rails_system->LeaveOrbitRails(rails_body);
+    }
+}
+
+void PlanetaryOrbit::BoardRails() {
+    StarSystem *system = parent->activeStarSystem;
+    if (system == nullptr) {
+        return;
+    }
+    unsigned int orbitee_body = OrbitRails::NO_PARENT;
+    if (subtype & SSELF) {
+        Unit *orbitee = group.GetUnit();
+        PlanetaryOrbit *orbitee_orbit = orbitee ? dynamic_cast<PlanetaryOrbit *>(orbitee->aistate) : nullptr;
+        //a moon boards once its planet has; whatever orbits a ship keeps being steered
+        if (orbitee_orbit == nullptr || orbitee_orbit->rails_system != system) {
+            return;
+        }
+        orbitee_body = orbitee_orbit->rails_body;
+    }
+    OrbitRails::Elements elements;
+    elements.offset = QVector(targetlocation) - focus;
+    elements.x_axis = x_size;
+    elements.y_axis = y_size;
+    elements.angular_velocity = velocity / (2.0 * PI);
+    //theta already includes the step the body was just steered through
+    rails_epoch = system->getOrbitTime() + simulation_atom_var;
+    elements.phase = theta;
+    elements.epoch = rails_epoch;
+    rails_body = system->BoardOrbitRails(this, elements, orbitee_body);
+    rails_system = system;
+}
+
+void PlanetaryOrbit::FollowRails() {
+    if (rails_system == nullptr || rails_system != parent->activeStarSystem) {
+        return;
+    }
+    const OrbitRails &rails = rails_system->orbitRails();
+    parent->SetCurPosition(rails.Position(rails_body));
+    parent->Velocity = parent->cumulative_velocity = rails.Velocity(rails_body);
+    rails_placed = true;
+}
+
+void PlanetaryOrbit::RailsMoved(unsigned int body) {
+    rails_body = body;
+}
+
+void PlanetaryOrbit::DropRails(double time) {
+    theta += velocity / (2.0 * PI) * (time - rails_epoch);
+    rails_epoch = time;
+    rails_system = nullptr;
+    rails_body = OrbitRails::NO_PARENT;
+    rails_placed = false;
+    //whatever is in the history predates the rails
+    for (unsigned int t = 0; t < NUM_ORBIT_AVERAGE; ++t) {
+        orbiting_average[t] = QVector(0, 0, 0);
+    }
+    current_orbit_frame = 0;
+    orbit_list_filled = false;
 }
 
 void PlanetaryOrbit::Execute() {
@@ -84,6 +147,20 @@ void PlanetaryOrbit::Execute() {
     if (done) {
         return;
     }
+    if (rails_system != nullptr) {
+        if (rails_system == parent->activeStarSystem) {
+            //only an orbit that is part of some other AI is left for its unit to place
+            if (!rails_placed) {
+                FollowRails();
+            }
+            rails_placed = false;
+            return;
+        }
+        //the body was moved to another system
+        const double time = rails_system->getOrbitTime();
+        rails_system->LeaveOrbitRails(rails_body);
+        DropRails(time);
+    }
     QVector origin(targetlocation);
     const float orbit_centroid_averaging = configuration().physics.orbit_averaging_flt;
     float averaging = (float) orbit_centroid_averaging / (float) (parent->predicted_priority + 1.0f);
@@ -199,4 +276,7 @@ void PlanetaryOrbit::Execute() {
         parent->cumulative_velocity.Set(0, 0, 0);
         parent->SetCurPosition(origin - focus + sum_orbiting_average + x_offset + y_offset);
     }
+    if (configuration().physics.orbit_rails) {
+        BoardRails();
+    }
 }
@@ -46,6 +46,15 @@ private:
     float orbiting_last_simatom;
     int current_orbit_frame;
     bool orbit_list_filled;
+    ///the system whose orbit rails carry the body, or nullptr while it is steered
+    StarSystem *rails_system;
+    unsigned int rails_body;
+    ///game time theta was last brought up to date at
+    double rails_epoch;
+    ///StarSystem::EvaluateOrbitRails already put the body where the rails have it this atom
+    bool rails_placed;
+
+    void BoardRails();
 protected:
 ///A vector containing all lihgts currently activated on current planet
     std::vector<int> lights;
@@ -60,6 +69,13 @@ public:
             Unit *target = NULL);
     ~PlanetaryOrbit();
     void Execute();
+
+    /// puts the body where the rails have it this atom, if it is on the rails of the system it is in
+    void FollowRails();
+    /// the StarSystem compacted its rails and renumbered the body
+    void RailsMoved(unsigned int body);
+    /// goes back to steering the body, picking its orbit up where the rails left it at game time
+    void DropRails(double time);
 };
 
 #endif //VEGA_STRIKE_ENGINE_CMD_PLANETARY_ORBIT_H
@@ -0,0 +1,326 @@
+/*
+ * rigid_body_batch.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "cmd/rigid_body_batch.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RIGID_BODY_BATCH_SSE
+#endif
+
+void RigidBodyBatch::Clear() {
+    for (std::vector<float> *v : {&qs, &qi, &qj, &qk, &vx, &vy, &vz, &wx, &wy, &wz, &lfx, &lfy, &lfz,
+            &ltx, &lty, &ltz, &fx, &fy, &fz, &tx, &ty, &tz, &mass, &moment, &max_rate, &dt, &dx, &dy, &dz}) {
+        v->clear();
+    }
+    px.clear();
+    py.clear();
+    pz.clear();
+}
+
+size_t RigidBodyBatch::Add(const Body &body) {
+    qs.push_back(body.orientation.s);
+    qi.push_back(body.orientation.v.i);
+    qj.push_back(body.orientation.v.j);
+    qk.push_back(body.orientation.v.k);
+    px.push_back(body.position.i);
+    py.push_back(body.position.j);
+    pz.push_back(body.position.k);
+    vx.push_back(body.velocity.i);
+    vy.push_back(body.velocity.j);
+    vz.push_back(body.velocity.k);
+    wx.push_back(body.angular_velocity.i);
+    wy.push_back(body.angular_velocity.j);
+    wz.push_back(body.angular_velocity.k);
+    lfx.push_back(body.local_force.i);
+    lfy.push_back(body.local_force.j);
+    lfz.push_back(body.local_force.k);
+    ltx.push_back(body.local_torque.i);
+    lty.push_back(body.local_torque.j);
+    ltz.push_back(body.local_torque.k);
+    fx.push_back(body.force.i);
+    fy.push_back(body.force.j);
+    fz.push_back(body.force.k);
+    tx.push_back(body.torque.i);
+    ty.push_back(body.torque.j);
+    tz.push_back(body.torque.k);
+    mass.push_back(body.mass);
+    moment.push_back(body.moment);
+    max_rate.push_back(body.max_rotation_rate);
+    dt.push_back(body.time_step);
+    dx.push_back(body.velocity.i);
+    dy.push_back(body.velocity.j);
+    dz.push_back(body.velocity.k);
+    return dt.size() - 1;
+}
+
+void RigidBodyBatch::SetVelocity(size_t body, const Vector &velocity) {
+    vx[body] = velocity.i;
+    vy[body] = velocity.j;
+    vz[body] = velocity.k;
+}
+
+void RigidBodyBatch::SetAngularVelocity(size_t body, const Vector &angular_velocity) {
+    wx[body] = angular_velocity.i;
+    wy[body] = angular_velocity.j;
+    wz[body] = angular_velocity.k;
+}
+
+void RigidBodyBatch::SetDrift(size_t body, const Vector &drift) {
+    dx[body] = drift.i;
+    dy[body] = drift.j;
+    dz[body] = drift.k;
+}
+
+void RigidBodyBatch::ResolveForcesOne(size_t b) {
+    Matrix m;
+    Orientation(b).to_matrix(m);
+    const Vector p = m.getP();
+    const Vector q = m.getQ();
+    const Vector r = m.getR();
+
+    Vector angular_acceleration(ltx[b] * p + lty[b] * q + ltz[b] * r);
+    angular_acceleration += Vector(tx[b], ty[b], tz[b]);
+    if (moment[b]) {
+        angular_acceleration = angular_acceleration / moment[b];
+    }
+    Vector w = AngularVelocity(b) + angular_acceleration * dt[b];
+    if (w.MagnitudeSquared() > max_rate[b] * max_rate[b]) {
+        w = w.Normalize() * max_rate[b];
+    }
+    SetAngularVelocity(b, w);
+
+    Vector acceleration(lfx[b] * p + lfy[b] * q + lfz[b] * r);
+    acceleration += Vector(fx[b], fy[b], fz[b]);
+    acceleration = acceleration / mass[b];
+    const Vector v = Velocity(b) + acceleration * dt[b];
+    SetVelocity(b, v);
+    SetDrift(b, v);
+}
+
+void RigidBodyBatch::AdvanceOne(size_t b) {
+    const Vector axis = AngularVelocity(b) * dt[b];
+    const double theta = axis.Magnitude();
+    if (theta >= 0.0001) {
+        const float s = cos(theta * .5);
+        const Quaternion rot(s, axis * (sinf(theta * .5) * (1 / theta)));
+        const Quaternion orientation = Orientation(b) * rot;
+        qs[b] = orientation.s;
+        qi[b] = orientation.v.i;
+        qj[b] = orientation.v.j;
+        qk[b] = orientation.v.k;
+    }
+    const QVector position = Position(b) + (Vector(dx[b], dy[b], dz[b]) * dt[b]).Cast();
+    px[b] = position.i;
+    py[b] = position.j;
+    pz[b] = position.k;
+}
+
+void RigidBodyBatch::ResolveForcesScalar() {
+    for (size_t b = 0, n = dt.size(); b < n; ++b) {
+        ResolveForcesOne(b);
+    }
+}
+
+void RigidBodyBatch::AdvanceScalar() {
+    for (size_t b = 0, n = dt.size(); b < n; ++b) {
+        AdvanceOne(b);
+    }
+}
+
+void RigidBodyBatch::ResolveForces() {
+    const size_t n = dt.size();
+    size_t b = 0;
+#ifdef RIGID_BODY_BATCH_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 epsilon = _mm_set1_ps(10e-6f);
+    const __m128 neg_epsilon = _mm_set1_ps(-10e-6f);
+    const __m128 tiny = _mm_set1_ps(0.00000000001f);
+    for (; b + 4 <= n; b += 4) {
+        //the body's axes, the columns of Quaternion::to_matrix
+        const __m128 s = _mm_loadu_ps(&qs[b]);
+        const __m128 i = _mm_loadu_ps(&qi[b]);
+        const __m128 j = _mm_loadu_ps(&qj[b]);
+        const __m128 k = _mm_loadu_ps(&qk[b]);
+        const __m128 norm = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(i, i), _mm_mul_ps(j, j)),
+                _mm_mul_ps(k, k)), _mm_mul_ps(s, s));
+        const __m128 degenerate = _mm_and_ps(_mm_cmplt_ps(norm, epsilon), _mm_cmpgt_ps(norm, neg_epsilon));
+        const __m128 w2 = _mm_andnot_ps(degenerate, _mm_div_ps(two, norm));
+        const __m128 xw = _mm_mul_ps(i, w2), yw = _mm_mul_ps(j, w2), zw = _mm_mul_ps(k, w2);
+        const __m128 sx = _mm_mul_ps(s, xw), sy = _mm_mul_ps(s, yw), sz = _mm_mul_ps(s, zw);
+        const __m128 xx = _mm_mul_ps(i, xw), xy = _mm_mul_ps(i, yw), xz = _mm_mul_ps(i, zw);
+        const __m128 yy = _mm_mul_ps(j, yw), yz = _mm_mul_ps(j, zw), zz = _mm_mul_ps(k, zw);
+        const __m128 p0 = _mm_sub_ps(one, _mm_add_ps(yy, zz)), p1 = _mm_sub_ps(xy, sz), p2 = _mm_add_ps(xz, sy);
+        const __m128 q0 = _mm_add_ps(xy, sz), q1 = _mm_sub_ps(one, _mm_add_ps(xx, zz)), q2 = _mm_sub_ps(yz, sx);
+        const __m128 r0 = _mm_sub_ps(xz, sy), r1 = _mm_add_ps(yz, sx), r2 = _mm_sub_ps(one, _mm_add_ps(xx, yy));
+        const __m128 step = _mm_loadu_ps(&dt[b]);
+
+        //angular velocity, clamped to the rotation rate
+        const __m128 lti = _mm_loadu_ps(&ltx[b]), ltj = _mm_loadu_ps(&lty[b]), ltk = _mm_loadu_ps(&ltz[b]);
+        __m128 ai = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(lti, p0), _mm_mul_ps(ltj, q0)), _mm_mul_ps(ltk, r0)),
+                _mm_loadu_ps(&tx[b]));
+        __m128 aj = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(lti, p1), _mm_mul_ps(ltj, q1)), _mm_mul_ps(ltk, r1)),
+                _mm_loadu_ps(&ty[b]));
+        __m128 ak = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(lti, p2), _mm_mul_ps(ltj, q2)), _mm_mul_ps(ltk, r2)),
+                _mm_loadu_ps(&tz[b]));
+        const __m128 mom = _mm_loadu_ps(&moment[b]);
+        const __m128 has_moment = _mm_cmpneq_ps(mom, zero);
+        const __m128 inv_moment = _mm_or_ps(_mm_and_ps(has_moment, _mm_div_ps(one, mom)),
+                _mm_andnot_ps(has_moment, one));
+        ai = _mm_mul_ps(ai, inv_moment);
+        aj = _mm_mul_ps(aj, inv_moment);
+        ak = _mm_mul_ps(ak, inv_moment);
+        __m128 wi = _mm_add_ps(_mm_loadu_ps(&wx[b]), _mm_mul_ps(ai, step));
+        __m128 wj = _mm_add_ps(_mm_loadu_ps(&wy[b]), _mm_mul_ps(aj, step));
+        __m128 wk = _mm_add_ps(_mm_loadu_ps(&wz[b]), _mm_mul_ps(ak, step));
+        const __m128 rate = _mm_loadu_ps(&max_rate[b]);
+        const __m128 mag2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(wi, wi), _mm_mul_ps(wj, wj)), _mm_mul_ps(wk, wk));
+        const __m128 too_fast = _mm_cmpgt_ps(mag2, _mm_mul_ps(rate, rate));
+        if (_mm_movemask_ps(too_fast)) {
+            //as Vector::Normalize, which leaves a near zero vector alone
+            const __m128 normalizable = _mm_cmpgt_ps(mag2, tiny);
+            const __m128 inv_mag = _mm_or_ps(_mm_and_ps(normalizable, _mm_div_ps(one, _mm_sqrt_ps(mag2))),
+                    _mm_andnot_ps(normalizable, one));
+            const __m128 scale = _mm_or_ps(_mm_and_ps(too_fast, _mm_mul_ps(inv_mag, rate)),
+                    _mm_andnot_ps(too_fast, one));
+            wi = _mm_mul_ps(wi, scale);
+            wj = _mm_mul_ps(wj, scale);
+            wk = _mm_mul_ps(wk, scale);
+        }
+        _mm_storeu_ps(&wx[b], wi);
+        _mm_storeu_ps(&wy[b], wj);
+        _mm_storeu_ps(&wz[b], wk);
+
+        //velocity
+        const __m128 lfi = _mm_loadu_ps(&lfx[b]), lfj = _mm_loadu_ps(&lfy[b]), lfk = _mm_loadu_ps(&lfz[b]);
+        const __m128 inv_mass = _mm_div_ps(one, _mm_loadu_ps(&mass[b]));
+        const __m128 ci = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(lfi, p0), _mm_mul_ps(lfj, q0)),
+                _mm_mul_ps(lfk, r0)), _mm_loadu_ps(&fx[b])), inv_mass);
+        const __m128 cj = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(lfi, p1), _mm_mul_ps(lfj, q1)),
+                _mm_mul_ps(lfk, r1)), _mm_loadu_ps(&fy[b])), inv_mass);
+        const __m128 ck = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(lfi, p2), _mm_mul_ps(lfj, q2)),
+                _mm_mul_ps(lfk, r2)), _mm_loadu_ps(&fz[b])), inv_mass);
+        const __m128 vi = _mm_add_ps(_mm_loadu_ps(&vx[b]), _mm_mul_ps(ci, step));
+        const __m128 vj = _mm_add_ps(_mm_loadu_ps(&vy[b]), _mm_mul_ps(cj, step));
+        const __m128 vk = _mm_add_ps(_mm_loadu_ps(&vz[b]), _mm_mul_ps(ck, step));
+        _mm_storeu_ps(&vx[b], vi);
+        _mm_storeu_ps(&vy[b], vj);
+        _mm_storeu_ps(&vz[b], vk);
+        _mm_storeu_ps(&dx[b], vi);
+        _mm_storeu_ps(&dy[b], vj);
+        _mm_storeu_ps(&dz[b], vk);
+    }
+#endif
+    for (; b < n; ++b) {
+        ResolveForcesOne(b);
+    }
+}
+
+void RigidBodyBatch::Advance() {
+    const size_t n = dt.size();
+    size_t b = 0;
+#ifdef RIGID_BODY_BATCH_SSE
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 min_angle = _mm_set1_ps(0.0001f);
+    //the series below are good to float precision up to a half turn per atom
+    const __m128 max_angle = _mm_set1_ps(3.14159265f);
+    for (; b + 4 <= n; b += 4) {
+        const __m128 step = _mm_loadu_ps(&dt[b]);
+        const __m128 ai = _mm_mul_ps(_mm_loadu_ps(&wx[b]), step);
+        const __m128 aj = _mm_mul_ps(_mm_loadu_ps(&wy[b]), step);
+        const __m128 ak = _mm_mul_ps(_mm_loadu_ps(&wz[b]), step);
+        const __m128 theta = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ai, ai), _mm_mul_ps(aj, aj)),
+                _mm_mul_ps(ak, ak)));
+        const int turning = _mm_movemask_ps(_mm_cmpge_ps(theta, min_angle));
+        if (_mm_movemask_ps(_mm_cmpgt_ps(theta, max_angle))) {
+            for (size_t l = b; l < b + 4; ++l) {
+                AdvanceOne(l);
+            }
+            continue;
+        }
+        if (turning) {
+            //cos(theta / 2) and sin(theta / 2) / theta by their Taylor series
+            const __m128 h = _mm_mul_ps(theta, half);
+            const __m128 h2 = _mm_mul_ps(h, h);
+            __m128 c = _mm_set1_ps(1.0f / 479001600.0f);
+            c = _mm_add_ps(_mm_mul_ps(c, h2), _mm_set1_ps(-1.0f / 3628800.0f));
+            c = _mm_add_ps(_mm_mul_ps(c, h2), _mm_set1_ps(1.0f / 40320.0f));
+            c = _mm_add_ps(_mm_mul_ps(c, h2), _mm_set1_ps(-1.0f / 720.0f));
+            c = _mm_add_ps(_mm_mul_ps(c, h2), _mm_set1_ps(1.0f / 24.0f));
+            c = _mm_add_ps(_mm_mul_ps(c, h2), _mm_set1_ps(-0.5f));
+            c = _mm_add_ps(_mm_mul_ps(c, h2), one);
+            __m128 sinc = _mm_set1_ps(1.0f / 6227020800.0f);
+            sinc = _mm_add_ps(_mm_mul_ps(sinc, h2), _mm_set1_ps(-1.0f / 39916800.0f));
+            sinc = _mm_add_ps(_mm_mul_ps(sinc, h2), _mm_set1_ps(1.0f / 362880.0f));
+            sinc = _mm_add_ps(_mm_mul_ps(sinc, h2), _mm_set1_ps(-1.0f / 5040.0f));
+            sinc = _mm_add_ps(_mm_mul_ps(sinc, h2), _mm_set1_ps(1.0f / 120.0f));
+            sinc = _mm_add_ps(_mm_mul_ps(sinc, h2), _mm_set1_ps(-1.0f / 6.0f));
+            sinc = _mm_add_ps(_mm_mul_ps(sinc, h2), one);
+            const __m128 f = _mm_mul_ps(sinc, half);
+            const __m128 bs = c, bi = _mm_mul_ps(ai, f), bj = _mm_mul_ps(aj, f), bk = _mm_mul_ps(ak, f);
+
+            //orientation * rotation, as Movable::Rotate
+            const __m128 as = _mm_loadu_ps(&qs[b]);
+            const __m128 qa_i = _mm_loadu_ps(&qi[b]);
+            const __m128 qa_j = _mm_loadu_ps(&qj[b]);
+            const __m128 qa_k = _mm_loadu_ps(&qk[b]);
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qa_i, bi), _mm_mul_ps(qa_j, bj)), _mm_mul_ps(qa_k, bk));
+            const __m128 rs = _mm_sub_ps(_mm_mul_ps(as, bs), dot);
+            const __m128 ri = _mm_add_ps(_mm_add_ps(_mm_mul_ps(as, bi), _mm_mul_ps(bs, qa_i)),
+                    _mm_sub_ps(_mm_mul_ps(qa_j, bk), _mm_mul_ps(qa_k, bj)));
+            const __m128 rj = _mm_add_ps(_mm_add_ps(_mm_mul_ps(as, bj), _mm_mul_ps(bs, qa_j)),
+                    _mm_sub_ps(_mm_mul_ps(qa_k, bi), _mm_mul_ps(qa_i, bk)));
+            const __m128 rk = _mm_add_ps(_mm_add_ps(_mm_mul_ps(as, bk), _mm_mul_ps(bs, qa_k)),
+                    _mm_sub_ps(_mm_mul_ps(qa_i, bj), _mm_mul_ps(qa_j, bi)));
+            //bodies turning by less than the threshold keep their orientation
+            const __m128 keep = _mm_cmplt_ps(theta, min_angle);
+            _mm_storeu_ps(&qs[b], _mm_or_ps(_mm_and_ps(keep, as), _mm_andnot_ps(keep, rs)));
+            _mm_storeu_ps(&qi[b], _mm_or_ps(_mm_and_ps(keep, qa_i), _mm_andnot_ps(keep, ri)));
+            _mm_storeu_ps(&qj[b], _mm_or_ps(_mm_and_ps(keep, qa_j), _mm_andnot_ps(keep, rj)));
+            _mm_storeu_ps(&qk[b], _mm_or_ps(_mm_and_ps(keep, qa_k), _mm_andnot_ps(keep, rk)));
+        }
+
+        //position, in double, two at a time
+        const __m128 mi = _mm_mul_ps(_mm_loadu_ps(&dx[b]), step);
+        const __m128 mj = _mm_mul_ps(_mm_loadu_ps(&dy[b]), step);
+        const __m128 mk = _mm_mul_ps(_mm_loadu_ps(&dz[b]), step);
+        _mm_storeu_pd(&px[b], _mm_add_pd(_mm_loadu_pd(&px[b]), _mm_cvtps_pd(mi)));
+        _mm_storeu_pd(&py[b], _mm_add_pd(_mm_loadu_pd(&py[b]), _mm_cvtps_pd(mj)));
+        _mm_storeu_pd(&pz[b], _mm_add_pd(_mm_loadu_pd(&pz[b]), _mm_cvtps_pd(mk)));
+        _mm_storeu_pd(&px[b + 2], _mm_add_pd(_mm_loadu_pd(&px[b + 2]), _mm_cvtps_pd(_mm_movehl_ps(mi, mi))));
+        _mm_storeu_pd(&py[b + 2], _mm_add_pd(_mm_loadu_pd(&py[b + 2]), _mm_cvtps_pd(_mm_movehl_ps(mj, mj))));
+        _mm_storeu_pd(&pz[b + 2], _mm_add_pd(_mm_loadu_pd(&pz[b + 2]), _mm_cvtps_pd(_mm_movehl_ps(mk, mk))));
+    }
+#endif
+    for (; b < n; ++b) {
+        AdvanceOne(b);
+    }
+}
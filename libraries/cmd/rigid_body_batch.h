@@ -0,0 +1,117 @@
+/*
+ * rigid_body_batch.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_RIGID_BODY_BATCH_H
+#define VEGA_STRIKE_ENGINE_CMD_RIGID_BODY_BATCH_H
+
+#include <vector>
+#include "gfx_generic/quaternion.h"
+
+/**
+ * Integrates the rigid bodies simulated in one sim atom together.
+ *
+ * Each body is packed as contiguous arrays of its orientation, position,
+ * velocity, angular velocity, the forces and torques accrued over the
+ * atom, mass, moment of inertia and time step. The two passes follow
+ * Movable::ResolveForces and Movable::Rotate / AddVelocity, and run four
+ * bodies at a time with SSE where available; the scalar versions are the
+ * reference the batched ones must agree with.
+ */
+class RigidBodyBatch {
+public:
+    struct Body {
+        Quaternion orientation;
+        QVector position;
+        Vector velocity;
+        Vector angular_velocity;
+        ///forces and torques in the body's own frame, as accrued by thrusters
+        Vector local_force;
+        Vector local_torque;
+        ///forces and torques in world space
+        Vector force;
+        Vector torque;
+        float mass;
+        ///0 leaves the torque unscaled, as Movable::ResolveForces does
+        float moment;
+        ///the angular velocity is clamped to this magnitude
+        float max_rotation_rate;
+        float time_step;
+    };
+
+    void Clear();
+    size_t Add(const Body &body);
+
+    size_t Size() const {
+        return dt.size();
+    }
+
+    ///Accelerates every body by its forces and torques over its time step
+    void ResolveForces();
+    void ResolveForcesScalar();
+
+    ///Turns every body by its angular velocity and moves it by its drift over its time step
+    void Advance();
+    void AdvanceScalar();
+
+    Vector Velocity(size_t body) const {
+        return Vector(vx[body], vy[body], vz[body]);
+    }
+
+    Vector AngularVelocity(size_t body) const {
+        return Vector(wx[body], wy[body], wz[body]);
+    }
+
+    Quaternion Orientation(size_t body) const {
+        return Quaternion(qs[body], Vector(qi[body], qj[body], qk[body]));
+    }
+
+    QVector Position(size_t body) const {
+        return QVector(px[body], py[body], pz[body]);
+    }
+
+    ///For the caller to apply speed limits and friction between the two passes
+    void SetVelocity(size_t body, const Vector &velocity);
+    void SetAngularVelocity(size_t body, const Vector &angular_velocity);
+    ///The velocity Advance moves the body by; defaults to its velocity after ResolveForces
+    void SetDrift(size_t body, const Vector &drift);
+
+private:
+    void ResolveForcesOne(size_t body);
+    void AdvanceOne(size_t body);
+
+    std::vector<float> qs, qi, qj, qk;
+    std::vector<double> px, py, pz;
+    std::vector<float> vx, vy, vz;
+    std::vector<float> wx, wy, wz;
+    std::vector<float> lfx, lfy, lfz;
+    std::vector<float> ltx, lty, ltz;
+    std::vector<float> fx, fy, fz;
+    std::vector<float> tx, ty, tz;
+    std::vector<float> mass, moment, max_rate, dt;
+    std::vector<float> dx, dy, dz;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_RIGID_BODY_BATCH_H
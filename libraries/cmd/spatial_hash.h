@@ -0,0 +1,449 @@
+/*
+ * spatial_hash.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_SPATIAL_HASH_H
+#define VEGA_STRIKE_ENGINE_CMD_SPATIAL_HASH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gfx_generic/vec.h"
+
+/**
+ * Sparse 3d spatial hash over axis aligned boxes.
+ *
+ * A cell is addressed by a 64 bit key made of its level and its signed cell
+ * coordinates, so cells far apart never share a bucket the way the old
+ * fixed size, modulo wrapped collide table made them. Each level has cells
+ * kLevelScale times wider than the one below. An item is stored on the
+ * finest level where its box covers at most max_span cells per axis, so big
+ * objects sit in a few coarse cells instead of a list checked against
+ * everything; only boxes beyond the range of the coarsest level overflow.
+ *
+ * Occupied cells are kept in a linear probing table of {key, head} slots and
+ * the items of a cell are chained through one shared entry pool. Empty cells
+ * are dropped, so memory follows the number of occupied cells, not the
+ * extent of the system.
+ */
+template<class T>
+class SpatialHash3d {
+public:
+    static const int kLevels = 16;
+    static const int kLevelScale = 4;
+    static const int kAxisBits = 20;
+
+    ///the cells a box covers on one level
+    struct Placement {
+        ///kLevels when the box went to the overflow list
+        int level;
+        int64_t lo[3];
+        int64_t hi[3];
+
+        bool Overflow() const {
+            return level >= kLevels;
+        }
+
+        bool operator==(const Placement &o) const {
+            if (level != o.level) {
+                return false;
+            }
+            if (Overflow()) {
+                return true;
+            }
+            for (int a = 0; a < 3; ++a) {
+                if (lo[a] != o.lo[a] || hi[a] != o.hi[a]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const Placement &o) const {
+            return !(*this == o);
+        }
+    };
+
+    explicit SpatialHash3d(double cell_size = 128.0, int max_span = 2)
+            : cell_size(cell_size), max_span(std::max(1, max_span)), occupied(0), free_entry(kNone) {
+        std::fill(level_entries, level_entries + kLevels, static_cast<size_t>(0));
+    }
+
+    static int64_t AxisMin() {
+        return -(static_cast<int64_t>(1) << (kAxisBits - 1));
+    }
+
+    static int64_t AxisMax() {
+        return (static_cast<int64_t>(1) << (kAxisBits - 1)) - 1;
+    }
+
+    static uint64_t CellKey(int level, int64_t x, int64_t y, int64_t z) {
+        return (static_cast<uint64_t>(level) << (3 * kAxisBits))
+                | (static_cast<uint64_t>(x - AxisMin()) << (2 * kAxisBits))
+                | (static_cast<uint64_t>(y - AxisMin()) << kAxisBits)
+                | static_cast<uint64_t>(z - AxisMin());
+    }
+
+    double CellSize(int level) const {
+        return cell_size * std::pow(static_cast<double>(kLevelScale), level);
+    }
+
+    ///where Put would store a box; compare two of these to tell whether an item has to be moved
+    Placement Place(const QVector &mini, const QVector &maxi) const {
+        Placement p;
+        double size = cell_size;
+        for (p.level = 0; p.level < kLevels; ++p.level, size *= kLevelScale) {
+            if (CellRange(mini, maxi, size, false, p)) {
+                bool fits = true;
+                for (int a = 0; a < 3; ++a) {
+                    fits = fits && p.hi[a] - p.lo[a] < max_span;
+                }
+                if (fits) {
+                    return p;
+                }
+            }
+        }
+        return p;
+    }
+
+    Placement Put(const QVector &mini, const QVector &maxi, const T &item) {
+        Placement p = Place(mini, maxi);
+        if (p.Overflow()) {
+            overflow.push_back(item);
+            return p;
+        }
+        for (int64_t x = p.lo[0]; x <= p.hi[0]; ++x) {
+            for (int64_t y = p.lo[1]; y <= p.hi[1]; ++y) {
+                for (int64_t z = p.lo[2]; z <= p.hi[2]; ++z) {
+                    size_t slot = InsertSlot(CellKey(p.level, x, y, z));
+                    uint32_t entry = AllocEntry(item, slots[slot].head);
+                    slots[slot].head = entry;
+                    ++level_entries[p.level];
+                }
+            }
+        }
+        return p;
+    }
+
+    ///removes item from the cells of the box it was Put with
+    bool Remove(const QVector &mini, const QVector &maxi, const T &item) {
+        Placement p = Place(mini, maxi);
+        if (p.Overflow()) {
+            typename std::vector<T>::iterator i = std::find(overflow.begin(), overflow.end(), item);
+            if (i == overflow.end()) {
+                return false;
+            }
+            overflow.erase(i);
+            return true;
+        }
+        bool ret = false;
+        for (int64_t x = p.lo[0]; x <= p.hi[0]; ++x) {
+            for (int64_t y = p.lo[1]; y <= p.hi[1]; ++y) {
+                for (int64_t z = p.lo[2]; z <= p.hi[2]; ++z) {
+                    size_t slot = FindSlot(CellKey(p.level, x, y, z));
+                    if (slot != kNoSlot) {
+                        ret |= RemoveFromSlot(slot, item, false);
+                    }
+                }
+            }
+        }
+        return ret;
+    }
+
+    ///removes every occurrence of item, wherever it was stored
+    bool Eradicate(const T &item) {
+        size_t before = overflow.size();
+        overflow.erase(std::remove(overflow.begin(), overflow.end(), item), overflow.end());
+        bool ret = overflow.size() != before;
+        for (size_t slot = 0; slot < slots.size();) {
+            if (slots[slot].head != kNone && RemoveFromSlot(slot, item, true)) {
+                //an emptied cell is refilled by the backward shift, so look at this slot again
+                ret = true;
+                continue;
+            }
+            ++slot;
+        }
+        return ret;
+    }
+
+    void Clear() {
+        for (size_t i = 0; i < slots.size(); ++i) {
+            slots[i].head = kNone;
+        }
+        entries.clear();
+        overflow.clear();
+        occupied = 0;
+        free_entry = kNone;
+        std::fill(level_entries, level_entries + kLevels, static_cast<size_t>(0));
+    }
+
+    /**
+     * Calls visit on every item stored in a cell the box touches, plus the
+     * overflow list. An item spanning several touched cells is visited once
+     * per cell.
+     */
+    template<class VISIT>
+    void Query(const QVector &mini, const QVector &maxi, VISIT visit) const {
+        for (size_t i = 0; i < overflow.size(); ++i) {
+            visit(overflow[i]);
+        }
+        Placement p;
+        double size = cell_size;
+        for (p.level = 0; p.level < kLevels; ++p.level, size *= kLevelScale) {
+            if (level_entries[p.level] == 0 || !CellRange(mini, maxi, size, true, p)) {
+                continue;
+            }
+            double cells = 1.0;
+            for (int a = 0; a < 3; ++a) {
+                cells *= static_cast<double>(p.hi[a] - p.lo[a] + 1);
+            }
+            if (cells > static_cast<double>(level_entries[p.level])) {
+                //a box much larger than this level's cells: walking the occupied cells is cheaper
+                for (size_t slot = 0; slot < slots.size(); ++slot) {
+                    if (slots[slot].head != kNone && KeyInside(slots[slot].key, p)) {
+                        VisitSlot(slot, visit);
+                    }
+                }
+                continue;
+            }
+            for (int64_t x = p.lo[0]; x <= p.hi[0]; ++x) {
+                for (int64_t y = p.lo[1]; y <= p.hi[1]; ++y) {
+                    for (int64_t z = p.lo[2]; z <= p.hi[2]; ++z) {
+                        size_t slot = FindSlot(CellKey(p.level, x, y, z));
+                        if (slot != kNoSlot) {
+                            VisitSlot(slot, visit);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    ///the distinct items near the box, sorted
+    void Get(const QVector &mini, const QVector &maxi, std::vector<T> &retval) const {
+        retval.clear();
+        Query(mini, maxi, [&retval](const T &item) {
+            retval.push_back(item);
+        });
+        std::sort(retval.begin(), retval.end());
+        retval.erase(std::unique(retval.begin(), retval.end()), retval.end());
+    }
+
+    const std::vector<T> &GetOverflow() const {
+        return overflow;
+    }
+
+    ///number of occupied cells over all levels
+    size_t CellCount() const {
+        return occupied;
+    }
+
+    ///number of item references stored in cells of this level
+    size_t LevelEntries(int level) const {
+        return level_entries[level];
+    }
+
+private:
+    static const uint32_t kNone = 0xffffffffu;
+    static const size_t kNoSlot = static_cast<size_t>(-1);
+
+    struct Slot {
+        uint64_t key;
+        uint32_t head;
+    };
+
+    struct Entry {
+        T item;
+        uint32_t next;
+    };
+
+    ///cell range of the box at this cell size; clamp keeps the part inside the key range
+    bool CellRange(const QVector &mini, const QVector &maxi, double size, bool clamp, Placement &p) const {
+        const double lo[3] = {mini.i, mini.j, mini.k};
+        const double hi[3] = {maxi.i, maxi.j, maxi.k};
+        const double axis_min = static_cast<double>(AxisMin());
+        const double axis_max = static_cast<double>(AxisMax());
+        for (int a = 0; a < 3; ++a) {
+            double l = std::floor(lo[a] / size);
+            double h = std::floor(hi[a] / size);
+            if (!(l <= h)) {
+                return false;
+            }
+            if (clamp) {
+                l = std::max(l, axis_min);
+                h = std::min(h, axis_max);
+                if (l > h) {
+                    return false;
+                }
+            } else if (l < axis_min || h > axis_max) {
+                return false;
+            }
+            p.lo[a] = static_cast<int64_t>(l);
+            p.hi[a] = static_cast<int64_t>(h);
+        }
+        return true;
+    }
+
+    static bool KeyInside(uint64_t key, const Placement &p) {
+        const uint64_t mask = (static_cast<uint64_t>(1) << kAxisBits) - 1;
+        if (static_cast<int>(key >> (3 * kAxisBits)) != p.level) {
+            return false;
+        }
+        for (int a = 0; a < 3; ++a) {
+            int64_t c = static_cast<int64_t>((key >> ((2 - a) * kAxisBits)) & mask) + AxisMin();
+            if (c < p.lo[a] || c > p.hi[a]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static size_t Mix(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+
+    size_t FindSlot(uint64_t key) const {
+        if (slots.empty()) {
+            return kNoSlot;
+        }
+        const size_t mask = slots.size() - 1;
+        for (size_t i = Mix(key) & mask;; i = (i + 1) & mask) {
+            if (slots[i].head == kNone) {
+                return kNoSlot;
+            }
+            if (slots[i].key == key) {
+                return i;
+            }
+        }
+    }
+
+    size_t InsertSlot(uint64_t key) {
+        if ((occupied + 1) * 2 > slots.size()) {
+            Rehash(std::max(static_cast<size_t>(64), slots.size() * 2));
+        }
+        const size_t mask = slots.size() - 1;
+        size_t i = Mix(key) & mask;
+        for (; slots[i].head != kNone; i = (i + 1) & mask) {
+            if (slots[i].key == key) {
+                return i;
+            }
+        }
+        slots[i].key = key;
+        ++occupied;
+        return i;
+    }
+
+    void Rehash(size_t size) {
+        std::vector<Slot> old(size, Slot{0, kNone});
+        old.swap(slots);
+        const size_t mask = size - 1;
+        for (size_t j = 0; j < old.size(); ++j) {
+            if (old[j].head != kNone) {
+                size_t i = Mix(old[j].key) & mask;
+                while (slots[i].head != kNone) {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = old[j];
+            }
+        }
+    }
+
+    ///backward shift deletion, so probe chains never need tombstones
+    void EraseSlot(size_t i) {
+        const size_t mask = slots.size() - 1;
+        for (size_t j = (i + 1) & mask; slots[j].head != kNone; j = (j + 1) & mask) {
+            size_t home = Mix(slots[j].key) & mask;
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i].head = kNone;
+        --occupied;
+    }
+
+    uint32_t AllocEntry(const T &item, uint32_t next) {
+        uint32_t e = free_entry;
+        if (e == kNone) {
+            e = static_cast<uint32_t>(entries.size());
+            entries.push_back(Entry{item, next});
+        } else {
+            free_entry = entries[e].next;
+            entries[e].item = item;
+            entries[e].next = next;
+        }
+        return e;
+    }
+
+    bool RemoveFromSlot(size_t slot, const T &item, bool all) {
+        const int level = static_cast<int>(slots[slot].key >> (3 * kAxisBits));
+        bool ret = false;
+        for (uint32_t *link = &slots[slot].head; *link != kNone;) {
+            uint32_t e = *link;
+            if (entries[e].item == item) {
+                *link = entries[e].next;
+                entries[e].next = free_entry;
+                free_entry = e;
+                --level_entries[level];
+                ret = true;
+                if (!all) {
+                    break;
+                }
+            } else {
+                link = &entries[e].next;
+            }
+        }
+        if (slots[slot].head == kNone) {
+            EraseSlot(slot);
+        }
+        return ret;
+    }
+
+    template<class VISIT>
+    void VisitSlot(size_t slot, VISIT &visit) const {
+        for (uint32_t e = slots[slot].head; e != kNone; e = entries[e].next) {
+            visit(entries[e].item);
+        }
+    }
+
+    double cell_size;
+    int max_span;
+    std::vector<Slot> slots;
+    std::vector<Entry> entries;
+    std::vector<T> overflow;
+    size_t occupied;
+    uint32_t free_entry;
+    size_t level_entries[kLevels];
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_SPATIAL_HASH_H
@@ -0,0 +1,149 @@
+/*
+ * sphere_tree.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "cmd/sphere_tree.h"
+
+#include <algorithm>
+#include <cfloat>
+
+const size_t SphereTree::npos = static_cast<size_t>(-1);
+
+void SphereTree::Build(const std::vector<QVector> &centers, const std::vector<double> &reaches) {
+    this->centers = centers;
+    this->reaches = reaches;
+    nodes.clear();
+    order.resize(centers.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    if (!order.empty()) {
+        BuildNode(0, order.size());
+    }
+}
+
+size_t SphereTree::BuildNode(size_t begin, size_t end) {
+    const size_t index = nodes.size();
+    nodes.push_back(Node());
+    nodes[index].begin = begin;
+    nodes[index].end = end;
+    nodes[index].left = nodes[index].right = 0;
+    Bound(nodes[index]);
+    if (end - begin > kLeafSize) {
+        //split at the median of the widest axis of the centers
+        QVector lo = centers[order[begin]];
+        QVector hi = lo;
+        for (size_t i = begin + 1; i < end; ++i) {
+            const QVector &c = centers[order[i]];
+            lo = QVector(std::min(lo.i, c.i), std::min(lo.j, c.j), std::min(lo.k, c.k));
+            hi = QVector(std::max(hi.i, c.i), std::max(hi.j, c.j), std::max(hi.k, c.k));
+        }
+        const QVector extent = hi - lo;
+        const int axis = (extent.i >= extent.j && extent.i >= extent.k) ? 0 : (extent.j >= extent.k ? 1 : 2);
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                [this, axis](size_t a, size_t b) {
+                    return (&centers[a].i)[axis] < (&centers[b].i)[axis];
+                });
+        const size_t left = BuildNode(begin, mid);
+        const size_t right = BuildNode(mid, end);
+        nodes[index].left = left;
+        nodes[index].right = right;
+    }
+    return index;
+}
+
+void SphereTree::Bound(Node &node) const {
+    QVector lo = centers[order[node.begin]];
+    QVector hi = lo;
+    node.max_reach = reaches[order[node.begin]];
+    for (size_t i = node.begin + 1; i < node.end; ++i) {
+        const QVector &c = centers[order[i]];
+        lo = QVector(std::min(lo.i, c.i), std::min(lo.j, c.j), std::min(lo.k, c.k));
+        hi = QVector(std::max(hi.i, c.i), std::max(hi.j, c.j), std::max(hi.k, c.k));
+        node.max_reach = std::max(node.max_reach, reaches[order[i]]);
+    }
+    node.center = (lo + hi) * 0.5;
+    node.radius = 0;
+    for (size_t i = node.begin; i < node.end; ++i) {
+        node.radius = std::max(node.radius, (centers[order[i]] - node.center).Magnitude());
+    }
+}
+
+double SphereTree::Refit(const std::vector<QVector> &centers) {
+    double moved = 0;
+    for (size_t i = 0; i < this->centers.size() && i < centers.size(); ++i) {
+        moved = std::max(moved, (centers[i] - this->centers[i]).Magnitude());
+        this->centers[i] = centers[i];
+    }
+    //each node bounds its own centers directly, so the split made by Build still holds
+    for (Node &node : nodes) {
+        Bound(node);
+    }
+    return moved;
+}
+
+SphereTree::Nearest SphereTree::FindNearest(const QVector &point) const {
+    Nearest best;
+    best.margin = DBL_MAX;
+    best.runner_up = DBL_MAX;
+    if (!nodes.empty()) {
+        Search(0, point, best);
+    }
+    return best;
+}
+
+void SphereTree::Search(size_t n, const QVector &point, Nearest &best) const {
+    const Node &node = nodes[n];
+    if (node.left == 0) {
+        for (size_t i = node.begin; i < node.end; ++i) {
+            const size_t sphere = order[i];
+            const double margin = (point - centers[sphere]).Magnitude() - reaches[sphere];
+            if (margin < best.margin) {
+                best.runner_up = best.margin;
+                best.margin = margin;
+                best.index = sphere;
+            } else if (margin < best.runner_up) {
+                best.runner_up = margin;
+            }
+        }
+        return;
+    }
+    //nearer child first; a child is only skipped once it cannot beat the runner up either
+    size_t first = node.left;
+    size_t second = node.right;
+    double first_bound = LowerBound(nodes[first], point);
+    double second_bound = LowerBound(nodes[second], point);
+    if (second_bound < first_bound) {
+        std::swap(first, second);
+        std::swap(first_bound, second_bound);
+    }
+    if (first_bound < best.runner_up) {
+        Search(first, point, best);
+    }
+    if (second_bound < best.runner_up) {
+        Search(second, point, best);
+    }
+}
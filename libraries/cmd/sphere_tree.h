@@ -0,0 +1,96 @@
+/*
+ * sphere_tree.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_SPHERE_TREE_H
+#define VEGA_STRIKE_ENGINE_CMD_SPHERE_TREE_H
+
+#include <cstddef>
+#include <vector>
+#include "gfx_generic/vec.h"
+
+/**
+ * Bounding sphere tree over a small, slowly moving set of spheres, such as
+ * the planets of a star system and how far their influence reaches.
+ *
+ * FindNearest returns the sphere whose surface is nearest a point, that is
+ * the least distance to its center minus its reach, visiting O(log n)
+ * nodes for points outside the spheres. The spheres may move: Refit
+ * updates the bounds without rebuilding the tree.
+ */
+class SphereTree {
+public:
+    static const size_t npos;
+
+    struct Nearest {
+        ///npos when the tree is empty
+        size_t index = npos;
+        ///distance from the point to the center of the sphere, minus its reach
+        double margin = 0;
+        ///margin of the next nearest sphere, or a huge value when there is none
+        double runner_up = 0;
+    };
+
+    void Build(const std::vector<QVector> &centers, const std::vector<double> &reaches);
+
+    ///Moves the spheres to new centers, given in the order they were built with; returns how far the furthest one moved
+    double Refit(const std::vector<QVector> &centers);
+
+    size_t Size() const {
+        return centers.size();
+    }
+
+    Nearest FindNearest(const QVector &point) const;
+
+private:
+    static const size_t kLeafSize = 4;
+
+    struct Node {
+        QVector center;
+        double radius;
+        double max_reach;
+        ///into order
+        size_t begin;
+        size_t end;
+        ///0 for leaves; the right child follows the whole left subtree
+        size_t left;
+        size_t right;
+    };
+
+    size_t BuildNode(size_t begin, size_t end);
+    void Bound(Node &node) const;
+    void Search(size_t node, const QVector &point, Nearest &best) const;
+
+    double LowerBound(const Node &node, const QVector &point) const {
+        return (point - node.center).Magnitude() - node.radius - node.max_reach;
+    }
+
+    std::vector<Node> nodes;
+    std::vector<size_t> order;
+    std::vector<QVector> centers;
+    std::vector<double> reaches;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_SPHERE_TREE_H
@@ -38,6 +38,7 @@
 #include "src/physics.h"
 
 #include "collide2/CSopcodecollider.h"
+#include "cmd/unit_pool.h"
 #include "collide2/csgeom2/optransfrm.h"
 #include "collide2/basecollider.h"
 
@@ -189,6 +190,24 @@ bool Unit::InsideCollideTree(Unit *smaller,
         Vector &smallNormal,
         bool bigasteroid,
         bool smallasteroid) {
+    return InsideCollideTree(csCollisionContext::ForThisThread(),
+            smaller,
+            bigpos,
+            bigNormal,
+            smallpos,
+            smallNormal,
+            bigasteroid,
+            smallasteroid);
+}
+
+bool Unit::InsideCollideTree(csCollisionContext &context,
+        Unit *smaller,
+        QVector &bigpos,
+        Vector &bigNormal,
+        QVector &smallpos,
+        Vector &smallNormal,
+        bool bigasteroid,
+        bool smallasteroid) {
     if (smaller->colTrees == NULL || this->colTrees == NULL) {
         return false;
     }
@@ -198,7 +217,7 @@ bool Unit::InsideCollideTree(Unit *smaller,
     if (smaller->colTrees->usingColTree() == false || this->colTrees->usingColTree() == false) {
         return false;
     }
-    csOPCODECollider::ResetCollisionPairs();
+    context.ResetCollisionPairs();
     Unit *bigger = this;
 
     csReversibleTransform bigtransform(bigger->cumulative_transformation_matrix);
@@ -210,13 +229,28 @@ bool Unit::InsideCollideTree(Unit *smaller,
 
     // Check for shield collisions here prior to checking for mesh on mesh or ray collisions below.
     csOPCODECollider *tmpCol = smaller->colTrees->colTree(smaller, bigger->GetWarpVelocity());
-    if (tmpCol
-            && (tmpCol->Collide(*bigger->colTrees->colTree(bigger,
-                            smaller->GetWarpVelocity()),
-                    &smalltransform,
-                    &bigtransform))) {
-        csCollisionPair *mycollide = csOPCODECollider::GetCollisions();
-        unsigned int numHits = csOPCODECollider::GetCollisionPairCount();
+    const float coherence_tolerance = configuration().physics.collision_coherence_tolerance_flt;
+    bool collided = false;
+    if (tmpCol && coherence_tolerance > 0) {
+        //pairs that keep station (docked, in formation) reuse the last answer while their relative pose holds
+        csCollisionCoherence &coherence = context.Coherence(smaller, UnitPool::Generation(smaller),
+                bigger, UnitPool::Generation(bigger));
+        collided = tmpCol->Collide(context,
+                coherence,
+                *bigger->colTrees->colTree(bigger, smaller->GetWarpVelocity()),
+                &smalltransform,
+                &bigtransform,
+                coherence_tolerance);
+    } else if (tmpCol) {
+        collided = tmpCol->Collide(context,
+                *bigger->colTrees->colTree(bigger,
+                        smaller->GetWarpVelocity()),
+                &smalltransform,
+                &bigtransform);
+    }
+    if (collided) {
+        csCollisionPair *mycollide = context.GetCollisions();
+        unsigned int numHits = context.GetCollisionPairCount();
         if (numHits) {
             smallpos.Set((mycollide[0].a1.x + mycollide[0].b1.x + mycollide[0].c1.x) / 3.0f,
                     (mycollide[0].a1.y + mycollide[0].b1.y + mycollide[0].c1.y) / 3.0f,
@@ -252,7 +286,8 @@ bool Unit::InsideCollideTree(Unit *smaller,
                 break;
             }
             if ((un->Position() - smaller->Position()).Magnitude() <= subrad + rad) {
-                if ((un->InsideCollideTree(smaller,
+                if ((un->InsideCollideTree(context,
+                        smaller,
                         bigpos,
                         bigNormal,
                         smallpos,
@@ -274,7 +309,8 @@ bool Unit::InsideCollideTree(Unit *smaller,
                 break;
             }
             if ((un->Position() - bigger->Position()).Magnitude() <= subrad + rad) {
-                if ((bigger->InsideCollideTree(un,
+                if ((bigger->InsideCollideTree(context,
+                        un,
                         bigpos,
                         bigNormal,
                         smallpos,
@@ -412,6 +448,14 @@ float globQuerySphere(QVector start, QVector end, QVector pos, float radius) {
     *  to tell calling code that the bolt should stop at a given point.
 */
 Unit *Unit::rayCollide(const QVector &start, const QVector &end, Vector &norm, float &distance) {
+    return rayCollide(csCollisionContext::ForThisThread(), start, end, norm, distance);
+}
+
+Unit *Unit::rayCollide(csCollisionContext &context,
+        const QVector &start,
+        const QVector &end,
+        Vector &norm,
+        float &distance) {
     Unit *tmp;
     float rad = this->rSize();
     if ((!SubUnits.empty()) && graphicOptions.RecurseIntoSubUnitsOnCollision) {
@@ -426,7 +470,7 @@ Unit *Unit::rayCollide(const QVector &start, const QVector &end, Vector &norm, f
         if (!SubUnits.empty()) {
             un_fiter i(SubUnits.fastIterator());
             for (Unit *un; (un = *i); ++i) {
-                if ((tmp = un->rayCollide(start, end, norm, distance)) != 0) {
+                if ((tmp = un->rayCollide(context, start, end, norm, distance)) != 0) {
                     return tmp;
                 }
             }
@@ -454,7 +498,7 @@ Unit *Unit::rayCollide(const QVector &start, const QVector &end, Vector &norm, f
 
                 return this;
             }
-            if (tmpCol->rayCollide(boltbeam, norm, distance)) {
+            if (tmpCol->rayCollide(context, boltbeam, norm, distance)) {
                 // compute real distance
                 distance = (end - start).Magnitude() * distance;
 
@@ -475,6 +519,23 @@ Unit *Unit::rayCollide(const QVector &start, const QVector &end, Vector &norm, f
     return (NULL);
 }
 
+bool Unit::capsuleMayCollide(csCollisionContext &context, const QVector &start, const QVector &end, float radius) {
+    if (!SubUnits.empty() && graphicOptions.RecurseIntoSubUnitsOnCollision) {
+        return true;
+    }
+    if (!colTrees || configuration().physics.sphere_collision) {
+        return true;
+    }
+    csOPCODECollider *tmpCol = colTrees->colTree(this, this->GetWarpVelocity());
+    if (tmpCol == NULL) {
+        return true;
+    }
+    QVector st(InvTransform(cumulative_transformation_matrix, start));
+    QVector ed(InvTransform(cumulative_transformation_matrix, end));
+    Opcode::Segment segment(Opcode::Point(st.i, st.j, st.k), Opcode::Point(ed.i, ed.j, ed.k));
+    return tmpCol->lssCollide(context, Opcode::LSS(segment, radius));
+}
+
 bool Unit::querySphere(const QVector &pnt, float err) const {
     unsigned int i;
     const Matrix *tmpo = &cumulative_transformation_matrix;
@@ -40,6 +40,7 @@
 #include "gfx_generic/quaternion.h"
 #include "cmd/role_bitmask.h"
 #include "cmd/unit_csv.h"
+#include "cmd/asteroid.h"
 #include <algorithm>
 #include <boost/json/array.hpp>
 #include <boost/json/value_from.hpp>
@@ -353,6 +354,8 @@ static void AddSubUnits(Unit *thus,
         int faction,
         const std::string &modification) {
     vector<SubUnitStruct> su = GetSubUnits(subunits);
+    //an asteroid field being loaded keeps its plain rocks as data, building one unit per rock file
+    AsteroidRocks *rocks = thus->isSubUnit() ? nullptr : AsteroidRocks::TakeLoading();
     xml.units.reserve(subunits.size() + xml.units.size());
     for (vector<SubUnitStruct>::iterator i = su.begin(); i != su.end(); ++i) {
         string filename = (*i).filename;
@@ -360,6 +363,9 @@ static void AddSubUnits(Unit *thus,
         QVector Q = (*i).Q;
         QVector R = (*i).R;
         double restricted = (*i).restricted;
+        if (rocks && rocks->Add(filename, pos * xml.unitscale, Q, R)) {
+            continue;
+        }
         xml.units
                 .push_back(new Unit(filename.c_str(),
                         true,
@@ -384,6 +390,9 @@ static void AddSubUnits(Unit *thus,
             xml.units.back()->pImage->unitwriter->setName(filename);
         }
         CheckAccessory(xml.units.back());         //turns on the ceerazy rotation for the turr
+        if (rocks && rocks->Adopt(xml.units.back())) {
+            xml.units.pop_back();
+        }
     }
     for (int a = xml.units.size() - 1; a >= 0; a--) {
         const bool random_spawn = xml.units[a]->name.get().find("randomspawn") != string::npos;
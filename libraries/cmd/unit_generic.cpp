@@ -32,6 +32,7 @@
 #include "cmd/unit_generic.h"
 
 #include <set>
+#include <unordered_set>
 #include "root_generic/configxml.h"
 #include "src/audiolib.h"
 #include "cmd/base.h"
@@ -46,6 +47,7 @@
 #include "src/universe_util.h"
 #include "cmd/unit_util.h"
 #include "cmd/script/mission.h"
+#include "cmd/script/mission_scheduler.h"
 #include "cmd/script/flightgroup.h"
 #include "cmd/ai/fire.h"
 #include "cmd/ai/turretai.h"
@@ -1427,6 +1429,10 @@ float Unit::ExplosionRadius() {
 }
 
 void Unit::ProcessDeleteQueue() {
+    //A unit killed with no references and then released again is queued
+    //twice; its slot is not reused before Reclaim(), so the address is
+    //enough to tell.
+    std::unordered_set<Unit *> deleted;
     while (!unit_delete_queue.empty()) {
 #ifdef DESTRUCTDEBUG
         VS_LOG_AND_FLUSH(trace, (boost::format("Eliminatin' %1$x - %2$d") % unit_delete_queue.back() % unit_delete_queue.size()));
@@ -1441,6 +1447,9 @@ void Unit::ProcessDeleteQueue() {
 #endif
         Unit *mydeleter = unit_delete_queue.back();
         unit_delete_queue.pop_back();
+        if (!deleted.insert(mydeleter).second) {
+            continue;
+        }
 
         // Avoid segfault when the unit getting destroyed is the player's current target
         Unit* parent = _Universe->AccessCockpit()->GetParent();
@@ -1455,6 +1464,19 @@ void Unit::ProcessDeleteQueue() {
         VS_LOG_AND_FLUSH(trace, (boost::format("Completed %1$d") % unit_delete_queue.size()));
 #endif
     }
+    //only now may the freed slots be handed out to new units
+    UnitPool::Reclaim();
+    if (!deleted.empty()) {
+        VS_LOG(trace, (boost::format("Reclaimed %1% units") % deleted.size()));
+    }
+}
+
+void *Unit::operator new(size_t size) {
+    return UnitPool::Allocate(size);
+}
+
+void Unit::operator delete(void *ptr, size_t size) {
+    UnitPool::Release(ptr, size);
 }
 
 
@@ -1620,6 +1642,7 @@ bool Unit::Explode(bool drawit, float timeit) {
 
         //notify the director that a ship got destroyed
         mission->DirectorShipDestroyed(this);
+        MissionScheduler::getSingleton()->notify(MissionScheduler::WAKE_ON_UNIT_DEATH);
         disableSubUnits(this);
         this->pImage->timeexplode = 0;
 
@@ -1992,6 +2015,7 @@ int Unit::ForceDock(Unit *utdw, unsigned int whichdockport) {
         docked |= DOCKED;
     }
     pImage->DockedTo.SetUnit(utdw);
+    MissionScheduler::getSingleton()->notify(MissionScheduler::WAKE_ON_DOCKING);
     computer.set_speed = 0;
     if (this == _Universe->AccessCockpit()->GetParent()) {
         this->RestoreGodliness();
@@ -3373,7 +3397,9 @@ void Unit::UpdatePhysics2(const Transformation &trans,
         UnitCollection *uc) {
     Movable::UpdatePhysics2(trans, old_physical_state, accel, difficulty, transmat, cum_vel, lastframe, uc);
 
-    this->AddVelocity(difficulty);
+    if (!pose_integrated) {
+        this->AddVelocity(difficulty);
+    }
 
 #ifdef DEPRECATEDPLANETSTUFF
                                                                                                                             if (planet) {
@@ -3418,12 +3444,12 @@ void Unit::UpdatePhysics2(const Transformation &trans,
 
 
 
-Vector Unit::ResolveForces(const Transformation &trans, const Matrix &transmat) {
+void Unit::PrepareResolveForces() {
 #ifndef PERFRAMESOUND
     //AUDAdjustSound( this->sound->engine, this->cumulative_transformation.position, this->cumulative_velocity );
     adjustSound(SoundType::engine);
 #endif
-    return Movable::ResolveForces(trans, transmat);
+    Movable::PrepareResolveForces();
 }
 
 void Unit::UpdatePhysics3(const Transformation &trans,
@@ -3835,6 +3861,7 @@ bool Unit::TransferUnitToSystem(const unsigned int which_jump_queue, StarSystem
         if (JumpCapable::TransferUnitToSystem(pendingjump[which_jump_queue]->dest)) {
             ///eradicating from system, leaving no trace
             ret = true;
+            MissionScheduler::getSingleton()->notify(MissionScheduler::WAKE_ON_SYSTEM_ENTRY);
 
             if (this == _Universe->AccessCockpit()->GetParent()) {
                 VS_LOG(info, "Unit is the active player character...changing scene graph\n");
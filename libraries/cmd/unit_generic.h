@@ -45,6 +45,7 @@
 #include "cmd/jump_capable.h"
 
 #include "cmd/mount.h"
+#include "cmd/unit_pool.h"
 #include "damage/damage.h"
 
 #ifdef VS_DEBUG
@@ -103,6 +104,7 @@ class VSSprite;
 class Box;
 class StarSystem;
 struct colTrees;
+class csCollisionContext;
 class Pilot;
 class MissileGeneric;
 class AsteroidGeneric;
@@ -408,6 +410,9 @@ public:
 //Should draw selection box?
 //Process all meshes to be deleted
     static void ProcessDeleteQueue();
+//Units and their subclasses live in UnitPool slabs
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
 //Returns the cockpit name so that the controller may load a new cockpit
     const std::string &getCockpit() const;
 
@@ -595,8 +600,8 @@ public:
     // 0 = not stated, 1 = done
     float ExplodingProgress() const;
 
-    ///Resolves forces of given unit on a physics frame
-    Vector ResolveForces(const Transformation &, const Matrix &) override;
+    ///Adjusts the engine sound as the forces of a physics frame are resolved
+    void PrepareResolveForces() override;
 
 //What's the size of this unit
     float rSize() const {
@@ -772,6 +777,11 @@ public:
 //Shouldn't do anything here - but needed by Python
 //Queries the ray collider with a world space st and end point. Returns the normal and distance on the line of the intersection
     Unit *rayCollide(const QVector &st, const QVector &end, Vector &normal, float &distance);
+//Same, with the OPCODE colliders and scratch state taken from the given context rather than the thread's own
+    virtual Unit *rayCollide(csCollisionContext &context, const QVector &st, const QVector &end, Vector &normal,
+            float &distance);
+//False only when a world space capsule surely misses this unit's own collide tree; units with subunits or no tree always pass
+    bool capsuleMayCollide(csCollisionContext &context, const QVector &st, const QVector &end, float radius);
 
 //fils in corner_min,corner_max and radial_size
 //Uses Box stuff -> only in NetUnit and Unit
@@ -807,6 +817,14 @@ public:
             Vector &smallNormal,
             bool bigasteroid = false,
             bool smallasteroid = false);
+    bool InsideCollideTree(csCollisionContext &context,
+            Unit *smaller,
+            QVector &bigpos,
+            Vector &bigNormal,
+            QVector &smallpos,
+            Vector &smallNormal,
+            bool bigasteroid = false,
+            bool smallasteroid = false);
 //    virtual void reactToCollision( Unit *smaller,
 //                                   const QVector &biglocation,
 //                                   const Vector &bignormal,
@@ -1009,6 +1027,12 @@ inline Unit *UnitContainer::GetUnit() {
 #ifdef CONTAINER_DEBUG
         CheckUnit( unit );
 #endif
+        if (*slot_generation != generation) {
+            //the unit was deleted while we still held it; its slot may hold another unit by now
+            UnitPool::ReportStale(unit, generation);
+            unit = NULL;
+            return unit;
+        }
         if (unit->Killed()) {
             unit->UnRef();
             unit = NULL;
@@ -0,0 +1,202 @@
+/*
+ * unit_pool.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include "cmd/unit_pool.h"
+#include "src/vs_logging.h"
+
+namespace {
+
+const uint32_t SLOT_MAGIC = 0x556e6974; //"Unit"
+const size_t SLOTS_PER_SLAB = 32;
+const size_t SLOT_ALIGN = alignof(std::max_align_t);
+
+struct SlotHeader {
+    uint32_t magic;
+    uint32_t generation;
+    uint32_t size_class;
+    uint32_t live;
+};
+
+static_assert(sizeof(SlotHeader) % SLOT_ALIGN == 0, "unit slots would be misaligned");
+
+struct SizeClass {
+    size_t object_size;
+    std::vector<SlotHeader *> free_slots;
+    std::vector<char *> slabs;
+    size_t live = 0;
+};
+
+//Built on first use and never destroyed, so units created during static
+//initialisation or released during static destruction are still served
+std::vector<SizeClass> &size_classes() {
+    static std::vector<SizeClass> *classes = new std::vector<SizeClass>();
+    return *classes;
+}
+
+struct SlabRange {
+    uintptr_t begin;
+    uintptr_t end;
+    size_t stride;
+};
+
+//Every slab, sorted by address, so a pointer can be checked without reading the memory in front of it
+std::vector<SlabRange> &slab_ranges() {
+    static std::vector<SlabRange> *ranges = new std::vector<SlabRange>();
+    return *ranges;
+}
+
+std::vector<SlotHeader *> &pending_slots() {
+    static std::vector<SlotHeader *> *pending = new std::vector<SlotHeader *>();
+    return *pending;
+}
+
+inline size_t round_up(size_t size) {
+    return (size + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+}
+
+//the header of the slot whose object starts at ptr, or nullptr if ptr is not the start of a pooled object
+SlotHeader *header_of(const void *ptr) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    const std::vector<SlabRange> &ranges = slab_ranges();
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), address, [](uintptr_t value, const SlabRange &range) {
+        return value < range.begin;
+    });
+    if (it == ranges.begin()) {
+        return nullptr;
+    }
+    --it;
+    if (address >= it->end || (address - it->begin) % it->stride != sizeof(SlotHeader)) {
+        return nullptr;
+    }
+    return reinterpret_cast<SlotHeader *>(address - sizeof(SlotHeader));
+}
+
+SizeClass &size_class_for(size_t object_size, uint32_t &index) {
+    for (index = 0; index < size_classes().size(); ++index) {
+        if (size_classes()[index].object_size == object_size) {
+            return size_classes()[index];
+        }
+    }
+    size_classes().emplace_back();
+    size_classes().back().object_size = object_size;
+    return size_classes().back();
+}
+
+void grow(SizeClass &sc, uint32_t index) {
+    const size_t stride = sizeof(SlotHeader) + sc.object_size;
+    char *slab = static_cast<char *>(::operator new(stride * SLOTS_PER_SLAB));
+    sc.slabs.push_back(slab);
+    const SlabRange range{reinterpret_cast<uintptr_t>(slab), reinterpret_cast<uintptr_t>(slab) + stride * SLOTS_PER_SLAB,
+            stride};
+    std::vector<SlabRange> &ranges = slab_ranges();
+    ranges.insert(std::upper_bound(ranges.begin(), ranges.end(), range, [](const SlabRange &a, const SlabRange &b) {
+        return a.begin < b.begin;
+    }), range);
+    //push in reverse so slots are handed out in address order
+    for (size_t i = SLOTS_PER_SLAB; i-- > 0;) {
+        SlotHeader *header = reinterpret_cast<SlotHeader *>(slab + i * stride);
+        header->magic = SLOT_MAGIC;
+        header->generation = 1;
+        header->size_class = index;
+        header->live = 0;
+        sc.free_slots.push_back(header);
+    }
+}
+
+} //namespace
+
+void *UnitPool::Allocate(size_t size) {
+    uint32_t index;
+    SizeClass &sc = size_class_for(round_up(size), index);
+    if (sc.free_slots.empty()) {
+        grow(sc, index);
+    }
+    SlotHeader *header = sc.free_slots.back();
+    sc.free_slots.pop_back();
+    header->live = 1;
+    ++sc.live;
+    return header + 1;
+}
+
+void UnitPool::Release(void *ptr, size_t) {
+    if (ptr == nullptr) {
+        return;
+    }
+    SlotHeader *header = header_of(ptr);
+    if (header == nullptr || header->magic != SLOT_MAGIC || !header->live) {
+        VS_LOG_AND_FLUSH(fatal, (boost::format("UnitPool::Release(): %1% is not a live unit slot") % ptr));
+        return;
+    }
+    header->live = 0;
+    //0 is reserved for "not pooled"
+    if (++header->generation == 0) {
+        header->generation = 1;
+    }
+    --size_classes()[header->size_class].live;
+    pending_slots().push_back(header);
+}
+
+void UnitPool::Reclaim() {
+    for (SlotHeader *header : pending_slots()) {
+        size_classes()[header->size_class].free_slots.push_back(header);
+    }
+    pending_slots().clear();
+}
+
+uint32_t UnitPool::Generation(const void *ptr) {
+    if (ptr == nullptr) {
+        return 0;
+    }
+    const SlotHeader *header = header_of(ptr);
+    return header ? header->generation : 0;
+}
+
+const uint32_t *UnitPool::GenerationWord(const void *ptr) {
+    static const uint32_t not_pooled = 0;
+    const SlotHeader *header = ptr ? header_of(ptr) : nullptr;
+    return header ? &header->generation : &not_pooled;
+}
+
+void UnitPool::ReportStale(const void *ptr, uint32_t expected) {
+    VS_LOG(error, (boost::format("Stale unit reference to %1%: generation %2%, slot is now at %3%")
+            % ptr % expected % Generation(ptr)));
+}
+
+UnitPool::Stats UnitPool::GetStats() {
+    Stats stats;
+    stats.size_classes = size_classes().size();
+    for (const SizeClass &sc : size_classes()) {
+        stats.slabs += sc.slabs.size();
+        stats.live += sc.live;
+        stats.free += sc.free_slots.size();
+    }
+    stats.pending = pending_slots().size();
+    return stats;
+}
@@ -0,0 +1,72 @@
+/*
+ * unit_pool.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_UNIT_POOL_H
+#define VEGA_STRIKE_ENGINE_CMD_UNIT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Slab allocator backing operator new/delete of Unit and its subclasses.
+ *
+ * Slots are segregated by object size, so each unit class (Missile, Planet,
+ * Asteroid, ...) recycles memory of its own shape instead of fragmenting the
+ * general heap. Every slot carries a generation counter just in front of the
+ * object; it is bumped when the unit is destroyed, which lets a UnitContainer
+ * tell that the unit it points at is gone. Pointers are looked up in the slab
+ * address ranges first, so units living outside the pool (statics, members)
+ * simply have no generation. Freed slots are only handed out
+ * again after Reclaim(), at the end of the frame.
+ */
+class UnitPool {
+public:
+    struct Stats {
+        size_t size_classes = 0;
+        size_t slabs = 0;
+        size_t live = 0;
+        size_t free = 0;
+        size_t pending = 0;
+    };
+
+    static void *Allocate(size_t size);
+    /// destroys nothing; marks the slot dead and queues it for Reclaim()
+    static void Release(void *ptr, size_t size);
+    /// makes the slots released since the last call available again
+    static void Reclaim();
+
+    /// generation of the slot holding ptr, or 0 if ptr does not come from the pool
+    static uint32_t Generation(const void *ptr);
+    /// where the generation of the slot holding ptr is kept, for checking it again without the lookup;
+    /// slabs are never freed, so it stays valid. Points at a 0 if ptr does not come from the pool
+    static const uint32_t *GenerationWord(const void *ptr);
+    /// logs a reference to a unit whose slot was recycled under it
+    static void ReportStale(const void *ptr, uint32_t expected);
+
+    static Stats GetStats();
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_UNIT_POOL_H
@@ -31,6 +31,7 @@
 #include <string>
 #include "cmd/unit_generic.h"
 #include "cmd/unit_util.h"
+#include "cmd/physics_priority.h"
 #include "root_generic/configxml.h"
 #include "root_generic/vs_globals.h"
 #include "gfx_generic/cockpit_generic.h"
@@ -113,217 +114,7 @@ bool hasDockingUnits(const Unit *my_unit) {
 }
 
 uint_fast32_t getPhysicsPriority(Unit *un) {
-    const bool FORCE_TOP_PRIORITY = configuration().physics.priorities.force_top_priority;
-    if (FORCE_TOP_PRIORITY) {
-        return 1;
-    }
-    //Some other comment mentions these need special treatment for subunit scheduling
-    const uint_fast32_t PLAYER_PRIORITY = configuration().physics.priorities.player;
-    const uint_fast32_t MISSILE_PRIORITY = configuration().physics.priorities.missile;
-    const uint_fast32_t DOCKABLE_PRIORITY = configuration().physics.priorities.dockable;
-
-    float rad = un->rSize();
-    Vega_UnitType untype = un->getUnitType();
-    float cpdist = FLT_MAX;
-    float tooclose = 0;
-    unsigned int np = _Universe->numPlayers();
-    Cockpit *cockpit = _Universe->AccessCockpit();
-    //const float     fixed_system_orbit_priorities =
-    //    configuration().physics.fixed_system_priority_velocity_cutoff;
-    const uint_fast32_t SYSTEM_INSTALLATION_PRIORITY = configuration().physics.priorities.system_installation;
-    bool system_installation = un->owner == getTopLevelOwner();
-    //if (system_installation && un->Velocity.MagnitudeSquared() > fixed_system_orbit_priorities*fixed_system_orbit_priorities)
-    //    force_system_installation_priority = true;
-    for (unsigned int i = 0; i < np; ++i) {
-        Unit *player = _Universe->AccessCockpit(i)->GetParent();
-        if (player) {
-            bool force_system_installation_priority = true;
-            if (force_system_installation_priority && player->activeStarSystem == un->activeStarSystem) {
-                return SYSTEM_INSTALLATION_PRIORITY;
-            }
-            if (un == player->Target()) {
-                return PLAYER_PRIORITY;
-            }
-            float tmpdist = UnitUtil::getDistance(un, player);
-            if (tmpdist < cpdist) {
-                QVector relvel = un->GetVelocity() - player->GetVelocity();
-                QVector relpos = un->Position() - player->Position();
-                cockpit = _Universe->AccessCockpit(i);
-                cpdist = tmpdist;
-                float lowest_priority_time = SIM_QUEUE_SIZE * SIMULATION_ATOM;
-                if (relpos.Dot(relvel) >= 0) {
-                    //No need to be wary if they're getting away
-                    tooclose =
-                            2 * (un->radial_size + player->radial_size)
-                                    + relvel.Magnitude() * lowest_priority_time;
-                }
-            }
-        }
-#ifndef NO_GFX
-        Camera *cam = _Universe->AccessCockpit(i)->AccessCamera();
-        if (cam) {
-            QVector relvel = un->GetVelocity() - cam->GetVelocity();
-            QVector relpos = un->Position() - cam->GetPosition();
-            double dist = relpos.Magnitude() - rad;
-            if (dist < cpdist) {
-                cpdist = dist;
-                Unit *parent = _Universe->AccessCockpit(i)->GetParent();
-                float lowest_priority_time = SIM_QUEUE_SIZE * SIMULATION_ATOM;
-                if (relpos.Dot(relvel) >= 0) {
-                    //No need to be wary if they're getting away
-                    tooclose =
-                            2 * (un->radial_size + (parent ? parent->radial_size : 0))
-                                    + relvel.Magnitude() * lowest_priority_time;
-                }
-            }
-        }
-#endif
-        if (player == un) {
-            return PLAYER_PRIORITY;
-        }
-    }
-    if (untype == Vega_UnitType::missile) {
-        return MISSILE_PRIORITY;
-    }
-    if (hasDockingUnits(un)) {
-        return DOCKABLE_PRIORITY;
-    }
-    const uint_fast32_t ASTEROID_PARENT_PRIORITY = configuration().physics.priorities.asteroid_parent;
-    const uint_fast32_t ASTEROID_HIGH_PRIORITY = configuration().physics.priorities.asteroid_high;
-    //const int ASTEROID_LOW_PRIORITY = configuration().physics.priorities.asteroid_low;
-    const uint_fast32_t HIGH_PRIORITY = configuration().physics.priorities.high;
-    const uint_fast32_t MEDIUMHIGH_PRIORITY = configuration().physics.priorities.medium_high;
-    const uint_fast32_t MEDIUM_PRIORITY = configuration().physics.priorities.medium;
-    const uint_fast32_t LOW_PRIORITY = configuration().physics.priorities.low;
-    const uint_fast32_t NOT_VISIBLE_COMBAT_HIGH = configuration().physics.priorities.not_visible_combat_high;
-    const uint_fast32_t NOT_VISIBLE_COMBAT_MEDIUM = configuration().physics.priorities.not_visible_combat_medium;
-    const uint_fast32_t NOT_VISIBLE_COMBAT_LOW = configuration().physics.priorities.not_visible_combat_low;
-    const uint_fast32_t NO_ENEMIES = configuration().physics.priorities.no_enemies;
-    const uint_fast32_t INERT_PRIORITY = configuration().physics.priorities.inert;
-    const double _PLAYERTHREAT_DISTANCE_FACTOR = configuration().physics.priorities.player_threat_distance_factor_dbl;
-    const double _THREAT_DISTANCE_FACTOR = configuration().physics.priorities.threat_distance_factor_dbl;
-    const double DYNAMIC_THROTTLE_MINFACTOR = configuration().physics.priorities.dynamic_throttle.min_distance_factor_dbl;
-    const double DYNAMIC_THROTTLE_MAXFACTOR = configuration().physics.priorities.dynamic_throttle.max_distance_factor_dbl;
-    const double DYNAMIC_THROTTLE_TARGETFPS = configuration().physics.priorities.dynamic_throttle.target_fps_dbl;
-    const double DYNAMIC_THROTTLE_TARGETELAPSEDTIME = 1.0 / DYNAMIC_THROTTLE_TARGETFPS;
-    static double DYNAMIC_THROTTLE_FACTOR = 1.0;
-    static double lastThrottleAdjust = 0.0;
-    if (UniverseUtil::GetGameTime() != lastThrottleAdjust) {
-        lastThrottleAdjust = UniverseUtil::GetGameTime();
-        double newfactor = DYNAMIC_THROTTLE_FACTOR * DYNAMIC_THROTTLE_TARGETELAPSEDTIME / GetElapsedTime();
-        newfactor = mymax(DYNAMIC_THROTTLE_MINFACTOR, mymin(DYNAMIC_THROTTLE_MAXFACTOR, newfactor));
-        DYNAMIC_THROTTLE_FACTOR = (newfactor * GetElapsedTime() + DYNAMIC_THROTTLE_FACTOR) / (1.0 + GetElapsedTime());
-    }
-    const double PLAYERTHREAT_DISTANCE_FACTOR = _PLAYERTHREAT_DISTANCE_FACTOR * DYNAMIC_THROTTLE_FACTOR;
-    const double THREAT_DISTANCE_FACTOR = _THREAT_DISTANCE_FACTOR * DYNAMIC_THROTTLE_FACTOR;
-    Unit *parent = cockpit->GetParent();
-    float gun_range = 0;
-    float missile_range = 0;
-    float dist = cpdist;
-    if (parent) {
-        float speed = 0;
-        parent->getAverageGunSpeed(speed, gun_range, missile_range);
-    }
-    const int cargofac = FactionUtil::GetFactionIndex("cargo");
-    int upfac = FactionUtil::GetUpgradeFaction();
-    int neutral = FactionUtil::GetNeutralFaction();
-    if (un->schedule_priority != Unit::scheduleDefault) {
-        //Asteroids do scheduling themselves within subunits, so...
-        //...only one caveat: units with their own internal scheduling
-        //must have constant priority... otherwise, big mess when changing
-        //priorities. I'll think of one way to overcome this...
-        switch (un->schedule_priority) {
-            case Unit::scheduleDefault:
-                break;
-            case Unit::scheduleAField:
-                return ASTEROID_PARENT_PRIORITY;
-
-            case Unit::scheduleRoid:
-                //if (dist < tooclose)
-                return ASTEROID_HIGH_PRIORITY;
-                //else
-                //return ASTEROID_LOW_PRIORITY;
-        }
-    }
-    if (UnitUtil::isAsteroid(un)) {
-        //some mods don't do the scheduling--still want correctness
-        const std::string blah = configuration().physics.priorities.min_asteroid_distance;
-        //static float too_close_asteroid = (blah == "none") ? tooclose : XMLSupport::parse_float( blah );
-        //if (dist < too_close_asteroid)
-        return ASTEROID_HIGH_PRIORITY;
-        //else
-        //return ASTEROID_LOW_PRIORITY;
-    }
-    Unit *targ = un->Target();
-    if (targ && targ->IsPlayerShip()) {
-        if (un->isJumppoint()) {
-            return PLAYER_PRIORITY;
-        } else if (UnitUtil::getDistance(targ, un) <= PLAYERTHREAT_DISTANCE_FACTOR * mymax(gun_range, missile_range)) {
-            return HIGH_PRIORITY;
-        } else { //Needs to accurately collide with it...
-            return MEDIUMHIGH_PRIORITY;
-        }
-    }
-    if (un->graphicOptions.WarpRamping || un->graphicOptions.RampCounter != 0) {
-        const float compwarprampuptime = configuration().physics.computer_warp_ramp_up_time_flt; //for the heck of it.  NOTE, variable also in unit_generic.cpp
-        const float warprampdowntime = configuration().physics.warp_ramp_down_time_flt;
-        float lowest_priority_time = SIM_QUEUE_SIZE * SIMULATION_ATOM;
-
-        float time_ramped = compwarprampuptime - un->graphicOptions.RampCounter;
-        if (!un->ftl_drive.Enabled()) {
-            time_ramped = warprampdowntime - un->graphicOptions.RampCounter;
-        }
-        if (un->graphicOptions.WarpRamping || time_ramped < lowest_priority_time) {
-            return MEDIUM_PRIORITY;
-        }
-        if (dist < gun_range) {
-            return MEDIUM_PRIORITY;
-        }
-        if (time_ramped < lowest_priority_time * 2) {
-            return LOW_PRIORITY;
-        }
-        //else defer decision
-    }
-    if (system_installation || un->faction == cargofac || un->faction == upfac || un->faction == neutral) {
-        if (dist < tooclose) {
-            return MEDIUM_PRIORITY;
-        } else {
-            if (system_installation) {
-                return SIM_QUEUE_SIZE / ORBIT_PRIORITY;
-            } //so that the averaging can still keep track of parent jumps
-            return INERT_PRIORITY;
-        }
-    }
-    const string &obj = UnitUtil::getFgDirective(un);
-    if (!(obj.length() == 0 || (obj.length() >= 1 && obj[0] == 'b'))) {
-        return MEDIUM_PRIORITY;
-    }
-    if (dist < 2 * PLAYERTHREAT_DISTANCE_FACTOR * mymax(missile_range, gun_range)) {
-        if (dist < tooclose * PLAYERTHREAT_DISTANCE_FACTOR) {
-            return MEDIUMHIGH_PRIORITY;
-        } else if (dist < 2 * gun_range * PLAYERTHREAT_DISTANCE_FACTOR) {
-            return MEDIUM_PRIORITY;
-        } else {
-            return LOW_PRIORITY;
-        }
-    }
-    if (targ) {
-        float speed;
-        un->getAverageGunSpeed(speed, gun_range, missile_range);
-        double distance = UnitUtil::getDistance(un, targ);
-        if (distance <= 2.0 * static_cast<double>(gun_range) * THREAT_DISTANCE_FACTOR) {
-            return NOT_VISIBLE_COMBAT_HIGH;
-        }
-        if (distance < 2.0 * static_cast<double>(missile_range) * THREAT_DISTANCE_FACTOR) {
-            return NOT_VISIBLE_COMBAT_MEDIUM;
-        }
-        return NOT_VISIBLE_COMBAT_LOW;
-    }
-    if (dist < tooclose * THREAT_DISTANCE_FACTOR) {
-        return MEDIUMHIGH_PRIORITY;
-    } else { //May not have weapons (hence missile_range|gun_range == 0)
-        return NO_ENEMIES;
-    }
+    return PhysicsPriorityService::getSingleton()->Evaluate(un);
 }
 
 void orbit(Unit *my_unit, Unit *orbitee, float speed, QVector R, QVector S, QVector center) {
@@ -0,0 +1,161 @@
+/*
+ * warp_field.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "cmd/warp_field.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cmd/collection.h"
+#include "cmd/unit_generic.h"
+#include "cmd/unit_pool.h"
+#include "configuration/configuration.h"
+
+//cached answers not asked for in this many atoms are dropped
+static const unsigned int kCacheIdleFrames = 256;
+
+void WarpFieldService::Refresh(UnitCollection &gravitational_units) {
+    config.min_warp_effect_size = configuration().physics.min_warp_effect_size_flt;
+    config.max_warp_effect_size = configuration().physics.max_warp_effect_size_flt;
+    config.warp_region0 = configuration().physics.warp_region0_dbl;
+    config.warp_region1 = configuration().physics.warp_region1_dbl;
+    config.curve_degree = configuration().physics.warp_curve_degree_dbl;
+    //so the curve reaches the cruise multiplier at the region 1-2 boundary
+    config.upcurvek = configuration().physics.warp_cruise_mult_dbl
+            / std::pow(config.warp_region1 - config.warp_region0, config.curve_degree);
+    config.def_inv_interdiction = 1.0 / configuration().physics.default_interdiction_flt;
+    config.planet_radius_percent = configuration().physics.auto_pilot_planet_radius_percent_flt;
+    config.warp_multiplier_min = configuration().warp.warp_multiplier_min_flt;
+    config.warp_multiplier_max = configuration().warp.warp_multiplier_max_flt;
+    config.max_effective_velocity = configuration().warp.max_effective_velocity_flt;
+    config.all_wells = configuration().physics.warp_all_wells;
+
+    artificial_wells.clear();
+    found_wells.clear();
+    Unit *unit;
+    for (un_fiter iter = gravitational_units.fastIterator(); (unit = *iter); ++iter) {
+        if (unit->Killed()) {
+            continue;
+        }
+        if (!unit->isPlanet()) {
+            artificial_wells.push_back(unit);
+            continue;
+        }
+        //the surface the SPEC curve starts from, plus how far beyond it the planet still pulls ships out of warp
+        const double radius = unit->rSize();
+        const double reach = radius * (1.0 + config.planet_radius_percent)
+                + std::min(std::max(radius, static_cast<double>(config.min_warp_effect_size))
+                        * (1.0 + config.planet_radius_percent),
+                        static_cast<double>(config.max_warp_effect_size));
+        found_wells.push_back(Well{unit, UnitPool::Generation(unit), unit->Position(), reach});
+    }
+    UpdateWells(found_wells);
+}
+
+void WarpFieldService::UpdateWells(const std::vector<Well> &planets) {
+    ++frame;
+    bool changed = false;
+    size_t count = 0;
+    for (const Well &planet : planets) {
+        if (count == wells.size()) {
+            wells.push_back(planet.unit);
+            well_generations.push_back(planet.generation);
+            well_centers.push_back(planet.center);
+            well_reaches.push_back(planet.reach);
+            changed = true;
+        } else {
+            changed = changed || wells[count] != planet.unit || well_generations[count] != planet.generation
+                    || well_reaches[count] != planet.reach;
+            wells[count] = planet.unit;
+            well_generations[count] = planet.generation;
+            well_centers[count] = planet.center;
+            well_reaches[count] = planet.reach;
+        }
+        ++count;
+    }
+    if (count != wells.size()) {
+        wells.resize(count);
+        well_generations.resize(count);
+        well_centers.resize(count);
+        well_reaches.resize(count);
+        changed = true;
+    }
+
+    if (changed) {
+        ++version;
+        Rebuild();
+    } else if (!wells.empty()) {
+        total_drift += tree.Refit(well_centers);
+        //refitting keeps the answers right, but the split gets worse as the planets wander off from it
+        if (total_drift - build_drift > *std::max_element(well_reaches.begin(), well_reaches.end())) {
+            Rebuild();
+        }
+    }
+    if (frame % kCacheIdleFrames == 0) {
+        PruneCache();
+    }
+}
+
+void WarpFieldService::Rebuild() {
+    tree.Build(well_centers, well_reaches);
+    build_drift = total_drift;
+}
+
+void WarpFieldService::PruneCache() {
+    for (auto i = cache.begin(); i != cache.end();) {
+        if (frame - i->second.last_frame > kCacheIdleFrames) {
+            i = cache.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+Unit *WarpFieldService::NearestWell(const Unit *unit) {
+    if (wells.empty()) {
+        return nullptr;
+    }
+    return wells[NearestWellIndex(unit, UnitPool::Generation(unit), unit->Position())];
+}
+
+size_t WarpFieldService::NearestWellIndex(const Unit *unit, uint32_t generation, const QVector &position) {
+    CachedWell &entry = cache[unit];
+    entry.last_frame = frame;
+    //every margin changes by at most how far the unit and the planets moved, so the
+    //nearest stays the nearest until that adds up to half the gap to the runner up
+    if (entry.well != SphereTree::npos && entry.version == version && entry.generation == generation
+            && (position - entry.position).Magnitude() + (total_drift - entry.drift) < entry.valid_radius) {
+        return entry.well;
+    }
+    const SphereTree::Nearest nearest = tree.FindNearest(position);
+    entry.generation = generation;
+    entry.well = nearest.index;
+    entry.position = position;
+    entry.valid_radius = 0.5 * (nearest.runner_up - nearest.margin);
+    entry.drift = total_drift;
+    entry.version = version;
+    return nearest.index;
+}
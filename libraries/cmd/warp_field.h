@@ -0,0 +1,142 @@
+/*
+ * warp_field.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_WARP_FIELD_H
+#define VEGA_STRIKE_ENGINE_CMD_WARP_FIELD_H
+
+#include <cstdint>
+#include <vector>
+
+#include "cmd/sphere_tree.h"
+#include "src/gnuhash.h"
+
+class Unit;
+class UnitCollection;
+
+/**
+ * Per star system answer to "which celestial body limits this ship's SPEC".
+ *
+ * Once per sim atom Refresh puts the planets (and jump points) into a
+ * SphereTree, each with the reach of its warp influence, and reads the warp
+ * configuration CalculateNearestWarpUnit and GetMaxWarpFieldStrength need.
+ * NearestWell then finds the limiting planet in O(log n), and remembers it
+ * per unit: the answer cannot change until the unit, or the planets, have
+ * moved half the gap between the nearest and the next nearest planet, so a
+ * cruising ship only repeats the tree search every so often.
+ *
+ * Gravitational units that are not planets (asteroid fields) have an
+ * interdiction that may be switched at any time, so they are only listed,
+ * to be evaluated directly by the caller.
+ */
+class WarpFieldService {
+public:
+    struct Params {
+        float min_warp_effect_size = 0;
+        float max_warp_effect_size = 0;
+        ///boundary between multiplier regions 0 (mult=1) and 1
+        double warp_region0 = 0;
+        ///boundary between multiplier regions 1 and 2 ("high" mult)
+        double warp_region1 = 0;
+        ///coefficient and degree of the multiplier curve in region 1
+        double upcurvek = 0;
+        double curve_degree = 0;
+        ///inverse fractional effect of ship vs real big object
+        float def_inv_interdiction = 1;
+        float planet_radius_percent = 0;
+        float warp_multiplier_min = 1;
+        float warp_multiplier_max = 1;
+        float max_effective_velocity = 0;
+        ///limit SPEC by every planet, not only the first one, when no ship is near
+        bool all_wells = false;
+    };
+
+    struct Well {
+        Unit *unit;
+        uint32_t generation;
+        QVector center;
+        ///how far the planet's warp influence reaches from its center
+        double reach;
+    };
+
+    /// rereads the warp configuration and refits (or rebuilds) the tree over the system's planets
+    void Refresh(UnitCollection &gravitational_units);
+    /// once per atom: refits the tree to the planets, or rebuilds it if they are not the ones it holds
+    void UpdateWells(const std::vector<Well> &planets);
+
+    const Params &params() const {
+        return config;
+    }
+
+    /// the planet whose warp influence is nearest the unit, or nullptr if there is none
+    Unit *NearestWell(const Unit *unit);
+    /// index in Wells() of the planet nearest position, for the unit (or any key) at that position;
+    /// the wells must not be empty
+    size_t NearestWellIndex(const Unit *unit, uint32_t generation, const QVector &position);
+
+    /// all planets in the tree, for callers that are themselves one of them
+    const std::vector<Unit *> &Wells() const {
+        return wells;
+    }
+
+    /// the gravitational units that are not planets
+    const std::vector<Unit *> &ArtificialWells() const {
+        return artificial_wells;
+    }
+
+private:
+    struct CachedWell {
+        uint32_t generation = 0;
+        size_t well = SphereTree::npos;
+        QVector position;
+        double valid_radius = 0;
+        double drift = 0;
+        unsigned int version = 0;
+        unsigned int last_frame = 0;
+    };
+
+    void Rebuild();
+    void PruneCache();
+
+    Params config;
+    ///the planets Refresh found, kept for their capacity
+    std::vector<Well> found_wells;
+    SphereTree tree;
+    std::vector<Unit *> wells;
+    std::vector<uint32_t> well_generations;
+    std::vector<QVector> well_centers;
+    std::vector<double> well_reaches;
+    std::vector<Unit *> artificial_wells;
+    ///bumped whenever the tree is rebuilt, which invalidates every cached answer
+    unsigned int version = 0;
+    unsigned int frame = 0;
+    ///how far the planets have moved in total, as an upper bound
+    double total_drift = 0;
+    ///total_drift when the tree was last built
+    double build_drift = 0;
+    vsUMap<const Unit *, CachedWell> cache;
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_WARP_FIELD_H
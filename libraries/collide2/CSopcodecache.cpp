@@ -0,0 +1,197 @@
+/*
+ * CSopcodecache.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "collide2/CSopcodecache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "src/vs_logging.h"
+
+using namespace Opcode;
+
+namespace {
+//bump whenever the image layout or the tree build settings change
+const uint32_t CACHE_VERSION = 1;
+const char CACHE_MAGIC[4] = {'V', 'S', 'O', 'C'};
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t triangles;
+    uint32_t vertices;
+    uint32_t rules;
+    uint32_t image_size;
+};
+
+std::string cache_directory;
+//any thread building a collider may load or store, so the counters are atomic
+struct CacheCounters {
+    std::atomic<unsigned int> hits{0};
+    std::atomic<unsigned int> misses{0};
+    std::atomic<unsigned int> stores{0};
+    std::atomic<unsigned int> rejected{0};
+};
+CacheCounters cache_stats;
+
+void Count(std::atomic<unsigned int> &counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+//a name no other process, nor another store in this one, writes to at the same time
+std::string TempFileName(const std::string &file) {
+    static const uint64_t process_tag = (static_cast<uint64_t>(std::random_device()()) << 32)
+            ^ std::random_device()();
+    static std::atomic<uint64_t> counter(0);
+    return (boost::format("%1%.%2$016x.%3%.tmp") % file % process_tag % counter++).str();
+}
+
+void FillHeader(CacheHeader &header, uint64_t key, const OPCODECREATE &create) {
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.triangles = create.mIMesh->GetNbTriangles();
+    header.vertices = create.mIMesh->GetNbVertices();
+    header.rules = create.mSettings.mRules;
+    header.image_size = 0;
+}
+} // namespace
+
+void csOPCODECache::SetDirectory(const std::string &dir) {
+    cache_directory = dir;
+}
+
+const std::string &csOPCODECache::Directory() {
+    return cache_directory;
+}
+
+csOPCODECache::Stats csOPCODECache::GetStats() {
+    Stats stats;
+    stats.hits = cache_stats.hits.load(std::memory_order_relaxed);
+    stats.misses = cache_stats.misses.load(std::memory_order_relaxed);
+    stats.stores = cache_stats.stores.load(std::memory_order_relaxed);
+    stats.rejected = cache_stats.rejected.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string csOPCODECache::FileName(uint64_t key) {
+    char name[24];
+    snprintf(name, sizeof(name), "%016llx.opc", static_cast<unsigned long long>(key));
+    return cache_directory + "/" + name;
+}
+
+uint64_t csOPCODECache::Key(const Point *vertices, uint32_t count) {
+    //FNV-1a over the raw vertex data
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(vertices);
+    const size_t size = static_cast<size_t>(count) * sizeof(Point);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ^ count;
+}
+
+bool csOPCODECache::Load(uint64_t key, const OPCODECREATE &create, Model &model) {
+    if (!Enabled() || !create.mIMesh) {
+        return false;
+    }
+    const std::string file = FileName(key);
+    try {
+        boost::interprocess::file_mapping mapping(file.c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(mapping, boost::interprocess::read_only);
+        const uint8_t *data = static_cast<const uint8_t *>(region.get_address());
+        const size_t size = region.get_size();
+
+        CacheHeader expected;
+        FillHeader(expected, key, create);
+        CacheHeader header;
+        if (size >= sizeof(header)) {
+            memcpy(&header, data, sizeof(header));
+            expected.image_size = header.image_size;
+        }
+        if (size < sizeof(header) || memcmp(&header, &expected, sizeof(header)) != 0
+                || size != sizeof(header) + header.image_size
+                || !model.Load(create, data + sizeof(header), header.image_size)) {
+            VS_LOG(info, (boost::format("Ignoring stale collision tree cache file %1%") % file));
+            Count(cache_stats.rejected);
+            Count(cache_stats.misses);
+            return false;
+        }
+    } catch (const boost::interprocess::interprocess_exception &) {
+        //no cache file yet
+        Count(cache_stats.misses);
+        return false;
+    }
+    Count(cache_stats.hits);
+    return true;
+}
+
+bool csOPCODECache::Store(uint64_t key, const OPCODECREATE &create, const Model &model) {
+    if (!Enabled() || !create.mIMesh) {
+        return false;
+    }
+    std::vector<uint8_t> image(sizeof(CacheHeader));
+    if (!model.Save(image)) {
+        return false;
+    }
+    CacheHeader header;
+    FillHeader(header, key, create);
+    header.image_size = static_cast<uint32_t>(image.size() - sizeof(header));
+    memcpy(image.data(), &header, sizeof(header));
+
+    //write aside and rename, so a reader never maps a half written file
+    const std::string file = FileName(key);
+    const std::string temp = TempFileName(file);
+    {
+        std::ofstream out(temp.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(image.data()), static_cast<std::streamsize>(image.size()));
+        if (!out) {
+            VS_LOG(warning, (boost::format("Could not write collision tree cache file %1%") % temp));
+            out.close();
+            std::remove(temp.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    //rename does not replace an existing file there
+    std::remove(file.c_str());
+#endif
+    if (std::rename(temp.c_str(), file.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    Count(cache_stats.stores);
+    return true;
+}
@@ -0,0 +1,79 @@
+/*
+ * CSopcodecache.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_CMD_COLLSION2_OPCODECACHE_H
+#define VEGA_STRIKE_ENGINE_CMD_COLLSION2_OPCODECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "collide2/Opcode.h"
+
+/**
+ * On-disk cache of built OPCODE collision trees.
+ *
+ * Each tree is stored in its own file, named after a hash of the vertices it
+ * was built from. Colliders are built from already scaled polygons, so the
+ * key covers the mesh and its scale alike. Files are memory mapped on load
+ * and the tree is relocated straight out of the mapping, which skips the
+ * sort-heavy AABB tree build.
+ *
+ * The cache is off until a directory is set.
+ */
+class csOPCODECache {
+public:
+    struct Stats {
+        unsigned int hits = 0;
+        unsigned int misses = 0;
+        unsigned int stores = 0;
+        /// files found but unusable: wrong version, wrong mesh or truncated
+        unsigned int rejected = 0;
+    };
+
+    /// enables the cache in dir, which must exist; an empty dir disables it
+    static void SetDirectory(const std::string &dir);
+    static const std::string &Directory();
+
+    static bool Enabled() {
+        return !Directory().empty();
+    }
+
+    /// key of the tree built from these vertices, three per triangle
+    static uint64_t Key(const Opcode::Point *vertices, uint32_t count);
+
+    /// sets the model up from the cache; false if there is no usable entry for key
+    static bool Load(uint64_t key, const Opcode::OPCODECREATE &create, Opcode::Model &model);
+    /// writes a built model to the cache
+    static bool Store(uint64_t key, const Opcode::OPCODECREATE &create, const Opcode::Model &model);
+
+    /// a snapshot of the counters, which are kept atomically
+    static Stats GetStats();
+
+    static std::string FileName(uint64_t key);
+};
+
+#endif //VEGA_STRIKE_ENGINE_CMD_COLLSION2_OPCODECACHE_H
@@ -31,27 +31,62 @@
 
 #include "collide2/Opcode.h"
 #include "collide2/CSopcodecollider.h"
+#include "collide2/CSopcodecache.h"
 #include "collide2/opcodeqsqrt.h"
+
+#include <algorithm>
 #define _X 1000
 
 #undef _X
 
 using namespace Opcode;
 
-static std::vector<csCollisionPair> pairs;
+csCollisionContext::csCollisionContext() : frame(0) {
+    TreeCollider.SetFirstContact(true);
+    TreeCollider.SetFullBoxBoxTest(false);
+    TreeCollider.SetTemporalCoherence(false);
+    rCollider.SetHitCallback(&csOPCODECollider::RayCallback);
+    rCollider.SetFirstContact(false);
+    lssCollider.SetFirstContact(true);
+    lssCollider.SetTemporalCoherence(false);
+}
+
+csCollisionContext &csCollisionContext::ForThisThread() {
+    static thread_local csCollisionContext context;
+    return context;
+}
+
+csCollisionCoherence &csCollisionContext::Coherence(const void *a,
+        uint32_t generation_a,
+        const void *b,
+        uint32_t generation_b) {
+    csCollisionCoherence &entry = coherence[PairKey{a, b}];
+    if (entry.generation0 != generation_a || entry.generation1 != generation_b) {
+        entry = csCollisionCoherence();
+        entry.generation0 = generation_a;
+        entry.generation1 = generation_b;
+    }
+    entry.last_used = frame;
+    return entry;
+}
+
+void csCollisionContext::AgeCoherence(unsigned int max_idle) {
+    ++frame;
+    for (auto i = coherence.begin(); i != coherence.end();) {
+        if (frame - i->second.last_used > max_idle) {
+            i = coherence.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
 
 csOPCODECollider::csOPCODECollider(const std::vector<mesh_polygon> &polygons) {
     m_pCollisionModel = nullptr;
     vertholder = nullptr;
-    //pairs.IncRef();
-    TreeCollider.SetFirstContact(true);
-    TreeCollider.SetFullBoxBoxTest(false);
-    TreeCollider.SetTemporalCoherence(false);
+    first_contact = true;
     opcMeshInt.SetCallback(&MeshCallback, this);
     GeometryInitialize(polygons);
-    CollisionFace collFace;
-    rCollider.SetFirstContact(true);
-
 }
 
 inline float min3(float a, float b, float c) {
@@ -107,8 +142,12 @@ void csOPCODECollider::GeometryInitialize(const std::vector<mesh_polygon> &polyg
         return;
     }
 
-    //bool status = m_pCollisionModel->Build (OPCC);
-    m_pCollisionModel->Build(OPCC);
+    const uint64_t cache_key = csOPCODECache::Key(vertholder, 3 * tri_count);
+    if (!csOPCODECache::Load(cache_key, OPCC, *m_pCollisionModel)) {
+        if (m_pCollisionModel->Build(OPCC)) {
+            csOPCODECache::Store(cache_key, OPCC, *m_pCollisionModel);
+        }
+    }
 }
 
 csOPCODECollider::~csOPCODECollider() {
@@ -132,18 +171,24 @@ void csOPCODECollider::MeshCallback(uint32_t triangle_index,
     triangle.Vertex[2] = &vertholder[index + 2];
 }
 
-bool csOPCODECollider::rayCollide(const Ray &boltbeam, Vector &norm, float &distance) {
-    rCollider.SetHitCallback(&csOPCODECollider::RayCallback);
-    rCollider.SetUserData(this);
-    rCollider.SetFirstContact(false);
+bool csOPCODECollider::rayCollide(const Ray &boltbeam, Vector &norm, float &distance) const {
+    return rayCollide(csCollisionContext::ForThisThread(), boltbeam, norm, distance);
+}
+
+bool csOPCODECollider::rayCollide(csCollisionContext &context,
+        const Ray &boltbeam,
+        Vector &norm,
+        float &distance) const {
+    RayCollider &rCollider = context.rCollider;
+    rCollider.SetUserData(&context);
     //rCollider.SetClosestHit(true);
-    collFace.mDistance = FLT_MAX;
+    context.collFace.mDistance = FLT_MAX;
     bool retval = rCollider.Collide(boltbeam, *m_pCollisionModel);
     rCollider.SetUserData(NULL);
     if (retval) {
-        retval = collFace.mDistance != FLT_MAX;
+        retval = context.collFace.mDistance != FLT_MAX;
         if (retval) {
-            distance = collFace.mDistance;
+            distance = context.collFace.mDistance;
 #ifdef VS_DEBUG
             VS_LOG(debug, (boost::format("Opcode actually reported a hit at %1$f meters!") % distance));
 #endif
@@ -155,85 +200,77 @@ bool csOPCODECollider::rayCollide(const Ray &boltbeam, Vector &norm, float &dist
     return retval;
 }
 
+bool csOPCODECollider::lssCollide(csCollisionContext &context, const LSS &capsule) const {
+    LSSCollider &lssCollider = context.lssCollider;
+    return lssCollider.Collide(context.lssCache, capsule, *m_pCollisionModel) && lssCollider.GetContactStatus();
+}
+
 void csOPCODECollider::RayCallback(const CollisionFace &faceHit, void *user_data) {
-    csOPCODECollider *collider = (csOPCODECollider *) user_data;
-    if (collider) {
-        if (collider->collFace.mDistance > faceHit.mDistance) {
-            collider->collFace = faceHit;
+    csCollisionContext *context = (csCollisionContext *) user_data;
+    if (context) {
+        if (context->collFace.mDistance > faceHit.mDistance) {
+            context->collFace = faceHit;
         }
     }
 }
 
+/* The OPCODE world matrix for a transform; identity when there is none */
+static void WorldMatrix(const csReversibleTransform *trans, Matrix4x4 &world) {
+    csMatrix3 m;
+    if (trans) {
+        m = trans->GetT2O();
+    }
+    csVector3 u;
+    world.m[0][3] = 0;
+    world.m[1][3] = 0;
+    world.m[2][3] = 0;
+    world.m[3][3] = 1;
+    u = m.Row1();
+    world.m[0][0] = u.x;
+    world.m[1][0] = u.y;
+    world.m[2][0] = u.z;
+    u = m.Row2();
+    world.m[0][1] = u.x;
+    world.m[1][1] = u.y;
+    world.m[2][1] = u.z;
+    u = m.Row3();
+    world.m[0][2] = u.x;
+    world.m[1][2] = u.y;
+    world.m[2][2] = u.z;
+    if (trans) {
+        u = trans->GetO2TTranslation();
+    } else {
+        u.Set(0, 0, 0);
+    }
+    world.m[3][0] = u.x;
+    world.m[3][1] = u.y;
+    world.m[3][2] = u.z;
+}
+
 bool csOPCODECollider::Collide(csOPCODECollider &otherCollider,
         const csReversibleTransform *trans1,
         const csReversibleTransform *trans2) {
+    return Collide(csCollisionContext::ForThisThread(), otherCollider, trans1, trans2);
+}
+
+bool csOPCODECollider::Collide(csCollisionContext &context,
+        csOPCODECollider &otherCollider,
+        const csReversibleTransform *trans1,
+        const csReversibleTransform *trans2) {
     csOPCODECollider *col2 = (csOPCODECollider *) &otherCollider;
+    BVTCache &ColCache = context.ColCache;
+    AABBTreeCollider &TreeCollider = context.TreeCollider;
     ColCache.Model0 = this->m_pCollisionModel;
     ColCache.Model1 = col2->m_pCollisionModel;
-    csMatrix3 m1;
-    if (trans1) {
-        m1 = trans1->GetT2O();
-    }
-    csMatrix3 m2;
-    if (trans2) {
-        m2 = trans2->GetT2O();
-    }
-    csVector3 u;
+    TreeCollider.SetFirstContact(first_contact);
     Matrix4x4 transform1;
-    transform1.m[0][3] = 0;
-    transform1.m[1][3] = 0;
-    transform1.m[2][3] = 0;
-    transform1.m[3][3] = 1;
     Matrix4x4 transform2;
-    transform2.m[0][3] = 0;
-    transform2.m[1][3] = 0;
-    transform2.m[2][3] = 0;
-    transform2.m[3][3] = 1;
-    u = m1.Row1();
-    transform1.m[0][0] = u.x;
-    transform1.m[1][0] = u.y;
-    transform1.m[2][0] = u.z;
-    u = m2.Row1();
-    transform2.m[0][0] = u.x;
-    transform2.m[1][0] = u.y;
-    transform2.m[2][0] = u.z;
-    u = m1.Row2();
-    transform1.m[0][1] = u.x;
-    transform1.m[1][1] = u.y;
-    transform1.m[2][1] = u.z;
-    u = m2.Row2();
-    transform2.m[0][1] = u.x;
-    transform2.m[1][1] = u.y;
-    transform2.m[2][1] = u.z;
-    u = m1.Row3();
-    transform1.m[0][2] = u.x;
-    transform1.m[1][2] = u.y;
-    transform1.m[2][2] = u.z;
-    u = m2.Row3();
-    transform2.m[0][2] = u.x;
-    transform2.m[1][2] = u.y;
-    transform2.m[2][2] = u.z;
-    if (trans1) {
-        u = trans1->GetO2TTranslation();
-    } else {
-        u.Set(0, 0, 0);
-    }
-    transform1.m[3][0] = u.x;
-    transform1.m[3][1] = u.y;
-    transform1.m[3][2] = u.z;
-
-    if (trans2) {
-        u = trans2->GetO2TTranslation();
-    } else {
-        u.Set(0, 0, 0);
-    }
-    transform2.m[3][0] = u.x;
-    transform2.m[3][1] = u.y;
-    transform2.m[3][2] = u.z;
+    WorldMatrix(trans1, transform1);
+    WorldMatrix(trans2, transform2);
     if (TreeCollider.Collide(ColCache, &transform1, &transform2)) {
         bool status = (TreeCollider.GetContactStatus() != FALSE);
         if (status) {
-            CopyCollisionPairs(this, col2);
+            CopyCollisionPairs(context, this, col2);
         }
         return status;
     } else {
@@ -241,21 +278,96 @@ bool csOPCODECollider::Collide(csOPCODECollider &otherCollider,
     }
 }
 
+/* True if no point within radius of the origin moves more than tolerance between the two poses */
+static bool PoseWithin(const Matrix4x4 &a, const Matrix4x4 &b, float tolerance, float radius) {
+    for (int i = 0; i < 3; ++i) {
+        float rotated = 0;
+        for (int j = 0; j < 3; ++j) {
+            rotated += fabsf(a.m[j][i] - b.m[j][i]);
+        }
+        if (rotated * radius + fabsf(a.m[3][i] - b.m[3][i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool csOPCODECollider::Collide(csCollisionContext &context,
+        csCollisionCoherence &coherence,
+        csOPCODECollider &otherCollider,
+        const csReversibleTransform *trans1,
+        const csReversibleTransform *trans2,
+        float tolerance) {
+    csOPCODECollider *col2 = &otherCollider;
+    Matrix4x4 transform1;
+    Matrix4x4 transform2;
+    Matrix4x4 inverse2;
+    WorldMatrix(trans1, transform1);
+    WorldMatrix(trans2, transform2);
+    InvertPRMatrix(inverse2, transform2);
+    const Matrix4x4 relative = transform1 * inverse2;
+
+    const bool same_pair = coherence.valid && coherence.collider0 == this && coherence.collider1 == col2;
+    if (same_pair && PoseWithin(coherence.relative, relative, tolerance, std::max(radius, col2->radius))) {
+        ++context.coherence_stats.reused;
+        if (coherence.contact) {
+            context.pairs.push_back(coherence.pair);
+        }
+        return coherence.contact;
+    }
+
+    BVTCache &ColCache = context.ColCache;
+    AABBTreeCollider &TreeCollider = context.TreeCollider;
+    ColCache.Model0 = this->m_pCollisionModel;
+    ColCache.Model1 = col2->m_pCollisionModel;
+    TreeCollider.SetFirstContact(first_contact);
+    // OPCODE only tries the cached triangles in first contact mode
+    const bool from_last_contact = same_pair && coherence.contact;
+    if (from_last_contact) {
+        ColCache.id0 = coherence.primitive0;
+        ColCache.id1 = coherence.primitive1;
+    }
+    TreeCollider.SetTemporalCoherence(from_last_contact);
+    const size_t first_pair = context.pairs.size();
+    bool status = TreeCollider.Collide(ColCache, &transform1, &transform2)
+            && TreeCollider.GetContactStatus() != FALSE;
+    TreeCollider.SetTemporalCoherence(false);
+    if (status) {
+        CopyCollisionPairs(context, this, col2);
+    }
+    if (status && from_last_contact && TreeCollider.GetNbBVBVTests() == 0) {
+        ++context.coherence_stats.shortcut;
+    } else {
+        ++context.coherence_stats.walked;
+    }
+
+    coherence.collider0 = this;
+    coherence.collider1 = col2;
+    coherence.relative = relative;
+    coherence.contact = context.pairs.size() > first_pair;
+    if (coherence.contact) {
+        coherence.pair = context.pairs[first_pair];
+        coherence.primitive0 = ColCache.id0;
+        coherence.primitive1 = ColCache.id1;
+    }
+    coherence.valid = true;
+    return status;
+}
+
 void csOPCODECollider::ResetCollisionPairs() {
-    pairs.clear();
+    csCollisionContext::ForThisThread().ResetCollisionPairs();
 }
 
 csCollisionPair *csOPCODECollider::GetCollisions() {
-    return pairs.data();
+    return csCollisionContext::ForThisThread().GetCollisions();
 }
 
 size_t csOPCODECollider::GetCollisionPairCount() {
-    return pairs.size();
+    return csCollisionContext::ForThisThread().GetCollisionPairCount();
 }
 
 void csOPCODECollider::SetOneHitOnly(bool on) {
-    TreeCollider.SetFirstContact(on);
-    rCollider.SetFirstContact(on);
+    first_contact = on;
 }
 
 Vector csOPCODECollider::getVertex(unsigned int which) const {
@@ -266,12 +378,15 @@ Vector csOPCODECollider::getVertex(unsigned int which) const {
     return Vector(vertholder[which].x, vertholder[which].y, vertholder[which].z);
 }
 
-void csOPCODECollider::CopyCollisionPairs(csOPCODECollider *col1,
+void csOPCODECollider::CopyCollisionPairs(csCollisionContext &context,
+        csOPCODECollider *col1,
         csOPCODECollider *col2) {
     if (!col1 || !col2) {
         return;
     }
 
+    const AABBTreeCollider &TreeCollider = context.TreeCollider;
+    std::vector<csCollisionPair> &pairs = context.pairs;
     unsigned int N_pairs = TreeCollider.GetNbPairs();
     if (N_pairs == 0) {
         return;
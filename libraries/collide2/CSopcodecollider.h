@@ -30,6 +30,8 @@
 
 #ifndef VEGA_STRIKE_ENGINE_CMD_COLLSION2_OPCODECOL_H
 #define VEGA_STRIKE_ENGINE_CMD_COLLSION2_OPCODECOL_H
+#include <unordered_map>
+#include <vector>
 #include "collide2/Opcode.h"
 #include "collide2/csgeom2/opmatrix3.h"
 #include "collide2/csgeom2/opvector3.h"
@@ -50,28 +52,142 @@
 	It defaults to not.
 	csOPCODECollider.SetOneHitOnly(bool);
 
-	The rest of the calls occur in your physics loops
+	The rest of the calls occur in your physics loops, against a
+	csCollisionContext owned by the caller (one per thread or per query).
 
 	Reset our list of collided pairs of vectors.
-	csOPCODECollider.ResetCollisionPairs();
+	csCollisionContext.ResetCollisionPairs();
 
-	Check if a collision occurred, sending the other collider and transforms for
-	both colliders.   Returns true if we collided.
-	csOPCODECollider.Collide(csOPCODECollider&, const csReversibleTransform* first,
-	                                            const csReversibleTransform* second);
+	Check if a collision occurred, sending the context, the other collider and
+	transforms for both colliders.   Returns true if we collided.
+	csOPCODECollider.Collide(csCollisionContext&, csOPCODECollider&,
+	                         const csReversibleTransform* first,
+	                         const csReversibleTransform* second);
 
 	If true, retrieve the vectors that collided so we can act upon them.
-	csOPCODECollider.GetCollisions();
+	csCollisionContext.GetCollisions();
 
 	We also need the number of collided vectors in case we dont have
 	first hit set to true.
-	csOPCodeCollider.GetCollisionPairCount();
+	csCollisionContext.GetCollisionPairCount();
+
+	The overloads without a context, and the static pair accessors on
+	csOPCODECollider, use csCollisionContext::ForThisThread().
 */
 
+class csOPCODECollider;
+
+/* What the last query between two particular objects found.   While their
+* relative pose stays put (docked ships, a formation holding station) the
+* answer is reused outright; otherwise the last colliding triangle pair is
+* tried before the trees are walked again. */
+struct csCollisionCoherence {
+    const csOPCODECollider *collider0 = nullptr;
+    const csOPCODECollider *collider1 = nullptr;
+    uint32_t generation0 = 0;
+    uint32_t generation1 = 0;
+    /* pose of the first collider in the second one's frame at the last full query */
+    Opcode::Matrix4x4 relative;
+    /* last colliding triangles, one from each collider */
+    uint32_t primitive0 = 0;
+    uint32_t primitive1 = 0;
+    /* the first pair the last full query returned */
+    csCollisionPair pair;
+    bool valid = false;
+    bool contact = false;
+    unsigned int last_used = 0;
+};
+
+/* Everything a collision query writes to: the OPCODE colliders, their cache
+* and the pair buffer.   Colliders themselves are only read during a query,
+* so any number of contexts may query the same colliders concurrently, as
+* long as no context is shared between two threads. */
+class csCollisionContext {
+public:
+    csCollisionContext();
+
+    /* clears the pair array */
+    void ResetCollisionPairs() {
+        pairs.clear();
+    }
+
+    /* The pair array contains the vertices that have collided as returned
+    * by the Collide calls since the last reset. */
+    csCollisionPair *GetCollisions() {
+        return pairs.data();
+    }
+
+    size_t GetCollisionPairCount() const {
+        return pairs.size();
+    }
+
+    /* The context used by the calls that do not take one explicitly */
+    static csCollisionContext &ForThisThread();
+
+    /* The coherence kept for objects a and b.   The generations tell an
+    * object apart from a later one allocated at the same address. */
+    csCollisionCoherence &Coherence(const void *a, uint32_t generation_a, const void *b, uint32_t generation_b);
+
+    /* Ends a frame: forgets the pairs that have not been queried for max_idle frames */
+    void AgeCoherence(unsigned int max_idle);
+
+    size_t CoherentPairs() const {
+        return coherence.size();
+    }
+
+    struct CoherenceStats {
+        /* answered from the cached pose without touching the trees */
+        unsigned int reused = 0;
+        /* answered by the last colliding triangle pair */
+        unsigned int shortcut = 0;
+        unsigned int walked = 0;
+    };
+
+    const CoherenceStats &GetCoherenceStats() const {
+        return coherence_stats;
+    }
+
+private:
+    friend class csOPCODECollider;
+
+    struct PairKey {
+        const void *a;
+        const void *b;
+
+        bool operator==(const PairKey &other) const {
+            return a == other.a && b == other.b;
+        }
+    };
+
+    struct PairKeyHash {
+        size_t operator()(const PairKey &key) const {
+            return std::hash<const void *>()(key.a) * 31 + std::hash<const void *>()(key.b);
+        }
+    };
+
+    std::unordered_map<PairKey, csCollisionCoherence, PairKeyHash> coherence;
+    CoherenceStats coherence_stats;
+    unsigned int frame;
+
+    Opcode::BVTCache ColCache;
+    Opcode::CollisionFace collFace;
+    /* Collider type: Tree - Used primarily for mesh on mesh collisions */
+    Opcode::AABBTreeCollider TreeCollider;
+    /* Collider type: Ray - used to check if a ray collided with a collision tree */
+    Opcode::RayCollider rCollider;
+    /* Collider type: LSS - used to check if a beam's capsule touches a collision tree */
+    Opcode::LSSCollider lssCollider;
+    Opcode::LSSCache lssCache;
+
+    std::vector<csCollisionPair> pairs;
+};
+
 
 // Low level collision detection using Opcode library.
 class csOPCODECollider {
 private:
+    friend class csCollisionContext;
+
     /* does what it says.  Takes our mesh_polygon vector and turns it into
     * a linear list of vertexes that we reference in collision trees
     * radius is set in here as well
@@ -94,19 +210,13 @@ private:
     /* OPCODE interfaces. */
     Opcode::Model *m_pCollisionModel;
     Opcode::MeshInterface opcMeshInt;
-    Opcode::BVTCache ColCache;
-    Opcode::CollisionFace collFace;
-    /* Collider type: Tree - Used primarily for mesh on mesh collisions */
-    Opcode::AABBTreeCollider TreeCollider;
 
-    /* Collider type: Ray - used to check if a ray collided with the tree collider above */
-    Opcode::RayCollider rCollider;
+    /* Stop at the first contact; applied to the context's colliders per query */
+    bool first_contact;
 
     /* We have to copy our Points to csVector3's because opcode likes Point
     * and VS likes Vector.  */
-    void CopyCollisionPairs(csOPCODECollider *col1, csOPCODECollider *col2);
-
-    // std::shared_ptr<VegaStrike::vs_vector<csCollisionPair>> pairs = std::make_shared<VegaStrike::vs_vector<csCollisionPair>>();
+    static void CopyCollisionPairs(csCollisionContext &context, csOPCODECollider *col1, csOPCODECollider *col2);
 
 public:
     csOPCODECollider(const std::vector<mesh_polygon> &polygons);
@@ -118,24 +228,43 @@ public:
     }
 
     /* Collides the bolt or beam with this collider, returning true if it occurred */
-    bool rayCollide(const Opcode::Ray &boltbeam, Vector &norm, float &distance);
+    bool rayCollide(csCollisionContext &context, const Opcode::Ray &boltbeam, Vector &norm, float &distance) const;
+    bool rayCollide(const Opcode::Ray &boltbeam, Vector &norm, float &distance) const;
+
+    /* True if the capsule, given in this collider's space, touches any of its triangles */
+    bool lssCollide(csCollisionContext &context, const Opcode::LSS &capsule) const;
 
-    /* Collides the argument collider with this collider, returning true if it occurred */
+    /* Collides the argument collider with this collider, returning true if it occurred.
+    * The colliding pairs are appended to the context's pair array. */
+    bool Collide(csCollisionContext &context,
+            csOPCODECollider &pOtherCollider,
+            const csReversibleTransform *pThisTransform = 0,
+            const csReversibleTransform *pOtherTransform = 0);
     bool Collide(csOPCODECollider &pOtherCollider,
             const csReversibleTransform *pThisTransform = 0,
             const csReversibleTransform *pOtherTransform = 0);
 
-    /* Returns the pair array, as of 0.5 this is a global static var
+    /* Same as above, for two objects queried frame after frame.   When their
+    * relative pose is within tolerance (in mesh units) of the one coherence
+    * was recorded at, the recorded answer is returned without a query. */
+    bool Collide(csCollisionContext &context,
+            csCollisionCoherence &coherence,
+            csOPCODECollider &pOtherCollider,
+            const csReversibleTransform *pThisTransform,
+            const csReversibleTransform *pOtherTransform,
+            float tolerance);
+
+    /* Returns the pair array of the calling thread's context
     * The pair array contains the vertices that have collided as returned
     * by the last collision.   This is concatenated, meaning, if it's not
     * cleared by the client code, the collisions just get pushed onto the
     * array indefinitely.   It should be cleared between collide calls */
     static csCollisionPair *GetCollisions();
 
-    /* clears the pair array */
+    /* clears the pair array of the calling thread's context */
     static void ResetCollisionPairs();
 
-    /* Returns the size of the pair array */
+    /* Returns the size of the pair array of the calling thread's context */
     static size_t GetCollisionPairCount();
 
     /* Sets First contact to argument.
@@ -145,7 +274,7 @@ public:
     void SetOneHitOnly(bool fh);
 
     inline bool GetOneHitOnly() const {
-        return (TreeCollider.FirstContactEnabled());
+        return first_contact;
     }
 
     /* Returns the radius of our collision mesh.  This is the max radius
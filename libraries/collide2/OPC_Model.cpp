@@ -231,3 +231,42 @@ size_t Model::GetUsedBytes() const {
     return mTree->GetUsedBytes();
 }
 
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Appends a position independent image of the collision tree.
+ *  \param		image		[out] buffer the image is appended to
+ *  \return		true if success
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool Model::Save(std::vector<uint8_t> &image) const {
+    if (!mTree || !(mModelCode & OPC_NO_LEAF) || !(mModelCode & OPC_QUANTIZED)) {
+        return false;
+    }
+    static_cast<const AABBQuantizedNoLeafTree *>(mTree)->Save(image);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Sets the model up from an image written by Save().
+ *  \param		create		[in] model creation structure
+ *  \param		image		[in] image data
+ *  \param		size		[in] image size in bytes
+ *  \return		true if success
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool Model::Load(const OPCODECREATE &create, const uint8_t *image, size_t size) {
+    if (!create.mIMesh || !create.mIMesh->IsValid() || !create.mNoLeaf || !create.mQuantized) {
+        return false;
+    }
+    Release();
+    mModelCode = 0;
+    SetMeshInterface(create.mIMesh);
+    if (!CreateTree(true, true)
+            || !static_cast<AABBQuantizedNoLeafTree *>(mTree)->Load(image, size, create.mIMesh->GetNbTriangles())) {
+        Release();
+        return false;
+    }
+    return true;
+}
@@ -58,6 +58,27 @@ public:
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     override(BaseModel) size_t GetUsedBytes() const;
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**
+     *	Appends a position independent image of the collision tree, for caching built models. [VS]
+     *	Only quantized no-leaf trees can be saved.
+     *	\param		image		[out] buffer the image is appended to
+     *	\return		true if success
+     */
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool Save(std::vector<uint8_t> &image) const;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**
+     *	Sets the model up from an image written by Save(), instead of building its tree. [VS]
+     *	\param		create		[in] model creation structure, as it would be passed to Build()
+     *	\param		image		[in] image data
+     *	\param		size		[in] image size in bytes
+     *	\return		true if success; on failure the model is left empty and Build() should be used
+     */
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool Load(const OPCODECREATE &create, const uint8_t *image, size_t size);
+
 private:
 #ifdef __MESHMERIZER_H__
     CollisionHull*		mHull;			//!< Possible convex hull
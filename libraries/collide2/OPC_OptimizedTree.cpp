@@ -792,3 +792,104 @@ bool AABBQuantizedNoLeafTree::Walk(GenericWalkingCallback callback, void *user_d
     return true;
 }
 
+
+// Image layout: node count, quantization coeffs, then per node the quantized box and both links.
+// A link is either (primitive<<1)|1 for a leaf, or (node index<<1) for a child node.
+static const size_t QUANTIZED_NOLEAF_HEADER = sizeof(uint32_t) + 6 * sizeof(float);
+static const size_t QUANTIZED_NOLEAF_NODE = 3 * sizeof(int16_t) + 3 * sizeof(uint16_t) + 2 * sizeof(uint32_t);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Appends a position independent image of the tree.
+ *  \param		image		[out] buffer the image is appended to
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void AABBQuantizedNoLeafTree::Save(std::vector<uint8_t> &image) const {
+    size_t at = image.size();
+    image.resize(at + QUANTIZED_NOLEAF_HEADER + mNbNodes * QUANTIZED_NOLEAF_NODE);
+    uint8_t *out = &image[at];
+    memcpy(out, &mNbNodes, sizeof(uint32_t));
+    out += sizeof(uint32_t);
+    const float coeffs[6] = {mCenterCoeff.x, mCenterCoeff.y, mCenterCoeff.z,
+            mExtentsCoeff.x, mExtentsCoeff.y, mExtentsCoeff.z};
+    memcpy(out, coeffs, sizeof(coeffs));
+    out += sizeof(coeffs);
+    for (uint32_t i = 0; i < mNbNodes; i++) {
+        const AABBQuantizedNoLeafNode &Current = mNodes[i];
+        memcpy(out, Current.mAABB.mCenter, 3 * sizeof(int16_t));
+        out += 3 * sizeof(int16_t);
+        memcpy(out, Current.mAABB.mExtents, 3 * sizeof(uint16_t));
+        out += 3 * sizeof(uint16_t);
+        uint32_t Links[2];
+        Links[0] = Current.HasPosLeaf() ? uint32_t(Current.mPosData)
+                : uint32_t(Current.GetPos() - mNodes) << 1;
+        Links[1] = Current.HasNegLeaf() ? uint32_t(Current.mNegData)
+                : uint32_t(Current.GetNeg() - mNodes) << 1;
+        memcpy(out, Links, sizeof(Links));
+        out += sizeof(Links);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Restores the tree from an image written by Save().
+ *  \param		image		[in] image data
+ *  \param		size		[in] image size in bytes
+ *  \param		nb_prims	[in] number of triangles of the mesh the tree was built for
+ *  \return		true if the image was complete and consistent
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool AABBQuantizedNoLeafTree::Load(const uint8_t *image, size_t size, uint32_t nb_prims) {
+    uint32_t NbNodes;
+    if (!image || size < QUANTIZED_NOLEAF_HEADER || nb_prims < 2) {
+        return false;
+    }
+    memcpy(&NbNodes, image, sizeof(uint32_t));
+    if (NbNodes != nb_prims - 1 || size != QUANTIZED_NOLEAF_HEADER + NbNodes * QUANTIZED_NOLEAF_NODE) {
+        return false;
+    }
+    const uint8_t *in = image + sizeof(uint32_t);
+    float coeffs[6];
+    memcpy(coeffs, in, sizeof(coeffs));
+    in += sizeof(coeffs);
+
+    AABBQuantizedNoLeafNode *Nodes = new AABBQuantizedNoLeafNode[NbNodes];
+    CHECKALLOC(Nodes);
+    for (uint32_t i = 0; i < NbNodes; i++) {
+        AABBQuantizedNoLeafNode &Current = Nodes[i];
+        memcpy(Current.mAABB.mCenter, in, 3 * sizeof(int16_t));
+        in += 3 * sizeof(int16_t);
+        memcpy(Current.mAABB.mExtents, in, 3 * sizeof(uint16_t));
+        in += 3 * sizeof(uint16_t);
+        uint32_t Links[2];
+        memcpy(Links, in, sizeof(Links));
+        in += sizeof(Links);
+        uintptr_t Data[2];
+        for (int j = 0; j < 2; j++) {
+            uint32_t Index = Links[j] >> 1;
+            if (Links[j] & 1) {
+                if (Index >= nb_prims) {
+                    DELETEARRAY(Nodes);
+                    return false;
+                }
+                Data[j] = uintptr_t(Links[j]);
+            } else {
+                // Children always follow their parent, which also rules out cycles
+                if (Index <= i || Index >= NbNodes) {
+                    DELETEARRAY(Nodes);
+                    return false;
+                }
+                Data[j] = uintptr_t(&Nodes[Index]);
+            }
+        }
+        Current.mPosData = Data[0];
+        Current.mNegData = Data[1];
+    }
+
+    DELETEARRAY(mNodes);
+    mNodes = Nodes;
+    mNbNodes = NbNodes;
+    mCenterCoeff.Set(coeffs[0], coeffs[1], coeffs[2]);
+    mExtentsCoeff.Set(coeffs[3], coeffs[4], coeffs[5]);
+    return true;
+}
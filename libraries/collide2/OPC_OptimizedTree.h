@@ -212,6 +212,25 @@ class OPCODE_API AABBQuantizedNoLeafTree : public AABBOptimizedTree {
 IMPLEMENT_COLLISION_TREE(AABBQuantizedNoLeafTree, AABBQuantizedNoLeafNode)
 
 public:
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**
+     *	Appends a position independent image of the tree: child links are stored as node indices. [VS]
+     *	\param		image		[out] buffer the image is appended to
+     */
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    void Save(std::vector<uint8_t> &image) const;
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /**
+     *	Restores the tree from an image written by Save(). [VS]
+     *	\param		image		[in] image data
+     *	\param		size		[in] image size in bytes
+     *	\param		nb_prims	[in] number of triangles of the mesh the tree was built for
+     *	\return		true if the image was complete and consistent
+     */
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    bool Load(const uint8_t *image, size_t size, uint32_t nb_prims);
+
     Point mCenterCoeff;
     Point mExtentsCoeff;
 };
@@ -38,6 +38,7 @@
 #include <cstring>
 #include <cstdint>
 #include <cassert>
+#include <vector>
 #include "gfx_generic/quaternion.h"
 #include "gfx_generic/tvector.h"
 
@@ -35,34 +35,34 @@
 #include "root_generic/options.h"
 #include "src/universe.h"
 
+extern double interpolation_blend_factor;
+
 QVector BoltDrawManager::camera_position = QVector();
 float BoltDrawManager::pixel_angle = 0.0;
 float BoltDrawManager::elapsed_time = 0.0;
+GFXVertex BoltDrawManager::boltvertices[12];
+WeaponInstances BoltDrawManager::instances;
 
 BoltDrawManager::BoltDrawManager() {
-    if (!boltmesh) {
-        GFXVertex vtx[12];
+    GFXVertex *vtx = boltvertices;
 #define V(ii, xx, yy, zz, ss, \
-           tt) vtx[(ii)].x = (xx); vtx[(ii)].y = (yy); vtx[(ii)].z = (zz) + configuration().graphics.bolt_offset_flt + .875; vtx[(ii)].i = 0; vtx[(ii)].j = 0; vtx[(ii)].k = 1; \
+       tt) vtx[(ii)].x = (xx); vtx[(ii)].y = (yy); vtx[(ii)].z = (zz) + configuration().graphics.bolt_offset_flt + .875; vtx[(ii)].i = 0; vtx[(ii)].j = 0; vtx[(ii)].k = 1; \
     vtx[(ii)].s = (ss); vtx[(ii)].t = (tt);
-        V(0, 0, 0, -.875, 0, .5);
-        V(1, 0, -1, 0, .875, 1);
-        V(2, 0, 0, .125, 1, .5);
-        V(3, 0, 1, 0, .875, 0);
-        V(4, 0, 0, -.875, 0, .5);
-        V(5, -1, 0, 0, .875, 1);
-        V(6, 0, 0, .125, 1, .5);
-        V(7, 1, 0, 0, .875, 0);
-        V(8, 1, 0, 0, .1875, 0);
-        V(9, 0, 1, 0, .375, .1875);
-        V(10, -1, 0, 0, .1875, .375);
-        V(11, 0, -1, 0, 0, .1875);
-        boltmesh = new GFXVertexList(GFXQUAD, 12, vtx, 12, false);         //not mutable;
-    }
+    V(0, 0, 0, -.875, 0, .5);
+    V(1, 0, -1, 0, .875, 1);
+    V(2, 0, 0, .125, 1, .5);
+    V(3, 0, 1, 0, .875, 0);
+    V(4, 0, 0, -.875, 0, .5);
+    V(5, -1, 0, 0, .875, 1);
+    V(6, 0, 0, .125, 1, .5);
+    V(7, 1, 0, 0, .875, 0);
+    V(8, 1, 0, 0, .1875, 0);
+    V(9, 0, 1, 0, .375, .1875);
+    V(10, -1, 0, 0, .1875, .375);
+    V(11, 0, -1, 0, 0, .1875);
+#undef V
 }
 
-GFXVertexList *BoltDrawManager::boltmesh = NULL;
-
 BoltDrawManager::~BoltDrawManager() {
     unsigned int i;
     for (i = 0; i < animations.size(); i++) {
@@ -103,6 +103,13 @@ void BoltDrawManager::Draw() {
     camera_position = _Universe->AccessCamera()->GetPosition();
     elapsed_time = GetElapsedTime();
 
+    //bolts and balls are written relative to the camera
+    instances.Begin(camera_position, pixel_angle, interpolation_blend_factor);
+    Matrix at_camera;
+    Identity(at_camera);
+    at_camera.p = camera_position;
+    GFXLoadMatrixModel(at_camera);
+
     // Iterate over ball types
     Bolt::DrawAllBalls();
 
@@ -30,6 +30,7 @@
 #include "gfx/decalqueue.h"
 #include "cmd/bolt.h"
 #include "gfx_generic/vec.h"
+#include "gfx_generic/weapon_instances.h"
 
 #include <vector>
 
@@ -38,7 +39,10 @@ class Animation;
 class BoltDrawManager {
 public:
     class DecalQueue boltdecals;
-    static GFXVertexList *boltmesh;
+    ///the crossed quads of a bolt, one unit across and one long
+    static GFXVertex boltvertices[12];
+    ///this frame's bolts and balls, next to the camera
+    static WeaponInstances instances;
     static QVector camera_position;
     static float pixel_angle;
     static float elapsed_time;
@@ -253,6 +253,9 @@ private:
 ///Activate a texture unit - internal usage
     void activateTextureUnit(const Pass::TextureUnit &tu, bool deflt = false);
 
+///The texture activateTextureUnit would bind for a texture unit, null if none or not mesh specific - internal usage
+    const Texture *resolveTextureUnit(const Pass::TextureUnit &tu, bool deflt = false) const;
+
 public:
     Mesh();
     Mesh(const Mesh &m);
@@ -0,0 +1,258 @@
+/*
+ * occlusion_raster.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "gfx_generic/occlusion_raster.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_RASTER_SSE
+#endif
+
+static unsigned int ClampedTexel(float f, unsigned int n) {
+    if (!(f > 0)) {
+        return 0;
+    }
+    if (f >= n) {
+        return n - 1;
+    }
+    return static_cast<unsigned int>(f);
+}
+
+OcclusionRaster::OcclusionRaster(unsigned int width, unsigned int height) :
+        width(0),
+        height(0),
+        has_view(false),
+        eye(0, 0, 0),
+        axis_x(1, 0, 0),
+        axis_y(0, 1, 0),
+        forward(0, 0, 1),
+        tan_left(-1),
+        tan_bottom(-1),
+        texel_u(0),
+        texel_v(0),
+        occluders(0) {
+    Resize(width, height);
+}
+
+void OcclusionRaster::Resize(unsigned int width, unsigned int height) {
+    if (width == 0 || height == 0) {
+        width = height = 0;
+    }
+    this->width = width;
+    this->height = height;
+    has_view = false;
+    occluders = 0;
+    depth.assign(static_cast<size_t>(width) * height, FLT_MAX);
+    corner_rows.assign(2 * (width + 1), 0);
+}
+
+void OcclusionRaster::SetView(const QVector &eye,
+        const Vector &axis_x,
+        const Vector &axis_y,
+        const Vector &forward,
+        float left,
+        float right,
+        float bottom,
+        float top,
+        float znear) {
+    has_view = width > 0 && znear > 0 && right > left && top > bottom;
+    if (!has_view) {
+        return;
+    }
+    this->eye = eye;
+    this->axis_x = axis_x.Cast();
+    this->axis_y = axis_y.Cast();
+    this->forward = forward.Cast();
+    tan_left = left / znear;
+    tan_bottom = bottom / znear;
+    texel_u = (right - left) / znear / width;
+    texel_v = (top - bottom) / znear / height;
+}
+
+void OcclusionRaster::Clear() {
+    if (occluders > 0) {
+        std::fill(depth.begin(), depth.end(), FLT_MAX);
+        occluders = 0;
+    }
+}
+
+bool OcclusionRaster::TexelRect(const QVector &rel, float radius, unsigned int lo[2], unsigned int hi[2]) const {
+    const double d = rel.Dot(forward);
+    const double dmin = d - radius;
+    if (!has_view || !(dmin > 0)) {
+        return false;
+    }
+    const double dmax = d + radius;
+    const double x = rel.Dot(axis_x);
+    const double y = rel.Dot(axis_y);
+    //x / d over the box around the sphere is extreme at its corners
+    const float x0 = static_cast<float>(std::min((x - radius) / dmin, (x - radius) / dmax) - tan_left) / texel_u;
+    const float x1 = static_cast<float>(std::max((x + radius) / dmin, (x + radius) / dmax) - tan_left) / texel_u;
+    const float y0 = static_cast<float>(std::min((y - radius) / dmin, (y - radius) / dmax) - tan_bottom) / texel_v;
+    const float y1 = static_cast<float>(std::max((y + radius) / dmin, (y + radius) / dmax) - tan_bottom) / texel_v;
+    if (x1 < 0 || y1 < 0 || x0 >= width || y0 >= height) {
+        return false;
+    }
+    lo[0] = ClampedTexel(x0, width);
+    hi[0] = ClampedTexel(x1, width);
+    lo[1] = ClampedTexel(y0, height);
+    hi[1] = ClampedTexel(y1, height);
+    return true;
+}
+
+//Whether the direction (u, v, 1) lies inside the cone around c with the given squared cosine
+static inline bool InsideCone(float u, float v, float cx, float cy, float cz, float cos2) {
+    const float dot = u * cx + v * cy + cz;
+    return dot > 0 && dot * dot >= cos2 * (u * u + v * v + 1);
+}
+
+bool OcclusionRaster::AddOccluder(const QVector &center, float radius) {
+    if (!has_view || !(radius > 0)) {
+        return false;
+    }
+    const QVector rel = center - eye;
+    //the silhouette is only a convex ellipse on screen while the whole sphere is in front of the eye
+    if (rel.Dot(forward) <= radius) {
+        return false;
+    }
+    unsigned int lo[2], hi[2];
+    if (!TexelRect(rel, radius, lo, hi)) {
+        return false;
+    }
+    const double dist2 = rel.MagnitudeSquared();
+    const double dist = sqrt(dist2);
+    //rays through the silhouette meet the surface no farther than the tangent length
+    const float hide = static_cast<float>(sqrt(dist2 - static_cast<double>(radius) * radius));
+    const float cx = static_cast<float>(rel.Dot(axis_x) / dist);
+    const float cy = static_cast<float>(rel.Dot(axis_y) / dist);
+    const float cz = static_cast<float>(rel.Dot(forward) / dist);
+    const float cos2 = static_cast<float>(1.0 - radius * static_cast<double>(radius) / dist2);
+
+    //a texel is covered when all four of its corners are inside the silhouette, as the silhouette is convex
+    const unsigned int corners = hi[0] - lo[0] + 2;
+    bool written = false;
+    for (unsigned int j = lo[1]; j <= hi[1] + 1; ++j) {
+        unsigned char *row = &corner_rows[(j & 1) * (width + 1)];
+        const float v = tan_bottom + j * texel_v;
+        unsigned int i = 0;
+#ifdef OCCLUSION_RASTER_SSE
+        const __m128 vcx = _mm_set1_ps(cx);
+        const __m128 vcos2 = _mm_set1_ps(cos2);
+        const __m128 vdot = _mm_set1_ps(v * cy + cz);
+        const __m128 vlen = _mm_set1_ps(v * v + 1);
+        const __m128 step = _mm_set_ps(3, 2, 1, 0);
+        const __m128 vtexel = _mm_set1_ps(texel_u);
+        for (; i + 4 <= corners; i += 4) {
+            const __m128 u = _mm_add_ps(_mm_set1_ps(tan_left + (lo[0] + i) * texel_u), _mm_mul_ps(step, vtexel));
+            const __m128 dot = _mm_add_ps(_mm_mul_ps(u, vcx), vdot);
+            const __m128 len = _mm_add_ps(_mm_mul_ps(u, u), vlen);
+            const __m128 inside = _mm_and_ps(_mm_cmpgt_ps(dot, _mm_setzero_ps()),
+                    _mm_cmpge_ps(_mm_mul_ps(dot, dot), _mm_mul_ps(vcos2, len)));
+            const int mask = _mm_movemask_ps(inside);
+            row[i] = mask & 1;
+            row[i + 1] = (mask >> 1) & 1;
+            row[i + 2] = (mask >> 2) & 1;
+            row[i + 3] = (mask >> 3) & 1;
+        }
+#endif
+        for (; i < corners; ++i) {
+            row[i] = InsideCone(tan_left + (lo[0] + i) * texel_u, v, cx, cy, cz, cos2);
+        }
+        if (j == lo[1]) {
+            continue;
+        }
+        //the row of texels between the corner row j - 1 and this one
+        const unsigned char *below = &corner_rows[((j - 1) & 1) * (width + 1)];
+        float *texels = &depth[(j - 1) * width + lo[0]];
+        for (i = 0; i + 1 < corners; ++i) {
+            if (below[i] & below[i + 1] & row[i] & row[i + 1]) {
+                texels[i] = std::min(texels[i], hide);
+                written = true;
+            }
+        }
+    }
+    if (written) {
+        ++occluders;
+    }
+    return written;
+}
+
+bool OcclusionRaster::IsOccluded(const QVector &center, float radius) const {
+#ifdef OCCLUSION_RASTER_SSE
+    if (occluders == 0) {
+        return false;
+    }
+    const QVector rel = center - eye;
+    unsigned int lo[2], hi[2];
+    if (!TexelRect(rel, radius, lo, hi)) {
+        return false;
+    }
+    const float nearest = static_cast<float>(rel.Magnitude() - radius);
+    const __m128 vnearest = _mm_set1_ps(nearest);
+    const unsigned int n = hi[0] - lo[0] + 1;
+    for (unsigned int j = lo[1]; j <= hi[1]; ++j) {
+        const float *texels = &depth[j * width + lo[0]];
+        unsigned int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(texels + i), vnearest))) {
+                return false;
+            }
+        }
+        for (; i < n; ++i) {
+            if (texels[i] >= nearest) {
+                return false;
+            }
+        }
+    }
+    return true;
+#else
+    return IsOccludedScalar(center, radius);
+#endif
+}
+
+bool OcclusionRaster::IsOccludedScalar(const QVector &center, float radius) const {
+    if (occluders == 0) {
+        return false;
+    }
+    const QVector rel = center - eye;
+    unsigned int lo[2], hi[2];
+    if (!TexelRect(rel, radius, lo, hi)) {
+        return false;
+    }
+    const float nearest = static_cast<float>(rel.Magnitude() - radius);
+    for (unsigned int j = lo[1]; j <= hi[1]; ++j) {
+        for (unsigned int i = lo[0]; i <= hi[0]; ++i) {
+            if (depth[j * width + i] >= nearest) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
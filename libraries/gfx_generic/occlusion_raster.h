@@ -0,0 +1,112 @@
+/*
+ * occlusion_raster.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_OCCLUSION_RASTER_H
+#define VEGA_STRIKE_ENGINE_GFX_OCCLUSION_RASTER_H
+
+#include <vector>
+#include "gfx_generic/vec.h"
+
+/**
+ * A small software depth buffer over the view, for culling objects hidden
+ * behind big solid spheres such as planets.
+ *
+ * Texels are laid out over the tangents of the view frustum and hold the
+ * distance from the eye behind which everything along the texel is known
+ * to be hidden. Both sides are conservative: an occluder only fills the
+ * texels its silhouette covers completely, at the farthest distance of its
+ * visible surface, and a sphere is only hidden when every texel of its
+ * bounding rectangle is nearer than the sphere's nearest point.
+ * Rows are filled and tested four texels at a time with SSE where available.
+ */
+class OcclusionRaster {
+public:
+    OcclusionRaster(unsigned int width = 128, unsigned int height = 64);
+
+    ///Drops every occluder and resizes the buffer; a width or height of 0 turns the raster off
+    void Resize(unsigned int width, unsigned int height);
+
+    ///The eye, its unit axes, and the frustum extents at znear, as GFXGetFrustumVars returns them
+    void SetView(const QVector &eye,
+            const Vector &axis_x,
+            const Vector &axis_y,
+            const Vector &forward,
+            float left,
+            float right,
+            float bottom,
+            float top,
+            float znear);
+
+    void Clear();
+
+    ///Rasterizes a solid sphere; returns false if it could not be used (the eye is inside it or it reaches behind the eye)
+    bool AddOccluder(const QVector &center, float radius);
+
+    ///True if the sphere is certainly hidden by the occluders added since Clear
+    bool IsOccluded(const QVector &center, float radius) const;
+
+    ///Plain scalar version of IsOccluded, the reference the SSE path must agree with
+    bool IsOccludedScalar(const QVector &center, float radius) const;
+
+    unsigned int Occluders() const {
+        return occluders;
+    }
+
+    unsigned int Width() const {
+        return width;
+    }
+
+    unsigned int Height() const {
+        return height;
+    }
+
+    ///The hiding distance of a texel, or FLT_MAX where nothing was rasterized
+    float Depth(unsigned int x, unsigned int y) const {
+        return depth[y * width + x];
+    }
+
+private:
+    ///Texels covered by the screen rectangle bounding the sphere; false if it is off screen or reaches behind the eye
+    bool TexelRect(const QVector &rel, float radius, unsigned int lo[2], unsigned int hi[2]) const;
+
+    unsigned int width;
+    unsigned int height;
+    bool has_view;
+    QVector eye;
+    QVector axis_x;
+    QVector axis_y;
+    QVector forward;
+    float tan_left;
+    float tan_bottom;
+    float texel_u;
+    float texel_v;
+    unsigned int occluders;
+    std::vector<float> depth;
+    ///which corners of the rows being filled lie inside the occluder's silhouette
+    std::vector<unsigned char> corner_rows;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_OCCLUSION_RASTER_H
@@ -0,0 +1,127 @@
+/*
+ * particle_arrays.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gfx_generic/particle_arrays.h"
+
+#include <algorithm>
+
+#include "gfx/radix_sort.h"
+
+void ParticleArrays::Add(const QVector &loc, const Vector &vel, const GFXColor &col, float size) {
+    loc_x.push_back(loc.i);
+    loc_y.push_back(loc.j);
+    loc_z.push_back(loc.k);
+    vel_x.push_back(vel.i);
+    vel_y.push_back(vel.j);
+    vel_z.push_back(vel.k);
+    col_r.push_back(col.r);
+    col_g.push_back(col.g);
+    col_b.push_back(col.b);
+    col_a.push_back(col.a);
+    sizes.push_back(size);
+}
+
+void ParticleArrays::Set(size_t i, const QVector &loc, const Vector &vel, const GFXColor &col, float size) {
+    loc_x[i] = loc.i;
+    loc_y[i] = loc.j;
+    loc_z[i] = loc.k;
+    vel_x[i] = vel.i;
+    vel_y[i] = vel.j;
+    vel_z[i] = vel.k;
+    col_r[i] = col.r;
+    col_g[i] = col.g;
+    col_b[i] = col.b;
+    col_a[i] = col.a;
+    sizes[i] = size;
+}
+
+template<typename T>
+static inline void SwapAndPop(std::vector<T> &v, size_t i) {
+    v[i] = v.back();
+    v.pop_back();
+}
+
+void ParticleArrays::Remove(size_t i) {
+    SwapAndPop(loc_x, i);
+    SwapAndPop(loc_y, i);
+    SwapAndPop(loc_z, i);
+    SwapAndPop(vel_x, i);
+    SwapAndPop(vel_y, i);
+    SwapAndPop(vel_z, i);
+    SwapAndPop(col_r, i);
+    SwapAndPop(col_g, i);
+    SwapAndPop(col_b, i);
+    SwapAndPop(col_a, i);
+    SwapAndPop(sizes, i);
+}
+
+void ParticleArrays::Update(float elapsed, float fade, bool fade_color) {
+    const size_t nparticles = sizes.size();
+    //Straight loops over the separate arrays, so the compiler can vectorize them
+    for (size_t i = 0; i < nparticles; ++i) {
+        loc_x[i] += vel_x[i] * elapsed;
+        loc_y[i] += vel_y[i] * elapsed;
+        loc_z[i] += vel_z[i] * elapsed;
+    }
+    fade *= elapsed;
+    if (fade_color) {
+        for (size_t i = 0; i < nparticles; ++i) {
+            col_r[i] = std::min(1.0F, std::max(0.0F, col_r[i] - fade));
+            col_g[i] = std::min(1.0F, std::max(0.0F, col_g[i] - fade));
+            col_b[i] = std::min(1.0F, std::max(0.0F, col_b[i] - fade));
+            col_a[i] = std::min(1.0F, std::max(0.0F, col_a[i] - fade));
+        }
+    } else {
+        for (size_t i = 0; i < nparticles; ++i) {
+            col_a[i] = std::max(0.0F, col_a[i] - fade);
+        }
+    }
+}
+
+void ParticleArrays::RemoveFaded(float min_alpha) {
+    for (size_t i = 0; i < sizes.size();) {
+        if (col_a[i] > min_alpha) {
+            ++i;
+        } else {
+            Remove(i);
+        }
+    }
+}
+
+const std::vector<ParticleArrays::DepthKey> &ParticleArrays::SortByDepth(const QVector &camera, float offset) {
+    const size_t nparticles = sizes.size();
+    depthOrder.resize(nparticles);
+    for (size_t i = 0; i < nparticles; ++i) {
+        const QVector d = Location(i, offset) - camera;
+        //complemented, so the farthest come first
+        depthOrder[i].key = ~FloatSortKey(static_cast<float>(d.MagnitudeSquared()));
+        depthOrder[i].index = static_cast<uint32_t>(i);
+    }
+    RadixSort(depthOrder, depthScratch, [](const DepthKey &k) {
+        return static_cast<uint64_t>(k.key);
+    });
+    return depthOrder;
+}
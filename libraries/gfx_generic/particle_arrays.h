@@ -0,0 +1,83 @@
+/*
+ * particle_arrays.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_PARTICLE_ARRAYS_H
+#define VEGA_STRIKE_ENGINE_GFX_PARTICLE_ARRAYS_H
+
+#include <cstdint>
+#include <vector>
+#include "gfx_generic/vec.h"
+#include "src/gfxlib_struct.h"
+
+/**
+ * The particles of one particle system, kept as one array per field so the
+ * per atom update is a handful of straight loops the compiler vectorizes.
+ *
+ * A removed particle is replaced by the last one, so indices only hold
+ * until the next removal. Locations are those of the last simulation atom;
+ * Location() and SortByDepth() take an offset in seconds from it, so the
+ * particles can be drawn where they are at the frame's interpolated time.
+ * Nothing in here talks to the renderer.
+ */
+class ParticleArrays {
+public:
+    std::vector<double> loc_x, loc_y, loc_z;
+    std::vector<float> vel_x, vel_y, vel_z;
+    std::vector<float> col_r, col_g, col_b, col_a;
+    std::vector<float> sizes;
+
+    struct DepthKey {
+        uint32_t key;
+        uint32_t index;
+    };
+
+    size_t size() const {
+        return sizes.size();
+    }
+
+    void Add(const QVector &loc, const Vector &vel, const GFXColor &col, float size);
+    void Set(size_t i, const QVector &loc, const Vector &vel, const GFXColor &col, float size);
+    ///Moves the last particle into i
+    void Remove(size_t i);
+
+    ///Moves the particles by elapsed seconds and fades their alpha, and their color if fade_color, by fade per second
+    void Update(float elapsed, float fade, bool fade_color);
+    ///Drops every particle whose alpha is down to min_alpha
+    void RemoveFaded(float min_alpha);
+
+    QVector Location(size_t i, float offset) const {
+        return QVector(loc_x[i] + vel_x[i] * offset, loc_y[i] + vel_y[i] * offset, loc_z[i] + vel_z[i] * offset);
+    }
+
+    ///Orders the particles farthest from camera first, as they are offset seconds from the last atom
+    const std::vector<DepthKey> &SortByDepth(const QVector &camera, float offset);
+
+private:
+    std::vector<DepthKey> depthOrder;
+    std::vector<DepthKey> depthScratch;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_PARTICLE_ARRAYS_H
@@ -0,0 +1,160 @@
+/*
+ * sphere_cull.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gfx_generic/sphere_cull.h"
+#include "gfx_generic/occlusion_raster.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPHERE_CULL_SSE
+#endif
+
+SphereCuller::SphereCuller() : origin(0, 0, 0) {
+    for (int p = 0; p < 5; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            planes[p][c] = 0;
+        }
+    }
+}
+
+void SphereCuller::SetFrustum(const double frustum[6][4], const QVector &origin) {
+    this->origin = origin;
+    for (int p = 0; p < 5; ++p) {
+        //move the plane into origin relative coordinates before dropping to float
+        planes[p][0] = static_cast<float>(frustum[p][0]);
+        planes[p][1] = static_cast<float>(frustum[p][1]);
+        planes[p][2] = static_cast<float>(frustum[p][2]);
+        planes[p][3] = static_cast<float>(frustum[p][0] * origin.i + frustum[p][1] * origin.j
+                + frustum[p][2] * origin.k + frustum[p][3]);
+    }
+}
+
+void SphereCuller::Clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+    max_distance.clear();
+    results.clear();
+    visible.clear();
+}
+
+size_t SphereCuller::Add(const QVector &center, float radius, float max_distance) {
+    x.push_back(static_cast<float>(center.i - origin.i));
+    y.push_back(static_cast<float>(center.j - origin.j));
+    z.push_back(static_cast<float>(center.k - origin.k));
+    this->radius.push_back(radius);
+    this->max_distance.push_back(max_distance);
+    return this->radius.size() - 1;
+}
+
+unsigned char SphereCuller::CullOne(size_t i) const {
+    unsigned char result = VISIBLE;
+    for (int p = 0; p < 5; ++p) {
+        float d = planes[p][0] * x[i] + planes[p][1] * y[i] + planes[p][2] * z[i] + planes[p][3];
+        if (d <= -radius[i]) {
+            result |= OUTSIDE_FRUSTUM;
+        }
+    }
+    if (max_distance[i] > 0) {
+        float limit = max_distance[i] + radius[i];
+        if (x[i] * x[i] + y[i] * y[i] + z[i] * z[i] > limit * limit) {
+            result |= BEYOND_DISTANCE;
+        }
+    }
+    return result;
+}
+
+void SphereCuller::CollectVisible() {
+    visible.clear();
+    for (size_t i = 0, n = results.size(); i < n; ++i) {
+        if (results[i] == VISIBLE) {
+            visible.push_back(static_cast<unsigned int>(i));
+        }
+    }
+}
+
+void SphereCuller::CullScalar() {
+    results.resize(radius.size());
+    for (size_t i = 0, n = radius.size(); i < n; ++i) {
+        results[i] = CullOne(i);
+    }
+    CollectVisible();
+}
+
+void SphereCuller::Cull() {
+    const size_t n = radius.size();
+    results.resize(n);
+    size_t i = 0;
+#ifdef SPHERE_CULL_SSE
+    const __m128 zero = _mm_setzero_ps();
+    __m128 plane[5][4];
+    for (int p = 0; p < 5; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            plane[p][c] = _mm_set1_ps(planes[p][c]);
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&x[i]);
+        const __m128 cy = _mm_loadu_ps(&y[i]);
+        const __m128 cz = _mm_loadu_ps(&z[i]);
+        const __m128 r = _mm_loadu_ps(&radius[i]);
+        const __m128 neg_r = _mm_sub_ps(zero, r);
+        __m128 outside = zero;
+        for (int p = 0; p < 5; ++p) {
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[p][0], cx), _mm_mul_ps(plane[p][1], cy)),
+                    _mm_mul_ps(plane[p][2], cz)), plane[p][3]);
+            outside = _mm_or_ps(outside, _mm_cmple_ps(d, neg_r));
+        }
+        const __m128 md = _mm_loadu_ps(&max_distance[i]);
+        const __m128 limit = _mm_add_ps(md, r);
+        const __m128 dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, cx), _mm_mul_ps(cy, cy)), _mm_mul_ps(cz, cz));
+        const __m128 beyond = _mm_and_ps(_mm_cmpgt_ps(md, zero), _mm_cmpgt_ps(dist2, _mm_mul_ps(limit, limit)));
+        const int outside_bits = _mm_movemask_ps(outside);
+        const int beyond_bits = _mm_movemask_ps(beyond);
+        for (int k = 0; k < 4; ++k) {
+            results[i + k] = static_cast<unsigned char>(((outside_bits >> k) & 1) * OUTSIDE_FRUSTUM
+                    | ((beyond_bits >> k) & 1) * BEYOND_DISTANCE);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        results[i] = CullOne(i);
+    }
+    CollectVisible();
+}
+
+void SphereCuller::Occlude(const OcclusionRaster &raster) {
+    if (raster.Occluders() == 0) {
+        return;
+    }
+    for (unsigned int i : visible) {
+        if (raster.IsOccluded(origin + QVector(x[i], y[i], z[i]), radius[i])) {
+            results[i] = HIDDEN;
+        }
+    }
+    CollectVisible();
+}
@@ -0,0 +1,102 @@
+/*
+ * sphere_cull.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_SPHERE_CULL_H
+#define VEGA_STRIKE_ENGINE_GFX_SPHERE_CULL_H
+
+#include <vector>
+#include "gfx_generic/vec.h"
+
+class OcclusionRaster;
+
+/**
+ * Culls a batch of bounding spheres against the view frustum and a per
+ * sphere draw distance in one go.
+ *
+ * Spheres are stored as contiguous float arrays relative to an origin
+ * (normally the camera), so the far away coordinates of a star system keep
+ * their precision, and are tested four at a time with SSE where available.
+ * Like GFXSphereInFrustum, the yon plane is not tested.
+ */
+class SphereCuller {
+public:
+    enum CullResult {
+        VISIBLE = 0,
+        OUTSIDE_FRUSTUM = 1,
+        BEYOND_DISTANCE = 2,
+        ///not set by Cull; marks spheres the caller found behind an occluder
+        HIDDEN = 4,
+    };
+
+    SphereCuller();
+
+    ///Takes the planes computed by GFXCalculateFrustum; spheres added afterwards are tested against them
+    void SetFrustum(const double frustum[6][4], const QVector &origin);
+
+    void Clear();
+
+    ///max_distance limits how far the nearest point of the sphere may be from the origin; 0 means no limit
+    size_t Add(const QVector &center, float radius, float max_distance = 0);
+
+    size_t Size() const {
+        return radius.size();
+    }
+
+    ///Culls every sphere added since Clear
+    void Cull();
+
+    ///Plain scalar version of Cull, the reference the batched path must agree with
+    void CullScalar();
+
+    ///Marks the spheres that passed Cull but are hidden behind the raster's occluders as HIDDEN
+    void Occlude(const OcclusionRaster &raster);
+
+    ///CullResult bits for each sphere, in the order they were added
+    const std::vector<unsigned char> &Results() const {
+        return results;
+    }
+
+    ///Indices of the spheres that passed both tests, in the order they were added
+    const std::vector<unsigned int> &Visible() const {
+        return visible;
+    }
+
+private:
+    unsigned char CullOne(size_t i) const;
+    void CollectVisible();
+
+    QVector origin;
+    float planes[5][4];
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> radius;
+    std::vector<float> max_distance;
+    std::vector<unsigned char> results;
+    std::vector<unsigned int> visible;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_SPHERE_CULL_H
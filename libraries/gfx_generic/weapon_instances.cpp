@@ -0,0 +1,355 @@
+/*
+ * weapon_instances.cpp
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+
+#include "gfx_generic/weapon_instances.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WEAPON_INSTANCES_SSE
+#endif
+
+WeaponInstances::WeaponInstances() :
+        camera(0, 0, 0),
+        pixel_angle(0),
+        blend(1),
+        radius(1),
+        length(1),
+        color{1, 1, 1, 1},
+        frame(0),
+        cull_size(0) {
+    open = Open(1);
+}
+
+void WeaponInstances::Begin(const QVector &camera, float pixel_angle, float blend) {
+    this->camera = camera;
+    this->pixel_angle = pixel_angle;
+    this->blend = blend;
+    instances.clear();
+    vertices.clear();
+    ClearQueue();
+}
+
+WeaponInstances::Batch WeaponInstances::Open(int texture_sets) const {
+    Batch batch;
+    batch.first_instance = instances.size();
+    batch.instances = 0;
+    batch.vertex_offset = vertices.size();
+    batch.vertices = 0;
+    batch.texture_sets = texture_sets;
+    return batch;
+}
+
+void WeaponInstances::ClearQueue() {
+    for (int c = 0; c < 3; ++c) {
+        prev[c].clear();
+        delta[c].clear();
+        forward[c].clear();
+        upward[c].clear();
+    }
+}
+
+void WeaponInstances::BeginBatch() {
+    ClearQueue();
+    open = Open(1);
+}
+
+void WeaponInstances::SetStyle(float radius, float length, const GFXColor &color, float frame, float cull_size) {
+    Flush();
+    this->radius = radius;
+    this->length = length;
+    this->color[0] = color.r;
+    this->color[1] = color.g;
+    this->color[2] = color.b;
+    this->color[3] = color.a;
+    this->frame = frame;
+    this->cull_size = cull_size;
+}
+
+void WeaponInstances::AddBolt(const QVector &prev, const QVector &cur, const Vector &direction, const Vector &up) {
+    const QVector from = prev - camera;
+    const QVector move = cur - prev;
+    this->prev[0].push_back(static_cast<float>(from.i));
+    this->prev[1].push_back(static_cast<float>(from.j));
+    this->prev[2].push_back(static_cast<float>(from.k));
+    delta[0].push_back(static_cast<float>(move.i));
+    delta[1].push_back(static_cast<float>(move.j));
+    delta[2].push_back(static_cast<float>(move.k));
+    forward[0].push_back(direction.i);
+    forward[1].push_back(direction.j);
+    forward[2].push_back(direction.k);
+    upward[0].push_back(up.i);
+    upward[1].push_back(up.j);
+    upward[2].push_back(up.k);
+}
+
+void WeaponInstances::Write(const float position[3], const float direction[3], const float up[3]) {
+    Instance instance;
+    for (int c = 0; c < 3; ++c) {
+        instance.position[c] = position[c];
+        instance.direction[c] = direction[c];
+        instance.up[c] = up[c];
+    }
+    instance.length = length;
+    instance.radius = radius;
+    instance.frame = frame;
+    for (int c = 0; c < 4; ++c) {
+        instance.color[c] = color[c];
+    }
+    instances.push_back(instance);
+}
+
+void WeaponInstances::CullScalar(size_t i) {
+    float position[3];
+    float distance = 0;
+    for (int c = 0; c < 3; ++c) {
+        position[c] = prev[c][i] + delta[c][i] * blend;
+        distance = distance + position[c] * position[c];
+    }
+    if (!(distance * pixel_angle < cull_size)) {
+        return;
+    }
+    float direction[3];
+    float up[3];
+    float direction_length = 0;
+    float up_length = 0;
+    for (int c = 0; c < 3; ++c) {
+        direction_length = direction_length + forward[c][i] * forward[c][i];
+        up_length = up_length + upward[c][i] * upward[c][i];
+    }
+    const float inverse_direction = 1.0F / std::sqrt(direction_length);
+    const float inverse_up = 1.0F / std::sqrt(up_length);
+    for (int c = 0; c < 3; ++c) {
+        direction[c] = forward[c][i] * inverse_direction;
+        up[c] = upward[c][i] * inverse_up;
+    }
+    Write(position, direction, up);
+}
+
+void WeaponInstances::FlushScalar() {
+    for (size_t i = 0, n = prev[0].size(); i < n; ++i) {
+        CullScalar(i);
+    }
+    ClearQueue();
+}
+
+void WeaponInstances::Flush() {
+#ifdef WEAPON_INSTANCES_SSE
+    const size_t n = prev[0].size();
+    size_t i = 0;
+    const __m128 blend4 = _mm_set1_ps(blend);
+    const __m128 pixel_angle4 = _mm_set1_ps(pixel_angle);
+    const __m128 cull_size4 = _mm_set1_ps(cull_size);
+    const __m128 one = _mm_set1_ps(1.0F);
+    //rows of position, direction and up components, four bolts each
+    alignas(16) float lanes[9][4];
+    for (; i + 4 <= n; i += 4) {
+        __m128 position[3];
+        __m128 distance = _mm_setzero_ps();
+        for (int c = 0; c < 3; ++c) {
+            position[c] = _mm_add_ps(_mm_loadu_ps(&prev[c][i]), _mm_mul_ps(_mm_loadu_ps(&delta[c][i]), blend4));
+            distance = _mm_add_ps(distance, _mm_mul_ps(position[c], position[c]));
+        }
+        const int visible = _mm_movemask_ps(_mm_cmplt_ps(_mm_mul_ps(distance, pixel_angle4), cull_size4));
+        if (visible == 0) {
+            continue;
+        }
+        __m128 direction[3];
+        __m128 up[3];
+        __m128 direction_length = _mm_setzero_ps();
+        __m128 up_length = _mm_setzero_ps();
+        for (int c = 0; c < 3; ++c) {
+            direction[c] = _mm_loadu_ps(&forward[c][i]);
+            up[c] = _mm_loadu_ps(&upward[c][i]);
+            direction_length = _mm_add_ps(direction_length, _mm_mul_ps(direction[c], direction[c]));
+            up_length = _mm_add_ps(up_length, _mm_mul_ps(up[c], up[c]));
+        }
+        const __m128 inverse_direction = _mm_div_ps(one, _mm_sqrt_ps(direction_length));
+        const __m128 inverse_up = _mm_div_ps(one, _mm_sqrt_ps(up_length));
+        for (int c = 0; c < 3; ++c) {
+            _mm_store_ps(lanes[c], position[c]);
+            _mm_store_ps(lanes[3 + c], _mm_mul_ps(direction[c], inverse_direction));
+            _mm_store_ps(lanes[6 + c], _mm_mul_ps(up[c], inverse_up));
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            if (visible & (1 << lane)) {
+                const float p[3] = {lanes[0][lane], lanes[1][lane], lanes[2][lane]};
+                const float d[3] = {lanes[3][lane], lanes[4][lane], lanes[5][lane]};
+                const float u[3] = {lanes[6][lane], lanes[7][lane], lanes[8][lane]};
+                Write(p, d, u);
+            }
+        }
+    }
+    for (; i < n; ++i) {
+        CullScalar(i);
+    }
+    ClearQueue();
+#else
+    FlushScalar();
+#endif
+}
+
+WeaponInstances::Batch WeaponInstances::EndBatch() {
+    Flush();
+    open.instances = instances.size() - open.first_instance;
+    return open;
+}
+
+WeaponInstances::Batch WeaponInstances::EndBatchScalar() {
+    FlushScalar();
+    open.instances = instances.size() - open.first_instance;
+    return open;
+}
+
+void WeaponInstances::BeginBeams() {
+    ClearQueue();
+    open = Open(1);
+}
+
+void WeaponInstances::AddBeam(const Matrix &m,
+        float length,
+        float radius,
+        float frame,
+        const GFXColor &color,
+        const GFXColorVertex *beam,
+        int count) {
+    const Vector position = (m.p - camera).Cast();
+    Vector direction = m.getR();
+    Vector up = m.getQ();
+    direction.Normalize();
+    up.Normalize();
+    Instance instance;
+    instance.position[0] = position.i;
+    instance.position[1] = position.j;
+    instance.position[2] = position.k;
+    instance.length = length;
+    instance.direction[0] = direction.i;
+    instance.direction[1] = direction.j;
+    instance.direction[2] = direction.k;
+    instance.radius = radius;
+    instance.up[0] = up.i;
+    instance.up[1] = up.j;
+    instance.up[2] = up.k;
+    instance.frame = frame;
+    instance.color[0] = color.r;
+    instance.color[1] = color.g;
+    instance.color[2] = color.b;
+    instance.color[3] = color.a;
+    instances.push_back(instance);
+
+    const size_t stride = VertexFloats(1);
+    size_t at = vertices.size();
+    vertices.resize(at + count * stride);
+    for (int v = 0; v < count; ++v, at += stride) {
+        const GFXColorVertex &in = beam[v];
+        const Vector offset = TransformNormal(m, Vector(in.x, in.y, in.z));
+        float *out = &vertices[at];
+        out[0] = position.i + offset.i;
+        out[1] = position.j + offset.j;
+        out[2] = position.k + offset.k;
+        out[3] = in.r;
+        out[4] = in.g;
+        out[5] = in.b;
+        out[6] = in.a;
+        out[7] = in.s;
+        out[8] = in.t;
+    }
+    open.vertices += count;
+}
+
+WeaponInstances::Batch WeaponInstances::EndBeams() {
+    open.instances = instances.size() - open.first_instance;
+    return open;
+}
+
+void WeaponInstances::ExpandScalar(Batch &batch, const GFXVertex *mesh, int count, int texture_sets) {
+    const size_t stride = VertexFloats(texture_sets);
+    batch.texture_sets = texture_sets;
+    batch.vertex_offset = vertices.size();
+    batch.vertices = batch.instances * count;
+    vertices.resize(batch.vertex_offset + batch.vertices * stride);
+    float *out = vertices.data() + batch.vertex_offset;
+    for (size_t i = batch.first_instance; i < batch.first_instance + batch.instances; ++i) {
+        const Instance &instance = instances[i];
+        const float *d = instance.direction;
+        const float *u = instance.up;
+        const float side[3] = {u[1] * d[2] - u[2] * d[1], u[2] * d[0] - u[0] * d[2], u[0] * d[1] - u[1] * d[0]};
+        for (int v = 0; v < count; ++v, out += stride) {
+            const float x = mesh[v].x * instance.radius;
+            const float y = mesh[v].y * instance.radius;
+            const float z = mesh[v].z * instance.length;
+            for (int c = 0; c < 3; ++c) {
+                out[c] = ((instance.position[c] + side[c] * x) + u[c] * y) + d[c] * z;
+            }
+            for (int c = 0; c < 4; ++c) {
+                out[3 + c] = instance.color[c];
+            }
+            for (int set = 0; set < texture_sets; ++set) {
+                out[7 + 2 * set] = mesh[v].s;
+                out[8 + 2 * set] = mesh[v].t;
+            }
+        }
+    }
+}
+
+void WeaponInstances::Expand(Batch &batch, const GFXVertex *mesh, int count, int texture_sets) {
+#ifdef WEAPON_INSTANCES_SSE
+    const size_t stride = VertexFloats(texture_sets);
+    batch.texture_sets = texture_sets;
+    batch.vertex_offset = vertices.size();
+    batch.vertices = batch.instances * count;
+    vertices.resize(batch.vertex_offset + batch.vertices * stride);
+    float *out = vertices.data() + batch.vertex_offset;
+    for (size_t i = batch.first_instance; i < batch.first_instance + batch.instances; ++i) {
+        const Instance &instance = instances[i];
+        const float *d = instance.direction;
+        const float *u = instance.up;
+        const __m128 position = _mm_setr_ps(instance.position[0], instance.position[1], instance.position[2], 0);
+        const __m128 side = _mm_setr_ps(u[1] * d[2] - u[2] * d[1], u[2] * d[0] - u[0] * d[2],
+                u[0] * d[1] - u[1] * d[0], 0);
+        const __m128 up = _mm_setr_ps(u[0], u[1], u[2], 0);
+        const __m128 direction = _mm_setr_ps(d[0], d[1], d[2], 0);
+        const __m128 color = _mm_loadu_ps(instance.color);
+        for (int v = 0; v < count; ++v, out += stride) {
+            const __m128 x = _mm_set1_ps(mesh[v].x * instance.radius);
+            const __m128 y = _mm_set1_ps(mesh[v].y * instance.radius);
+            const __m128 z = _mm_set1_ps(mesh[v].z * instance.length);
+            const __m128 vertex = _mm_add_ps(_mm_add_ps(_mm_add_ps(position, _mm_mul_ps(side, x)),
+                    _mm_mul_ps(up, y)), _mm_mul_ps(direction, z));
+            //the fourth lane lands on r and is overwritten by the colour
+            _mm_storeu_ps(out, vertex);
+            _mm_storeu_ps(out + 3, color);
+            for (int set = 0; set < texture_sets; ++set) {
+                out[7 + 2 * set] = mesh[v].s;
+                out[8 + 2 * set] = mesh[v].t;
+            }
+        }
+    }
+#else
+    ExpandScalar(batch, mesh, count, texture_sets);
+#endif
+}
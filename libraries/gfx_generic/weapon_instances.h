@@ -0,0 +1,146 @@
+/*
+ * weapon_instances.h
+ *
+ * Vega Strike - Space Simulation, Combat and Trading
+ * Copyright (C) 2001-2026 The Vega Strike Contributors:
+ * Project creator: Daniel Horn
+ * Original development team: As listed in the AUTHORS file
+ * Current development team: Roy Falk, Benjamen R. Meyer, Stephen G. Tuggy
+ *
+ * https://github.com/vegastrike/Vega-Strike-Engine-Source
+ *
+ * This file is part of Vega Strike.
+ *
+ * Vega Strike is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Vega Strike is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Vega Strike.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef VEGA_STRIKE_ENGINE_GFX_WEAPON_INSTANCES_H
+#define VEGA_STRIKE_ENGINE_GFX_WEAPON_INSTANCES_H
+
+#include <vector>
+#include "gfx_generic/vec.h"
+#include "gfx_generic/matrix.h"
+#include "src/gfxlib_struct.h"
+
+/**
+ * Collects the bolts, balls and beams drawn in a frame into one instance
+ * stream per weapon type, and expands each type into a single vertex
+ * buffer that can be handed to GFXDraw in one call.
+ *
+ * Positions are kept relative to the camera, so the stream is drawn with
+ * the camera position as model matrix and stays precise far from the
+ * system origin. Bolts and balls are queued and then blended, culled and
+ * written four at a time with SSE where available; the expansion writes
+ * each vertex as x y z, r g b a, then one or two s t pairs.
+ * Nothing in here talks to the renderer.
+ */
+class WeaponInstances {
+public:
+    struct Instance {
+        ///relative to the camera
+        float position[3];
+        float length;
+        ///unit vectors; the mesh x axis is up cross direction
+        float direction[3];
+        float radius;
+        float up[3];
+        ///animation frame of balls, texture scroll of beams
+        float frame;
+        float color[4];
+    };
+
+    ///A run of instances and of the vertices expanded from them
+    struct Batch {
+        size_t first_instance;
+        size_t instances;
+        ///in floats, as batches may differ in vertex size
+        size_t vertex_offset;
+        size_t vertices;
+        ///number of s t pairs per vertex
+        int texture_sets;
+    };
+
+    WeaponInstances();
+
+    ///Drops the last frame; pixel_angle is the squared angle under which a weapon is not drawn
+    void Begin(const QVector &camera, float pixel_angle, float blend);
+
+    ///Starts a batch of bolts or balls, all drawn with one texture
+    void BeginBatch();
+    ///Look of the bolts added from now on; those whose squared distance times pixel_angle reaches cull_size are culled
+    void SetStyle(float radius, float length, const GFXColor &color, float frame, float cull_size);
+    ///Queues a bolt or ball moving from prev to cur; direction and up need not be unit length
+    void AddBolt(const QVector &prev, const QVector &cur, const Vector &direction, const Vector &up);
+    ///Blends, culls and writes the queued bolts
+    Batch EndBatch();
+    ///Plain scalar version of EndBatch, the reference the SSE path must agree with
+    Batch EndBatchScalar();
+
+    ///Starts a batch of beams, which come with their own vertices
+    void BeginBeams();
+    ///Adds a beam whose vertices are given in the space of m, where m's z axis is the beam
+    void AddBeam(const Matrix &m, float length, float radius, float frame, const GFXColor &color,
+            const GFXColorVertex *vertices, int count);
+    Batch EndBeams();
+
+    ///Places mesh, scaled by radius across and length along, at every instance of the batch
+    void Expand(Batch &batch, const GFXVertex *mesh, int count, int texture_sets = 1);
+    ///Scalar version of Expand
+    void ExpandScalar(Batch &batch, const GFXVertex *mesh, int count, int texture_sets = 1);
+
+    const QVector &Camera() const {
+        return camera;
+    }
+
+    const std::vector<Instance> &Instances() const {
+        return instances;
+    }
+
+    ///Floats per expanded vertex with the given number of s t pairs
+    static int VertexFloats(int texture_sets) {
+        return 7 + 2 * texture_sets;
+    }
+
+    const float *Vertices(const Batch &batch) const {
+        return vertices.data() + batch.vertex_offset;
+    }
+
+private:
+    Batch Open(int texture_sets) const;
+    void Write(const float position[3], const float direction[3], const float up[3]);
+    ///Blends, culls and writes queued bolt i
+    void CullScalar(size_t i);
+    ///Writes the bolts queued with the current style
+    void Flush();
+    void FlushScalar();
+    void ClearQueue();
+
+    QVector camera;
+    float pixel_angle;
+    float blend;
+    float radius;
+    float length;
+    float color[4];
+    float frame;
+    float cull_size;
+    Batch open;
+    ///queued bolts, a row of each component relative to the camera
+    std::vector<float> prev[3];
+    std::vector<float> delta[3];
+    std::vector<float> forward[3];
+    std::vector<float> upward[3];
+    std::vector<Instance> instances;
+    std::vector<float> vertices;
+};
+
+#endif //VEGA_STRIKE_ENGINE_GFX_WEAPON_INSTANCES_H
@@ -34,6 +34,7 @@
 #include <sys/stat.h>
 #include "root_generic/lin_time.h"
 #include "cmd/script/mission.h"
+#include "cmd/script/mission_scheduler.h"
 #include "src/universe_util.h"
 #include "cmd/unit_generic.h"
 #include "cmd/collection.h"
@@ -661,6 +662,26 @@ namespace UniverseUtil {
         return num + ::num_delayed_missions();
     }
 
+    void setMissionTickInterval(float seconds) {
+        MissionScheduler::getSingleton()->setTickInterval(mission, seconds);
+    }
+
+    void wakeMissionAt(float gametime) {
+        MissionScheduler::getSingleton()->wakeAt(mission, gametime);
+    }
+
+    void wakeMissionOn(string condition) {
+        MissionScheduler::getSingleton()->wakeOn(mission, MissionScheduler::parseWakeCondition(condition));
+    }
+
+    void clearMissionWakeups() {
+        MissionScheduler::getSingleton()->clearWakeConditions(mission);
+    }
+
+    float getMissionCPUTime() {
+        return MissionScheduler::getSingleton()->getAccounting(mission).total_seconds;
+    }
+
     void IOmessage(int delay, string from, string to, string message) {
         if (to == "news" && (!configuration().cargo.news_from_cargo_list)) {
             for (unsigned int i = 0; i < _Universe->numPlayers(); i++) {